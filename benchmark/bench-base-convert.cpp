@@ -0,0 +1,45 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "hexl/experimental/seal/base-convert.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+static void BM_FastBaseConvert(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t num_from_moduli = state.range(1);
+  size_t modulus_bits = state.range(2);
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(num_from_moduli + 4, modulus_bits, true, n);
+  std::vector<uint64_t> from_moduli(moduli.begin(),
+                                    moduli.begin() + num_from_moduli);
+  std::vector<uint64_t> to_moduli(moduli.begin() + num_from_moduli,
+                                  moduli.end());
+
+  AlignedVector64<uint64_t> operand;
+  for (uint64_t modulus : from_moduli) {
+    auto residues = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+    operand.insert(operand.end(), residues.begin(), residues.end());
+  }
+  AlignedVector64<uint64_t> result(to_moduli.size() * n);
+  BaseConverter converter(from_moduli, to_moduli);
+
+  for (auto _ : state) {
+    converter.FastBaseConvert(result.data(), operand.data(), n);
+  }
+}
+
+BENCHMARK(BM_FastBaseConvert)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {4, 16}, {49, 60}});
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,73 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "hexl/experimental/seal/ckks-encode.hpp"
+#include "hexl/ntt/ntt-cache.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+
+namespace intel {
+namespace hexl {
+
+static void BM_CKKSEncode(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t num_moduli = state.range(1);
+  std::vector<uint64_t> moduli = GeneratePrimes(num_moduli, 50, true, n);
+  for (uint64_t modulus : moduli) {
+    // Computes the NTT tables outside the timed loop
+    GetNTT(n, modulus)->Precompute();
+  }
+  CKKSEncoder encoder(n, moduli);
+
+  std::vector<std::complex<double>> values(n / 2);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = std::complex<double>(std::sin(i), std::cos(i));
+  }
+  AlignedVector64<uint64_t> plain(num_moduli * n);
+  double scale = std::pow(2.0, 40);
+
+  for (auto _ : state) {
+    encoder.Encode(plain.data(), values.data(), values.size(), scale);
+  }
+}
+
+BENCHMARK(BM_CKKSEncode)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {1, 4, 16}});
+
+//=================================================================
+
+static void BM_CKKSDecode(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t num_moduli = state.range(1);
+  std::vector<uint64_t> moduli = GeneratePrimes(num_moduli, 50, true, n);
+  for (uint64_t modulus : moduli) {
+    GetNTT(n, modulus)->Precompute();
+  }
+  CKKSEncoder encoder(n, moduli);
+
+  std::vector<std::complex<double>> values(n / 2);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = std::complex<double>(std::sin(i), std::cos(i));
+  }
+  AlignedVector64<uint64_t> plain(num_moduli * n);
+  double scale = std::pow(2.0, 40);
+  encoder.Encode(plain.data(), values.data(), values.size(), scale);
+
+  for (auto _ : state) {
+    encoder.Decode(values.data(), plain.data(), scale);
+  }
+}
+
+BENCHMARK(BM_CKKSDecode)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {1, 4, 16}});
+
+}  // namespace hexl
+}  // namespace intel
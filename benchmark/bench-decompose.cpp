@@ -0,0 +1,66 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "hexl/experimental/seal/decompose.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+// state[0] is the degree, state[1] the number of bits per digit
+static void BM_DecomposePowerOfTwoBase(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t log_base = state.range(1);
+  size_t num_polys = 4;
+  size_t num_digits = (60 + log_base - 1) / log_base;
+
+  auto operand =
+      GenerateInsecureUniformIntRandomValues(num_polys * n, 0, 1ULL << 60);
+  AlignedVector64<uint64_t> result(num_polys * num_digits * n);
+
+  for (auto _ : state) {
+    DecomposePowerOfTwoBase(result.data(), operand.data(), n, num_polys,
+                            log_base, num_digits);
+  }
+}
+
+BENCHMARK(BM_DecomposePowerOfTwoBase)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {10, 20, 30}});
+
+//=================================================================
+
+// state[0] is the degree, state[1] the number of digits
+static void BM_GroupDecompose(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t dnum = state.range(1);
+  std::vector<uint64_t> primes = GeneratePrimes(14, 50, true, n);
+  std::vector<uint64_t> moduli(primes.begin(), primes.begin() + 12);
+  std::vector<uint64_t> extension_moduli(primes.begin() + 12, primes.end());
+
+  AlignedVector64<uint64_t> operand;
+  for (uint64_t modulus : moduli) {
+    auto residues = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+    operand.insert(operand.end(), residues.begin(), residues.end());
+  }
+  GroupDecomposer decomposer(moduli, dnum, extension_moduli);
+  AlignedVector64<uint64_t> result(decomposer.GetNumDigits() * primes.size() *
+                                   n);
+
+  for (auto _ : state) {
+    decomposer.Decompose(result.data(), operand.data(), n);
+  }
+}
+
+BENCHMARK(BM_GroupDecompose)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {2, 3, 12}});
+
+}  // namespace hexl
+}  // namespace intel
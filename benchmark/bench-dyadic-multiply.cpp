@@ -0,0 +1,48 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "hexl/experimental/seal/dyadic-multiply.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+static void BM_DyadicMultiply(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t num_moduli = state.range(1);
+  size_t modulus_bits = state.range(2);
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(num_moduli, modulus_bits, true, n);
+
+  AlignedVector64<uint64_t> operand1(2 * n * num_moduli);
+  AlignedVector64<uint64_t> operand2(2 * n * num_moduli);
+  for (size_t poly = 0; poly < 2; ++poly) {
+    for (size_t i = 0; i < num_moduli; ++i) {
+      size_t offset = (poly * num_moduli + i) * n;
+      auto values1 = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      auto values2 = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      std::copy(values1.begin(), values1.end(), operand1.begin() + offset);
+      std::copy(values2.begin(), values2.end(), operand2.begin() + offset);
+    }
+  }
+  AlignedVector64<uint64_t> result(3 * n * num_moduli);
+
+  for (auto _ : state) {
+    DyadicMultiply(result.data(), operand1.data(), operand2.data(), n,
+                   moduli.data(), num_moduli);
+  }
+}
+
+BENCHMARK(BM_DyadicMultiply)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {4, 16}, {40, 60}});
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,60 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "hexl/eltwise/eltwise-apply-galois.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+// state[0] is the degree
+static void BM_EltwiseApplyGalois(benchmark::State& state) {  //  NOLINT
+  size_t input_size = state.range(0);
+  uint64_t modulus = 0xffffffffffc0001ULL;
+
+  auto input = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+  AlignedVector64<uint64_t> output(input_size, 0);
+  // Computes the permutation tables outside the timed loop
+  GetGaloisPermutation(input_size, 5);
+
+  for (auto _ : state) {
+    EltwiseApplyGalois(output.data(), input.data(), input_size, 5, modulus);
+  }
+}
+
+BENCHMARK(BM_EltwiseApplyGalois)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384});
+
+//=================================================================
+
+// state[0] is the degree
+static void BM_EltwiseApplyGaloisNTT(benchmark::State& state) {  //  NOLINT
+  size_t input_size = state.range(0);
+  uint64_t modulus = 0xffffffffffc0001ULL;
+
+  auto input = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+  AlignedVector64<uint64_t> output(input_size, 0);
+  GetGaloisPermutation(input_size, 5);
+
+  for (auto _ : state) {
+    EltwiseApplyGaloisNTT(output.data(), input.data(), input_size, 5);
+  }
+}
+
+BENCHMARK(BM_EltwiseApplyGaloisNTT)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024})
+    ->Args({4096})
+    ->Args({16384});
+
+}  // namespace hexl
+}  // namespace intel
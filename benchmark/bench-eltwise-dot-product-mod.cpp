@@ -0,0 +1,70 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "hexl/eltwise/eltwise-add-mod.hpp"
+#include "hexl/eltwise/eltwise-dot-product-mod.hpp"
+#include "hexl/eltwise/eltwise-mult-mod.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+//=================================================================
+
+// state[0] is the number of terms
+// state[1] is the bit width of the modulus
+// state[2] is true to use EltwiseDotProductMod, false to use EltwiseMultMod and
+// EltwiseAddMod per term
+static void BM_EltwiseDotProductMod(benchmark::State& state) {  //  NOLINT
+  size_t count = state.range(0);
+  size_t bits = state.range(1);
+  bool fused = state.range(2);
+  size_t input_size = 4096;
+  uint64_t modulus = GeneratePrimes(1, bits, true, input_size)[0];
+
+  std::vector<AlignedVector64<uint64_t>> operand1;
+  std::vector<AlignedVector64<uint64_t>> operand2;
+  std::vector<const uint64_t*> operand1_ptrs;
+  std::vector<const uint64_t*> operand2_ptrs;
+  for (size_t i = 0; i < count; ++i) {
+    operand1.push_back(
+        GenerateInsecureUniformIntRandomValues(input_size, 0, modulus));
+    operand2.push_back(
+        GenerateInsecureUniformIntRandomValues(input_size, 0, modulus));
+  }
+  for (size_t i = 0; i < count; ++i) {
+    operand1_ptrs.push_back(operand1[i].data());
+    operand2_ptrs.push_back(operand2[i].data());
+  }
+  AlignedVector64<uint64_t> product(input_size);
+  AlignedVector64<uint64_t> result(input_size);
+
+  for (auto _ : state) {
+    if (fused) {
+      EltwiseDotProductMod(result.data(), operand1_ptrs.data(),
+                           operand2_ptrs.data(), count, input_size, modulus);
+    } else {
+      std::fill(result.begin(), result.end(), 0);
+      for (size_t i = 0; i < count; ++i) {
+        EltwiseMultMod(product.data(), operand1_ptrs[i], operand2_ptrs[i],
+                       input_size, modulus, 1);
+        EltwiseAddMod(result.data(), result.data(), product.data(),
+                      input_size, modulus);
+      }
+    }
+  }
+}
+
+BENCHMARK(BM_EltwiseDotProductMod)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{2, 8, 32}, {50, 60}, {false, true}});
+
+}  // namespace hexl
+}  // namespace intel
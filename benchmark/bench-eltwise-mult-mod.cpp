@@ -42,6 +42,30 @@ BENCHMARK(BM_EltwiseMultMod)
 
 //=================================================================
 
+// state[0] is the degree
+// state[1] is the grain size of the parallel execution policy
+static void BM_EltwiseMultModParallel(benchmark::State& state) {  //  NOLINT
+  size_t input_size = state.range(0);
+  uint64_t grain_size = state.range(1);
+  uint64_t modulus = 0xffffffffffc0001ULL;
+
+  auto input1 = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+  auto input2 = GenerateInsecureUniformIntRandomValues(input_size, 0, modulus);
+  AlignedVector64<uint64_t> output(input_size, 2);
+  ExecutionPolicy policy = ExecutionPolicy::Parallel(grain_size);
+
+  for (auto _ : state) {
+    EltwiseMultMod(output.data(), input1.data(), input2.data(), input_size,
+                   modulus, 1, policy);
+  }
+}
+
+BENCHMARK(BM_EltwiseMultModParallel)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{1 << 16, 1 << 20}, {1 << 12, 1 << 14, 1 << 16}});
+
+//=================================================================
+
 // state[0] is the degree
 static void BM_EltwiseMultModNative(benchmark::State& state) {  //  NOLINT
   size_t input_size = state.range(0);
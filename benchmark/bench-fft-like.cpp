@@ -355,6 +355,104 @@ BENCHMARK(BM_InvFFTLikeNativeRadix2CopyScaled)
     ->Args({4096})
     ->Args({16384});
 
+// Batched transforms
+//=================================================================
+
+// state.range(2) is the number of threads; 1 uses the serial policy
+static void BM_FwdFFTLikeBatch(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t batch_size = state.range(1);
+  const size_t num_threads = state.range(2);
+  FFTLike fft_like(fft_like_size, nullptr);
+
+  AlignedVector64<std::complex<double>> input(fft_like_size * batch_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(0, 1),
+                             GenerateInsecureUniformRealRandomValue(0, 1));
+  }
+  ExecutionPolicy policy = num_threads == 1
+                               ? ExecutionPolicy::Serial()
+                               : ExecutionPolicy::Parallel(1024, num_threads);
+
+  for (auto _ : state) {
+    fft_like.ComputeForwardFFTLikeBatch(input.data(), input.data(), batch_size,
+                                        nullptr, policy);
+  }
+}
+
+BENCHMARK(BM_FwdFFTLikeBatch)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{1024, 4096}, {1, 16, 64}, {1, 4}});
+
+//=================================================================
+
+static void BM_InvFFTLikeBatch(benchmark::State& state) {  //  NOLINT
+  const size_t fft_like_size = state.range(0);
+  const size_t batch_size = state.range(1);
+  const size_t num_threads = state.range(2);
+  const double scale = 1.0 / static_cast<double>(fft_like_size);
+  FFTLike fft_like(fft_like_size, nullptr);
+
+  AlignedVector64<std::complex<double>> input(fft_like_size * batch_size);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] =
+        std::complex<double>(GenerateInsecureUniformRealRandomValue(0, 1),
+                             GenerateInsecureUniformRealRandomValue(0, 1));
+  }
+  ExecutionPolicy policy = num_threads == 1
+                               ? ExecutionPolicy::Serial()
+                               : ExecutionPolicy::Parallel(1024, num_threads);
+
+  for (auto _ : state) {
+    fft_like.ComputeInverseFFTLikeBatch(input.data(), input.data(), batch_size,
+                                        &scale, policy);
+  }
+}
+
+BENCHMARK(BM_InvFFTLikeBatch)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{1024, 4096}, {1, 16, 64}, {1, 4}});
+
+// Floating-point construction
+//=================================================================
+
+// state.range(2) is the number of threads; 1 uses the serial policy
+static void BM_FFTLikeBuildFloatingPoints(
+    benchmark::State& state) {  //  NOLINT
+  const size_t coeff_count = state.range(0);
+  const size_t mod_size = state.range(1);
+  const size_t num_threads = state.range(2);
+  FFTLike fft_like(coeff_count, nullptr);
+
+  std::vector<uint64_t> decryption_modulus(mod_size, 0xFFFFFFFFFFFFFFFF);
+  decryption_modulus[mod_size - 1] = 1ULL << 40;
+  std::vector<uint64_t> threshold(mod_size, 0);
+  threshold[mod_size - 1] = 1ULL << 39;
+  AlignedVector64<uint64_t> plain;
+  for (size_t i = 0; i < coeff_count; ++i) {
+    auto words = GenerateInsecureUniformIntRandomValues(mod_size, 0,
+                                                        0xFFFFFFFFFFFFFFFF);
+    words[mod_size - 1] %= decryption_modulus[mod_size - 1];
+    plain.insert(plain.end(), words.begin(), words.end());
+  }
+  AlignedVector64<std::complex<double>> result(coeff_count);
+  ExecutionPolicy policy = num_threads == 1
+                               ? ExecutionPolicy::Serial()
+                               : ExecutionPolicy::Parallel(1024, num_threads);
+
+  for (auto _ : state) {
+    fft_like.BuildFloatingPoints(result.data(), plain.data(),
+                                 threshold.data(), decryption_modulus.data(),
+                                 1.0 / (1ULL << 40), mod_size, coeff_count,
+                                 policy);
+  }
+}
+
+BENCHMARK(BM_FFTLikeBuildFloatingPoints)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {4, 16}, {1, 4}});
+
 //=================================================================
 
 #ifdef HEXL_HAS_AVX512DQ
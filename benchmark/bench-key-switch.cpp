@@ -0,0 +1,134 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <utility>
+#include <vector>
+
+#include "hexl/experimental/seal/key-switch.hpp"
+#include "hexl/ntt/ntt-cache.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+// state.range(2) is the number of threads; 1 uses the serial policy and 0
+// uses all threads of the pool
+static void BM_KeySwitch(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t decomp_modulus_size = state.range(1);
+  size_t num_threads = state.range(2);
+  size_t key_modulus_size = decomp_modulus_size + 1;
+  size_t key_component_count = 2;
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(key_modulus_size, 50, true, n);
+
+  AlignedVector64<uint64_t> target;
+  std::vector<uint64_t> modswitch_factors;
+  for (size_t i = 0; i < decomp_modulus_size; ++i) {
+    auto residues = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+    target.insert(target.end(), residues.begin(), residues.end());
+    modswitch_factors.push_back(
+        InverseMod(moduli.back() % moduli[i], moduli[i]));
+  }
+  for (uint64_t modulus : moduli) {
+    // Computes the NTT tables outside the timed loop
+    GetNTT(n, modulus)->Precompute();
+  }
+
+  std::vector<AlignedVector64<uint64_t>> keys;
+  std::vector<const uint64_t*> key_ptrs;
+  for (size_t j = 0; j < decomp_modulus_size; ++j) {
+    AlignedVector64<uint64_t> key;
+    for (size_t k = 0; k < key_component_count; ++k) {
+      for (uint64_t modulus : moduli) {
+        auto residues = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+        key.insert(key.end(), residues.begin(), residues.end());
+      }
+    }
+    keys.push_back(std::move(key));
+    key_ptrs.push_back(keys.back().data());
+  }
+
+  ExecutionPolicy policy = num_threads == 1
+                               ? ExecutionPolicy::Serial()
+                               : ExecutionPolicy::Parallel(n, num_threads);
+  KeySwitchWorkspace workspace(n, decomp_modulus_size, key_modulus_size,
+                               key_component_count,
+                               num_threads == 0 ? 64 : num_threads);
+  AlignedVector64<uint64_t> result(key_component_count * decomp_modulus_size *
+                                   n);
+
+  for (auto _ : state) {
+    KeySwitch(result.data(), target.data(), n, decomp_modulus_size,
+              key_modulus_size, key_modulus_size, key_component_count,
+              moduli.data(), key_ptrs.data(), modswitch_factors.data(),
+              workspace, nullptr, policy);
+  }
+}
+
+BENCHMARK(BM_KeySwitch)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{8192, 16384}, {7, 15}, {1, 4, 0}});
+
+// state.range(2) is 1 to precompute the factors for Shoup multiplication
+static void BM_KeySwitchPrecomputedKeys(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t decomp_modulus_size = state.range(1);
+  bool precompute_shoup = state.range(2) != 0;
+  size_t key_modulus_size = decomp_modulus_size + 1;
+  size_t key_component_count = 2;
+  std::vector<uint64_t> moduli =
+      GeneratePrimes(key_modulus_size, 50, true, n);
+
+  AlignedVector64<uint64_t> target;
+  std::vector<uint64_t> modswitch_factors;
+  for (size_t i = 0; i < decomp_modulus_size; ++i) {
+    auto residues = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+    target.insert(target.end(), residues.begin(), residues.end());
+    modswitch_factors.push_back(
+        InverseMod(moduli.back() % moduli[i], moduli[i]));
+  }
+  for (uint64_t modulus : moduli) {
+    // Computes the NTT tables outside the timed loop
+    GetNTT(n, modulus)->Precompute();
+  }
+
+  std::vector<AlignedVector64<uint64_t>> key_data;
+  std::vector<const uint64_t*> key_ptrs;
+  for (size_t j = 0; j < decomp_modulus_size; ++j) {
+    AlignedVector64<uint64_t> key;
+    for (size_t k = 0; k < key_component_count; ++k) {
+      for (uint64_t modulus : moduli) {
+        auto residues = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+        key.insert(key.end(), residues.begin(), residues.end());
+      }
+    }
+    key_data.push_back(std::move(key));
+    key_ptrs.push_back(key_data.back().data());
+  }
+  KeySwitchKeys keys(key_ptrs.data(), n, decomp_modulus_size,
+                     key_modulus_size, key_component_count, moduli.data(),
+                     precompute_shoup);
+
+  KeySwitchWorkspace workspace(n, decomp_modulus_size, key_modulus_size,
+                               key_component_count);
+  AlignedVector64<uint64_t> result(key_component_count * decomp_modulus_size *
+                                   n);
+
+  for (auto _ : state) {
+    KeySwitch(result.data(), target.data(), n, decomp_modulus_size,
+              key_modulus_size, key_modulus_size, key_component_count,
+              moduli.data(), keys, modswitch_factors.data(), workspace);
+  }
+}
+
+BENCHMARK(BM_KeySwitchPrecomputedKeys)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{8192, 16384}, {7, 15}, {0, 1}});
+
+}  // namespace hexl
+}  // namespace intel
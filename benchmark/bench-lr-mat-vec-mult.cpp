@@ -0,0 +1,82 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "hexl/experimental/misc/lr-mat-vec-mult.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Fills num_weights ciphertexts of 2 polynomials with values below moduli
+AlignedVector64<uint64_t> RandomCiphertexts(
+    uint64_t n, const std::vector<uint64_t>& moduli, size_t num_weights) {
+  size_t num_moduli = moduli.size();
+  AlignedVector64<uint64_t> ciphertexts(num_weights * 2 * n * num_moduli);
+  for (size_t poly = 0; poly < 2 * num_weights; ++poly) {
+    for (size_t i = 0; i < num_moduli; ++i) {
+      auto values = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      std::copy(values.begin(), values.end(),
+                ciphertexts.begin() + (poly * num_moduli + i) * n);
+    }
+  }
+  return ciphertexts;
+}
+
+}  // namespace
+
+static void BM_LinRegMatrixVectorMultiply(benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t num_moduli = state.range(1);
+  size_t num_weights = state.range(2);
+  std::vector<uint64_t> moduli = GeneratePrimes(num_moduli, 50, true, n);
+
+  auto operand1 = RandomCiphertexts(n, moduli, num_weights);
+  auto operand2 = RandomCiphertexts(n, moduli, num_weights);
+  AlignedVector64<uint64_t> result(num_weights * 3 * n * num_moduli);
+
+  for (auto _ : state) {
+    LinRegMatrixVectorMultiply(result.data(), operand1.data(),
+                               operand2.data(), n, moduli.data(), num_moduli,
+                               num_weights);
+  }
+}
+
+BENCHMARK(BM_LinRegMatrixVectorMultiply)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {4}, {8, 64}});
+
+//=================================================================
+
+static void BM_LinRegMatrixVectorMultiplyStreaming(  //  NOLINT
+    benchmark::State& state) {
+  size_t n = state.range(0);
+  size_t num_moduli = state.range(1);
+  size_t num_weights = state.range(2);
+  std::vector<uint64_t> moduli = GeneratePrimes(num_moduli, 50, true, n);
+
+  auto operand1 = RandomCiphertexts(n, moduli, num_weights);
+  auto operand2 = RandomCiphertexts(n, moduli, num_weights);
+  AlignedVector64<uint64_t> result(3 * n * num_moduli);
+
+  for (auto _ : state) {
+    LinRegMatrixVectorMultiplyStreaming(result.data(), operand1.data(),
+                                        operand2.data(), n, moduli.data(),
+                                        num_moduli, num_weights);
+  }
+}
+
+BENCHMARK(BM_LinRegMatrixVectorMultiplyStreaming)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {4}, {8, 64}});
+
+}  // namespace hexl
+}  // namespace intel
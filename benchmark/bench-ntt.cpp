@@ -3,10 +3,16 @@
 
 #include <benchmark/benchmark.h>
 
+#include <cstdio>
+#include <string>
 #include <vector>
 
 #include "hexl/logging/logging.hpp"
+#include "hexl/ntt/ntt-cache.hpp"
+#include "hexl/ntt/ntt-tables.hpp"
 #include "hexl/ntt/ntt.hpp"
+#include "hexl/ntt/poly-multiply-mod.hpp"
+#include "hexl/ntt/rns-ntt.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "hexl/util/aligned-allocator.hpp"
 #include "ntt/fwd-ntt-avx512.hpp"
@@ -305,6 +311,32 @@ BENCHMARK(BM_InvNTTInPlace)
 
 //=================================================================
 
+// state[0] is the degree
+// state[1] is the number of threads
+static void BM_InvNTTThreads(benchmark::State& state) {  //  NOLINT
+  size_t ntt_size = state.range(0);
+  size_t num_threads = state.range(1);
+  size_t modulus = GeneratePrimes(1, 50, true, ntt_size)[0];
+
+  auto input = GenerateInsecureUniformIntRandomValues(ntt_size, 0, modulus);
+  NTT ntt(ntt_size, modulus);
+  auto policy = ExecutionPolicy::Parallel(ExecutionPolicy::s_default_grain_size,
+                                          num_threads);
+
+  for (auto _ : state) {
+    ntt.ComputeInverse(input.data(), input.data(), 1, 1, policy);
+  }
+}
+
+BENCHMARK(BM_InvNTTThreads)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({32768, 1})
+    ->Args({32768, 4})
+    ->Args({65536, 1})
+    ->Args({65536, 4});
+
+//=================================================================
+
 // state[0] is the degree
 static void BM_InvNTTCopy(benchmark::State& state) {  //  NOLINT
   size_t ntt_size = state.range(0);
@@ -327,6 +359,64 @@ BENCHMARK(BM_InvNTTCopy)
 
 //=================================================================
 
+// state[0] is the degree
+// state[1] is the number of moduli
+// state[2] is the number of threads
+static void BM_FwdRNSNTT(benchmark::State& state) {  //  NOLINT
+  size_t ntt_size = state.range(0);
+  size_t num_moduli = state.range(1);
+  size_t num_threads = state.range(2);
+  const uint64_t num_polys = 2;
+  auto moduli = GeneratePrimes(num_moduli, 50, true, ntt_size);
+
+  auto input = GenerateInsecureUniformIntRandomValues(
+      num_polys * num_moduli * ntt_size, 0, moduli[0]);
+  RNSNTT rns_ntt(ntt_size, moduli);
+  auto policy = num_threads == 1
+                    ? ExecutionPolicy::Serial()
+                    : ExecutionPolicy::Parallel(
+                          ExecutionPolicy::s_default_grain_size, num_threads);
+
+  for (auto _ : state) {
+    rns_ntt.ComputeForward(input.data(), input.data(), num_polys, 1, 1,
+                           policy);
+  }
+}
+
+BENCHMARK(BM_FwdRNSNTT)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({4096, 4, 1})
+    ->Args({16384, 8, 1})
+    ->Args({16384, 8, 4});
+
+//=================================================================
+
+// state[0] is the degree
+// state[1] is the number of threads
+static void BM_FwdNTTThreads(benchmark::State& state) {  //  NOLINT
+  size_t ntt_size = state.range(0);
+  size_t num_threads = state.range(1);
+  size_t modulus = GeneratePrimes(1, 50, true, ntt_size)[0];
+
+  auto input = GenerateInsecureUniformIntRandomValues(ntt_size, 0, modulus);
+  NTT ntt(ntt_size, modulus);
+  auto policy = ExecutionPolicy::Parallel(ExecutionPolicy::s_default_grain_size,
+                                          num_threads);
+
+  for (auto _ : state) {
+    ntt.ComputeForward(input.data(), input.data(), 1, 1, policy);
+  }
+}
+
+BENCHMARK(BM_FwdNTTThreads)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({32768, 1})
+    ->Args({32768, 4})
+    ->Args({65536, 1})
+    ->Args({65536, 4});
+
+//=================================================================
+
 // Inverse transforms
 
 static void BM_InvNTTNativeRadix2InPlace(benchmark::State& state) {  //  NOLINT
@@ -547,5 +637,85 @@ BENCHMARK(BM_InvNTT_AVX512DQ_64)
 
 //=================================================================
 
+// state[0] is the degree
+// state[1] is the number of bits in the modulus
+static void BM_PolyMultiplyMod(benchmark::State& state) {  //  NOLINT
+  size_t ntt_size = state.range(0);
+  size_t modulus = GeneratePrimes(1, state.range(1), true, ntt_size)[0];
+
+  auto op1 = GenerateInsecureUniformIntRandomValues(ntt_size, 0, modulus);
+  auto op2 = GenerateInsecureUniformIntRandomValues(ntt_size, 0, modulus);
+  AlignedVector64<uint64_t> output(ntt_size, 0);
+
+  for (auto _ : state) {
+    PolyMultiplyMod(output.data(), op1.data(), op2.data(), ntt_size, modulus);
+  }
+}
+
+BENCHMARK(BM_PolyMultiplyMod)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({1024, 45})
+    ->Args({4096, 45})
+    ->Args({16384, 45})
+    ->Args({16384, 61})
+    ->Args({65536, 45});
+
+//=================================================================
+
+static void BM_NTTCacheGet(benchmark::State& state) {  //  NOLINT
+  size_t ntt_size = 16384;
+  std::vector<uint64_t> moduli = GeneratePrimes(8, 50, true, ntt_size);
+  NTTCache::Instance().Prewarm(ntt_size, moduli);
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(GetNTT(ntt_size, moduli[i++ % moduli.size()]));
+  }
+}
+
+BENCHMARK(BM_NTTCacheGet)->Threads(1)->Threads(4);
+
+//=================================================================
+
+static void BM_NTTConstruct(benchmark::State& state) {  //  NOLINT
+  size_t ntt_size = state.range(0);
+  size_t modulus = GeneratePrimes(1, 50, true, ntt_size)[0];
+
+  for (auto _ : state) {
+    NTT ntt(ntt_size, modulus);
+    ntt.Precompute(NTT::Direction::Both);
+    benchmark::DoNotOptimize(ntt.GetTableMemoryBytes());
+  }
+}
+
+BENCHMARK(BM_NTTConstruct)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({4096})
+    ->Args({16384})
+    ->Args({65536});
+
+static void BM_NTTMapTables(benchmark::State& state) {  //  NOLINT
+  size_t ntt_size = state.range(0);
+  size_t modulus = GeneratePrimes(1, 50, true, ntt_size)[0];
+  NTT ntt(ntt_size, modulus);
+  std::string path = "bench-ntt-tables-" + std::to_string(ntt_size) + ".bin";
+  SaveNTTTables(path, {&ntt});
+
+  for (auto _ : state) {
+    NTT mapped_ntt = MappedNTTTables(path).GetNTT(0);
+    benchmark::DoNotOptimize(
+        mapped_ntt.GetTable(NTT::Table::RootOfUnityPowers));
+  }
+  std::remove(path.c_str());
+}
+
+BENCHMARK(BM_NTTMapTables)
+    ->Unit(benchmark::kMicrosecond)
+    ->Args({4096})
+    ->Args({16384})
+    ->Args({65536});
+
+//=================================================================
+
 }  // namespace hexl
 }  // namespace intel
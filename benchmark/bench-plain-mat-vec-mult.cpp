@@ -0,0 +1,105 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "hexl/experimental/misc/plain-mat-vec-mult.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Fills num_polys polynomials with values below moduli
+AlignedVector64<uint64_t> RandomPolys(uint64_t num_polys, uint64_t n,
+                                      const std::vector<uint64_t>& moduli) {
+  size_t num_moduli = moduli.size();
+  AlignedVector64<uint64_t> polys(num_polys * n * num_moduli);
+  for (size_t poly = 0; poly < num_polys; ++poly) {
+    for (size_t i = 0; i < num_moduli; ++i) {
+      auto values = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      std::copy(values.begin(), values.end(),
+                polys.begin() + (poly * num_moduli + i) * n);
+    }
+  }
+  return polys;
+}
+
+}  // namespace
+
+// state[0] is the degree
+// state[1] is the number of moduli
+// state[2] is the number of diagonals
+static void BM_PlainMatrixVectorMultiplyDiagonal(  //  NOLINT
+    benchmark::State& state) {
+  size_t n = state.range(0);
+  size_t num_moduli = state.range(1);
+  size_t num_diagonals = state.range(2);
+  size_t ciphertext_size = 2;
+  std::vector<uint64_t> moduli = GeneratePrimes(num_moduli, 50, true, n);
+
+  auto diagonals = RandomPolys(num_diagonals, n, moduli);
+  std::vector<AlignedVector64<uint64_t>> rotated;
+  std::vector<const uint64_t*> rotated_ptrs;
+  for (size_t d = 0; d < num_diagonals; ++d) {
+    rotated.push_back(RandomPolys(ciphertext_size, n, moduli));
+  }
+  for (const auto& cipher : rotated) {
+    rotated_ptrs.push_back(cipher.data());
+  }
+  AlignedVector64<uint64_t> result(ciphertext_size * n * num_moduli);
+
+  for (auto _ : state) {
+    PlainMatrixVectorMultiplyDiagonal(
+        result.data(), diagonals.data(), rotated_ptrs.data(), n, moduli.data(),
+        num_moduli, ciphertext_size, num_diagonals);
+  }
+}
+
+BENCHMARK(BM_PlainMatrixVectorMultiplyDiagonal)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {4}, {16, 64}});
+
+//=================================================================
+
+// state[0] is the degree
+// state[1] is the number of moduli
+// state[2] is the number of baby steps, and of giant steps
+static void BM_PlainMatrixVectorMultiplyBSGS(  //  NOLINT
+    benchmark::State& state) {
+  size_t n = state.range(0);
+  size_t num_moduli = state.range(1);
+  size_t steps = state.range(2);
+  size_t ciphertext_size = 2;
+  std::vector<uint64_t> moduli = GeneratePrimes(num_moduli, 50, true, n);
+
+  auto diagonals = RandomPolys(steps * steps, n, moduli);
+  std::vector<AlignedVector64<uint64_t>> rotated;
+  std::vector<const uint64_t*> rotated_ptrs;
+  for (size_t i = 0; i < steps; ++i) {
+    rotated.push_back(RandomPolys(ciphertext_size, n, moduli));
+  }
+  for (const auto& cipher : rotated) {
+    rotated_ptrs.push_back(cipher.data());
+  }
+  AlignedVector64<uint64_t> result(steps * ciphertext_size * n * num_moduli);
+
+  for (auto _ : state) {
+    PlainMatrixVectorMultiplyBSGS(result.data(), diagonals.data(),
+                                  rotated_ptrs.data(), n, moduli.data(),
+                                  num_moduli, ciphertext_size, steps, steps);
+  }
+}
+
+BENCHMARK(BM_PlainMatrixVectorMultiplyBSGS)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {4}, {4, 8}});
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,43 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "hexl/experimental/seal/rescale.hpp"
+#include "hexl/ntt/ntt-cache.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+static void BM_RescaleDivideRoundLastModulus(
+    benchmark::State& state) {  //  NOLINT
+  size_t n = state.range(0);
+  size_t num_moduli = state.range(1);
+  std::vector<uint64_t> moduli = GeneratePrimes(num_moduli, 50, true, n);
+
+  AlignedVector64<uint64_t> operand;
+  for (uint64_t modulus : moduli) {
+    auto residues = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+    operand.insert(operand.end(), residues.begin(), residues.end());
+    // Computes the NTT tables outside the timed loop
+    GetNTT(n, modulus)->Precompute();
+  }
+  AlignedVector64<uint64_t> result((num_moduli - 1) * n);
+
+  for (auto _ : state) {
+    RescaleDivideRoundLastModulus(result.data(), operand.data(), n,
+                                  moduli.data(), num_moduli);
+  }
+}
+
+BENCHMARK(BM_RescaleDivideRoundLastModulus)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({{4096, 16384}, {4, 16}});
+
+}  // namespace hexl
+}  // namespace intel
@@ -4,11 +4,13 @@
 #include "hexl/eltwise/eltwise-add-mod.hpp"
 
 #include "eltwise/eltwise-add-mod-avx512.hpp"
+#include "eltwise/eltwise-add-mod-avx2.hpp"
 #include "eltwise/eltwise-add-mod-internal.hpp"
 #include "hexl/logging/logging.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "hexl/util/check.hpp"
 #include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
 
 namespace intel {
 namespace hexl {
@@ -69,7 +71,8 @@ void EltwiseAddModNative(uint64_t* result, const uint64_t* operand1,
 }
 
 void EltwiseAddMod(uint64_t* result, const uint64_t* operand1,
-                   const uint64_t* operand2, uint64_t n, uint64_t modulus) {
+                   const uint64_t* operand2, uint64_t n, uint64_t modulus,
+                   const ExecutionPolicy& policy) {
   HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
   HEXL_CHECK(operand2 != nullptr, "Require operand2 != nullptr");
   HEXL_CHECK(n != 0, "Require n != 0");
@@ -80,6 +83,14 @@ void EltwiseAddMod(uint64_t* result, const uint64_t* operand1,
   HEXL_CHECK_BOUNDS(operand2, n, modulus,
                     "pre-add value in operand2 exceeds bound " << modulus);
 
+  if (!policy.IsSerial()) {
+    ParallelFor(n, policy, [&](uint64_t begin, uint64_t end) {
+      EltwiseAddMod(result + begin, operand1 + begin, operand2 + begin,
+                    end - begin, modulus);
+    });
+    return;
+  }
+
 #ifdef HEXL_HAS_AVX512DQ
   if (has_avx512dq) {
     EltwiseAddModAVX512(result, operand1, operand2, n, modulus);
@@ -87,12 +98,20 @@ void EltwiseAddMod(uint64_t* result, const uint64_t* operand1,
   }
 #endif
 
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2) {
+    EltwiseAddModAVX2(result, operand1, operand2, n, modulus);
+    return;
+  }
+#endif
+
   HEXL_VLOG(3, "Calling EltwiseAddModNative");
   EltwiseAddModNative(result, operand1, operand2, n, modulus);
 }
 
 void EltwiseAddMod(uint64_t* result, const uint64_t* operand1,
-                   const uint64_t operand2, uint64_t n, uint64_t modulus) {
+                   const uint64_t operand2, uint64_t n, uint64_t modulus,
+                   const ExecutionPolicy& policy) {
   HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
   HEXL_CHECK(n != 0, "Require n != 0");
   HEXL_CHECK(modulus > 1, "Require modulus > 1");
@@ -101,6 +120,14 @@ void EltwiseAddMod(uint64_t* result, const uint64_t* operand1,
                     "pre-add value in operand1 exceeds bound " << modulus);
   HEXL_CHECK(operand2 < modulus, "Require operand2 < modulus");
 
+  if (!policy.IsSerial()) {
+    ParallelFor(n, policy, [&](uint64_t begin, uint64_t end) {
+      EltwiseAddMod(result + begin, operand1 + begin, operand2, end - begin,
+                    modulus);
+    });
+    return;
+  }
+
 #ifdef HEXL_HAS_AVX512DQ
   if (has_avx512dq) {
     EltwiseAddModAVX512(result, operand1, operand2, n, modulus);
@@ -108,6 +135,13 @@ void EltwiseAddMod(uint64_t* result, const uint64_t* operand1,
   }
 #endif
 
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2) {
+    EltwiseAddModAVX2(result, operand1, operand2, n, modulus);
+    return;
+  }
+#endif
+
   HEXL_VLOG(3, "Calling EltwiseAddModNative");
   EltwiseAddModNative(result, operand1, operand2, n, modulus);
 }
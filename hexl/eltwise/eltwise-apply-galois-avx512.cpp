@@ -0,0 +1,82 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "eltwise/eltwise-apply-galois-avx512.hpp"
+
+#include <immintrin.h>
+#include <stdint.h>
+
+#include "eltwise/eltwise-apply-galois-internal.hpp"
+#include "hexl/eltwise/eltwise-apply-galois.hpp"
+#include "hexl/util/check.hpp"
+
+#ifdef HEXL_HAS_AVX512DQ
+
+namespace intel {
+namespace hexl {
+
+void EltwiseApplyGaloisAVX512(uint64_t* result, const uint64_t* operand,
+                              const uint32_t* source, uint64_t n,
+                              uint64_t modulus) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand != nullptr, "Require operand != nullptr");
+  HEXL_CHECK(source != nullptr, "Require source != nullptr");
+
+  uint64_t n_mod_8 = n % 8;
+  if (n_mod_8 != 0) {
+    EltwiseApplyGaloisNative(result, operand, source, n_mod_8, modulus);
+    result += n_mod_8;
+    source += n_mod_8;
+    n -= n_mod_8;
+  }
+
+  const __m256i v_index_mask = _mm256_set1_epi32(
+      static_cast<int32_t>(~GaloisPermutation::s_negate_flag));
+  const __m512i v_modulus = _mm512_set1_epi64(static_cast<int64_t>(modulus));
+  const __m256i* v_source = reinterpret_cast<const __m256i*>(source);
+  __m512i* v_result = reinterpret_cast<__m512i*>(result);
+
+  for (size_t i = n / 8; i > 0; --i) {
+    __m256i v_src = _mm256_loadu_si256(v_source);
+    // The negate flag is the sign bit of each index
+    __mmask8 negate = _mm256_movepi32_mask(v_src);
+    __m256i v_index = _mm256_and_si256(v_src, v_index_mask);
+    __m512i v_value = _mm512_i32gather_epi64(v_index, operand, 8);
+    // Zero stays zero when negated
+    negate = _mm512_mask_test_epi64_mask(negate, v_value, v_value);
+    v_value = _mm512_mask_sub_epi64(v_value, negate, v_modulus, v_value);
+    _mm512_storeu_si512(v_result, v_value);
+    ++v_source;
+    ++v_result;
+  }
+}
+
+void EltwiseApplyGaloisNTTAVX512(uint64_t* result, const uint64_t* operand,
+                                 const uint32_t* source, uint64_t n) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand != nullptr, "Require operand != nullptr");
+  HEXL_CHECK(source != nullptr, "Require source != nullptr");
+
+  uint64_t n_mod_8 = n % 8;
+  if (n_mod_8 != 0) {
+    EltwiseApplyGaloisNTTNative(result, operand, source, n_mod_8);
+    result += n_mod_8;
+    source += n_mod_8;
+    n -= n_mod_8;
+  }
+
+  const __m256i* v_source = reinterpret_cast<const __m256i*>(source);
+  __m512i* v_result = reinterpret_cast<__m512i*>(result);
+
+  for (size_t i = n / 8; i > 0; --i) {
+    __m256i v_index = _mm256_loadu_si256(v_source);
+    _mm512_storeu_si512(v_result, _mm512_i32gather_epi64(v_index, operand, 8));
+    ++v_source;
+    ++v_result;
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
+
+#endif
@@ -0,0 +1,19 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+void EltwiseApplyGaloisAVX512(uint64_t* result, const uint64_t* operand,
+                              const uint32_t* source, uint64_t n,
+                              uint64_t modulus);
+
+void EltwiseApplyGaloisNTTAVX512(uint64_t* result, const uint64_t* operand,
+                                 const uint32_t* source, uint64_t n);
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,33 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+/// @brief Sets result[j] = operand[source[j]] for j in [0, n), negated modulo
+/// modulus where source[j] has GaloisPermutation::s_negate_flag set
+/// @param[out] result Stores the result
+/// @param[in] operand Values in [0, modulus), indexed by source
+/// @param[in] source Source indices, as in
+/// GaloisPermutation::GetCoeffSourceIndices
+/// @param[in] n Number of elements in result and source
+/// @param[in] modulus Modulus with which to negate
+void EltwiseApplyGaloisNative(uint64_t* result, const uint64_t* operand,
+                              const uint32_t* source, uint64_t n,
+                              uint64_t modulus);
+
+/// @brief Sets result[j] = operand[source[j]] for j in [0, n)
+/// @param[out] result Stores the result
+/// @param[in] operand Values indexed by source
+/// @param[in] source Source indices, as in
+/// GaloisPermutation::GetNTTSourceIndices
+/// @param[in] n Number of elements in result and source
+void EltwiseApplyGaloisNTTNative(uint64_t* result, const uint64_t* operand,
+                                 const uint32_t* source, uint64_t n);
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,164 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/eltwise/eltwise-apply-galois.hpp"
+
+#include <utility>
+#include <vector>
+
+#include "eltwise/eltwise-apply-galois-avx512.hpp"
+#include "eltwise/eltwise-apply-galois-internal.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
+
+namespace intel {
+namespace hexl {
+
+GaloisPermutation::GaloisPermutation(uint64_t n, uint64_t galois_elt)
+    : m_degree(n),
+      m_galois_elt(galois_elt),
+      m_coeff_source(n),
+      m_ntt_source(n) {
+  HEXL_CHECK(IsPowerOfTwo(n), "n " << n << " is not a power of 2");
+  HEXL_CHECK(n < (1ULL << 31), "Require n < 2^31");
+  HEXL_CHECK(galois_elt % 2 == 1 && galois_elt < 2 * n,
+             "galois_elt " << galois_elt << " must be odd and less than "
+                           << 2 * n);
+
+  const uint64_t two_n_mask = 2 * n - 1;
+  for (uint64_t i = 0; i < n; ++i) {
+    uint64_t index = (i * galois_elt) & two_n_mask;
+    if (index < n) {
+      m_coeff_source[index] = static_cast<uint32_t>(i);
+    } else {
+      m_coeff_source[index - n] = static_cast<uint32_t>(i) | s_negate_flag;
+    }
+  }
+
+  // Index j of the NTT holds the evaluation at psi^(2 * rev(j) + 1), which
+  // the automorphism takes from the evaluation at psi^(g * (2 * rev(j) + 1))
+  const uint64_t log_n = Log2(n);
+  for (uint64_t j = 0; j < n; ++j) {
+    uint64_t exponent = 2 * ReverseBits(j, log_n) + 1;
+    uint64_t source = ((exponent * galois_elt) & two_n_mask) >> 1;
+    m_ntt_source[j] = static_cast<uint32_t>(ReverseBits(source, log_n));
+  }
+}
+
+std::shared_ptr<const GaloisPermutation> GetGaloisPermutation(
+    uint64_t n, uint64_t galois_elt) {
+  // Ordered from least to most recently used. Thread-local, so lookups take
+  // no lock, and small enough that a linear search is cheap next to applying
+  // the permutation.
+  thread_local std::vector<std::shared_ptr<const GaloisPermutation>>
+      permutations;
+
+  for (auto it = permutations.rbegin(); it != permutations.rend(); ++it) {
+    if ((*it)->GetDegree() == n && (*it)->GetGaloisElt() == galois_elt) {
+      auto permutation = *it;
+      if (it != permutations.rbegin()) {
+        permutations.erase(std::next(it).base());
+        permutations.push_back(permutation);
+      }
+      return permutation;
+    }
+  }
+
+  auto permutation = std::make_shared<const GaloisPermutation>(n, galois_elt);
+  if (permutations.size() == s_max_cached_galois_permutations) {
+    permutations.erase(permutations.begin());
+  }
+  permutations.push_back(permutation);
+  return permutation;
+}
+
+void EltwiseApplyGaloisNative(uint64_t* result, const uint64_t* operand,
+                              const uint32_t* source, uint64_t n,
+                              uint64_t modulus) {
+  constexpr uint32_t index_mask = ~GaloisPermutation::s_negate_flag;
+  for (size_t j = 0; j < n; ++j) {
+    uint64_t value = operand[source[j] & index_mask];
+    if ((source[j] & GaloisPermutation::s_negate_flag) && value != 0) {
+      value = modulus - value;
+    }
+    result[j] = value;
+  }
+}
+
+void EltwiseApplyGaloisNTTNative(uint64_t* result, const uint64_t* operand,
+                                 const uint32_t* source, uint64_t n) {
+  for (size_t j = 0; j < n; ++j) {
+    result[j] = operand[source[j]];
+  }
+}
+
+void EltwiseApplyGalois(uint64_t* result, const uint64_t* operand, uint64_t n,
+                        uint64_t galois_elt, uint64_t modulus,
+                        const ExecutionPolicy& policy) {
+  auto permutation = GetGaloisPermutation(n, galois_elt);
+  EltwiseApplyGalois(result, operand, *permutation, modulus, policy);
+}
+
+void EltwiseApplyGalois(uint64_t* result, const uint64_t* operand,
+                        const GaloisPermutation& permutation, uint64_t modulus,
+                        const ExecutionPolicy& policy) {
+  const uint64_t n = permutation.GetDegree();
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand != nullptr, "Require operand != nullptr");
+  HEXL_CHECK(result != operand, "Require result != operand");
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK_BOUNDS(operand, n, modulus,
+                    "value in operand exceeds bound " << modulus);
+
+  const uint32_t* source = permutation.GetCoeffSourceIndices().data();
+
+  ParallelFor(n, policy, [&](uint64_t begin, uint64_t end) {
+#ifdef HEXL_HAS_AVX512DQ
+    if (has_avx512dq) {
+      EltwiseApplyGaloisAVX512(result + begin, operand, source + begin,
+                               end - begin, modulus);
+      return;
+    }
+#endif
+    HEXL_VLOG(3, "Calling EltwiseApplyGaloisNative");
+    EltwiseApplyGaloisNative(result + begin, operand, source + begin,
+                             end - begin, modulus);
+  });
+}
+
+void EltwiseApplyGaloisNTT(uint64_t* result, const uint64_t* operand,
+                           uint64_t n, uint64_t galois_elt,
+                           const ExecutionPolicy& policy) {
+  auto permutation = GetGaloisPermutation(n, galois_elt);
+  EltwiseApplyGaloisNTT(result, operand, *permutation, policy);
+}
+
+void EltwiseApplyGaloisNTT(uint64_t* result, const uint64_t* operand,
+                           const GaloisPermutation& permutation,
+                           const ExecutionPolicy& policy) {
+  const uint64_t n = permutation.GetDegree();
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand != nullptr, "Require operand != nullptr");
+  HEXL_CHECK(result != operand, "Require result != operand");
+
+  const uint32_t* source = permutation.GetNTTSourceIndices().data();
+
+  ParallelFor(n, policy, [&](uint64_t begin, uint64_t end) {
+#ifdef HEXL_HAS_AVX512DQ
+    if (has_avx512dq) {
+      EltwiseApplyGaloisNTTAVX512(result + begin, operand, source + begin,
+                                  end - begin);
+      return;
+    }
+#endif
+    HEXL_VLOG(3, "Calling EltwiseApplyGaloisNTTNative");
+    EltwiseApplyGaloisNTTNative(result + begin, operand, source + begin,
+                                end - begin);
+  });
+}
+
+}  // namespace hexl
+}  // namespace intel
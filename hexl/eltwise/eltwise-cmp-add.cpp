@@ -4,28 +4,46 @@
 #include "hexl/eltwise/eltwise-cmp-add.hpp"
 
 #include "eltwise/eltwise-cmp-add-avx512.hpp"
+#include "eltwise/eltwise-cmp-add-avx2.hpp"
 #include "eltwise/eltwise-cmp-add-internal.hpp"
 #include "hexl/logging/logging.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "hexl/util/check.hpp"
 #include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
 
 namespace intel {
 namespace hexl {
 
 void EltwiseCmpAdd(uint64_t* result, const uint64_t* operand1, uint64_t n,
-                   CMPINT cmp, uint64_t bound, uint64_t diff) {
+                   CMPINT cmp, uint64_t bound, uint64_t diff,
+                   const ExecutionPolicy& policy) {
   HEXL_CHECK(result != nullptr, "Require result != nullptr");
   HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
   HEXL_CHECK(n != 0, "Require n != 0");
   HEXL_CHECK(diff != 0, "Require diff != 0");
 
+  if (!policy.IsSerial()) {
+    ParallelFor(n, policy, [&](uint64_t begin, uint64_t end) {
+      EltwiseCmpAdd(result + begin, operand1 + begin, end - begin, cmp, bound,
+                    diff);
+    });
+    return;
+  }
+
 #ifdef HEXL_HAS_AVX512DQ
   if (has_avx512dq) {
     EltwiseCmpAddAVX512(result, operand1, n, cmp, bound, diff);
     return;
   }
 #endif
+
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2) {
+    EltwiseCmpAddAVX2(result, operand1, n, cmp, bound, diff);
+    return;
+  }
+#endif
   EltwiseCmpAddNative(result, operand1, n, cmp, bound, diff);
 }
 
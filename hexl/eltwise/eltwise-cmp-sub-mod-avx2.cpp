@@ -0,0 +1,67 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "eltwise/eltwise-cmp-sub-mod-avx2.hpp"
+
+#include <immintrin.h>
+#include <stdint.h>
+
+#include "eltwise/eltwise-cmp-sub-mod-internal.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "util/avx2-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+void EltwiseCmpSubModAVX2(uint64_t* result, const uint64_t* operand1,
+                          uint64_t n, uint64_t modulus, CMPINT cmp,
+                          uint64_t bound, uint64_t diff) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0")
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK(diff != 0, "Require diff != 0");
+  HEXL_CHECK(diff < modulus, "Diff " << diff << " >= modulus " << modulus);
+
+  uint64_t n_mod_4 = n % 4;
+  if (n_mod_4 != 0) {
+    EltwiseCmpSubModNative(result, operand1, n_mod_4, modulus, cmp, bound,
+                           diff);
+    operand1 += n_mod_4;
+    result += n_mod_4;
+    n -= n_mod_4;
+  }
+
+  const __m256i* v_op_ptr = reinterpret_cast<const __m256i*>(operand1);
+  __m256i* v_result_ptr = reinterpret_cast<__m256i*>(result);
+  __m256i v_bound = _mm256_set1_epi64x(static_cast<int64_t>(bound));
+  __m256i v_diff = _mm256_set1_epi64x(static_cast<int64_t>(diff));
+  __m256i v_modulus = _mm256_set1_epi64x(static_cast<int64_t>(modulus));
+
+  uint64_t mu = MultiplyFactor(1, 64, modulus).BarrettFactor();
+  __m256i v_mu = _mm256_set1_epi64x(static_cast<int64_t>(mu));
+
+  for (size_t i = n / 4; i > 0; --i) {
+    __m256i v_op = _mm256_loadu_si256(v_op_ptr);
+    __m256i op_cmp = _mm256_hexl_cmp_epu64_mask(v_op, v_bound, cmp);
+
+    v_op = _mm256_hexl_barrett_reduce64<1>(v_op, v_modulus, v_mu);
+
+    // to_add = (op < diff ? modulus : 0) - diff, applied where cmp holds
+    __m256i v_to_add =
+        _mm256_hexl_cmp_epi64(v_op, v_diff, CMPINT::LT, modulus);
+    v_to_add = _mm256_sub_epi64(v_to_add, v_diff);
+    v_to_add = _mm256_and_si256(v_to_add, op_cmp);
+
+    v_op = _mm256_add_epi64(v_op, v_to_add);
+    _mm256_storeu_si256(v_result_ptr, v_op);
+    ++v_op_ptr;
+    ++v_result_ptr;
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
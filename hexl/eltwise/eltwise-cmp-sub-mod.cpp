@@ -4,12 +4,14 @@
 #include "hexl/eltwise/eltwise-cmp-sub-mod.hpp"
 
 #include "eltwise/eltwise-cmp-sub-mod-avx512.hpp"
+#include "eltwise/eltwise-cmp-sub-mod-avx2.hpp"
 #include "eltwise/eltwise-cmp-sub-mod-internal.hpp"
 #include "hexl/logging/logging.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "hexl/util/check.hpp"
 #include "hexl/util/util.hpp"
 #include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
 #include "util/util-internal.hpp"
 
 namespace intel {
@@ -17,13 +19,21 @@ namespace hexl {
 
 void EltwiseCmpSubMod(uint64_t* result, const uint64_t* operand1, uint64_t n,
                       uint64_t modulus, CMPINT cmp, uint64_t bound,
-                      uint64_t diff) {
+                      uint64_t diff, const ExecutionPolicy& policy) {
   HEXL_CHECK(result != nullptr, "Require result != nullptr");
   HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
   HEXL_CHECK(n != 0, "Require n != 0");
   HEXL_CHECK(modulus > 1, "Require modulus > 1");
   HEXL_CHECK(diff != 0, "Require diff != 0");
 
+  if (!policy.IsSerial()) {
+    ParallelFor(n, policy, [&](uint64_t begin, uint64_t end) {
+      EltwiseCmpSubMod(result + begin, operand1 + begin, end - begin, modulus,
+                       cmp, bound, diff);
+    });
+    return;
+  }
+
 #ifdef HEXL_HAS_AVX512IFMA
   if (has_avx512ifma) {
     if (modulus < (1ULL << 52)) {
@@ -40,6 +50,13 @@ void EltwiseCmpSubMod(uint64_t* result, const uint64_t* operand1, uint64_t n,
     return;
   }
 #endif
+
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2) {
+    EltwiseCmpSubModAVX2(result, operand1, n, modulus, cmp, bound, diff);
+    return;
+  }
+#endif
   EltwiseCmpSubModNative(result, operand1, n, modulus, cmp, bound, diff);
   return;
 }
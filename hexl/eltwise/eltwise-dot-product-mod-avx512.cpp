@@ -0,0 +1,114 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "eltwise/eltwise-dot-product-mod-avx512.hpp"
+
+#include <immintrin.h>
+#include <stdint.h>
+
+#include "eltwise/eltwise-dot-product-mod-internal.hpp"
+#include "eltwise/eltwise-lazy-accumulate-avx512.hpp"
+#include "eltwise/eltwise-lazy-accumulate-internal.hpp"
+#include "hexl/util/check.hpp"
+#include "hexl/util/defines.hpp"
+#include "util/avx512-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+
+void EltwiseDotProductModAVX512DQ(uint64_t* result,
+                                  const uint64_t* const* operand1,
+                                  const uint64_t* const* operand2,
+                                  uint64_t count, uint64_t begin, uint64_t end,
+                                  uint64_t modulus) {
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK(modulus < (1ULL << 62), "Require modulus < (1ULL << 62)");
+
+  const uint64_t n_tail = (end - begin) % 8;
+  if (n_tail != 0) {
+    EltwiseDotProductModNative(result, operand1, operand2, count, begin,
+                               begin + n_tail, modulus);
+  }
+
+  const uint64_t max_products = LazyAccumulateMaxProducts(modulus);
+  const LazyReducerAVX512 reducer(modulus);
+  const __m512i v_zero = _mm512_setzero_si512();
+  const __m512i v_one = _mm512_set1_epi64(1);
+
+  for (size_t j = begin + n_tail; j < end; j += 8) {
+    __m512i v_acc_hi = v_zero;
+    __m512i v_acc_lo = v_zero;
+    uint64_t num_products = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (num_products == max_products) {
+        v_acc_lo = reducer.Reduce(v_acc_hi, v_acc_lo);
+        v_acc_hi = v_zero;
+        num_products = 0;
+      }
+      __m512i v_op1 = _mm512_loadu_si512(&operand1[i][j]);
+      __m512i v_op2 = _mm512_loadu_si512(&operand2[i][j]);
+      __m512i v_prod_hi = _mm512_hexl_mulhi_epi<64>(v_op1, v_op2);
+      __m512i v_prod_lo = _mm512_hexl_mullo_epi<64>(v_op1, v_op2);
+
+      v_acc_lo = _mm512_add_epi64(v_acc_lo, v_prod_lo);
+      __mmask8 carry = _mm512_cmplt_epu64_mask(v_acc_lo, v_prod_lo);
+      v_acc_hi = _mm512_add_epi64(v_acc_hi, v_prod_hi);
+      v_acc_hi = _mm512_mask_add_epi64(v_acc_hi, carry, v_acc_hi, v_one);
+      ++num_products;
+    }
+    _mm512_storeu_si512(&result[j], reducer.Reduce(v_acc_hi, v_acc_lo));
+  }
+}
+
+#endif
+
+#ifdef HEXL_HAS_AVX512IFMA
+
+void EltwiseDotProductModAVX512IFMA(uint64_t* result,
+                                    const uint64_t* const* operand1,
+                                    const uint64_t* const* operand2,
+                                    uint64_t count, uint64_t begin,
+                                    uint64_t end, uint64_t modulus) {
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK(modulus < (1ULL << 52), "Require modulus < (1ULL << 52)");
+
+  const uint64_t n_tail = (end - begin) % 8;
+  if (n_tail != 0) {
+    EltwiseDotProductModNative(result, operand1, operand2, count, begin,
+                               begin + n_tail, modulus);
+  }
+
+  const uint64_t max_products = LazyAccumulateKernels::s_max_products_ifma;
+  const LazyReducerAVX512 reducer(modulus);
+  const __m512i v_zero = _mm512_setzero_si512();
+
+  for (size_t j = begin + n_tail; j < end; j += 8) {
+    __m512i v_acc_hi = v_zero;
+    __m512i v_acc_lo = v_zero;
+    __m512i v_hi;
+    __m512i v_lo;
+    uint64_t num_products = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (num_products == max_products) {
+        LazyCombineAVX512IFMA(v_acc_hi, v_acc_lo, &v_hi, &v_lo);
+        v_acc_lo = reducer.Reduce(v_hi, v_lo);
+        v_acc_hi = v_zero;
+        num_products = 0;
+      }
+      __m512i v_op1 = _mm512_loadu_si512(&operand1[i][j]);
+      __m512i v_op2 = _mm512_loadu_si512(&operand2[i][j]);
+      v_acc_lo = _mm512_madd52lo_epu64(v_acc_lo, v_op1, v_op2);
+      v_acc_hi = _mm512_madd52hi_epu64(v_acc_hi, v_op1, v_op2);
+      ++num_products;
+    }
+    LazyCombineAVX512IFMA(v_acc_hi, v_acc_lo, &v_hi, &v_lo);
+    _mm512_storeu_si512(&result[j], reducer.Reduce(v_hi, v_lo));
+  }
+}
+
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,36 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include "hexl/util/defines.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+/// @brief AVX512-DQ implementation of EltwiseDotProductModNative,
+/// accumulating the 128-bit products in a high and a low register. Requires
+/// modulus < 2^62
+void EltwiseDotProductModAVX512DQ(uint64_t* result,
+                                  const uint64_t* const* operand1,
+                                  const uint64_t* const* operand2,
+                                  uint64_t count, uint64_t begin, uint64_t end,
+                                  uint64_t modulus);
+#endif
+
+#ifdef HEXL_HAS_AVX512IFMA
+/// @brief AVX512-IFMA implementation of EltwiseDotProductModNative,
+/// accumulating the low and high 52 bits of the 104-bit products in two
+/// registers. Requires modulus < 2^52
+void EltwiseDotProductModAVX512IFMA(uint64_t* result,
+                                    const uint64_t* const* operand1,
+                                    const uint64_t* const* operand2,
+                                    uint64_t count, uint64_t begin,
+                                    uint64_t end, uint64_t modulus);
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,22 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+/// @brief Native implementation of EltwiseDotProductMod, without checks
+/// @details Sets result[j] = sum_i operand1[i][j] * operand2[i][j] mod
+/// modulus for j in [begin, end), so that threads may share the operand
+/// arrays. Requires modulus < 2^62
+void EltwiseDotProductModNative(uint64_t* result,
+                                const uint64_t* const* operand1,
+                                const uint64_t* const* operand2,
+                                uint64_t count, uint64_t begin, uint64_t end,
+                                uint64_t modulus);
+
+}  // namespace hexl
+}  // namespace intel
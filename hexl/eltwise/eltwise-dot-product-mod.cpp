@@ -0,0 +1,91 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/eltwise/eltwise-dot-product-mod.hpp"
+
+#include "eltwise/eltwise-dot-product-mod-avx512.hpp"
+#include "eltwise/eltwise-dot-product-mod-internal.hpp"
+#include "eltwise/eltwise-lazy-accumulate-internal.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
+
+namespace intel {
+namespace hexl {
+
+void EltwiseDotProductModNative(uint64_t* result,
+                                const uint64_t* const* operand1,
+                                const uint64_t* const* operand2,
+                                uint64_t count, uint64_t begin, uint64_t end,
+                                uint64_t modulus) {
+  const uint64_t max_products = LazyAccumulateMaxProducts(modulus);
+
+  for (size_t j = begin; j < end; ++j) {
+    uint64_t acc_hi = 0;
+    uint64_t acc_lo = 0;
+    uint64_t num_products = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (num_products == max_products) {
+        acc_lo = BarrettReduce128(acc_hi, acc_lo, modulus);
+        acc_hi = 0;
+        num_products = 0;
+      }
+      uint64_t prod_hi;
+      uint64_t prod_lo;
+      MultiplyUInt64(operand1[i][j], operand2[i][j], &prod_hi, &prod_lo);
+      acc_hi += prod_hi + AddUInt64(acc_lo, prod_lo, &acc_lo);
+      ++num_products;
+    }
+    result[j] = BarrettReduce128(acc_hi, acc_lo, modulus);
+  }
+}
+
+void EltwiseDotProductMod(uint64_t* result, const uint64_t* const* operand1,
+                          const uint64_t* const* operand2, uint64_t count,
+                          uint64_t n, uint64_t modulus,
+                          const ExecutionPolicy& policy) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
+  HEXL_CHECK(operand2 != nullptr, "Require operand2 != nullptr");
+  HEXL_CHECK(count != 0, "Require count != 0");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK(modulus < (1ULL << 62), "Require modulus < (1ULL << 62)");
+  for (size_t i = 0; i < count; ++i) {
+    HEXL_CHECK(operand1[i] != nullptr,
+               "Require operand1[" << i << "] != nullptr");
+    HEXL_CHECK(operand2[i] != nullptr,
+               "Require operand2[" << i << "] != nullptr");
+    HEXL_CHECK_BOUNDS(operand1[i], n, modulus,
+                      "operand1[" << i << "] exceeds bound " << modulus);
+    HEXL_CHECK_BOUNDS(operand2[i], n, modulus,
+                      "operand2[" << i << "] exceeds bound " << modulus);
+  }
+
+  // Each thread computes a slice of the columns from the shared operand
+  // arrays, with the kernel selected once
+  auto kernel = EltwiseDotProductModNative;
+#ifdef HEXL_HAS_AVX512IFMA
+  if (has_avx512ifma && modulus < (1ULL << 52)) {
+    HEXL_VLOG(3, "Calling EltwiseDotProductModAVX512IFMA");
+    kernel = EltwiseDotProductModAVX512IFMA;
+  }
+#endif
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq && kernel == EltwiseDotProductModNative) {
+    HEXL_VLOG(3, "Calling EltwiseDotProductModAVX512DQ");
+    kernel = EltwiseDotProductModAVX512DQ;
+  }
+#endif
+  if (kernel == EltwiseDotProductModNative) {
+    HEXL_VLOG(3, "Calling EltwiseDotProductModNative");
+  }
+  ParallelFor(n, policy, [&](uint64_t begin, uint64_t end) {
+    kernel(result, operand1, operand2, count, begin, end, modulus);
+  });
+}
+
+}  // namespace hexl
+}  // namespace intel
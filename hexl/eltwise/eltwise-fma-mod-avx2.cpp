@@ -0,0 +1,137 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "eltwise/eltwise-fma-mod-avx2.hpp"
+
+#include <immintrin.h>
+
+#include "hexl/eltwise/eltwise-fma-mod.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "util/avx2-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+
+template void EltwiseFMAModAVX2<32, 1>(uint64_t* result, const uint64_t* arg1,
+                                       uint64_t arg2, const uint64_t* arg3,
+                                       uint64_t n, uint64_t modulus);
+template void EltwiseFMAModAVX2<32, 2>(uint64_t* result, const uint64_t* arg1,
+                                       uint64_t arg2, const uint64_t* arg3,
+                                       uint64_t n, uint64_t modulus);
+template void EltwiseFMAModAVX2<32, 4>(uint64_t* result, const uint64_t* arg1,
+                                       uint64_t arg2, const uint64_t* arg3,
+                                       uint64_t n, uint64_t modulus);
+template void EltwiseFMAModAVX2<32, 8>(uint64_t* result, const uint64_t* arg1,
+                                       uint64_t arg2, const uint64_t* arg3,
+                                       uint64_t n, uint64_t modulus);
+template void EltwiseFMAModAVX2<64, 1>(uint64_t* result, const uint64_t* arg1,
+                                       uint64_t arg2, const uint64_t* arg3,
+                                       uint64_t n, uint64_t modulus);
+template void EltwiseFMAModAVX2<64, 2>(uint64_t* result, const uint64_t* arg1,
+                                       uint64_t arg2, const uint64_t* arg3,
+                                       uint64_t n, uint64_t modulus);
+template void EltwiseFMAModAVX2<64, 4>(uint64_t* result, const uint64_t* arg1,
+                                       uint64_t arg2, const uint64_t* arg3,
+                                       uint64_t n, uint64_t modulus);
+template void EltwiseFMAModAVX2<64, 8>(uint64_t* result, const uint64_t* arg1,
+                                       uint64_t arg2, const uint64_t* arg3,
+                                       uint64_t n, uint64_t modulus);
+
+template <int BitShift, int InputModFactor>
+void EltwiseFMAModAVX2(uint64_t* result, const uint64_t* arg1, uint64_t arg2,
+                       const uint64_t* arg3, uint64_t n, uint64_t modulus) {
+  HEXL_CHECK(BitShift == 32 || BitShift == 64,
+             "Invalid bitshift " << BitShift << "; need 32 or 64");
+  HEXL_CHECK(modulus < (BitShift == 32 ? (1ULL << 30) : (1ULL << 61)),
+             "Modulus " << modulus << " too large for bit shift " << BitShift);
+  HEXL_CHECK(modulus != 0, "Require modulus != 0");
+
+  HEXL_CHECK(arg1, "arg1 == nullptr");
+  HEXL_CHECK(result, "result == nullptr");
+
+  HEXL_CHECK_BOUNDS(arg1, n, InputModFactor * modulus,
+                    "arg1 exceeds bound " << (InputModFactor * modulus));
+  HEXL_CHECK_BOUNDS(&arg2, 1, InputModFactor * modulus,
+                    "arg2 exceeds bound " << (InputModFactor * modulus));
+
+  uint64_t n_mod_4 = n % 4;
+  if (n_mod_4 != 0) {
+    EltwiseFMAModNative<InputModFactor>(result, arg1, arg2, arg3, n_mod_4,
+                                        modulus);
+    arg1 += n_mod_4;
+    if (arg3 != nullptr) {
+      arg3 += n_mod_4;
+    }
+    result += n_mod_4;
+    n -= n_mod_4;
+  }
+
+  uint64_t twice_modulus = 2 * modulus;
+  uint64_t four_times_modulus = 4 * modulus;
+  arg2 = ReduceMod<InputModFactor>(arg2, modulus, &twice_modulus,
+                                   &four_times_modulus);
+  uint64_t arg2_barr = MultiplyFactor(arg2, BitShift, modulus).BarrettFactor();
+
+  __m256i varg2 = _mm256_set1_epi64x(static_cast<int64_t>(arg2));
+  __m256i varg2_barr = _mm256_set1_epi64x(static_cast<int64_t>(arg2_barr));
+  __m256i vmodulus = _mm256_set1_epi64x(static_cast<int64_t>(modulus));
+  __m256i v2_modulus = _mm256_set1_epi64x(static_cast<int64_t>(twice_modulus));
+  __m256i v4_modulus =
+      _mm256_set1_epi64x(static_cast<int64_t>(four_times_modulus));
+  const __m256i* vp_arg1 = reinterpret_cast<const __m256i*>(arg1);
+  __m256i* vp_result = reinterpret_cast<__m256i*>(result);
+
+  if (arg3) {
+    const __m256i* vp_arg3 = reinterpret_cast<const __m256i*>(arg3);
+    HEXL_LOOP_UNROLL_8
+    for (size_t i = n / 4; i > 0; --i) {
+      __m256i varg1 = _mm256_loadu_si256(vp_arg1);
+      __m256i varg3 = _mm256_loadu_si256(vp_arg3);
+
+      varg1 = _mm256_hexl_small_mod_epu64<InputModFactor>(
+          varg1, vmodulus, &v2_modulus, &v4_modulus);
+      varg3 = _mm256_hexl_small_mod_epu64<InputModFactor>(
+          varg3, vmodulus, &v2_modulus, &v4_modulus);
+
+      // Compute vq = a * b mod p in [0, 2 * p) where p is the modulus
+      __m256i vq = _mm256_hexl_mul_mod_lazy_epi64<BitShift>(
+          varg1, varg2, varg2_barr, vmodulus, v2_modulus);
+
+      // Add arg3, bringing vq to [0, 3 * p)
+      vq = _mm256_add_epi64(vq, varg3);
+      // Reduce to [0, p)
+      vq = _mm256_hexl_small_mod_epu64<4>(vq, vmodulus, &v2_modulus);
+
+      _mm256_storeu_si256(vp_result, vq);
+
+      ++vp_arg1;
+      ++vp_result;
+      ++vp_arg3;
+    }
+  } else {  // arg3 == nullptr
+    HEXL_LOOP_UNROLL_8
+    for (size_t i = n / 4; i > 0; --i) {
+      __m256i varg1 = _mm256_loadu_si256(vp_arg1);
+      varg1 = _mm256_hexl_small_mod_epu64<InputModFactor>(
+          varg1, vmodulus, &v2_modulus, &v4_modulus);
+
+      // Compute vq = a * b mod p in [0, 2 * p) where p is the modulus
+      __m256i vq = _mm256_hexl_mul_mod_lazy_epi64<BitShift>(
+          varg1, varg2, varg2_barr, vmodulus, v2_modulus);
+      // Conditional Barrett subtraction
+      vq = _mm256_hexl_small_mod_epu64(vq, vmodulus);
+      _mm256_storeu_si256(vp_result, vq);
+
+      ++vp_arg1;
+      ++vp_result;
+    }
+  }
+}
+
+#endif
+
+}  // namespace hexl
+}  // namespace intel
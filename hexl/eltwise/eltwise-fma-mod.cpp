@@ -6,17 +6,19 @@
 #include <algorithm>
 
 #include "eltwise/eltwise-fma-mod-avx512.hpp"
+#include "eltwise/eltwise-fma-mod-avx2.hpp"
 #include "eltwise/eltwise-fma-mod-internal.hpp"
 #include "hexl/logging/logging.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
 
 namespace intel {
 namespace hexl {
 
 void EltwiseFMAMod(uint64_t* result, const uint64_t* arg1, uint64_t arg2,
                    const uint64_t* arg3, uint64_t n, uint64_t modulus,
-                   uint64_t input_mod_factor) {
+                   uint64_t input_mod_factor, const ExecutionPolicy& policy) {
   HEXL_CHECK(result != nullptr, "Require result != nullptr");
   HEXL_CHECK(arg1 != nullptr, "Require arg1 != nullptr");
   HEXL_CHECK(n != 0, "Require n != 0")
@@ -39,6 +41,15 @@ void EltwiseFMAMod(uint64_t* result, const uint64_t* arg1, uint64_t arg2,
              "arg3 value in EltwiseFMAMod exceeds bound "
                  << (input_mod_factor * modulus));
 
+  if (!policy.IsSerial()) {
+    ParallelFor(n, policy, [&](uint64_t begin, uint64_t end) {
+      EltwiseFMAMod(result + begin, arg1 + begin, arg2,
+                    arg3 == nullptr ? nullptr : arg3 + begin, end - begin,
+                    modulus, input_mod_factor);
+    });
+    return;
+  }
+
 #ifdef HEXL_HAS_AVX512IFMA
   if (has_avx512ifma && input_mod_factor * modulus < (1ULL << 51)) {
     HEXL_VLOG(3, "Calling 52-bit EltwiseFMAModAVX512");
@@ -83,6 +94,45 @@ void EltwiseFMAMod(uint64_t* result, const uint64_t* arg1, uint64_t arg2,
   }
 #endif
 
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2) {
+    if (modulus < (1ULL << 30)) {
+      HEXL_VLOG(3, "Calling 32-bit EltwiseFMAModAVX2");
+      switch (input_mod_factor) {
+        case 1:
+          EltwiseFMAModAVX2<32, 1>(result, arg1, arg2, arg3, n, modulus);
+          break;
+        case 2:
+          EltwiseFMAModAVX2<32, 2>(result, arg1, arg2, arg3, n, modulus);
+          break;
+        case 4:
+          EltwiseFMAModAVX2<32, 4>(result, arg1, arg2, arg3, n, modulus);
+          break;
+        case 8:
+          EltwiseFMAModAVX2<32, 8>(result, arg1, arg2, arg3, n, modulus);
+          break;
+      }
+      return;
+    }
+    HEXL_VLOG(3, "Calling 64-bit EltwiseFMAModAVX2");
+    switch (input_mod_factor) {
+      case 1:
+        EltwiseFMAModAVX2<64, 1>(result, arg1, arg2, arg3, n, modulus);
+        break;
+      case 2:
+        EltwiseFMAModAVX2<64, 2>(result, arg1, arg2, arg3, n, modulus);
+        break;
+      case 4:
+        EltwiseFMAModAVX2<64, 4>(result, arg1, arg2, arg3, n, modulus);
+        break;
+      case 8:
+        EltwiseFMAModAVX2<64, 8>(result, arg1, arg2, arg3, n, modulus);
+        break;
+    }
+    return;
+  }
+#endif
+
   HEXL_VLOG(3, "Calling EltwiseFMAModNative");
   switch (input_mod_factor) {
     case 1:
@@ -0,0 +1,130 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "eltwise/eltwise-lazy-accumulate-avx512.hpp"
+
+#include <immintrin.h>
+
+#include "eltwise/eltwise-lazy-accumulate-internal.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/defines.hpp"
+#include "util/avx512-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+
+void EltwiseLazyMultAccumulateAVX512DQ(uint64_t* acc_hi, uint64_t* acc_lo,
+                                       const uint64_t* operand1,
+                                       const uint64_t* operand2, uint64_t n) {
+  const uint64_t n_tail = n % 8;
+  if (n_tail != 0) {
+    EltwiseLazyMultAccumulateNative(acc_hi, acc_lo, operand1, operand2,
+                                    n_tail);
+    acc_hi += n_tail;
+    acc_lo += n_tail;
+    operand1 += n_tail;
+    operand2 += n_tail;
+    n -= n_tail;
+  }
+
+  const __m512i v_one = _mm512_set1_epi64(1);
+  for (uint64_t l = 0; l < n; l += 8) {
+    __m512i v_x = _mm512_loadu_si512(&operand1[l]);
+    __m512i v_y = _mm512_loadu_si512(&operand2[l]);
+    __m512i v_prod_lo = _mm512_mullo_epi64(v_x, v_y);
+    __m512i v_prod_hi = _mm512_hexl_mulhi_epi<64>(v_x, v_y);
+
+    __m512i v_lo = _mm512_add_epi64(_mm512_loadu_si512(&acc_lo[l]), v_prod_lo);
+    __mmask8 carry = _mm512_cmplt_epu64_mask(v_lo, v_prod_lo);
+    __m512i v_hi = _mm512_add_epi64(_mm512_loadu_si512(&acc_hi[l]), v_prod_hi);
+    v_hi = _mm512_mask_add_epi64(v_hi, carry, v_hi, v_one);
+
+    _mm512_storeu_si512(&acc_lo[l], v_lo);
+    _mm512_storeu_si512(&acc_hi[l], v_hi);
+  }
+}
+
+void EltwiseLazyReduceAVX512DQ(uint64_t* result, const uint64_t* acc_hi,
+                               const uint64_t* acc_lo, uint64_t n,
+                               uint64_t modulus) {
+  const uint64_t n_tail = n % 8;
+  if (n_tail != 0) {
+    EltwiseLazyReduceNative(result, acc_hi, acc_lo, n_tail, modulus);
+    result += n_tail;
+    acc_hi += n_tail;
+    acc_lo += n_tail;
+    n -= n_tail;
+  }
+
+  const LazyReducerAVX512 reducer(modulus);
+  for (uint64_t l = 0; l < n; l += 8) {
+    __m512i v_hi = _mm512_loadu_si512(&acc_hi[l]);
+    __m512i v_lo = _mm512_loadu_si512(&acc_lo[l]);
+    _mm512_storeu_si512(&result[l], reducer.Reduce(v_hi, v_lo));
+  }
+}
+
+#endif
+
+#ifdef HEXL_HAS_AVX512IFMA
+
+void EltwiseLazyMultAccumulateAVX512IFMA(uint64_t* acc_hi, uint64_t* acc_lo,
+                                         const uint64_t* operand1,
+                                         const uint64_t* operand2,
+                                         uint64_t n) {
+  const uint64_t n_tail = n % 8;
+  for (uint64_t l = 0; l < n_tail; ++l) {
+    uint64_t prod_hi;
+    uint64_t prod_lo;
+    MultiplyUInt64(operand1[l], operand2[l], &prod_hi, &prod_lo);
+    acc_lo[l] += prod_lo & ((1ULL << 52) - 1);
+    acc_hi[l] += (prod_hi << 12) | (prod_lo >> 52);
+  }
+  acc_hi += n_tail;
+  acc_lo += n_tail;
+  operand1 += n_tail;
+  operand2 += n_tail;
+  n -= n_tail;
+
+  for (uint64_t l = 0; l < n; l += 8) {
+    __m512i v_x = _mm512_loadu_si512(&operand1[l]);
+    __m512i v_y = _mm512_loadu_si512(&operand2[l]);
+    __m512i v_lo = _mm512_loadu_si512(&acc_lo[l]);
+    __m512i v_hi = _mm512_loadu_si512(&acc_hi[l]);
+    _mm512_storeu_si512(&acc_lo[l], _mm512_madd52lo_epu64(v_lo, v_x, v_y));
+    _mm512_storeu_si512(&acc_hi[l], _mm512_madd52hi_epu64(v_hi, v_x, v_y));
+  }
+}
+
+void EltwiseLazyReduceAVX512IFMA(uint64_t* result, const uint64_t* acc_hi,
+                                 const uint64_t* acc_lo, uint64_t n,
+                                 uint64_t modulus) {
+  const uint64_t n_tail = n % 8;
+  for (uint64_t l = 0; l < n_tail; ++l) {
+    // acc_hi * 2^52 + acc_lo as a 128-bit value
+    uint64_t lo;
+    uint64_t carry = AddUInt64(acc_hi[l] << 52, acc_lo[l], &lo);
+    uint64_t hi = (acc_hi[l] >> 12) + carry;
+    result[l] = BarrettReduce128(hi, lo, modulus);
+  }
+  result += n_tail;
+  acc_hi += n_tail;
+  acc_lo += n_tail;
+  n -= n_tail;
+
+  const LazyReducerAVX512 reducer(modulus);
+  for (uint64_t l = 0; l < n; l += 8) {
+    __m512i v_hi;
+    __m512i v_lo;
+    LazyCombineAVX512IFMA(_mm512_loadu_si512(&acc_hi[l]),
+                          _mm512_loadu_si512(&acc_lo[l]), &v_hi, &v_lo);
+    _mm512_storeu_si512(&result[l], reducer.Reduce(v_hi, v_lo));
+  }
+}
+
+#endif
+
+}  // namespace hexl
+}  // namespace intel
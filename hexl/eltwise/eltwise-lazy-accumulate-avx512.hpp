@@ -0,0 +1,87 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <immintrin.h>
+#include <stdint.h>
+
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/defines.hpp"
+#include "util/avx512-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+/// @brief AVX512-DQ implementation of EltwiseLazyMultAccumulateNative
+void EltwiseLazyMultAccumulateAVX512DQ(uint64_t* acc_hi, uint64_t* acc_lo,
+                                       const uint64_t* operand1,
+                                       const uint64_t* operand2, uint64_t n);
+
+/// @brief AVX512-DQ implementation of EltwiseLazyReduceNative, for modulus <
+/// 2^62
+void EltwiseLazyReduceAVX512DQ(uint64_t* result, const uint64_t* acc_hi,
+                               const uint64_t* acc_lo, uint64_t n,
+                               uint64_t modulus);
+
+/// @brief Reduces 8 128-bit values v_hi * 2^64 + v_lo at a time modulo a
+/// fixed modulus < 2^62
+struct LazyReducerAVX512 {
+  explicit LazyReducerAVX512(uint64_t modulus) {
+    // 2^64 mod q = (2^64 - q) mod q
+    const uint64_t r = (0 - modulus) % modulus;
+    v_modulus = _mm512_set1_epi64(static_cast<int64_t>(modulus));
+    v_barr = _mm512_set1_epi64(
+        static_cast<int64_t>(MultiplyFactor(1, 64, modulus).BarrettFactor()));
+    v_r = _mm512_set1_epi64(static_cast<int64_t>(r));
+    v_r_precon = _mm512_set1_epi64(
+        static_cast<int64_t>(MultiplyFactor(r, 64, modulus).BarrettFactor()));
+  }
+
+  /// @brief Returns (v_hi * 2^64 + v_lo) mod modulus
+  __m512i Reduce(__m512i v_hi, __m512i v_lo) const {
+    return _mm512_hexl_barrett_reduce128(v_hi, v_lo, v_modulus, v_barr, v_r,
+                                         v_r_precon);
+  }
+
+  __m512i v_modulus;
+  __m512i v_barr;
+  __m512i v_r;
+  __m512i v_r_precon;
+};
+#endif
+
+#ifdef HEXL_HAS_AVX512IFMA
+/// @brief Adds the low and high 52 bits of operand1[l] * operand2[l] to
+/// acc_lo[l] and acc_hi[l], respectively, representing acc_hi[l] * 2^52 +
+/// acc_lo[l]
+/// @details Requires operands below 2^52. At most
+/// LazyAccumulateKernels::s_max_products_ifma products may be accumulated
+/// into accumulators starting below 2^52.
+void EltwiseLazyMultAccumulateAVX512IFMA(uint64_t* acc_hi, uint64_t* acc_lo,
+                                         const uint64_t* operand1,
+                                         const uint64_t* operand2,
+                                         uint64_t n);
+
+/// @brief Sets result[l] = (acc_hi[l] * 2^52 + acc_lo[l]) mod modulus, for
+/// accumulators of EltwiseLazyMultAccumulateAVX512IFMA and modulus < 2^62.
+/// result may alias acc_lo
+void EltwiseLazyReduceAVX512IFMA(uint64_t* result, const uint64_t* acc_hi,
+                                 const uint64_t* acc_lo, uint64_t n,
+                                 uint64_t modulus);
+
+/// @brief Converts the 52-bit split accumulators v_acc_hi * 2^52 + v_acc_lo
+/// into 128-bit values *v_hi * 2^64 + *v_lo
+inline void LazyCombineAVX512IFMA(__m512i v_acc_hi, __m512i v_acc_lo,
+                                  __m512i* v_hi, __m512i* v_lo) {
+  __m512i v_shifted = _mm512_slli_epi64(v_acc_hi, 52);
+  *v_lo = _mm512_add_epi64(v_shifted, v_acc_lo);
+  __mmask8 carry = _mm512_cmplt_epu64_mask(*v_lo, v_shifted);
+  *v_hi = _mm512_srli_epi64(v_acc_hi, 12);
+  *v_hi = _mm512_mask_add_epi64(*v_hi, carry, *v_hi, _mm512_set1_epi64(1));
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
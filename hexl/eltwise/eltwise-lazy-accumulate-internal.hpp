@@ -0,0 +1,55 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+/// @brief Adds operand1[l] * operand2[l] to the 128-bit value acc_hi[l] * 2^64
+/// + acc_lo[l], for l in [0, n), without reduction
+void EltwiseLazyMultAccumulateNative(uint64_t* acc_hi, uint64_t* acc_lo,
+                                     const uint64_t* operand1,
+                                     const uint64_t* operand2, uint64_t n);
+
+/// @brief Sets result[l] = (acc_hi[l] * 2^64 + acc_lo[l]) mod modulus. result
+/// may alias acc_lo
+void EltwiseLazyReduceNative(uint64_t* result, const uint64_t* acc_hi,
+                             const uint64_t* acc_lo, uint64_t n,
+                             uint64_t modulus);
+
+/// @brief Returns the number of products of values in [0, modulus) which may
+/// be added to a 128-bit accumulator below modulus without overflow
+uint64_t LazyAccumulateMaxProducts(uint64_t modulus);
+
+/// @brief The fastest lazy multiply-accumulate and reduce kernels for products
+/// of values in [0, modulus)
+struct LazyAccumulateKernels {
+  /// @brief Selects the kernels for \p modulus
+  explicit LazyAccumulateKernels(uint64_t modulus);
+
+  /// @brief Adds operand1[l] * operand2[l] to the accumulators, for l in [0,
+  /// n)
+  void (*accumulate)(uint64_t* acc_hi, uint64_t* acc_lo,
+                     const uint64_t* operand1, const uint64_t* operand2,
+                     uint64_t n);
+
+  /// @brief Sets result[l] to the accumulator l modulo the modulus. result
+  /// may alias acc_lo
+  void (*reduce)(uint64_t* result, const uint64_t* acc_hi,
+                 const uint64_t* acc_lo, uint64_t n, uint64_t modulus);
+
+  /// @brief Number of products which may be accumulated into accumulators
+  /// with acc_hi = 0 and acc_lo < modulus without overflow
+  uint64_t max_products;
+
+  /// @brief Number of products which may be accumulated into the 52-bit
+  /// split accumulators of the AVX512-IFMA kernels, starting from acc_hi = 0
+  /// and acc_lo < 2^52, without overflow
+  static constexpr uint64_t s_max_products_ifma{(1ULL << 12) - 2};
+};
+
+}  // namespace hexl
+}  // namespace intel
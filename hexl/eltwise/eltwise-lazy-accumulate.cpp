@@ -0,0 +1,64 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "eltwise/eltwise-lazy-accumulate-avx512.hpp"
+#include "eltwise/eltwise-lazy-accumulate-internal.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "util/cpu-features.hpp"
+
+namespace intel {
+namespace hexl {
+
+void EltwiseLazyMultAccumulateNative(uint64_t* acc_hi, uint64_t* acc_lo,
+                                     const uint64_t* operand1,
+                                     const uint64_t* operand2, uint64_t n) {
+  for (size_t l = 0; l < n; ++l) {
+    uint64_t prod_hi;
+    uint64_t prod_lo;
+    MultiplyUInt64(operand1[l], operand2[l], &prod_hi, &prod_lo);
+    acc_hi[l] += prod_hi + AddUInt64(acc_lo[l], prod_lo, &acc_lo[l]);
+  }
+}
+
+void EltwiseLazyReduceNative(uint64_t* result, const uint64_t* acc_hi,
+                             const uint64_t* acc_lo, uint64_t n,
+                             uint64_t modulus) {
+  for (size_t l = 0; l < n; ++l) {
+    result[l] = BarrettReduce128(acc_hi[l], acc_lo[l], modulus);
+  }
+}
+
+uint64_t LazyAccumulateMaxProducts(uint64_t modulus) {
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  // With b = bits(modulus - 1), each product is at most (2^b - 1)^2 and the
+  // accumulator starts at most at 2^b, so 2^(128 - 2b) - 1 products fit into
+  // 128 bits
+  const uint64_t bits = Log2(modulus - 1) + 1;
+  if (2 * bits <= 64) {
+    return ~0ULL;
+  }
+  return (1ULL << (128 - 2 * bits)) - 1;
+}
+
+LazyAccumulateKernels::LazyAccumulateKernels(uint64_t modulus)
+    : accumulate(EltwiseLazyMultAccumulateNative),
+      reduce(EltwiseLazyReduceNative),
+      max_products(LazyAccumulateMaxProducts(modulus)) {
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq && modulus < (1ULL << 62)) {
+    accumulate = EltwiseLazyMultAccumulateAVX512DQ;
+    reduce = EltwiseLazyReduceAVX512DQ;
+  }
+#endif
+#ifdef HEXL_HAS_AVX512IFMA
+  if (has_avx512ifma && modulus < (1ULL << 52)) {
+    accumulate = EltwiseLazyMultAccumulateAVX512IFMA;
+    reduce = EltwiseLazyReduceAVX512IFMA;
+    max_products = s_max_products_ifma;
+  }
+#endif
+}
+
+}  // namespace hexl
+}  // namespace intel
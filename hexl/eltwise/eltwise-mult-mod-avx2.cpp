@@ -0,0 +1,215 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "eltwise/eltwise-mult-mod-avx2.hpp"
+
+#include <immintrin.h>
+#include <stdint.h>
+
+#include <limits>
+
+#include "eltwise/eltwise-mult-mod-internal.hpp"
+#include "hexl/eltwise/eltwise-mult-mod.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "hexl/util/compiler.hpp"
+#include "util/avx2-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+
+template void EltwiseMultModAVX2Int<1>(uint64_t* result,
+                                       const uint64_t* operand1,
+                                       const uint64_t* operand2, uint64_t n,
+                                       uint64_t modulus);
+template void EltwiseMultModAVX2Int<2>(uint64_t* result,
+                                       const uint64_t* operand1,
+                                       const uint64_t* operand2, uint64_t n,
+                                       uint64_t modulus);
+template void EltwiseMultModAVX2Int<4>(uint64_t* result,
+                                       const uint64_t* operand1,
+                                       const uint64_t* operand2, uint64_t n,
+                                       uint64_t modulus);
+
+template void EltwiseMultModAVX2Float<1>(uint64_t* result,
+                                         const uint64_t* operand1,
+                                         const uint64_t* operand2, uint64_t n,
+                                         uint64_t modulus);
+template void EltwiseMultModAVX2Float<2>(uint64_t* result,
+                                         const uint64_t* operand1,
+                                         const uint64_t* operand2, uint64_t n,
+                                         uint64_t modulus);
+template void EltwiseMultModAVX2Float<4>(uint64_t* result,
+                                         const uint64_t* operand1,
+                                         const uint64_t* operand2, uint64_t n,
+                                         uint64_t modulus);
+
+template <int InputModFactor>
+void EltwiseMultModAVX2Int(uint64_t* result, const uint64_t* operand1,
+                           const uint64_t* operand2, uint64_t n,
+                           uint64_t modulus) {
+  HEXL_CHECK(InputModFactor == 1 || InputModFactor == 2 || InputModFactor == 4,
+             "Require InputModFactor = 1, 2, or 4")
+  HEXL_CHECK(modulus < (1ULL << 62), "Require modulus < (1ULL << 62)");
+  HEXL_CHECK_BOUNDS(operand1, n, InputModFactor * modulus,
+                    "operand1 exceeds bound " << (InputModFactor * modulus));
+  HEXL_CHECK_BOUNDS(operand2, n, InputModFactor * modulus,
+                    "operand2 exceeds bound " << (InputModFactor * modulus));
+
+  uint64_t n_mod_4 = n % 4;
+  if (n_mod_4 != 0) {
+    EltwiseMultModNative<InputModFactor>(result, operand1, operand2, n_mod_4,
+                                         modulus);
+    operand1 += n_mod_4;
+    operand2 += n_mod_4;
+    result += n_mod_4;
+    n -= n_mod_4;
+  }
+
+  constexpr int64_t beta = -2;
+  constexpr int64_t alpha = 62;  // ensures alpha - beta = 64
+
+  const uint64_t ceil_log_mod = Log2(modulus) + 1;  // "n" from Algorithm 2
+  uint64_t prod_right_shift = ceil_log_mod + beta;
+
+  // Barrett factor "mu"
+  uint64_t barr_lo =
+      MultiplyFactor(uint64_t(1) << (ceil_log_mod + alpha - 64), 64, modulus)
+          .BarrettFactor();
+
+  __m256i vbarr_lo = _mm256_set1_epi64x(static_cast<int64_t>(barr_lo));
+  __m256i vmodulus = _mm256_set1_epi64x(static_cast<int64_t>(modulus));
+  __m256i vtwice_mod = _mm256_set1_epi64x(static_cast<int64_t>(2 * modulus));
+  // AVX2 shifts by a count of 64 or more yield zero, so prod_right_shift == 0
+  // is handled without special-casing
+  __m128i vright_shift =
+      _mm_set_epi64x(0, static_cast<int64_t>(prod_right_shift));
+  __m128i vleft_shift =
+      _mm_set_epi64x(0, static_cast<int64_t>(64 - prod_right_shift));
+
+  const __m256i* vp_operand1 = reinterpret_cast<const __m256i*>(operand1);
+  const __m256i* vp_operand2 = reinterpret_cast<const __m256i*>(operand2);
+  __m256i* vp_result = reinterpret_cast<__m256i*>(result);
+
+  HEXL_LOOP_UNROLL_4
+  for (size_t i = n / 4; i > 0; --i) {
+    __m256i vx = _mm256_loadu_si256(vp_operand1);
+    __m256i vy = _mm256_loadu_si256(vp_operand2);
+
+    vx = _mm256_hexl_small_mod_epu64<InputModFactor>(vx, vmodulus, &vtwice_mod);
+    vy = _mm256_hexl_small_mod_epu64<InputModFactor>(vy, vmodulus, &vtwice_mod);
+
+    // Multiply inputs
+    __m256i vprod_hi = _mm256_hexl_mulhi_epi64(vx, vy);
+    __m256i vprod_lo = _mm256_hexl_mullo_epi64(vx, vy);
+
+    // c1 = floor(U / 2^{n + beta})
+    __m256i c1 = _mm256_or_si256(_mm256_srl_epi64(vprod_lo, vright_shift),
+                                 _mm256_sll_epi64(vprod_hi, vleft_shift));
+
+    // alpha - beta == 64, so we only need high 64 bits
+    __m256i q_hat = _mm256_hexl_mulhi_epi64(c1, vbarr_lo);
+
+    // only compute low bits, since we know high bits will be 0
+    __m256i vz =
+        _mm256_sub_epi64(vprod_lo, _mm256_hexl_mullo_epi64(q_hat, vmodulus));
+
+    // Conditional subtraction
+    vz = _mm256_hexl_small_mod_epu64(vz, vmodulus);
+    _mm256_storeu_si256(vp_result, vz);
+
+    ++vp_operand1;
+    ++vp_operand2;
+    ++vp_result;
+  }
+}
+
+template <int InputModFactor>
+void EltwiseMultModAVX2Float(uint64_t* result, const uint64_t* operand1,
+                             const uint64_t* operand2, uint64_t n,
+                             uint64_t modulus) {
+  HEXL_CHECK(modulus < MaximumValue(50),
+             " modulus " << modulus << " exceeds bound " << MaximumValue(50));
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK_BOUNDS(operand1, n, InputModFactor * modulus,
+                    "operand1 exceeds bound " << (InputModFactor * modulus));
+  HEXL_CHECK_BOUNDS(operand2, n, InputModFactor * modulus,
+                    "operand2 exceeds bound " << (InputModFactor * modulus));
+
+  uint64_t n_mod_4 = n % 4;
+  if (n_mod_4 != 0) {
+    EltwiseMultModNative<InputModFactor>(result, operand1, operand2, n_mod_4,
+                                         modulus);
+    operand1 += n_mod_4;
+    operand2 += n_mod_4;
+    result += n_mod_4;
+    n -= n_mod_4;
+  }
+
+  __m256d v_p = _mm256_set1_pd(static_cast<double>(modulus));
+  __m256i v_modulus = _mm256_set1_epi64x(static_cast<int64_t>(modulus));
+  __m256i v_twice_mod = _mm256_set1_epi64x(static_cast<int64_t>(modulus * 2));
+
+  // Add epsilon to ensure u * p >= 1.0
+  // See Proposition 13 of https://arxiv.org/pdf/1407.3383.pdf
+  double u_bar = (1.0 + std::numeric_limits<double>::epsilon()) /
+                 static_cast<double>(modulus);
+  __m256d v_u = _mm256_set1_pd(u_bar);
+
+  // AVX2 lacks 64-bit integer <-> double conversions. Integers below 2^52 are
+  // converted exactly by placing them in the mantissa of 2^52 and subtracting
+  // 2^52 again.
+  const __m256i v_two_pow_52 = _mm256_set1_epi64x(0x4330000000000000);
+  const __m256d v_two_pow_52_pd = _mm256_castsi256_pd(v_two_pow_52);
+
+  const __m256i* vp_operand1 = reinterpret_cast<const __m256i*>(operand1);
+  const __m256i* vp_operand2 = reinterpret_cast<const __m256i*>(operand2);
+  __m256i* vp_result = reinterpret_cast<__m256i*>(result);
+
+  HEXL_LOOP_UNROLL_4
+  for (size_t i = n / 4; i > 0; --i) {
+    __m256i v_op1 = _mm256_loadu_si256(vp_operand1);
+    v_op1 = _mm256_hexl_small_mod_epu64<InputModFactor>(v_op1, v_modulus,
+                                                        &v_twice_mod);
+    __m256i v_op2 = _mm256_loadu_si256(vp_operand2);
+    v_op2 = _mm256_hexl_small_mod_epu64<InputModFactor>(v_op2, v_modulus,
+                                                        &v_twice_mod);
+
+    __m256d v_x = _mm256_sub_pd(
+        _mm256_castsi256_pd(_mm256_or_si256(v_op1, v_two_pow_52)),
+        v_two_pow_52_pd);
+    __m256d v_y = _mm256_sub_pd(
+        _mm256_castsi256_pd(_mm256_or_si256(v_op2, v_two_pow_52)),
+        v_two_pow_52_pd);
+
+    __m256d v_h = _mm256_mul_pd(v_x, v_y);
+    __m256d v_l =
+        _mm256_fmsub_pd(v_x, v_y, v_h);     // rounding error; h + l == x * y
+    __m256d v_b = _mm256_mul_pd(v_h, v_u);  // ~ (x * y) / p
+    __m256d v_c = _mm256_floor_pd(v_b);     // ~ floor(x * y / p)
+    __m256d v_d = _mm256_fnmadd_pd(v_c, v_p, v_h);
+    __m256d v_g = _mm256_add_pd(v_d, v_l);
+    __m256d v_g_lt_zero =
+        _mm256_cmp_pd(v_g, _mm256_setzero_pd(), _CMP_LT_OQ);
+    v_g = _mm256_add_pd(v_g, _mm256_and_pd(v_g_lt_zero, v_p));
+
+    __m256i v_result = _mm256_xor_si256(
+        _mm256_castpd_si256(_mm256_add_pd(v_g, v_two_pow_52_pd)),
+        v_two_pow_52);
+
+    _mm256_storeu_si256(vp_result, v_result);
+
+    ++vp_operand1;
+    ++vp_operand2;
+    ++vp_result;
+  }
+
+  HEXL_CHECK_BOUNDS(result, n, modulus, "result exceeds bound " << modulus);
+}
+
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,56 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+
+/// @brief Multiplies two vectors elementwise with modular reduction
+/// @param[in] result Result of element-wise multiplication
+/// @param[in] operand1 Vector of elements to multiply. Each element must be
+/// less than the modulus.
+/// @param[in] operand2 Vector of elements to multiply. Each element must be
+/// less than the modulus.
+/// @param[in] n Number of elements in each vector
+/// @param[in] modulus Modulus with which to perform modular reduction
+/// @param[in] input_mod_factor Assumes input elements are in [0,
+/// input_mod_factor * p) Must be 1, 2 or 4.
+/// @details Computes \p result[i] = (\p operand1[i] * \p operand2[i]) mod \p
+/// modulus for i=0, ..., \p n - 1
+/// @details Barrett's algorithm for vector-vector modular multiplication
+/// (Algorithm 2 from
+/// https://homes.esat.kuleuven.be/~fvercaut/papers/bar_mont.pdf) using AVX2
+template <int InputModFactor>
+void EltwiseMultModAVX2Int(uint64_t* result, const uint64_t* operand1,
+                           const uint64_t* operand2, uint64_t n,
+                           uint64_t modulus);
+
+/// @brief Multiplies two vectors elementwise with modular reduction
+/// @param[in] result Result of element-wise multiplication
+/// @param[in] operand1 Vector of elements to multiply. Each element must be
+/// less than the modulus.
+/// @param[in] operand2 Vector of elements to multiply. Each element must be
+/// less than the modulus.
+/// @param[in] n Number of elements in each vector
+/// @param[in] modulus Modulus with which to perform modular reduction. Must be
+/// less than 2^50.
+/// @param[in] input_mod_factor Assumes input elements are in [0,
+/// input_mod_factor * p) Must be 1, 2 or 4.
+/// @details Computes \p result[i] = (\p operand1[i] * \p operand2[i]) mod \p
+/// modulus for i=0, ..., \p n - 1
+/// @details Function 18 on page 19 of https://arxiv.org/pdf/1407.3383.pdf
+/// Uses floating-point arithmetic
+template <int InputModFactor>
+void EltwiseMultModAVX2Float(uint64_t* result, const uint64_t* operand1,
+                             const uint64_t* operand2, uint64_t n,
+                             uint64_t modulus);
+
+#endif
+
+}  // namespace hexl
+}  // namespace intel
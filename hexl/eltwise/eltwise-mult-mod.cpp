@@ -4,6 +4,7 @@
 #include "hexl/eltwise/eltwise-mult-mod.hpp"
 
 #include "eltwise/eltwise-mult-mod-avx512.hpp"
+#include "eltwise/eltwise-mult-mod-avx2.hpp"
 #include "eltwise/eltwise-mult-mod-internal.hpp"
 #include "hexl/eltwise/eltwise-reduce-mod.hpp"
 #include "hexl/logging/logging.hpp"
@@ -11,13 +12,14 @@
 #include "hexl/util/aligned-allocator.hpp"
 #include "hexl/util/check.hpp"
 #include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
 
 namespace intel {
 namespace hexl {
 
 void EltwiseMultMod(uint64_t* result, const uint64_t* operand1,
                     const uint64_t* operand2, uint64_t n, uint64_t modulus,
-                    uint64_t input_mod_factor) {
+                    uint64_t input_mod_factor, const ExecutionPolicy& policy) {
   HEXL_CHECK(result != nullptr, "Require result != nullptr");
   HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
   HEXL_CHECK(operand2 != nullptr, "Require operand2 != nullptr");
@@ -33,6 +35,14 @@ void EltwiseMultMod(uint64_t* result, const uint64_t* operand1,
   HEXL_CHECK_BOUNDS(operand2, n, input_mod_factor * modulus,
                     "operand2 exceeds bound " << (input_mod_factor * modulus))
 
+  if (!policy.IsSerial()) {
+    ParallelFor(n, policy, [&](uint64_t begin, uint64_t end) {
+      EltwiseMultMod(result + begin, operand1 + begin, operand2 + begin,
+                     end - begin, modulus, input_mod_factor);
+    });
+    return;
+  }
+
 #ifdef HEXL_HAS_AVX512DQ
   if (has_avx512dq) {
     if (modulus < (1ULL << 50)) {
@@ -67,6 +77,37 @@ void EltwiseMultMod(uint64_t* result, const uint64_t* operand1,
   }
 #endif
 
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2) {
+    if (modulus < (1ULL << 50)) {
+      switch (input_mod_factor) {
+        case 1:
+          EltwiseMultModAVX2Float<1>(result, operand1, operand2, n, modulus);
+          break;
+        case 2:
+          EltwiseMultModAVX2Float<2>(result, operand1, operand2, n, modulus);
+          break;
+        case 4:
+          EltwiseMultModAVX2Float<4>(result, operand1, operand2, n, modulus);
+          break;
+      }
+    } else {
+      switch (input_mod_factor) {
+        case 1:
+          EltwiseMultModAVX2Int<1>(result, operand1, operand2, n, modulus);
+          break;
+        case 2:
+          EltwiseMultModAVX2Int<2>(result, operand1, operand2, n, modulus);
+          break;
+        case 4:
+          EltwiseMultModAVX2Int<4>(result, operand1, operand2, n, modulus);
+          break;
+      }
+    }
+    return;
+  }
+#endif
+
   HEXL_VLOG(3, "Calling EltwiseMultModNative");
   switch (input_mod_factor) {
     case 1:
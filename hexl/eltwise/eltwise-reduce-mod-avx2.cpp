@@ -0,0 +1,117 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "eltwise/eltwise-reduce-mod-avx2.hpp"
+
+#include <immintrin.h>
+
+#include "eltwise/eltwise-reduce-mod-internal.hpp"
+#include "hexl/eltwise/eltwise-reduce-mod.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "util/avx2-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+
+void EltwiseReduceModAVX2(uint64_t* result, const uint64_t* operand,
+                          uint64_t n, uint64_t modulus,
+                          uint64_t input_mod_factor,
+                          uint64_t output_mod_factor) {
+  HEXL_CHECK(operand != nullptr, "Require operand1 != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK(input_mod_factor == modulus || input_mod_factor == 2 ||
+                 input_mod_factor == 4,
+             "input_mod_factor must be modulus or 2 or 4" << input_mod_factor);
+  HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 2,
+             "output_mod_factor must be 1 or 2 " << output_mod_factor);
+  HEXL_CHECK(input_mod_factor != output_mod_factor,
+             "input_mod_factor must not be equal to output_mod_factor ");
+
+  // Deals with n not divisible by 4
+  uint64_t n_mod_4 = n % 4;
+  if (n_mod_4 != 0) {
+    EltwiseReduceModNative(result, operand, n_mod_4, modulus, input_mod_factor,
+                           output_mod_factor);
+    operand += n_mod_4;
+    result += n_mod_4;
+    n -= n_mod_4;
+  }
+
+  uint64_t twice_mod = modulus << 1;
+  const __m256i* v_operand = reinterpret_cast<const __m256i*>(operand);
+  __m256i* v_result = reinterpret_cast<__m256i*>(result);
+  __m256i v_modulus = _mm256_set1_epi64x(static_cast<int64_t>(modulus));
+  __m256i v_twice_mod = _mm256_set1_epi64x(static_cast<int64_t>(twice_mod));
+
+  if (input_mod_factor == modulus) {
+    // Single-worded Barrett reduction
+    uint64_t barrett_factor = MultiplyFactor(1, 64, modulus).BarrettFactor();
+    __m256i v_bf = _mm256_set1_epi64x(static_cast<int64_t>(barrett_factor));
+
+    if (output_mod_factor == 2) {
+      for (size_t i = n / 4; i > 0; --i) {
+        __m256i v_op = _mm256_loadu_si256(v_operand);
+        v_op = _mm256_hexl_barrett_reduce64<2>(v_op, v_modulus, v_bf);
+        _mm256_storeu_si256(v_result, v_op);
+        ++v_operand;
+        ++v_result;
+      }
+    } else {
+      for (size_t i = n / 4; i > 0; --i) {
+        __m256i v_op = _mm256_loadu_si256(v_operand);
+        v_op = _mm256_hexl_barrett_reduce64<1>(v_op, v_modulus, v_bf);
+        HEXL_CHECK_BOUNDS(ExtractValues(v_op).data(), 4, modulus,
+                          "v_op exceeds bound " << modulus);
+        _mm256_storeu_si256(v_result, v_op);
+        ++v_operand;
+        ++v_result;
+      }
+    }
+  }
+
+  if (input_mod_factor == 2) {
+    for (size_t i = n / 4; i > 0; --i) {
+      __m256i v_op = _mm256_loadu_si256(v_operand);
+      v_op = _mm256_hexl_small_mod_epu64(v_op, v_modulus);
+      HEXL_CHECK_BOUNDS(ExtractValues(v_op).data(), 4, modulus,
+                        "v_op exceeds bound " << modulus);
+      _mm256_storeu_si256(v_result, v_op);
+      ++v_operand;
+      ++v_result;
+    }
+  }
+
+  if (input_mod_factor == 4) {
+    if (output_mod_factor == 1) {
+      for (size_t i = n / 4; i > 0; --i) {
+        __m256i v_op = _mm256_loadu_si256(v_operand);
+        v_op = _mm256_hexl_small_mod_epu64<4>(v_op, v_modulus, &v_twice_mod);
+        HEXL_CHECK_BOUNDS(ExtractValues(v_op).data(), 4, modulus,
+                          "v_op exceeds bound " << modulus);
+        _mm256_storeu_si256(v_result, v_op);
+        ++v_operand;
+        ++v_result;
+      }
+    }
+    if (output_mod_factor == 2) {
+      for (size_t i = n / 4; i > 0; --i) {
+        __m256i v_op = _mm256_loadu_si256(v_operand);
+        v_op = _mm256_hexl_small_mod_epu64(v_op, v_twice_mod);
+        HEXL_CHECK_BOUNDS(ExtractValues(v_op).data(), 4, twice_mod,
+                          "v_op exceeds bound " << twice_mod);
+        _mm256_storeu_si256(v_result, v_op);
+        ++v_operand;
+        ++v_result;
+      }
+    }
+  }
+}
+
+#endif
+
+}  // namespace hexl
+}  // namespace intel
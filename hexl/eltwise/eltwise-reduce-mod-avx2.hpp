@@ -0,0 +1,24 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+
+/// @brief AVX2 implementation of EltwiseReduceMod
+/// @details See EltwiseReduceMod for the supported input and output mod
+/// factors. Requires input_mod_factor != output_mod_factor.
+void EltwiseReduceModAVX2(uint64_t* result, const uint64_t* operand,
+                          uint64_t n, uint64_t modulus,
+                          uint64_t input_mod_factor,
+                          uint64_t output_mod_factor);
+
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -4,11 +4,13 @@
 #include "hexl/eltwise/eltwise-reduce-mod.hpp"
 
 #include "eltwise/eltwise-reduce-mod-avx512.hpp"
+#include "eltwise/eltwise-reduce-mod-avx2.hpp"
 #include "eltwise/eltwise-reduce-mod-internal.hpp"
 #include "hexl/logging/logging.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "hexl/util/check.hpp"
 #include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
 
 namespace intel {
 namespace hexl {
@@ -80,7 +82,8 @@ void EltwiseReduceModNative(uint64_t* result, const uint64_t* operand,
 
 void EltwiseReduceMod(uint64_t* result, const uint64_t* operand, uint64_t n,
                       uint64_t modulus, uint64_t input_mod_factor,
-                      uint64_t output_mod_factor) {
+                      uint64_t output_mod_factor,
+                      const ExecutionPolicy& policy) {
   HEXL_CHECK(operand != nullptr, "Require operand1 != nullptr");
   HEXL_CHECK(result != nullptr, "Require result != nullptr");
   HEXL_CHECK(n != 0, "Require n != 0");
@@ -91,6 +94,14 @@ void EltwiseReduceMod(uint64_t* result, const uint64_t* operand, uint64_t n,
   HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 2,
              "output_mod_factor must be 1 or 2 " << output_mod_factor);
 
+  if (!policy.IsSerial()) {
+    ParallelFor(n, policy, [&](uint64_t begin, uint64_t end) {
+      EltwiseReduceMod(result + begin, operand + begin, end - begin, modulus,
+                       input_mod_factor, output_mod_factor);
+    });
+    return;
+  }
+
   if (input_mod_factor == output_mod_factor && (operand != result)) {
     for (size_t i = 0; i < n; ++i) {
       result[i] = operand[i];
@@ -117,6 +128,14 @@ void EltwiseReduceMod(uint64_t* result, const uint64_t* operand, uint64_t n,
   }
 #endif
 
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2) {
+    EltwiseReduceModAVX2(result, operand, n, modulus, input_mod_factor,
+                         output_mod_factor);
+    return;
+  }
+#endif
+
   HEXL_VLOG(3, "Calling EltwiseReduceModNative");
   EltwiseReduceModNative(result, operand, n, modulus, input_mod_factor,
                          output_mod_factor);
@@ -1,13 +1,17 @@
 // Copyright (C) 2020 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include "hexl/eltwise/eltwise-sub-mod.hpp"
+
 #include "eltwise/eltwise-sub-mod-avx512.hpp"
+#include "eltwise/eltwise-sub-mod-avx2.hpp"
 #include "eltwise/eltwise-sub-mod-internal.hpp"
 #include "hexl/eltwise/eltwise-add-mod.hpp"
 #include "hexl/logging/logging.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "hexl/util/check.hpp"
 #include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
 
 namespace intel {
 namespace hexl {
@@ -65,7 +69,8 @@ void EltwiseSubModNative(uint64_t* result, const uint64_t* operand1,
 }
 
 void EltwiseSubMod(uint64_t* result, const uint64_t* operand1,
-                   const uint64_t* operand2, uint64_t n, uint64_t modulus) {
+                   const uint64_t* operand2, uint64_t n, uint64_t modulus,
+                   const ExecutionPolicy& policy) {
   HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
   HEXL_CHECK(operand2 != nullptr, "Require operand2 != nullptr");
   HEXL_CHECK(n != 0, "Require n != 0");
@@ -76,6 +81,14 @@ void EltwiseSubMod(uint64_t* result, const uint64_t* operand1,
   HEXL_CHECK_BOUNDS(operand2, n, modulus,
                     "pre-sub value in operand2 exceeds bound " << modulus);
 
+  if (!policy.IsSerial()) {
+    ParallelFor(n, policy, [&](uint64_t begin, uint64_t end) {
+      EltwiseSubMod(result + begin, operand1 + begin, operand2 + begin,
+                    end - begin, modulus);
+    });
+    return;
+  }
+
 #ifdef HEXL_HAS_AVX512DQ
   if (has_avx512dq) {
     EltwiseSubModAVX512(result, operand1, operand2, n, modulus);
@@ -83,12 +96,20 @@ void EltwiseSubMod(uint64_t* result, const uint64_t* operand1,
   }
 #endif
 
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2) {
+    EltwiseSubModAVX2(result, operand1, operand2, n, modulus);
+    return;
+  }
+#endif
+
   HEXL_VLOG(3, "Calling EltwiseSubModNative");
   EltwiseSubModNative(result, operand1, operand2, n, modulus);
 }
 
 void EltwiseSubMod(uint64_t* result, const uint64_t* operand1,
-                   uint64_t operand2, uint64_t n, uint64_t modulus) {
+                   uint64_t operand2, uint64_t n, uint64_t modulus,
+                   const ExecutionPolicy& policy) {
   HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
   HEXL_CHECK(n != 0, "Require n != 0");
   HEXL_CHECK(modulus > 1, "Require modulus > 1");
@@ -97,6 +118,14 @@ void EltwiseSubMod(uint64_t* result, const uint64_t* operand1,
                     "pre-sub value in operand1 exceeds bound " << modulus);
   HEXL_CHECK(operand2 < modulus, "Require operand2 < modulus");
 
+  if (!policy.IsSerial()) {
+    ParallelFor(n, policy, [&](uint64_t begin, uint64_t end) {
+      EltwiseSubMod(result + begin, operand1 + begin, operand2, end - begin,
+                    modulus);
+    });
+    return;
+  }
+
 #ifdef HEXL_HAS_AVX512DQ
   if (has_avx512dq) {
     EltwiseSubModAVX512(result, operand1, operand2, n, modulus);
@@ -104,6 +133,13 @@ void EltwiseSubMod(uint64_t* result, const uint64_t* operand1,
   }
 #endif
 
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2) {
+    EltwiseSubModAVX2(result, operand1, operand2, n, modulus);
+    return;
+  }
+#endif
+
   HEXL_VLOG(3, "Calling EltwiseSubModNative");
   EltwiseSubModNative(result, operand1, operand2, n, modulus);
 }
@@ -0,0 +1,136 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/experimental/fft-like/fft-like-avx2.hpp"
+
+#include <immintrin.h>
+
+#include <cmath>
+
+#include "hexl/experimental/fft-like/fft-like-native.hpp"
+#include "util/avx2-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+
+namespace {
+
+// Returns the unsigned 64-bit integers in x converted to double, rounded to
+// nearest like static_cast<double>. Both halves convert exactly, so the final
+// addition is the only rounding.
+inline __m256d ConvertToDouble(__m256i x) {
+  // Bit patterns of 2^52 and 2^84
+  const __m256i v_exp_lo = _mm256_set1_epi64x(0x4330000000000000);
+  const __m256i v_exp_hi = _mm256_set1_epi64x(0x4530000000000000);
+  const __m256d v_offset = _mm256_set1_pd(19342813118337666422669312.0);
+
+  // 2^52 + lo and 2^84 + hi * 2^32
+  __m256i v_lo = _mm256_blend_epi32(x, v_exp_lo, 0xaa);
+  __m256i v_hi = _mm256_or_si256(_mm256_srli_epi64(x, 32), v_exp_hi);
+  __m256d v_hi_pd =
+      _mm256_sub_pd(_mm256_castsi256_pd(v_hi), v_offset);  // hi * 2^32 - 2^52
+  return _mm256_add_pd(v_hi_pd, _mm256_castsi256_pd(v_lo));
+}
+
+}  // namespace
+
+void BuildFloatingPointsAVX2(std::complex<double>* res, const uint64_t* plain,
+                             const uint64_t* threshold,
+                             const uint64_t* decryption_modulus,
+                             const double inv_scale, size_t mod_size,
+                             size_t coeff_count) {
+  const __m256i v_zero = _mm256_setzero_si256();
+  const __m256i v_all_ones = _mm256_set1_epi64x(-1);
+  const __m256i v_sign_bit =
+      _mm256_set1_epi64x(static_cast<int64_t>(1ULL << 63));
+  const __m256d v_inv_scale = _mm256_set1_pd(inv_scale);
+  const __m256d v_zero_pd = _mm256_setzero_pd();
+
+  const size_t avx2_count = coeff_count / 4 * 4;
+  for (size_t i = 0; i < avx2_count; i += 4) {
+    // Returns word j of the four coefficients
+    auto load_words = [&](size_t j) {
+      const uint64_t* base = plain + j;
+      return _mm256_set_epi64x(
+          static_cast<int64_t>(base[(i + 3) * mod_size]),
+          static_cast<int64_t>(base[(i + 2) * mod_size]),
+          static_cast<int64_t>(base[(i + 1) * mod_size]),
+          static_cast<int64_t>(base[i * mod_size]));
+    };
+
+    // Compares with the threshold from the most significant word. Lanes equal
+    // to the threshold are negative.
+    __m256i v_negative = v_all_ones;
+    __m256i v_undecided = v_all_ones;
+    for (size_t j = mod_size; j-- > 0;) {
+      __m256i v_coeff = load_words(j);
+      __m256i v_threshold =
+          _mm256_set1_epi64x(static_cast<int64_t>(threshold[j]));
+      __m256i v_decided = _mm256_andnot_si256(
+          _mm256_cmpeq_epi64(v_coeff, v_threshold), v_undecided);
+      __m256i v_gt = _mm256_hexl_cmplt_epu64(v_threshold, v_coeff);
+      v_negative = _mm256_blendv_epi8(v_negative, v_gt, v_decided);
+      v_undecided = _mm256_andnot_si256(v_decided, v_undecided);
+      if (_mm256_testz_si256(v_undecided, v_undecided)) {
+        break;
+      }
+    }
+
+    // Adds |coeff| or |coeff - decryption_modulus| word by word; the words of
+    // the difference are computed with borrow propagation. v_borrow is all
+    // ones in the lanes with a borrow.
+    __m256d v_value = v_zero_pd;
+    __m256i v_borrow = v_zero;
+    for (size_t j = 0; j < mod_size; ++j) {
+      __m256i v_coeff = load_words(j);
+      __m256i v_modulus =
+          _mm256_set1_epi64x(static_cast<int64_t>(decryption_modulus[j]));
+      __m256i v_diff = _mm256_sub_epi64(v_modulus, v_coeff);
+      __m256i v_next_borrow = _mm256_or_si256(
+          _mm256_hexl_cmplt_epu64(v_modulus, v_coeff),
+          _mm256_and_si256(_mm256_cmpeq_epi64(v_diff, v_zero), v_borrow));
+      v_diff = _mm256_add_epi64(v_diff, v_borrow);
+      v_borrow = v_next_borrow;
+      __m256i v_word = _mm256_blendv_epi8(v_coeff, v_diff, v_negative);
+
+      __m256d v_scaled = _mm256_mul_pd(ConvertToDouble(v_word), v_inv_scale);
+      const int exponent = static_cast<int>(64 * j);
+      if (exponent <= 1023) {
+        // Exact, like std::ldexp, since the factor is a power of two
+        v_scaled = _mm256_mul_pd(v_scaled,
+                                 _mm256_set1_pd(std::ldexp(1.0, exponent)));
+      } else {
+        // 2^(64 j) overflows, so each nonzero word is scaled separately
+        double scaled[4];
+        _mm256_storeu_pd(scaled, v_scaled);
+        for (double& value : scaled) {
+          if (value != 0.0) {
+            value = std::ldexp(value, exponent);
+          }
+        }
+        v_scaled = _mm256_loadu_pd(scaled);
+      }
+      v_value = _mm256_add_pd(v_value, v_scaled);
+    }
+    v_value = _mm256_xor_pd(
+        v_value, _mm256_castsi256_pd(_mm256_and_si256(v_negative, v_sign_bit)));
+
+    // Interleaves the values with zero imaginary parts
+    __m256d v_lo = _mm256_unpacklo_pd(v_value, v_zero_pd);
+    __m256d v_hi = _mm256_unpackhi_pd(v_value, v_zero_pd);
+    double* out = reinterpret_cast<double*>(&res[i]);
+    _mm256_storeu_pd(out, _mm256_permute2f128_pd(v_lo, v_hi, 0x20));
+    _mm256_storeu_pd(out + 4, _mm256_permute2f128_pd(v_lo, v_hi, 0x31));
+  }
+
+  BuildFloatingPointsNative(&res[avx2_count], &plain[avx2_count * mod_size],
+                            threshold, decryption_modulus, inv_scale,
+                            mod_size, coeff_count - avx2_count);
+}
+
+#endif  // HEXL_HAS_AVX256
+
+}  // namespace hexl
+}  // namespace intel
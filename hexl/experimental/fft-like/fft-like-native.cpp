@@ -3,6 +3,7 @@
 
 #include "hexl/experimental/fft-like/fft-like-native.hpp"
 
+#include <cmath>
 #include <cstring>
 
 #include "hexl/logging/logging.hpp"
@@ -419,5 +420,139 @@ void Inverse_FFTLike_FromBitReverseRadix2(
   }
 }
 
+void Forward_FFTLike_ToBitReverseBatchRadix2(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* root_of_unity_powers, const uint64_t n,
+    uint64_t batch_count, uint64_t batch_stride, const double* scalar) {
+  HEXL_CHECK(IsPowerOfTwo(n), "degree " << n << " is not a power of 2");
+  HEXL_CHECK(root_of_unity_powers != nullptr,
+             "root_of_unity_powers == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(batch_count <= batch_stride,
+             "batch_count " << batch_count << " exceeds batch_stride "
+                            << batch_stride);
+
+  if (result != operand) {
+    CopyFFTLikeBatch(result, operand, n, batch_count, batch_stride);
+  }
+
+  size_t gap = (n >> 1);
+  for (size_t m = 1; m < n; m <<= 1, gap >>= 1) {
+    // The scalar is folded into the last stage
+    const bool scale_stage = (scalar != nullptr) && (gap == 1);
+    for (size_t i = 0; i < m; i++) {
+      std::complex<double> W = root_of_unity_powers[m + i];
+      if (scale_stage) {
+        W = *scalar * W;
+      }
+      std::complex<double>* X_r = result + 2 * i * gap * batch_stride;
+      for (size_t j = 0; j < gap; j++, X_r += batch_stride) {
+        std::complex<double>* Y_r = X_r + gap * batch_stride;
+        for (size_t b = 0; b < batch_count; b++) {
+          if (scale_stage) {
+            X_r[b] = *scalar * X_r[b];
+          }
+          ComplexFwdButterflyRadix2(&X_r[b], &Y_r[b], &X_r[b], &Y_r[b], W);
+        }
+      }
+    }
+  }
+}
+
+void Inverse_FFTLike_FromBitReverseBatchRadix2(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* inv_root_of_unity_powers, const uint64_t n,
+    uint64_t batch_count, uint64_t batch_stride, const double* scalar) {
+  HEXL_CHECK(IsPowerOfTwo(n), "degree " << n << " is not a power of 2");
+  HEXL_CHECK(inv_root_of_unity_powers != nullptr,
+             "inv_root_of_unity_powers == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(batch_count <= batch_stride,
+             "batch_count " << batch_count << " exceeds batch_stride "
+                            << batch_stride);
+
+  if (result != operand) {
+    CopyFFTLikeBatch(result, operand, n, batch_count, batch_stride);
+  }
+
+  size_t gap = 1;
+  size_t root_index = 1;
+  for (size_t m = (n >> 1); m > 0; m >>= 1, gap <<= 1) {
+    // The scalar is folded into the last stage
+    const bool scale_stage = (scalar != nullptr) && (m == 1);
+    for (size_t i = 0; i < m; i++, root_index++) {
+      std::complex<double> W = inv_root_of_unity_powers[root_index];
+      if (scale_stage) {
+        W = *scalar * W;
+      }
+      std::complex<double>* X_r = result + 2 * i * gap * batch_stride;
+      for (size_t j = 0; j < gap; j++, X_r += batch_stride) {
+        std::complex<double>* Y_r = X_r + gap * batch_stride;
+        if (scale_stage) {
+          for (size_t b = 0; b < batch_count; b++) {
+            ScaledComplexInvButterflyRadix2(&X_r[b], &Y_r[b], &X_r[b],
+                                            &Y_r[b], W, scalar);
+          }
+        } else {
+          for (size_t b = 0; b < batch_count; b++) {
+            ComplexInvButterflyRadix2(&X_r[b], &Y_r[b], &X_r[b], &Y_r[b], W);
+          }
+        }
+      }
+    }
+  }
+}
+
+void CopyFFTLikeBatch(std::complex<double>* result,
+                      const std::complex<double>* operand, const uint64_t n,
+                      uint64_t batch_count, uint64_t batch_stride) {
+  for (size_t k = 0; k < n; k++) {
+    std::memcpy(&result[k * batch_stride], &operand[k * batch_stride],
+                batch_count * sizeof(std::complex<double>));
+  }
+}
+
+void BuildFloatingPointsNative(std::complex<double>* res, const uint64_t* plain,
+                               const uint64_t* threshold,
+                               const uint64_t* decryption_modulus,
+                               const double inv_scale, size_t mod_size,
+                               size_t coeff_count) {
+  for (size_t i = 0; i < coeff_count; ++i) {
+    const uint64_t* coeff = &plain[i * mod_size];
+
+    // Compares with the threshold from the most significant word
+    bool negative = true;
+    for (size_t j = mod_size; j-- > 0;) {
+      if (coeff[j] != threshold[j]) {
+        negative = coeff[j] > threshold[j];
+        break;
+      }
+    }
+
+    // Adds |coeff| or |coeff - decryption_modulus| word by word; the words of
+    // the difference are computed with borrow propagation
+    double value = 0.0;
+    uint64_t borrow = 0;
+    for (size_t j = 0; j < mod_size; ++j) {
+      uint64_t word = coeff[j];
+      if (negative) {
+        uint64_t diff = decryption_modulus[j] - word;
+        uint64_t next_borrow =
+            (decryption_modulus[j] < word) || (diff < borrow) ? 1 : 0;
+        word = diff - borrow;
+        borrow = next_borrow;
+      }
+      // Skips zero words, whose scale 2^(64 j) may overflow to infinity
+      if (word != 0) {
+        value += std::ldexp(static_cast<double>(word) * inv_scale,
+                            static_cast<int>(64 * j));
+      }
+    }
+    res[i] = std::complex<double>(negative ? -value : value, 0.0);
+  }
+}
+
 }  // namespace hexl
 }  // namespace intel
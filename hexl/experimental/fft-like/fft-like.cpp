@@ -3,8 +3,13 @@
 
 #include "hexl/experimental/fft-like/fft-like.hpp"
 
+#include <algorithm>
+
+#include "hexl/experimental/fft-like/fft-like-avx2.hpp"
 #include "hexl/experimental/fft-like/fft-like-native.hpp"
 #include "hexl/logging/logging.hpp"
+#include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
 
 namespace intel {
 namespace hexl {
@@ -133,28 +138,148 @@ void FFTLike::ComputeInverseFFTLike(std::complex<double>* result,
 #endif
 }
 
+namespace {
+
+// Calls transform(begin, count) on tiles of the batch, with begin a multiple
+// of 4, the width of the AVX512 kernels
+template <typename TransformFunc>
+void ForEachBatchTile(uint64_t degree, uint64_t batch_size,
+                      const ExecutionPolicy& policy, TransformFunc transform) {
+  // Vectors transformed at a time by each thread, so a tile stays in cache
+  // across the stages
+  const uint64_t tile_size = std::max<uint64_t>(
+      4, GetTileBytes() / (degree * sizeof(std::complex<double>)) / 4 * 4);
+  const uint64_t num_blocks = (batch_size + 3) / 4;
+  auto transform_range = [&](uint64_t begin, uint64_t end) {
+    const uint64_t last = std::min<uint64_t>(end * 4, batch_size);
+    for (uint64_t tile_begin = begin * 4; tile_begin < last;
+         tile_begin += tile_size) {
+      transform(tile_begin, std::min(tile_size, last - tile_begin));
+    }
+  };
+  // Each item is a block of 4 vectors of degree complex values
+  ParallelFor(num_blocks, policy, transform_range, 8 * degree);
+}
+
+}  // namespace
+
+void FFTLike::ComputeForwardFFTLikeBatch(std::complex<double>* result,
+                                         const std::complex<double>* operand,
+                                         uint64_t batch_size,
+                                         const double* in_scale,
+                                         const ExecutionPolicy& policy) {
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+
+  const double* out_scale = nullptr;
+  if (scalar != nullptr) {
+    out_scale = &inv_scale;
+  } else if (in_scale != nullptr) {
+    out_scale = in_scale;
+  }
+
+  ForEachBatchTile(
+      m_degree, batch_size, policy, [&](uint64_t begin, uint64_t count) {
+#ifdef HEXL_HAS_AVX512DQ
+        if (has_avx512dq) {
+          HEXL_VLOG(3, "Calling 64-bit AVX512-DQ FwdFFTLikeBatch");
+          Forward_FFTLike_ToBitReverseBatchAVX512(
+              result + begin, operand + begin, m_complex_roots_of_unity.data(),
+              m_degree, count, batch_size, out_scale);
+          return;
+        }
+#endif
+        HEXL_VLOG(3, "Calling Native FwdFFTLikeBatch");
+        Forward_FFTLike_ToBitReverseBatchRadix2(
+            result + begin, operand + begin, m_complex_roots_of_unity.data(),
+            m_degree, count, batch_size, out_scale);
+      });
+}
+
+void FFTLike::ComputeInverseFFTLikeBatch(std::complex<double>* result,
+                                         const std::complex<double>* operand,
+                                         uint64_t batch_size,
+                                         const double* in_scale,
+                                         const ExecutionPolicy& policy) {
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+
+  const double* out_scale = nullptr;
+  if (scalar != nullptr) {
+    out_scale = &scale;
+  } else if (in_scale != nullptr) {
+    out_scale = in_scale;
+  }
+
+  ForEachBatchTile(
+      m_degree, batch_size, policy, [&](uint64_t begin, uint64_t count) {
+#ifdef HEXL_HAS_AVX512DQ
+        if (has_avx512dq) {
+          HEXL_VLOG(3, "Calling 64-bit AVX512-DQ InvFFTLikeBatch");
+          Inverse_FFTLike_FromBitReverseBatchAVX512(
+              result + begin, operand + begin,
+              m_inv_complex_roots_of_unity.data(), m_degree, count,
+              batch_size, out_scale);
+          return;
+        }
+#endif
+        HEXL_VLOG(3, "Calling Native InvFFTLikeBatch");
+        Inverse_FFTLike_FromBitReverseBatchRadix2(
+            result + begin, operand + begin,
+            m_inv_complex_roots_of_unity.data(), m_degree, count, batch_size,
+            out_scale);
+      });
+}
+
 void FFTLike::BuildFloatingPoints(std::complex<double>* res,
                                   const uint64_t* plain,
                                   const uint64_t* threshold,
                                   const uint64_t* decryption_modulus,
                                   const double in_inv_scale, size_t mod_size,
-                                  size_t coeff_count) {
-  HEXL_UNUSED(res);
-  HEXL_UNUSED(plain);
-  HEXL_UNUSED(threshold);
-  HEXL_UNUSED(decryption_modulus);
-  HEXL_UNUSED(in_inv_scale);
-  HEXL_UNUSED(mod_size);
-  HEXL_UNUSED(coeff_count);
+                                  size_t coeff_count,
+                                  const ExecutionPolicy& policy) {
+  HEXL_CHECK(res != nullptr, "res == nullptr");
+  HEXL_CHECK(plain != nullptr, "plain == nullptr");
+  HEXL_CHECK(threshold != nullptr, "threshold == nullptr");
+  HEXL_CHECK(decryption_modulus != nullptr, "decryption_modulus == nullptr");
+  HEXL_CHECK(mod_size != 0, "mod_size == 0");
 
+  // Each item is a block of 8 coefficients, the width of the AVX512 kernel
+  const uint64_t num_blocks = (coeff_count + 7) / 8;
+  auto build_range = [&](uint64_t begin, uint64_t end) {
+    const uint64_t first = begin * 8;
+    const uint64_t last = std::min<uint64_t>(end * 8, coeff_count);
 #ifdef HEXL_HAS_AVX512DQ
-  HEXL_VLOG(3, "Calling 64-bit AVX512-DQ BuildFloatingPoints");
-
-  BuildFloatingPointsAVX512(&(reinterpret_cast<double(&)[2]>(res[0]))[0], plain,
-                            threshold, decryption_modulus, in_inv_scale,
-                            mod_size, coeff_count);
-  return;
+    if (has_avx512dq) {
+      HEXL_VLOG(3, "Calling 64-bit AVX512-DQ BuildFloatingPoints");
+      const uint64_t avx512_count = (last - first) / 8 * 8;
+      BuildFloatingPointsAVX512(
+          &(reinterpret_cast<double(&)[2]>(res[first]))[0],
+          &plain[first * mod_size], threshold, decryption_modulus,
+          in_inv_scale, mod_size, avx512_count);
+      BuildFloatingPointsNative(
+          &res[first + avx512_count], &plain[(first + avx512_count) * mod_size],
+          threshold, decryption_modulus, in_inv_scale, mod_size,
+          last - first - avx512_count);
+      return;
+    }
 #endif
+#ifdef HEXL_HAS_AVX256
+    if (has_avx2) {
+      HEXL_VLOG(3, "Calling 64-bit AVX2 BuildFloatingPoints");
+      BuildFloatingPointsAVX2(&res[first], &plain[first * mod_size], threshold,
+                              decryption_modulus, in_inv_scale, mod_size,
+                              last - first);
+      return;
+    }
+#endif
+    HEXL_VLOG(3, "Calling Native BuildFloatingPoints");
+    BuildFloatingPointsNative(&res[first], &plain[first * mod_size], threshold,
+                              decryption_modulus, in_inv_scale, mod_size,
+                              last - first);
+  };
+
+  ParallelFor(num_blocks, policy, build_range, 8 * mod_size);
 }
 
 }  // namespace hexl
@@ -3,6 +3,7 @@
 #include "hexl/experimental/fft-like/inv-fft-like-avx512.hpp"
 
 #include "hexl/experimental/fft-like/fft-like-avx512-util.hpp"
+#include "hexl/experimental/fft-like/fft-like-native.hpp"
 #include "hexl/logging/logging.hpp"
 
 namespace intel {
@@ -405,6 +406,63 @@ void Inverse_FFTLike_FromBitReverseAVX512(
   }
 }
 
+void Inverse_FFTLike_FromBitReverseBatchAVX512(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* inv_root_of_unity_powers, const uint64_t n,
+    uint64_t batch_count, uint64_t batch_stride, const double* scale) {
+  HEXL_CHECK(IsPowerOfTwo(n), "n " << n << " is not a power of 2");
+
+  const uint64_t batch_tail = batch_count % 4;
+  batch_count -= batch_tail;
+  if (batch_tail != 0) {
+    Inverse_FFTLike_FromBitReverseBatchRadix2(
+        result + batch_count, operand + batch_count, inv_root_of_unity_powers,
+        n, batch_tail, batch_stride, scale);
+  }
+  if (batch_count == 0) {
+    return;
+  }
+  if (result != operand) {
+    CopyFFTLikeBatch(result, operand, n, batch_count, batch_stride);
+  }
+
+  __m512d v_scale = _mm512_set1_pd(scale != nullptr ? *scale : 1.0);
+  size_t gap = 1;
+  size_t root_index = 1;
+  for (size_t m = (n >> 1); m > 0; m >>= 1, gap <<= 1) {
+    // The scale is folded into the last stage
+    const bool scale_stage = (scale != nullptr) && (m == 1);
+    for (size_t i = 0; i < m; i++, root_index++) {
+      std::complex<double> W = inv_root_of_unity_powers[root_index];
+      if (scale_stage) {
+        W = *scale * W;
+      }
+      __m512d v_W_real;
+      __m512d v_W_imag;
+      ComplexLoadBroadcast(W, &v_W_real, &v_W_imag);
+
+      double* X_r =
+          reinterpret_cast<double*>(result + 2 * i * gap * batch_stride);
+      for (size_t j = 0; j < gap; j++, X_r += 2 * batch_stride) {
+        double* Y_r = X_r + 2 * gap * batch_stride;
+        for (size_t b = 0; b < 2 * batch_count; b += 8) {
+          __m512d v_U = _mm512_loadu_pd(&X_r[b]);
+          __m512d v_Y = _mm512_loadu_pd(&Y_r[b]);
+          // X = U + Y, Y = (U - Y) * W
+          __m512d v_X = _mm512_add_pd(v_U, v_Y);
+          if (scale_stage) {
+            v_X = _mm512_mul_pd(v_X, v_scale);
+          }
+          _mm512_storeu_pd(&X_r[b], v_X);
+          _mm512_storeu_pd(&Y_r[b],
+                           ComplexMulBroadcast(_mm512_sub_pd(v_U, v_Y),
+                                               v_W_real, v_W_imag));
+        }
+      }
+    }
+  }
+}
+
 #endif  // HEXL_HAS_AVX512DQ
 
 }  // namespace hexl
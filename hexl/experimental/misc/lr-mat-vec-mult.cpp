@@ -3,14 +3,17 @@
 
 #include "hexl/experimental/misc/lr-mat-vec-mult.hpp"
 
+#include <algorithm>
 #include <cstring>
 
+#include "eltwise/eltwise-lazy-accumulate-internal.hpp"
 #include "hexl/eltwise/eltwise-add-mod.hpp"
 #include "hexl/eltwise/eltwise-mult-mod.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "hexl/util/aligned-allocator.hpp"
 #include "hexl/util/check.hpp"
 #include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
 
 namespace intel {
 namespace hexl {
@@ -25,7 +28,8 @@ namespace hexl {
 void LinRegMatrixVectorMultiply(uint64_t* result, const uint64_t* operand1,
                                 const uint64_t* operand2, uint64_t n,
                                 const uint64_t* moduli, uint64_t num_moduli,
-                                uint64_t num_weights) {
+                                uint64_t num_weights,
+                                const ExecutionPolicy& policy) {
   HEXL_CHECK(result != nullptr, "Require result != nullptr");
   HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
   HEXL_CHECK(operand2 != nullptr, "Require operand2 != nullptr");
@@ -42,16 +46,21 @@ void LinRegMatrixVectorMultiply(uint64_t* result, const uint64_t* operand1,
   // ciphertext output increment to switch to the next output
   size_t output_size = 3 * poly_size;
 
-  AlignedVector64<uint64_t> temp(n, 0);
+  // Each (weight, modulus) product is independent, so split them across
+  // threads, each with its own temporary buffer
+  auto multiply_rows = [&](uint64_t begin, uint64_t end) {
+    AlignedVector64<uint64_t> temp(n, 0);
 
-  for (size_t r = 0; r < num_weights; r++) {
-    size_t next_output = r * output_size;
-    size_t next_poly_pair = r * cipher_size;
-    uint64_t* cipher2 = result + next_output;
-    const uint64_t* cipher0 = operand1 + next_poly_pair;
-    const uint64_t* cipher1 = operand2 + next_poly_pair;
+    for (uint64_t item = begin; item < end; ++item) {
+      size_t r = item / num_moduli;
+      size_t i = item % num_moduli;
+
+      size_t next_output = r * output_size;
+      size_t next_poly_pair = r * cipher_size;
+      uint64_t* cipher2 = result + next_output;
+      const uint64_t* cipher0 = operand1 + next_poly_pair;
+      const uint64_t* cipher1 = operand2 + next_poly_pair;
 
-    for (size_t i = 0; i < num_moduli; i++) {
       size_t i_times_n = i * n;
       size_t poly0_offset = i_times_n;
       size_t poly1_offset = poly0_offset + poly_size;
@@ -86,7 +95,8 @@ void LinRegMatrixVectorMultiply(uint64_t* result, const uint64_t* operand1,
                                   cipher0 + poly0_offset,
                                   cipher1 + poly0_offset, n, moduli[i], 1);
     }
-  }
+  };
+  ParallelFor(num_weights * num_moduli, policy, multiply_rows, n);
 
   const bool USE_ADDER_TREE = true;
   if (USE_ADDER_TREE) {
@@ -94,20 +104,23 @@ void LinRegMatrixVectorMultiply(uint64_t* result, const uint64_t* operand1,
     for (size_t dist = 1; dist < num_weights; dist += dist) {
       size_t step = dist * 2;
       size_t neighbor_cipher_incr = dist * output_size;
-      // This loop can leverage parallelism using #pragma unroll
-      for (size_t s = 0; s < num_weights; s += step) {
-        size_t next_cipher_pair_incr = s * output_size;
-        uint64_t* left_cipher = result + next_cipher_pair_incr;
-        uint64_t* right_cipher = left_cipher + neighbor_cipher_incr;
-
-        // This loop can leverage parallelism using #pragma unroll
-        for (size_t i = 0; i < num_moduli; i++) {
+      size_t num_pairs = (num_weights - dist + step - 1) / step;
+
+      // All additions within one level of the tree are independent
+      auto add_pairs = [&](uint64_t begin, uint64_t end) {
+        for (uint64_t item = begin; item < end; ++item) {
+          size_t s = (item / num_moduli) * step;
+          size_t i = item % num_moduli;
+
+          size_t next_cipher_pair_incr = s * output_size;
+          uint64_t* left_cipher = result + next_cipher_pair_incr;
+          uint64_t* right_cipher = left_cipher + neighbor_cipher_incr;
+
           size_t i_times_n = i * n;
           size_t poly0_offset = i_times_n;
           size_t poly1_offset = poly0_offset + poly_size;
           size_t poly2_offset = poly0_offset + 2 * poly_size;
 
-          // All EltwiseAddMod below can run in parallel
           intel::hexl::EltwiseAddMod(left_cipher + poly0_offset,
                                      right_cipher + poly0_offset,
                                      left_cipher + poly0_offset, n, moduli[i]);
@@ -118,7 +131,8 @@ void LinRegMatrixVectorMultiply(uint64_t* result, const uint64_t* operand1,
                                      right_cipher + poly2_offset,
                                      left_cipher + poly2_offset, n, moduli[i]);
         }
-      }
+      };
+      ParallelFor(num_pairs * num_moduli, policy, add_pairs, 3 * n);
     }
   } else {
     // Accumulate all rows in sequence
@@ -145,5 +159,88 @@ void LinRegMatrixVectorMultiply(uint64_t* result, const uint64_t* operand1,
   }
 }
 
+void LinRegMatrixVectorMultiplyStreaming(uint64_t* result,
+                                         const uint64_t* operand1,
+                                         const uint64_t* operand2, uint64_t n,
+                                         const uint64_t* moduli,
+                                         uint64_t num_moduli,
+                                         uint64_t num_weights,
+                                         const ExecutionPolicy& policy) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
+  HEXL_CHECK(operand2 != nullptr, "Require operand2 != nullptr");
+  HEXL_CHECK(moduli != nullptr, "Require moduli != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(num_weights != 0, "Require num_weights != 0");
+
+  // pointer increment to switch to a next polynomial
+  size_t poly_size = n * num_moduli;
+
+  // ciphertext increment to switch to the next ciphertext
+  size_t cipher_size = 2 * poly_size;
+
+  // A tile of the 4 input polynomials of a weight and of the 3 accumulators,
+  // each of two words, fits into cache
+  const size_t tile_size = GetTileSize(10 * sizeof(uint64_t), n);
+  const size_t num_tiles = (n + tile_size - 1) / tile_size;
+
+  // Each (modulus, tile) pair is independent, so split them across threads,
+  // each with its own accumulators
+  auto multiply_tiles = [&](uint64_t begin, uint64_t end) {
+    AlignedVector64<uint64_t> acc(6 * tile_size);
+    uint64_t* acc_hi[3] = {&acc[0], &acc[tile_size], &acc[2 * tile_size]};
+    uint64_t* acc_lo[3] = {&acc[3 * tile_size], &acc[4 * tile_size],
+                           &acc[5 * tile_size]};
+
+    for (uint64_t item = begin; item < end; ++item) {
+      size_t i = item / num_tiles;
+      size_t tile = item % num_tiles;
+      const uint64_t modulus = moduli[i];
+      size_t poly0_offset = i * n + tile_size * tile;
+      size_t tile_length = std::min(tile_size, n - tile_size * tile);
+
+      const LazyAccumulateKernels kernels(modulus);
+      auto accumulate = kernels.accumulate;
+      auto reduce = kernels.reduce;
+      // Each weight adds two products to the second accumulator
+      const uint64_t lazy_weights = kernels.max_products / 2;
+
+      for (size_t k = 0; k < 3; ++k) {
+        std::fill(acc_hi[k], acc_hi[k] + tile_length, 0);
+        std::fill(acc_lo[k], acc_lo[k] + tile_length, 0);
+      }
+
+      // Output ciphertext has 3 polynomials, where x, y are the input
+      // ciphertexts: (sum x[0] * y[0], sum x[0] * y[1] + x[1] * y[0],
+      // sum x[1] * y[1]) over the weights
+      for (size_t r = 0; r < num_weights; ++r) {
+        // Reduce the accumulators before they overflow
+        if (r != 0 && r % lazy_weights == 0) {
+          for (size_t k = 0; k < 3; ++k) {
+            reduce(acc_lo[k], acc_hi[k], acc_lo[k], tile_length, modulus);
+            std::fill(acc_hi[k], acc_hi[k] + tile_length, 0);
+          }
+        }
+
+        const uint64_t* x0 = operand1 + r * cipher_size + poly0_offset;
+        const uint64_t* y0 = operand2 + r * cipher_size + poly0_offset;
+        const uint64_t* x1 = x0 + poly_size;
+        const uint64_t* y1 = y0 + poly_size;
+        accumulate(acc_hi[0], acc_lo[0], x0, y0, tile_length);
+        accumulate(acc_hi[1], acc_lo[1], x0, y1, tile_length);
+        accumulate(acc_hi[1], acc_lo[1], x1, y0, tile_length);
+        accumulate(acc_hi[2], acc_lo[2], x1, y1, tile_length);
+      }
+
+      for (size_t k = 0; k < 3; ++k) {
+        reduce(result + poly0_offset + k * poly_size, acc_hi[k], acc_lo[k],
+               tile_length, modulus);
+      }
+    }
+  };
+  ParallelFor(num_moduli * num_tiles, policy, multiply_tiles,
+              num_weights * tile_size);
+}
+
 }  // namespace hexl
 }  // namespace intel
@@ -0,0 +1,155 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/experimental/misc/plain-mat-vec-mult.hpp"
+
+#include <algorithm>
+
+#include "eltwise/eltwise-lazy-accumulate-internal.hpp"
+#include "hexl/eltwise/eltwise-apply-galois.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "hexl/util/check.hpp"
+#include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Sets result[j] = sum_i diagonals[j * num_terms + i] * operands[i], for i in
+// [0, num_terms) and j in [0, num_outputs), one component of the ciphertexts
+// at a time
+void MultiplyAccumulateDiagonals(uint64_t* result, const uint64_t* diagonals,
+                                 const uint64_t* const* operands, uint64_t n,
+                                 const uint64_t* moduli, uint64_t num_moduli,
+                                 uint64_t ciphertext_size, uint64_t num_terms,
+                                 uint64_t num_outputs,
+                                 const ExecutionPolicy& policy) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(diagonals != nullptr, "Require diagonals != nullptr");
+  HEXL_CHECK(operands != nullptr, "Require operands != nullptr");
+  HEXL_CHECK(moduli != nullptr, "Require moduli != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(ciphertext_size != 0, "Require ciphertext_size != 0");
+  HEXL_CHECK(num_terms != 0, "Require num_terms != 0");
+
+  // pointer increment to switch to a next polynomial
+  size_t poly_size = n * num_moduli;
+
+  // ciphertext increment to switch to the next ciphertext
+  size_t cipher_size = ciphertext_size * poly_size;
+
+  // A tile of the operands, reused by each output, of a diagonal and of the
+  // accumulators, each of two words, fits into cache
+  const size_t tile_size = GetTileSize(
+      sizeof(uint64_t) * ((num_terms + 2) * ciphertext_size + 1), n);
+  const size_t num_tiles = (n + tile_size - 1) / tile_size;
+
+  // Each (modulus, tile) pair is independent, so split them across threads,
+  // each with its own accumulators
+  auto multiply_tiles = [&](uint64_t begin, uint64_t end) {
+    AlignedVector64<uint64_t> acc(2 * ciphertext_size * tile_size);
+    uint64_t* acc_hi = &acc[0];
+    uint64_t* acc_lo = &acc[ciphertext_size * tile_size];
+
+    for (uint64_t item = begin; item < end; ++item) {
+      size_t i = item / num_tiles;
+      size_t tile = item % num_tiles;
+      const uint64_t modulus = moduli[i];
+      size_t poly0_offset = i * n + tile_size * tile;
+      size_t tile_length = std::min(tile_size, n - tile_size * tile);
+
+      const LazyAccumulateKernels kernels(modulus);
+      // Each diagonal adds one product to each accumulator
+      const uint64_t lazy_terms = kernels.max_products;
+
+      for (size_t j = 0; j < num_outputs; ++j) {
+        std::fill(acc.begin(), acc.end(), 0);
+        for (size_t t = 0; t < num_terms; ++t) {
+          // Reduce the accumulators before they overflow
+          if (t != 0 && t % lazy_terms == 0) {
+            for (size_t k = 0; k < ciphertext_size; ++k) {
+              kernels.reduce(&acc_lo[k * tile_size], &acc_hi[k * tile_size],
+                             &acc_lo[k * tile_size], tile_length, modulus);
+              std::fill(&acc_hi[k * tile_size],
+                        &acc_hi[k * tile_size] + tile_length, 0);
+            }
+          }
+
+          const uint64_t* diagonal =
+              diagonals + (j * num_terms + t) * poly_size + poly0_offset;
+          for (size_t k = 0; k < ciphertext_size; ++k) {
+            kernels.accumulate(&acc_hi[k * tile_size], &acc_lo[k * tile_size],
+                               diagonal,
+                               operands[t] + k * poly_size + poly0_offset,
+                               tile_length);
+          }
+        }
+
+        uint64_t* cipher = result + j * cipher_size;
+        for (size_t k = 0; k < ciphertext_size; ++k) {
+          kernels.reduce(cipher + k * poly_size + poly0_offset,
+                         &acc_hi[k * tile_size], &acc_lo[k * tile_size],
+                         tile_length, modulus);
+        }
+      }
+    }
+  };
+  ParallelFor(num_moduli * num_tiles, policy, multiply_tiles,
+              num_outputs * num_terms * ciphertext_size * tile_size);
+}
+
+}  // namespace
+
+void PlainMatrixVectorMultiplyDiagonal(uint64_t* result,
+                                       const uint64_t* diagonals,
+                                       const uint64_t* const* rotated_operands,
+                                       uint64_t n, const uint64_t* moduli,
+                                       uint64_t num_moduli,
+                                       uint64_t ciphertext_size,
+                                       uint64_t num_diagonals,
+                                       const ExecutionPolicy& policy) {
+  HEXL_CHECK(num_diagonals != 0, "Require num_diagonals != 0");
+  MultiplyAccumulateDiagonals(result, diagonals, rotated_operands, n, moduli,
+                              num_moduli, ciphertext_size, num_diagonals, 1,
+                              policy);
+}
+
+void PlainMatrixVectorMultiplyBSGS(uint64_t* result, const uint64_t* diagonals,
+                                   const uint64_t* const* rotated_operands,
+                                   uint64_t n, const uint64_t* moduli,
+                                   uint64_t num_moduli,
+                                   uint64_t ciphertext_size,
+                                   uint64_t baby_steps, uint64_t giant_steps,
+                                   const ExecutionPolicy& policy) {
+  HEXL_CHECK(baby_steps != 0, "Require baby_steps != 0");
+  HEXL_CHECK(giant_steps != 0, "Require giant_steps != 0");
+  MultiplyAccumulateDiagonals(result, diagonals, rotated_operands, n, moduli,
+                              num_moduli, ciphertext_size, baby_steps,
+                              giant_steps, policy);
+}
+
+void RotateDiagonalsBSGS(uint64_t* result, const uint64_t* diagonals,
+                         uint64_t n, uint64_t num_moduli, uint64_t baby_steps,
+                         uint64_t giant_steps, const uint64_t* galois_elts,
+                         const ExecutionPolicy& policy) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(diagonals != nullptr, "Require diagonals != nullptr");
+  HEXL_CHECK(galois_elts != nullptr, "Require galois_elts != nullptr");
+  HEXL_CHECK(result != diagonals, "result must not alias diagonals");
+
+  // Each residue polynomial of each diagonal is permuted independently
+  const uint64_t num_polys = giant_steps * baby_steps * num_moduli;
+  auto rotate_range = [&](uint64_t begin, uint64_t end) {
+    for (uint64_t poly = begin; poly < end; ++poly) {
+      uint64_t j = poly / (baby_steps * num_moduli);
+      EltwiseApplyGaloisNTT(&result[poly * n], &diagonals[poly * n], n,
+                            galois_elts[j]);
+    }
+  };
+  ParallelFor(num_polys, policy, rotate_range, n);
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,83 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <immintrin.h>
+
+#include <algorithm>
+
+#include "experimental/seal/base-convert-internal.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/defines.hpp"
+#include "util/avx512-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512IFMA
+
+void FastBaseConvertAVX512IFMA(uint64_t* result, uint64_t result_stride,
+                               const uint64_t* scaled_operand,
+                               uint64_t operand_stride, uint64_t n,
+                               uint64_t num_from_moduli,
+                               const uint64_t* to_moduli,
+                               uint64_t num_to_moduli,
+                               const uint64_t* q_hat_mod_p,
+                               const uint64_t* q_hat_mod_p_precon52) {
+  // Number of 8-lane vectors accumulated at once, reusing each broadcast
+  // q_hat_mod_p
+  constexpr uint64_t unroll = 4;
+  const uint64_t n_vec = n / 8 * 8;
+
+  for (uint64_t j = 0; j < num_to_moduli; ++j) {
+    const uint64_t p = to_moduli[j];
+    const uint64_t* q_hat = &q_hat_mod_p[j * num_from_moduli];
+    const uint64_t* q_hat_precon = &q_hat_mod_p_precon52[j * num_from_moduli];
+    uint64_t* result_j = &result[j * result_stride];
+
+    __m512i v_p = _mm512_set1_epi64(static_cast<int64_t>(p));
+    __m512i v_neg_p = _mm512_set1_epi64(-static_cast<int64_t>(p));
+    __m512i v_barr = _mm512_set1_epi64(
+        static_cast<int64_t>(MultiplyFactor(1, 64, p).BarrettFactor()));
+
+    uint64_t m = 0;
+    while (m < n_vec) {
+      uint64_t num_vecs = std::min(unroll, (n_vec - m) / 8);
+      __m512i v_sum[unroll];
+      for (uint64_t v = 0; v < num_vecs; ++v) {
+        v_sum[v] = _mm512_setzero_si512();
+      }
+      for (uint64_t i = 0; i < num_from_moduli; ++i) {
+        __m512i v_q_hat = _mm512_set1_epi64(static_cast<int64_t>(q_hat[i]));
+        __m512i v_q_hat_precon =
+            _mm512_set1_epi64(static_cast<int64_t>(q_hat_precon[i]));
+        const uint64_t* operand = &scaled_operand[i * operand_stride + m];
+        for (uint64_t v = 0; v < num_vecs; ++v) {
+          __m512i v_op = _mm512_loadu_si512(operand + 8 * v);
+          // Shoup multiplication, with output in [0, 2p)
+          __m512i v_quot = _mm512_hexl_mulhi_epi<52>(v_op, v_q_hat_precon);
+          __m512i v_prod = _mm512_hexl_mullo_epi<52>(v_op, v_q_hat);
+          v_prod = _mm512_hexl_mullo_add_lo_epi<52>(v_prod, v_quot, v_neg_p);
+          v_sum[v] = _mm512_add_epi64(v_sum[v], v_prod);
+        }
+      }
+      for (uint64_t v = 0; v < num_vecs; ++v) {
+        __m512i v_result = _mm512_hexl_barrett_reduce64<64, 1>(
+            v_sum[v], v_p, v_barr, v_barr, 0, v_neg_p);
+        _mm512_storeu_si512(result_j + m + 8 * v, v_result);
+      }
+      m += 8 * num_vecs;
+    }
+  }
+
+  if (n_vec < n) {
+    FastBaseConvertNative(&result[n_vec], result_stride,
+                          &scaled_operand[n_vec], operand_stride, n - n_vec,
+                          num_from_moduli, 52, to_moduli, num_to_moduli,
+                          q_hat_mod_p);
+  }
+}
+
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,52 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include "hexl/util/defines.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Computes the sum over i of scaled_operand_i * q_hat_mod_p[j * k + i]
+/// mod p_j, for each of the num_to_moduli moduli p_j, accumulating lazily in
+/// 128-bit values
+/// @param[out] result Stores residue polynomial j at result + j *
+/// result_stride
+/// @param[in] scaled_operand Holds residue polynomial i, \f$ [x_i
+/// \hat{q}_i^{-1}]_{q_i} \f$, at scaled_operand + i * operand_stride
+/// @param[in] n Number of coefficients in each residue polynomial
+/// @param[in] num_from_moduli Number of input moduli k
+/// @param[in] from_bits Maximum number of bits in the scaled operand
+/// @param[in] to_moduli Output moduli p_j
+/// @param[in] num_to_moduli Number of output moduli
+/// @param[in] q_hat_mod_p Row-major num_to_moduli x k matrix of \f$ \hat{q}_i
+/// \bmod p_j \f$
+void FastBaseConvertNative(uint64_t* result, uint64_t result_stride,
+                           const uint64_t* scaled_operand,
+                           uint64_t operand_stride, uint64_t n,
+                           uint64_t num_from_moduli, uint64_t from_bits,
+                           const uint64_t* to_moduli, uint64_t num_to_moduli,
+                           const uint64_t* q_hat_mod_p);
+
+#ifdef HEXL_HAS_AVX512IFMA
+/// @brief AVX512-IFMA implementation of FastBaseConvertNative, accumulating
+/// lazily in 64-bit lanes
+/// @details Requires scaled_operand < 2^52, p_j < 2^50 and num_from_moduli <
+/// 2^12, so the sum of num_from_moduli products in [0, 2 p_j) fits in 64 bits
+/// @param[in] q_hat_mod_p_precon52 Barrett factors floor(2^52 * q_hat_mod_p /
+/// p_j)
+void FastBaseConvertAVX512IFMA(uint64_t* result, uint64_t result_stride,
+                               const uint64_t* scaled_operand,
+                               uint64_t operand_stride, uint64_t n,
+                               uint64_t num_from_moduli,
+                               const uint64_t* to_moduli,
+                               uint64_t num_to_moduli,
+                               const uint64_t* q_hat_mod_p,
+                               const uint64_t* q_hat_mod_p_precon52);
+#endif
+
+}  // namespace hexl
+}  // namespace intel
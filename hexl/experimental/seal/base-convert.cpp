@@ -0,0 +1,186 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/experimental/seal/base-convert.hpp"
+
+#include <algorithm>
+
+#include "experimental/seal/base-convert-internal.hpp"
+#include "hexl/eltwise/eltwise-fma-mod.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "hexl/util/check.hpp"
+#include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+uint64_t MaxBits(const std::vector<uint64_t>& moduli) {
+  return Log2(*std::max_element(moduli.begin(), moduli.end())) + 1;
+}
+
+}  // namespace
+
+BaseConverter::BaseConverter(const std::vector<uint64_t>& from_moduli,
+                             const std::vector<uint64_t>& to_moduli)
+    : m_from_moduli(from_moduli), m_to_moduli(to_moduli) {
+  HEXL_CHECK(!from_moduli.empty(), "Require from_moduli to be non-empty");
+  HEXL_CHECK(!to_moduli.empty(), "Require to_moduli to be non-empty");
+  for (uint64_t modulus : from_moduli) {
+    HEXL_CHECK(modulus > 1 && modulus < (1ULL << 61),
+               "Require 1 < modulus < 2^61, got " << modulus);
+    HEXL_UNUSED(modulus);
+  }
+  for (uint64_t modulus : to_moduli) {
+    HEXL_CHECK(modulus > 1 && modulus < (1ULL << 61),
+               "Require 1 < modulus < 2^61, got " << modulus);
+    HEXL_UNUSED(modulus);
+  }
+
+  size_t k = from_moduli.size();
+
+  // q_hat_i mod q_i, computed as a product of the other moduli
+  m_q_hat_inv_mod_q.resize(k);
+  for (size_t i = 0; i < k; ++i) {
+    uint64_t q_hat_mod_q = 1;
+    for (size_t m = 0; m < k; ++m) {
+      if (m != i) {
+        q_hat_mod_q =
+            MultiplyMod(q_hat_mod_q, from_moduli[m] % from_moduli[i],
+                        from_moduli[i]);
+      }
+    }
+    m_q_hat_inv_mod_q[i] = InverseMod(q_hat_mod_q, from_moduli[i]);
+  }
+
+  m_q_hat_mod_p.resize(to_moduli.size() * k);
+  m_q_hat_mod_p_precon52.resize(to_moduli.size() * k);
+  for (size_t j = 0; j < to_moduli.size(); ++j) {
+    uint64_t p = to_moduli[j];
+    for (size_t i = 0; i < k; ++i) {
+      uint64_t q_hat_mod_p = 1 % p;
+      for (size_t m = 0; m < k; ++m) {
+        if (m != i) {
+          q_hat_mod_p = MultiplyMod(q_hat_mod_p, from_moduli[m] % p, p);
+        }
+      }
+      m_q_hat_mod_p[j * k + i] = q_hat_mod_p;
+      if (p < (1ULL << 52)) {
+        m_q_hat_mod_p_precon52[j * k + i] =
+            MultiplyFactor(q_hat_mod_p, 52, p).BarrettFactor();
+      }
+    }
+  }
+}
+
+void BaseConverter::FastBaseConvert(uint64_t* result, const uint64_t* operand,
+                                    uint64_t n,
+                                    const ExecutionPolicy& policy) const {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand != nullptr, "Require operand != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(!m_from_moduli.empty(), "BaseConverter is not initialized");
+
+  const uint64_t k = m_from_moduli.size();
+  const uint64_t l = m_to_moduli.size();
+  for (uint64_t i = 0; i < k; ++i) {
+    HEXL_CHECK_BOUNDS(&operand[i * n], n, m_from_moduli[i],
+                      "operand exceeds bound " << m_from_moduli[i]);
+  }
+  const uint64_t from_bits = MaxBits(m_from_moduli);
+  const uint64_t to_bits = MaxBits(m_to_moduli);
+  HEXL_UNUSED(to_bits);
+
+  // Number of coefficients converted at a time, so the scaled operand stays in
+  // cache between the two passes
+  const uint64_t max_tile_size =
+      GetTileSize(sizeof(uint64_t) * (2 * k + l), n);
+
+  auto convert_range = [&](uint64_t begin, uint64_t end) {
+    AlignedVector64<uint64_t> scaled_operand(
+        k * std::min(max_tile_size, end - begin));
+    for (uint64_t tile_begin = begin; tile_begin < end;
+         tile_begin += max_tile_size) {
+      uint64_t tile_size = std::min(max_tile_size, end - tile_begin);
+
+      // [x_i * q_hat_i^{-1}]_{q_i}
+      for (uint64_t i = 0; i < k; ++i) {
+        EltwiseFMAMod(&scaled_operand[i * tile_size],
+                      &operand[i * n + tile_begin], m_q_hat_inv_mod_q[i],
+                      nullptr, tile_size, m_from_moduli[i], 1);
+      }
+
+#ifdef HEXL_HAS_AVX512IFMA
+      if (has_avx512ifma && from_bits <= 52 && to_bits <= 50 &&
+          k < (1ULL << 12)) {
+        HEXL_VLOG(3, "Calling FastBaseConvertAVX512IFMA");
+        FastBaseConvertAVX512IFMA(&result[tile_begin], n,
+                                  scaled_operand.data(), tile_size, tile_size,
+                                  k, m_to_moduli.data(), l,
+                                  m_q_hat_mod_p.data(),
+                                  m_q_hat_mod_p_precon52.data());
+        continue;
+      }
+#endif
+      HEXL_VLOG(3, "Calling FastBaseConvertNative");
+      FastBaseConvertNative(&result[tile_begin], n, scaled_operand.data(),
+                            tile_size, tile_size, k, from_bits,
+                            m_to_moduli.data(), l, m_q_hat_mod_p.data());
+    }
+  };
+
+  ParallelFor(n, policy, convert_range, k + l);
+}
+
+void FastBaseConvert(uint64_t* result, const uint64_t* operand,
+                     const std::vector<uint64_t>& from_moduli,
+                     const std::vector<uint64_t>& to_moduli, uint64_t n,
+                     const ExecutionPolicy& policy) {
+  BaseConverter(from_moduli, to_moduli)
+      .FastBaseConvert(result, operand, n, policy);
+}
+
+void FastBaseConvertNative(uint64_t* result, uint64_t result_stride,
+                           const uint64_t* scaled_operand,
+                           uint64_t operand_stride, uint64_t n,
+                           uint64_t num_from_moduli, uint64_t from_bits,
+                           const uint64_t* to_moduli, uint64_t num_to_moduli,
+                           const uint64_t* q_hat_mod_p) {
+  for (uint64_t j = 0; j < num_to_moduli; ++j) {
+    const uint64_t p = to_moduli[j];
+    const uint64_t* q_hat = &q_hat_mod_p[j * num_from_moduli];
+    uint64_t* result_j = &result[j * result_stride];
+
+    // Number of products below 2^{from_bits + to_bits} which may be added to
+    // a value below p without overflowing 128 bits
+    const uint64_t to_bits = Log2(p) + 1;
+    const uint64_t lazy_bits = 127 - from_bits - to_bits;
+    const uint64_t max_lazy_terms =
+        (lazy_bits >= 32) ? num_from_moduli : (1ULL << lazy_bits);
+
+    for (uint64_t m = 0; m < n; ++m) {
+      uint128_t sum = 0;
+      uint64_t i = 0;
+      while (true) {
+        uint64_t chunk_end = std::min(num_from_moduli, i + max_lazy_terms);
+        for (; i < chunk_end; ++i) {
+          sum += MultiplyUInt64(scaled_operand[i * operand_stride + m],
+                                q_hat[i]);
+        }
+        sum = BarrettReduce128(static_cast<uint64_t>(sum >> 64),
+                               static_cast<uint64_t>(sum), p);
+        if (i == num_from_moduli) {
+          break;
+        }
+      }
+      result_j[m] = static_cast<uint64_t>(sum);
+    }
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,82 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <immintrin.h>
+
+#include <vector>
+
+#include "experimental/seal/ckks-encode-internal.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/defines.hpp"
+#include "util/avx512-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+
+void CKKSRoundReduceAVX512(uint64_t* result, const std::complex<double>* values,
+                           uint64_t count, uint64_t stride,
+                           const uint64_t* moduli, uint64_t num_moduli) {
+  const uint64_t count_tail = count % 8;
+  if (count_tail != 0) {
+    CKKSRoundReduceNative(result, values, count_tail, stride, moduli,
+                          num_moduli);
+    result += count_tail;
+    values += count_tail;
+    count -= count_tail;
+  }
+
+  std::vector<uint64_t> barr_factors(num_moduli);
+  for (uint64_t j = 0; j < num_moduli; ++j) {
+    barr_factors[j] = MultiplyFactor(1, 64, moduli[j]).BarrettFactor();
+  }
+
+  const double* values_ptr = reinterpret_cast<const double*>(values);
+  // Selects the real parts out of two vectors of 4 interleaved complex values
+  const __m512i v_real_index = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+  const __m512d v_zero = _mm512_setzero_pd();
+  const __m512d v_half = _mm512_set1_pd(0.5);
+  const __m512d v_one = _mm512_set1_pd(1.0);
+  const __m512d v_two_pow_64 = _mm512_set1_pd(18446744073709551616.0);
+  const __m512i v_zero_epi64 = _mm512_setzero_si512();
+
+  for (uint64_t i = 0; i < count; i += 8) {
+    __m512d v_lo = _mm512_loadu_pd(&values_ptr[2 * i]);
+    __m512d v_hi = _mm512_loadu_pd(&values_ptr[2 * i + 8]);
+    __m512d v_real = _mm512_permutex2var_pd(v_lo, v_real_index, v_hi);
+
+    // Rounds |x| half away from zero; |x| - trunc(|x|) is exact
+    __mmask8 negative = _mm512_cmp_pd_mask(v_real, v_zero, _CMP_LT_OQ);
+    __m512d v_abs = _mm512_abs_pd(v_real);
+    __m512d v_trunc = _mm512_roundscale_pd(
+        v_abs, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __mmask8 round_up = _mm512_cmp_pd_mask(_mm512_sub_pd(v_abs, v_trunc),
+                                           v_half, _CMP_GE_OQ);
+    __m512d v_round = _mm512_mask_add_pd(v_trunc, round_up, v_trunc, v_one);
+
+    // Values of 2^64 or more don't fit into 64 bits
+    if (_mm512_cmp_pd_mask(v_round, v_two_pow_64, _CMP_NLT_UQ) != 0) {
+      CKKSRoundReduceNative(&result[i], &values[i], 8, stride, moduli,
+                            num_moduli);
+      continue;
+    }
+    __m512i v_coeff = _mm512_cvttpd_epu64(v_round);
+
+    for (uint64_t j = 0; j < num_moduli; ++j) {
+      __m512i v_modulus = _mm512_set1_epi64(static_cast<int64_t>(moduli[j]));
+      __m512i v_barr = _mm512_set1_epi64(static_cast<int64_t>(barr_factors[j]));
+      __m512i v_r = _mm512_hexl_barrett_reduce64<64, 1>(
+          v_coeff, v_modulus, v_barr, v_barr, 0, v_modulus);
+      __mmask8 negate =
+          negative & _mm512_cmpneq_epu64_mask(v_r, v_zero_epi64);
+      v_r = _mm512_mask_sub_epi64(v_r, negate, v_modulus, v_r);
+      _mm512_storeu_si512(&result[j * stride + i], v_r);
+    }
+  }
+}
+
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,54 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <complex>
+#include <vector>
+
+#include "hexl/util/defines.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Rounds the real part of each of the \p count values to the nearest
+/// integer, halfway cases away from zero, and stores it modulo each modulus
+/// @param[out] result Stores the residue of values[i] modulo moduli[j] at
+/// index j * \p stride + i
+/// @param[in] moduli Moduli, each less than 2^62
+void CKKSRoundReduceNative(uint64_t* result, const std::complex<double>* values,
+                           uint64_t count, uint64_t stride,
+                           const uint64_t* moduli, uint64_t num_moduli);
+
+/// @brief Composes the residues of \p count coefficients into integers modulo
+/// the product Q of the moduli
+/// @param[out] result Stores coefficient i as \p num_moduli words, least
+/// significant first, at index i * \p num_moduli
+/// @param[in] plain Holds the residue of coefficient i modulo moduli[j] at
+/// index j * \p stride + i
+/// @param[in] q_hat_inv_mod_q (Q / q_j)^{-1} mod q_j for each modulus
+/// @param[in] q_hat Q / q_j as \p num_moduli words at index j * \p num_moduli
+/// @param[in] decryption_modulus Q as \p num_moduli words
+void CKKSComposeNative(uint64_t* result, const uint64_t* plain, uint64_t count,
+                       uint64_t stride, const uint64_t* moduli,
+                       uint64_t num_moduli, const uint64_t* q_hat_inv_mod_q,
+                       const uint64_t* q_hat,
+                       const uint64_t* decryption_modulus);
+
+/// @brief Returns (Q + 1) / 2 for an odd Q, the smallest composed value
+/// decoded as negative
+/// @param[in] decryption_modulus Q as words, least significant first
+std::vector<uint64_t> CKKSComputeUpperHalfThreshold(
+    const std::vector<uint64_t>& decryption_modulus);
+
+#ifdef HEXL_HAS_AVX512DQ
+/// @brief AVX512-DQ implementation of CKKSRoundReduceNative
+void CKKSRoundReduceAVX512(uint64_t* result, const std::complex<double>* values,
+                           uint64_t count, uint64_t stride,
+                           const uint64_t* moduli, uint64_t num_moduli);
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,316 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/experimental/seal/ckks-encode.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "experimental/seal/ckks-encode-internal.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/ntt/ntt-cache.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "hexl/util/check.hpp"
+#include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Sets words = words * factor, with words holding num_words 64-bit words
+void MultiplyWords(uint64_t* words, uint64_t num_words, uint64_t factor) {
+  uint64_t carry = 0;
+  for (uint64_t w = 0; w < num_words; ++w) {
+    uint64_t prod_hi;
+    uint64_t prod_lo;
+    MultiplyUInt64(words[w], factor, &prod_hi, &prod_lo);
+    prod_hi += AddUInt64(prod_lo, carry, &words[w]);
+    carry = prod_hi;
+  }
+  HEXL_CHECK(carry == 0, "Product overflows " << num_words << " words");
+}
+
+// Returns true if x >= y, for x and y of num_words words each
+bool GreaterOrEqualWords(const uint64_t* x, const uint64_t* y,
+                         uint64_t num_words) {
+  for (uint64_t w = num_words; w-- > 0;) {
+    if (x[w] != y[w]) {
+      return x[w] > y[w];
+    }
+  }
+  return true;
+}
+
+// Sets x = x - y, for x >= y of num_words words each
+void SubtractWords(uint64_t* x, const uint64_t* y, uint64_t num_words) {
+  uint64_t borrow = 0;
+  for (uint64_t w = 0; w < num_words; ++w) {
+    uint64_t diff = x[w] - y[w];
+    uint64_t next_borrow = (x[w] < y[w]) || (diff < borrow) ? 1 : 0;
+    x[w] = diff - borrow;
+    borrow = next_borrow;
+  }
+}
+
+}  // namespace
+
+CKKSEncoder::CKKSEncoder(uint64_t n, const std::vector<uint64_t>& moduli)
+    : m_degree(n), m_moduli(moduli) {
+  HEXL_CHECK(IsPowerOfTwo(n), "Require n to be a power of 2, got " << n);
+  HEXL_CHECK(n > 8, "Require n > 8, got " << n);
+  HEXL_CHECK(!moduli.empty(), "Require moduli to be non-empty");
+  for (uint64_t modulus : moduli) {
+    HEXL_CHECK(modulus > 1 && modulus < (1ULL << 62),
+               "Require 1 < modulus < 2^62, got " << modulus);
+    HEXL_CHECK(modulus % (2 * n) == 1,
+               "Require modulus = 1 mod 2n, got " << modulus);
+    HEXL_UNUSED(modulus);
+  }
+
+  m_fft_like = std::make_shared<FFTLike>(n, nullptr);
+
+  // Slot i holds the evaluation at the primitive root to the power 3^i, and
+  // its conjugate the evaluation at the power -3^i, as in SEAL
+  const uint64_t log_n = Log2(n);
+  const uint64_t slots = n / 2;
+  const uint64_t m = 2 * n;
+  const uint64_t gen = 3;
+  uint64_t pos = 1;
+  m_slot_index_map.resize(n);
+  for (uint64_t i = 0; i < slots; ++i) {
+    m_slot_index_map[i] = ReverseBits((pos - 1) >> 1, log_n);
+    m_slot_index_map[slots + i] = ReverseBits((m - pos - 1) >> 1, log_n);
+    pos = (pos * gen) & (m - 1);
+  }
+
+  // Each modulus is below 2^62, so the product fits into k words
+  const uint64_t k = moduli.size();
+  m_decryption_modulus.assign(k, 0);
+  m_decryption_modulus[0] = 1;
+  m_q_hat.assign(k * k, 0);
+  m_q_hat_inv_mod_q.resize(k);
+  for (uint64_t i = 0; i < k; ++i) {
+    MultiplyWords(m_decryption_modulus.data(), k, moduli[i]);
+
+    uint64_t* q_hat = &m_q_hat[i * k];
+    q_hat[0] = 1;
+    uint64_t q_hat_mod_q = 1;
+    for (uint64_t j = 0; j < k; ++j) {
+      if (j != i) {
+        MultiplyWords(q_hat, k, moduli[j]);
+        q_hat_mod_q = MultiplyMod(q_hat_mod_q, moduli[j] % moduli[i],
+                                  moduli[i]);
+      }
+    }
+    m_q_hat_inv_mod_q[i] = InverseMod(q_hat_mod_q, moduli[i]);
+  }
+
+  m_upper_half_threshold = CKKSComputeUpperHalfThreshold(m_decryption_modulus);
+}
+
+void CKKSEncoder::Encode(uint64_t* result, const std::complex<double>* values,
+                         uint64_t num_values, double scale,
+                         const ExecutionPolicy& policy) const {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(values != nullptr || num_values == 0,
+             "Require values != nullptr");
+  HEXL_CHECK(num_values <= GetSlotCount(),
+             "Require num_values <= " << GetSlotCount() << ", got "
+                                      << num_values);
+  HEXL_CHECK(scale > 0, "Require scale > 0, got " << scale);
+
+  const uint64_t n = m_degree;
+  const uint64_t k = m_moduli.size();
+  const uint64_t slots = GetSlotCount();
+
+  AlignedVector64<std::complex<double>> conj_values(n, 0);
+  for (uint64_t i = 0; i < num_values; ++i) {
+    conj_values[m_slot_index_map[i]] = values[i];
+    conj_values[m_slot_index_map[slots + i]] = std::conj(values[i]);
+  }
+
+  double fix = scale / static_cast<double>(n);
+  m_fft_like->ComputeInverseFFTLike(conj_values.data(), conj_values.data(),
+                                    &fix);
+
+  auto reduce_range = [&](uint64_t begin, uint64_t end) {
+#ifdef HEXL_HAS_AVX512DQ
+    if (has_avx512dq) {
+      HEXL_VLOG(3, "Calling CKKSRoundReduceAVX512");
+      CKKSRoundReduceAVX512(&result[begin], &conj_values[begin], end - begin,
+                            n, m_moduli.data(), k);
+      return;
+    }
+#endif
+    HEXL_VLOG(3, "Calling CKKSRoundReduceNative");
+    CKKSRoundReduceNative(&result[begin], &conj_values[begin], end - begin, n,
+                          m_moduli.data(), k);
+  };
+  ParallelFor(n, policy, reduce_range, k);
+
+  auto ntt_range = [&](uint64_t begin, uint64_t end) {
+    for (uint64_t j = begin; j < end; ++j) {
+      GetNTT(n, m_moduli[j])
+          ->ComputeForward(&result[j * n], &result[j * n], 1, 1);
+    }
+  };
+  ParallelFor(k, policy, ntt_range, n);
+}
+
+void CKKSEncoder::Decode(std::complex<double>* result, const uint64_t* plain,
+                         double scale, const ExecutionPolicy& policy) const {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(plain != nullptr, "Require plain != nullptr");
+  HEXL_CHECK(scale > 0, "Require scale > 0, got " << scale);
+
+  const uint64_t n = m_degree;
+  const uint64_t k = m_moduli.size();
+  for (uint64_t j = 0; j < k; ++j) {
+    HEXL_CHECK_BOUNDS(&plain[j * n], n, m_moduli[j],
+                      "plain exceeds bound " << m_moduli[j]);
+  }
+
+  AlignedVector64<uint64_t> coeffs(k * n);
+  auto intt_range = [&](uint64_t begin, uint64_t end) {
+    for (uint64_t j = begin; j < end; ++j) {
+      GetNTT(n, m_moduli[j])
+          ->ComputeInverse(&coeffs[j * n], &plain[j * n], 1, 1);
+    }
+  };
+  ParallelFor(k, policy, intt_range, n);
+
+  AlignedVector64<std::complex<double>> res(n);
+  const double inv_scale = 1.0 / scale;
+  // Number of coefficients composed at a time, so the composed integers stay
+  // in cache until they are converted to floating point
+  const uint64_t max_tile_size = GetTileSize(
+      2 * k * sizeof(uint64_t) + sizeof(std::complex<double>), n);
+  auto build_range = [&](uint64_t begin, uint64_t end) {
+    AlignedVector64<uint64_t> composed(k *
+                                       std::min(max_tile_size, end - begin));
+    for (uint64_t tile_begin = begin; tile_begin < end;
+         tile_begin += max_tile_size) {
+      uint64_t tile_size = std::min(max_tile_size, end - tile_begin);
+      CKKSComposeNative(composed.data(), &coeffs[tile_begin], tile_size, n,
+                        m_moduli.data(), k, m_q_hat_inv_mod_q.data(),
+                        m_q_hat.data(), m_decryption_modulus.data());
+      m_fft_like->BuildFloatingPoints(
+          &res[tile_begin], composed.data(), m_upper_half_threshold.data(),
+          m_decryption_modulus.data(), inv_scale, k, tile_size);
+    }
+  };
+  ParallelFor(n, policy, build_range, 2 * k);
+
+  m_fft_like->ComputeForwardFFTLike(res.data(), res.data(), nullptr);
+
+  for (uint64_t i = 0; i < GetSlotCount(); ++i) {
+    result[i] = res[m_slot_index_map[i]];
+  }
+}
+
+std::vector<uint64_t> CKKSComputeUpperHalfThreshold(
+    const std::vector<uint64_t>& decryption_modulus) {
+  HEXL_CHECK(!decryption_modulus.empty(),
+             "Require decryption_modulus to be non-empty");
+  HEXL_CHECK((decryption_modulus[0] & 1) == 1,
+             "Require an odd decryption_modulus");
+  const uint64_t k = decryption_modulus.size();
+  // (Q + 1) / 2 = floor(Q / 2) + 1, as Q is odd
+  std::vector<uint64_t> threshold(k);
+  for (uint64_t w = 0; w < k; ++w) {
+    uint64_t next = (w + 1 < k) ? decryption_modulus[w + 1] : 0;
+    threshold[w] = (decryption_modulus[w] >> 1) | (next << 63);
+  }
+  // Adds one, propagating the carry through the higher words. The sum is less
+  // than Q, so it does not carry past the last word.
+  for (uint64_t w = 0; w < k; ++w) {
+    if (++threshold[w] != 0) {
+      break;
+    }
+  }
+  return threshold;
+}
+
+void CKKSRoundReduceNative(uint64_t* result, const std::complex<double>* values,
+                           uint64_t count, uint64_t stride,
+                           const uint64_t* moduli, uint64_t num_moduli) {
+  const double two_pow_64 = 18446744073709551616.0;
+  for (uint64_t i = 0; i < count; ++i) {
+    double coeff = std::round(values[i].real());
+    HEXL_CHECK(std::isfinite(coeff), "Encoded value " << coeff
+                                                      << " is not finite");
+    bool negative = std::signbit(coeff);
+    coeff = std::fabs(coeff);
+
+    if (coeff < two_pow_64) {
+      uint64_t coeff_u = static_cast<uint64_t>(coeff);
+      for (uint64_t j = 0; j < num_moduli; ++j) {
+        uint64_t r = coeff_u % moduli[j];
+        result[j * stride + i] = (negative && r != 0) ? moduli[j] - r : r;
+      }
+      continue;
+    }
+
+    // coeff = mantissa * 2^(exponent - 53), with a 53-bit integer mantissa
+    int exponent;
+    uint64_t mantissa =
+        static_cast<uint64_t>(std::ldexp(std::frexp(coeff, &exponent), 53));
+    for (uint64_t j = 0; j < num_moduli; ++j) {
+      uint64_t r = MultiplyMod(
+          mantissa % moduli[j],
+          PowMod(2, static_cast<uint64_t>(exponent - 53), moduli[j]),
+          moduli[j]);
+      result[j * stride + i] = (negative && r != 0) ? moduli[j] - r : r;
+    }
+  }
+}
+
+void CKKSComposeNative(uint64_t* result, const uint64_t* plain, uint64_t count,
+                       uint64_t stride, const uint64_t* moduli,
+                       uint64_t num_moduli, const uint64_t* q_hat_inv_mod_q,
+                       const uint64_t* q_hat,
+                       const uint64_t* decryption_modulus) {
+  for (uint64_t i = 0; i < count; ++i) {
+    uint64_t* acc = &result[i * num_moduli];
+    std::fill(acc, acc + num_moduli, 0);
+
+    // acc = sum_j [x_j * q_hat_j^{-1}]_{q_j} * q_hat_j mod Q. Each term is
+    // below Q, and Q < 2^(62 * num_moduli), so acc + term does not overflow
+    for (uint64_t j = 0; j < num_moduli; ++j) {
+      uint64_t y = MultiplyMod(plain[j * stride + i], q_hat_inv_mod_q[j],
+                               moduli[j]);
+      const uint64_t* q_hat_j = &q_hat[j * num_moduli];
+      uint64_t carry = 0;
+      for (uint64_t w = 0; w < num_moduli; ++w) {
+        uint64_t prod_hi;
+        uint64_t prod_lo;
+        MultiplyUInt64(y, q_hat_j[w], &prod_hi, &prod_lo);
+        prod_hi += AddUInt64(prod_lo, carry, &prod_lo);
+        prod_hi += AddUInt64(acc[w], prod_lo, &acc[w]);
+        carry = prod_hi;
+      }
+      if (GreaterOrEqualWords(acc, decryption_modulus, num_moduli)) {
+        SubtractWords(acc, decryption_modulus, num_moduli);
+      }
+    }
+  }
+}
+
+void CKKSEncode(uint64_t* result, const std::complex<double>* values,
+                uint64_t num_values, double scale,
+                const std::vector<uint64_t>& moduli, uint64_t n,
+                const ExecutionPolicy& policy) {
+  CKKSEncoder(n, moduli).Encode(result, values, num_values, scale, policy);
+}
+
+void CKKSDecode(std::complex<double>* result, const uint64_t* plain,
+                double scale, const std::vector<uint64_t>& moduli, uint64_t n,
+                const ExecutionPolicy& policy) {
+  CKKSEncoder(n, moduli).Decode(result, plain, scale, policy);
+}
+
+}  // namespace hexl
+}  // namespace intel
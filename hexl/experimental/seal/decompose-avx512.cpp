@@ -0,0 +1,44 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <immintrin.h>
+
+#include "experimental/seal/decompose-internal.hpp"
+#include "hexl/util/defines.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+
+void DecomposePowerOfTwoBaseAVX512(uint64_t* result, uint64_t result_stride,
+                                   const uint64_t* operand, uint64_t n,
+                                   uint64_t log_base, uint64_t num_digits) {
+  const uint64_t n_tail = n % 8;
+  if (n_tail != 0) {
+    DecomposePowerOfTwoBaseNative(result, result_stride, operand, n_tail,
+                                  log_base, num_digits);
+    result += n_tail;
+    operand += n_tail;
+    n -= n_tail;
+  }
+
+  const __m512i v_mask =
+      _mm512_set1_epi64(static_cast<int64_t>((1ULL << log_base) - 1));
+  const __m128i v_shift = _mm_set_epi64x(0, static_cast<int64_t>(log_base));
+
+  for (uint64_t m = 0; m < n; m += 8) {
+    __m512i v_x = _mm512_loadu_si512(&operand[m]);
+    uint64_t* result_m = &result[m];
+    for (uint64_t k = 0; k < num_digits; ++k) {
+      _mm512_storeu_si512(result_m, _mm512_and_si512(v_x, v_mask));
+      v_x = _mm512_srl_epi64(v_x, v_shift);
+      result_m += result_stride;
+    }
+  }
+}
+
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,29 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include "hexl/util/defines.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Splits each of the \p n values of \p operand into \p num_digits
+/// digits of \p log_base bits, least significant first
+/// @param[out] result Stores digit k at result + k * result_stride
+/// @param[in] operand Values less than 2^(log_base * num_digits)
+void DecomposePowerOfTwoBaseNative(uint64_t* result, uint64_t result_stride,
+                                   const uint64_t* operand, uint64_t n,
+                                   uint64_t log_base, uint64_t num_digits);
+
+#ifdef HEXL_HAS_AVX512DQ
+/// @brief AVX512 implementation of DecomposePowerOfTwoBaseNative
+void DecomposePowerOfTwoBaseAVX512(uint64_t* result, uint64_t result_stride,
+                                   const uint64_t* operand, uint64_t n,
+                                   uint64_t log_base, uint64_t num_digits);
+#endif
+
+}  // namespace hexl
+}  // namespace intel
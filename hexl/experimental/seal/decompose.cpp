@@ -0,0 +1,126 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/experimental/seal/decompose.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "experimental/seal/decompose-internal.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/util/check.hpp"
+#include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
+
+namespace intel {
+namespace hexl {
+
+void DecomposePowerOfTwoBase(uint64_t* result, const uint64_t* operand,
+                             uint64_t n, uint64_t num_polys, uint64_t log_base,
+                             uint64_t num_digits,
+                             const ExecutionPolicy& policy) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand != nullptr, "Require operand != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(log_base >= 1 && log_base <= 63,
+             "Require 1 <= log_base <= 63, got " << log_base);
+  HEXL_CHECK(num_digits >= 1, "Require num_digits >= 1");
+  HEXL_CHECK(log_base * num_digits >= 64 ||
+                 *std::max_element(operand, operand + n * num_polys) <
+                     (1ULL << (log_base * num_digits)),
+             "operand exceeds " << log_base * num_digits << " bits");
+
+  auto decompose_range = [&](uint64_t begin, uint64_t end) {
+    for (uint64_t i = 0; i < num_polys; ++i) {
+      uint64_t* result_i = &result[i * num_digits * n + begin];
+      const uint64_t* operand_i = &operand[i * n + begin];
+#ifdef HEXL_HAS_AVX512DQ
+      if (has_avx512dq) {
+        DecomposePowerOfTwoBaseAVX512(result_i, n, operand_i, end - begin,
+                                      log_base, num_digits);
+        continue;
+      }
+#endif
+      HEXL_VLOG(3, "Calling DecomposePowerOfTwoBaseNative");
+      DecomposePowerOfTwoBaseNative(result_i, n, operand_i, end - begin,
+                                    log_base, num_digits);
+    }
+  };
+
+  ParallelFor(n, policy, decompose_range, num_polys * (num_digits + 1));
+}
+
+void DecomposePowerOfTwoBaseNative(uint64_t* result, uint64_t result_stride,
+                                   const uint64_t* operand, uint64_t n,
+                                   uint64_t log_base, uint64_t num_digits) {
+  const uint64_t mask = (1ULL << log_base) - 1;
+  for (uint64_t m = 0; m < n; ++m) {
+    uint64_t x = operand[m];
+    uint64_t* result_m = &result[m];
+    for (uint64_t k = 0; k < num_digits; ++k) {
+      *result_m = x & mask;
+      // Shifting by 64 or more bits is undefined
+      x = (log_base * (k + 1) < 64) ? x >> log_base : 0;
+      result_m += result_stride;
+    }
+  }
+}
+
+GroupDecomposer::GroupDecomposer(const std::vector<uint64_t>& moduli,
+                                 uint64_t dnum,
+                                 const std::vector<uint64_t>& extension_moduli)
+    : m_moduli(moduli), m_digit_moduli(moduli) {
+  HEXL_CHECK(!moduli.empty(), "Require moduli to be non-empty");
+  HEXL_CHECK(dnum >= 1 && dnum <= moduli.size(),
+             "Require 1 <= dnum <= " << moduli.size() << ", got " << dnum);
+  m_digit_moduli.insert(m_digit_moduli.end(), extension_moduli.begin(),
+                        extension_moduli.end());
+
+  const uint64_t num_moduli = moduli.size();
+  m_group_size = (num_moduli + dnum - 1) / dnum;
+  for (uint64_t begin = 0; begin < num_moduli; begin += m_group_size) {
+    uint64_t end = std::min(num_moduli, begin + m_group_size);
+    m_group_begin.push_back(begin);
+
+    std::vector<uint64_t> group(moduli.begin() + begin, moduli.begin() + end);
+    std::vector<uint64_t> before(moduli.begin(), moduli.begin() + begin);
+    std::vector<uint64_t> after(m_digit_moduli.begin() + end,
+                                m_digit_moduli.end());
+    m_converters_before.push_back(before.empty() ? BaseConverter()
+                                                 : BaseConverter(group, before));
+    m_converters_after.push_back(after.empty() ? BaseConverter()
+                                               : BaseConverter(group, after));
+  }
+}
+
+void GroupDecomposer::Decompose(uint64_t* result, const uint64_t* operand,
+                                uint64_t n,
+                                const ExecutionPolicy& policy) const {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand != nullptr, "Require operand != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(!m_moduli.empty(), "GroupDecomposer is not initialized");
+
+  const uint64_t num_moduli = m_moduli.size();
+  const uint64_t digit_size = m_digit_moduli.size() * n;
+  for (uint64_t j = 0; j < GetNumDigits(); ++j) {
+    const uint64_t begin = m_group_begin[j];
+    const uint64_t end = std::min(num_moduli, begin + m_group_size);
+    const uint64_t* group_operand = &operand[begin * n];
+    uint64_t* digit = &result[j * digit_size];
+
+    // The residues modulo the group are the digit itself
+    std::memcpy(&digit[begin * n], group_operand,
+                (end - begin) * n * sizeof(uint64_t));
+    if (begin > 0) {
+      m_converters_before[j].FastBaseConvert(digit, group_operand, n, policy);
+    }
+    if (end < m_digit_moduli.size()) {
+      m_converters_after[j].FastBaseConvert(&digit[end * n], group_operand, n,
+                                            policy);
+    }
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,104 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <immintrin.h>
+
+#include "hexl/experimental/seal/dyadic-multiply-internal.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "hexl/util/defines.hpp"
+#include "util/avx512-util.hpp"
+
+namespace intel {
+namespace hexl {
+namespace internal {
+
+#ifdef HEXL_HAS_AVX512DQ
+
+namespace {
+
+// Returns x * y mod q for x, y in [0, q), using Algorithm 2 from
+// https://homes.esat.kuleuven.be/~fvercaut/papers/bar_mont.pdf as in
+// EltwiseMultModAVX512DQInt
+inline __m512i MultiplyModAVX512(__m512i x, __m512i y, __m512i v_modulus,
+                                 __m512i v_twice_mod, __m512i v_barr_lo,
+                                 unsigned int prod_right_shift) {
+  __m512i v_prod_hi = _mm512_hexl_mulhi_epi<64>(x, y);
+  __m512i v_prod_lo = _mm512_hexl_mullo_epi<64>(x, y);
+  __m512i c1 = _mm512_hexl_shrdi_epi64(v_prod_lo, v_prod_hi, prod_right_shift);
+  __m512i q_hat = _mm512_hexl_mulhi_approx_epi<64>(c1, v_barr_lo);
+  // Computes result in [0, 4q)
+  __m512i v_result =
+      _mm512_sub_epi64(v_prod_lo, _mm512_hexl_mullo_epi<64>(q_hat, v_modulus));
+  return _mm512_hexl_small_mod_epu64<4>(v_result, v_modulus, &v_twice_mod);
+}
+
+}  // namespace
+
+void DyadicMultiplyAVX512(uint64_t* result0, uint64_t* result1,
+                          uint64_t* result2, const uint64_t* x0,
+                          const uint64_t* x1, const uint64_t* y0,
+                          const uint64_t* y1, uint64_t n, uint64_t modulus) {
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK(modulus < (1ULL << 62), "Require modulus < (1ULL << 62)");
+
+  const uint64_t n_tail = n % 8;
+  if (n_tail != 0) {
+    DyadicMultiplyNative(result0, result1, result2, x0, x1, y0, y1, n_tail,
+                         modulus);
+    result0 += n_tail;
+    result1 += n_tail;
+    result2 += n_tail;
+    x0 += n_tail;
+    x1 += n_tail;
+    y0 += n_tail;
+    y1 += n_tail;
+    n -= n_tail;
+  }
+
+  // alpha = 62, beta = -2
+  const uint64_t ceil_log_mod = Log2(modulus) + 1;
+  const unsigned int prod_right_shift =
+      static_cast<unsigned int>(ceil_log_mod - 2);
+  const uint64_t barr_lo =
+      MultiplyFactor(uint64_t(1) << (ceil_log_mod - 2), 64, modulus)
+          .BarrettFactor();
+
+  __m512i v_modulus = _mm512_set1_epi64(static_cast<int64_t>(modulus));
+  __m512i v_twice_mod = _mm512_set1_epi64(static_cast<int64_t>(2 * modulus));
+  __m512i v_barr_lo = _mm512_set1_epi64(static_cast<int64_t>(barr_lo));
+
+  HEXL_LOOP_UNROLL_4
+  for (size_t j = 0; j < n; j += 8) {
+    __m512i v_x0 = _mm512_loadu_si512(&x0[j]);
+    __m512i v_x1 = _mm512_loadu_si512(&x1[j]);
+    __m512i v_y0 = _mm512_loadu_si512(&y0[j]);
+    __m512i v_y1 = _mm512_loadu_si512(&y1[j]);
+
+    __m512i v_prod0 = MultiplyModAVX512(v_x0, v_y0, v_modulus, v_twice_mod,
+                                        v_barr_lo, prod_right_shift);
+    __m512i v_prod2 = MultiplyModAVX512(v_x1, v_y1, v_modulus, v_twice_mod,
+                                        v_barr_lo, prod_right_shift);
+
+    // (x0 + x1) * (y0 + y1) - x0 * y0 - x1 * y1 = x0 * y1 + x1 * y0
+    __m512i v_x_sum = _mm512_hexl_small_add_mod_epi64(v_x0, v_x1, v_modulus);
+    __m512i v_y_sum = _mm512_hexl_small_add_mod_epi64(v_y0, v_y1, v_modulus);
+    __m512i v_prod_sum = MultiplyModAVX512(v_x_sum, v_y_sum, v_modulus,
+                                           v_twice_mod, v_barr_lo,
+                                           prod_right_shift);
+    __m512i v_prod1 = _mm512_hexl_small_sub_mod_epi64(
+        v_prod_sum,
+        _mm512_hexl_small_add_mod_epi64(v_prod0, v_prod2, v_modulus),
+        v_modulus);
+
+    _mm512_storeu_si512(&result0[j], v_prod0);
+    _mm512_storeu_si512(&result1[j], v_prod1);
+    _mm512_storeu_si512(&result2[j], v_prod2);
+  }
+}
+
+#endif
+
+}  // namespace internal
+}  // namespace hexl
+}  // namespace intel
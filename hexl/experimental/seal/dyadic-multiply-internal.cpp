@@ -3,12 +3,12 @@
 
 #include "hexl/experimental/seal/dyadic-multiply-internal.hpp"
 
-#include "hexl/eltwise/eltwise-add-mod.hpp"
-#include "hexl/eltwise/eltwise-mult-mod.hpp"
+#include <algorithm>
+
 #include "hexl/number-theory/number-theory.hpp"
-#include "hexl/util/aligned-allocator.hpp"
 #include "hexl/util/check.hpp"
 #include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
 
 namespace intel {
 namespace hexl {
@@ -16,7 +16,8 @@ namespace internal {
 
 void DyadicMultiply(uint64_t* result, const uint64_t* operand1,
                     const uint64_t* operand2, uint64_t n,
-                    const uint64_t* moduli, uint64_t num_moduli) {
+                    const uint64_t* moduli, uint64_t num_moduli,
+                    const ExecutionPolicy& policy) {
   HEXL_CHECK(result != nullptr, "Require result != nullptr");
   HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
   HEXL_CHECK(operand2 != nullptr, "Require operand2 != nullptr");
@@ -29,47 +30,84 @@ void DyadicMultiply(uint64_t* result, const uint64_t* operand1,
   // Output ciphertext has 3 polynomials, where x, y are the input
   // ciphertexts: (x[0] * y[0], x[0] * y[1] + x[1] * y[0], x[1] * y[1])
 
-  // TODO(fboemer): Determine based on cpu cache size
-  size_t tile_size = std::min(n, uint64_t(512));
-  size_t num_tiles = n / tile_size;
+  // A tile of each of the 4 input and 3 output polynomials fits into cache
+  const size_t tile_size = GetTileSize(7 * sizeof(uint64_t), n);
+  const size_t num_tiles = (n + tile_size - 1) / tile_size;
 
-  AlignedVector64<uint64_t> temp(tile_size, 0);
+  // Tiles are independent, so split (modulus, tile) pairs across threads
+  auto multiply_tiles = [&](uint64_t begin, uint64_t end) {
+    for (uint64_t item = begin; item < end; ++item) {
+      size_t i = item / num_tiles;
+      size_t tile = item % num_tiles;
 
-  // Modulus by modulus
-  for (size_t i = 0; i < num_moduli; i++) {
-    // Split by tiles for better caching
-    size_t i_times_n = i * n;
-    for (size_t tile = 0; tile < num_tiles; ++tile) {
-      size_t poly0_offset = i_times_n + tile_size * tile;
+      size_t poly0_offset = i * n + tile_size * tile;
       size_t poly1_offset = poly0_offset + poly_size;
       size_t poly2_offset = poly0_offset + 2 * poly_size;
+      size_t tile_length = std::min(tile_size, n - tile_size * tile);
 
-      // Compute third output polynomial
-      // Output written directly to result rather than temporary buffer
-      // result[2] = x[1] * y[1]
-      intel::hexl::EltwiseMultMod(
-          &result[poly2_offset], operand1 + poly1_offset,
-          operand2 + poly1_offset, tile_size, moduli[i], 1);
-
-      // Compute second output polynomial
-      // result[1] = x[1] * y[0]
-      intel::hexl::EltwiseMultMod(temp.data(), operand1 + poly1_offset,
-                                  operand2 + poly0_offset, tile_size, moduli[i],
-                                  1);
-      // result[1] = x[0] * y[1]
-      intel::hexl::EltwiseMultMod(
-          &result[poly1_offset], operand1 + poly0_offset,
-          operand2 + poly1_offset, tile_size, moduli[i], 1);
-      // result[1] += temp_poly
-      intel::hexl::EltwiseAddMod(&result[poly1_offset], temp.data(),
-                                 &result[poly1_offset], tile_size, moduli[i]);
-
-      // Compute first output polynomial
-      // result[0] = x[0] * y[0]
-      intel::hexl::EltwiseMultMod(
-          &result[poly0_offset], operand1 + poly0_offset,
-          operand2 + poly0_offset, tile_size, moduli[i], 1);
+      // Each kernel reads x[0], x[1], y[0], y[1] once and writes all three
+      // output polynomials, so result may alias operand1 or operand2
+#ifdef HEXL_HAS_AVX512DQ
+      if (has_avx512dq) {
+        DyadicMultiplyAVX512(&result[poly0_offset], &result[poly1_offset],
+                             &result[poly2_offset], operand1 + poly0_offset,
+                             operand1 + poly1_offset, operand2 + poly0_offset,
+                             operand2 + poly1_offset, tile_length, moduli[i]);
+        continue;
+      }
+#endif
+      DyadicMultiplyNative(&result[poly0_offset], &result[poly1_offset],
+                           &result[poly2_offset], operand1 + poly0_offset,
+                           operand1 + poly1_offset, operand2 + poly0_offset,
+                           operand2 + poly1_offset, tile_length, moduli[i]);
     }
+  };
+  ParallelFor(num_moduli * num_tiles, policy, multiply_tiles, tile_size);
+}
+
+void DyadicMultiplyNative(uint64_t* result0, uint64_t* result1,
+                          uint64_t* result2, const uint64_t* x0,
+                          const uint64_t* x1, const uint64_t* y0,
+                          const uint64_t* y1, uint64_t n, uint64_t modulus) {
+  HEXL_CHECK(modulus > 1, "Require modulus > 1");
+  HEXL_CHECK(modulus < (1ULL << 62), "Require modulus < (1ULL << 62)");
+
+  // Barrett reduction of products of values in [0, modulus), as in
+  // EltwiseMultModNative with alpha = 62, beta = -2
+  const uint64_t ceil_log_mod = Log2(modulus) + 1;
+  const uint64_t prod_right_shift = ceil_log_mod - 2;
+  const uint64_t barr_lo =
+      MultiplyFactor(uint64_t(1) << (ceil_log_mod - 2), 64, modulus)
+          .BarrettFactor();
+  const uint64_t twice_modulus = 2 * modulus;
+  auto multiply_mod = [=](uint64_t x, uint64_t y) {
+    uint64_t prod_hi, prod_lo, c2_hi, c2_lo;
+    MultiplyUInt64(x, y, &prod_hi, &prod_lo);
+    // floor(x * y / 2^prod_right_shift); x * y < 2^64 if prod_right_shift = 0
+    uint64_t c1 = (prod_right_shift == 0)
+                      ? prod_lo
+                      : (prod_lo >> prod_right_shift) +
+                            (prod_hi << (64 - prod_right_shift));
+    MultiplyUInt64(c1, barr_lo, &c2_hi, &c2_lo);
+    uint64_t z = prod_lo - c2_hi * modulus;
+    return ReduceMod<4>(z, modulus, &twice_modulus);
+  };
+
+  for (size_t j = 0; j < n; ++j) {
+    uint64_t x0_j = x0[j];
+    uint64_t x1_j = x1[j];
+    uint64_t y0_j = y0[j];
+    uint64_t y1_j = y1[j];
+
+    uint64_t prod0 = multiply_mod(x0_j, y0_j);
+    uint64_t prod2 = multiply_mod(x1_j, y1_j);
+    uint64_t prod_sum = multiply_mod(AddUIntMod(x0_j, x1_j, modulus),
+                                     AddUIntMod(y0_j, y1_j, modulus));
+
+    result0[j] = prod0;
+    result1[j] =
+        SubUIntMod(prod_sum, AddUIntMod(prod0, prod2, modulus), modulus);
+    result2[j] = prod2;
   }
 }
 
@@ -0,0 +1,53 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <immintrin.h>
+
+#include "experimental/seal/key-switch-accumulate.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/defines.hpp"
+#include "util/avx512-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+
+void KeySwitchAccumulateShoupAVX512(uint64_t* acc, const uint64_t* operand,
+                                    const uint64_t* key,
+                                    const uint64_t* key_precon, uint64_t n,
+                                    uint64_t modulus) {
+  const uint64_t n_tail = n % 8;
+  if (n_tail != 0) {
+    KeySwitchAccumulateShoupNative(acc, operand, key, key_precon, n_tail,
+                                   modulus);
+    acc += n_tail;
+    operand += n_tail;
+    key += n_tail;
+    key_precon += n_tail;
+    n -= n_tail;
+  }
+
+  __m512i v_modulus = _mm512_set1_epi64(static_cast<int64_t>(modulus));
+  __m512i v_twice_modulus =
+      _mm512_set1_epi64(static_cast<int64_t>(2 * modulus));
+  for (uint64_t l = 0; l < n; l += 8) {
+    __m512i v_x = _mm512_loadu_si512(&operand[l]);
+    __m512i v_y = _mm512_loadu_si512(&key[l]);
+    __m512i v_y_precon = _mm512_loadu_si512(&key_precon[l]);
+
+    // x * y - floor(x * y_precon / 2^64) * q, in [0, 2q)
+    __m512i v_q_hat = _mm512_hexl_mulhi_epi<64>(v_x, v_y_precon);
+    __m512i v_prod = _mm512_sub_epi64(_mm512_mullo_epi64(v_x, v_y),
+                                      _mm512_mullo_epi64(v_q_hat, v_modulus));
+
+    __m512i v_acc = _mm512_add_epi64(_mm512_loadu_si512(&acc[l]), v_prod);
+    v_acc = _mm512_hexl_small_mod_epu64<2>(v_acc, v_twice_modulus);
+    _mm512_storeu_si512(&acc[l], v_acc);
+  }
+}
+
+#endif
+
+}  // namespace hexl
+}  // namespace intel
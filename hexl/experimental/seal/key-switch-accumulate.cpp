@@ -0,0 +1,24 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "experimental/seal/key-switch-accumulate.hpp"
+
+#include "hexl/number-theory/number-theory.hpp"
+
+namespace intel {
+namespace hexl {
+
+void KeySwitchAccumulateShoupNative(uint64_t* acc, const uint64_t* operand,
+                                    const uint64_t* key,
+                                    const uint64_t* key_precon, uint64_t n,
+                                    uint64_t modulus) {
+  const uint64_t twice_modulus = 2 * modulus;
+  for (size_t l = 0; l < n; ++l) {
+    uint64_t prod =
+        MultiplyModLazy<64>(operand[l], key[l], key_precon[l], modulus);
+    acc[l] = ReduceMod<2>(acc[l] + prod, twice_modulus);
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
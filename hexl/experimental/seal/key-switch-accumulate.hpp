@@ -0,0 +1,32 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include "hexl/util/defines.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Sets acc[l] = acc[l] + operand[l] * key[l] mod modulus, in [0, 2 *
+/// modulus), using the precomputed factors key_precon[l] = floor(2^64 *
+/// key[l] / modulus)
+/// @details Requires acc in [0, 2 * modulus), key in [0, modulus) and modulus
+/// < 2^62
+void KeySwitchAccumulateShoupNative(uint64_t* acc, const uint64_t* operand,
+                                    const uint64_t* key,
+                                    const uint64_t* key_precon, uint64_t n,
+                                    uint64_t modulus);
+
+#ifdef HEXL_HAS_AVX512DQ
+/// @brief AVX512-DQ implementation of KeySwitchAccumulateShoupNative
+void KeySwitchAccumulateShoupAVX512(uint64_t* acc, const uint64_t* operand,
+                                    const uint64_t* key,
+                                    const uint64_t* key_precon, uint64_t n,
+                                    uint64_t modulus);
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -3,67 +3,260 @@
 
 #include "hexl/experimental/seal/key-switch-internal.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <exception>
 #include <iostream>
+#include <stdexcept>
 
+#include "eltwise/eltwise-lazy-accumulate-avx512.hpp"
+#include "eltwise/eltwise-lazy-accumulate-internal.hpp"
+#include "experimental/seal/key-switch-accumulate.hpp"
+#include "experimental/seal/rescale-internal.hpp"
 #include "hexl/eltwise/eltwise-add-mod.hpp"
-#include "hexl/eltwise/eltwise-fma-mod.hpp"
 #include "hexl/eltwise/eltwise-mult-mod.hpp"
 #include "hexl/eltwise/eltwise-reduce-mod.hpp"
-#include "hexl/experimental/seal/ntt-cache.hpp"
 #include "hexl/logging/logging.hpp"
+#include "hexl/ntt/ntt-cache.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "hexl/util/aligned-allocator.hpp"
 #include "hexl/util/check.hpp"
 #include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
 
 namespace intel {
 namespace hexl {
+
+KeySwitchWorkspace::KeySwitchWorkspace(uint64_t n,
+                                       uint64_t decomp_modulus_size,
+                                       uint64_t key_modulus_size,
+                                       uint64_t key_component_count,
+                                       size_t num_threads)
+    : m_n(n),
+      m_decomp_modulus_size(decomp_modulus_size),
+      m_key_modulus_size(key_modulus_size),
+      m_key_component_count(key_component_count),
+      m_num_threads(std::max<size_t>(num_threads, 1)),
+      m_target(n * decomp_modulus_size, 0),
+      m_ntt(m_num_threads * n, 0),
+      m_poly_prod(key_component_count * n * (decomp_modulus_size + 1), 0),
+      m_acc_hi(m_num_threads * key_component_count * n, 0),
+      m_acc_lo(m_num_threads * key_component_count * n, 0),
+      m_last(key_component_count * n, 0),
+      m_moduli(key_modulus_size, 0),
+      m_modswitch_precon(decomp_modulus_size, 0) {
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(decomp_modulus_size < key_modulus_size,
+             "Require decomp_modulus_size < key_modulus_size");
+  HEXL_CHECK(key_component_count != 0, "Require key_component_count != 0");
+}
+
+KeySwitchKeys::KeySwitchKeys(const uint64_t** k_switch_keys, uint64_t n,
+                             uint64_t decomp_modulus_size,
+                             uint64_t key_modulus_size,
+                             uint64_t key_component_count,
+                             const uint64_t* moduli, bool precompute_shoup)
+    : m_n(n),
+      m_decomp_modulus_size(decomp_modulus_size),
+      m_key_modulus_size(key_modulus_size),
+      m_key_component_count(key_component_count),
+      m_keys(key_modulus_size * decomp_modulus_size * key_component_count * n) {
+  HEXL_CHECK(k_switch_keys != nullptr, "Require k_switch_keys != nullptr");
+  HEXL_CHECK(moduli != nullptr, "Require moduli != nullptr");
+  HEXL_CHECK(n != 0, "Require n != 0");
+  HEXL_CHECK(decomp_modulus_size < key_modulus_size,
+             "Require decomp_modulus_size < key_modulus_size");
+  HEXL_CHECK(key_component_count != 0, "Require key_component_count != 0");
+
+  for (uint64_t key_index = 0; key_index < key_modulus_size; ++key_index) {
+    for (uint64_t j = 0; j < decomp_modulus_size; ++j) {
+      uint64_t* keys = &m_keys[BlockOffset(key_index, j)];
+      for (uint64_t k = 0; k < key_component_count; ++k) {
+        const uint64_t* key =
+            &k_switch_keys[j][n * key_index + k * key_modulus_size * n];
+        std::copy(key, key + n, &keys[k * n]);
+      }
+    }
+  }
+  if (!precompute_shoup) {
+    return;
+  }
+
+  m_keys_precon.resize(m_keys.size());
+  for (uint64_t key_index = 0; key_index < key_modulus_size; ++key_index) {
+    const uint64_t modulus = moduli[key_index];
+    HEXL_CHECK(modulus < (1ULL << 62),
+               "Require modulus < 2^62 for precomputed factors, got "
+                   << modulus);
+    const uint64_t begin = BlockOffset(key_index, 0);
+    const uint64_t end = BlockOffset(key_index + 1, 0);
+    HEXL_CHECK_BOUNDS(&m_keys[begin], end - begin, modulus,
+                      "key exceeds bound " << modulus);
+    for (uint64_t l = begin; l < end; ++l) {
+      m_keys_precon[l] = MultiplyFactor(m_keys[l], 64, modulus).BarrettFactor();
+    }
+  }
+}
+
 namespace internal {
 
+namespace {
+
+// Number of threads used for key switching under policy, for a ciphertext of
+// the given size
+size_t KeySwitchNumThreads(const ExecutionPolicy& policy, uint64_t size) {
+  if (policy.IsSerial() || size <= policy.GetGrainSize()) {
+    return 1;
+  }
+  size_t num_threads = policy.GetNumThreads();
+  if (num_threads == 0) {
+    num_threads = ThreadPool::Instance().NumWorkers() + 1;
+  }
+  return num_threads;
+}
+
+// Calls func(thread, index) for each index in [0, size), spread over
+// num_threads threads. Thread t handles the indices congruent to t modulo
+// num_threads, so it may use scratch memory owned by thread t
+template <typename Func>
+void ForEachStrided(uint64_t size, size_t num_threads, Func func) {
+  num_threads =
+      static_cast<size_t>(std::min<uint64_t>(std::max<size_t>(num_threads, 1),
+                                             size));
+  ParallelFor(num_threads, num_threads, [&](uint64_t begin, uint64_t end) {
+    for (uint64_t t = begin; t < end; ++t) {
+      for (uint64_t index = t; index < size; index += num_threads) {
+        func(t, index);
+      }
+    }
+  });
+}
+
+}  // namespace
+
 void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
                uint64_t decomp_modulus_size, uint64_t key_modulus_size,
                uint64_t rns_modulus_size, uint64_t key_component_count,
                const uint64_t* moduli, const uint64_t** k_switch_keys,
                const uint64_t* modswitch_factors,
-               const uint64_t* root_of_unity_powers_ptr) {
-  if (root_of_unity_powers_ptr != nullptr) {
+               const uint64_t* root_of_unity_powers_ptr,
+               const ExecutionPolicy& policy) {
+  KeySwitchWorkspace workspace(
+      n, decomp_modulus_size, key_modulus_size, key_component_count,
+      KeySwitchNumThreads(policy,
+                          n * rns_modulus_size * key_component_count));
+  internal::KeySwitch(result, t_target_iter_ptr, n, decomp_modulus_size,
+                      key_modulus_size, rns_modulus_size, key_component_count,
+                      moduli, k_switch_keys, modswitch_factors, workspace,
+                      root_of_unity_powers_ptr, policy);
+}
+
+namespace {
+
+// Key switching with either the key layout of SEAL, k_switch_keys, or the
+// precomputed layout, prepared_keys
+void KeySwitchImpl(uint64_t* result, const uint64_t* t_target_iter_ptr,
+                   uint64_t n, uint64_t decomp_modulus_size,
+                   uint64_t key_modulus_size, uint64_t rns_modulus_size,
+                   uint64_t key_component_count, const uint64_t* moduli,
+                   const uint64_t** k_switch_keys,
+                   const KeySwitchKeys* prepared_keys,
+                   const uint64_t* modswitch_factors,
+                   KeySwitchWorkspace& workspace,
+                   const ExecutionPolicy& policy) {
+  if (rns_modulus_size != decomp_modulus_size + 1) {
     throw std::invalid_argument(
-        "Parameter root_of_unity_powers_ptr is not supported yet.");
+        "Require rns_modulus_size == decomp_modulus_size + 1");
+  }
+  if (!workspace.Fits(n, decomp_modulus_size, key_modulus_size,
+                      key_component_count)) {
+    throw std::invalid_argument(
+        "workspace is empty or too small for the key switching parameters");
   }
 
   uint64_t coeff_count = n;
+  const uint64_t acc_size = key_component_count * coeff_count;
 
-  // Create a copy of target_iter
-  std::vector<uint64_t> t_target(
-      t_target_iter_ptr,
-      t_target_iter_ptr + (coeff_count * decomp_modulus_size));
-  uint64_t* t_target_ptr = t_target.data();
+  // Each thread uses the scratch memory of its own index in the workspace,
+  // and the work of each item does not depend on the thread
+  const size_t num_threads =
+      std::min(workspace.GetNumThreads(),
+               KeySwitchNumThreads(policy, coeff_count * rns_modulus_size *
+                                               key_component_count));
 
-  // Simplified implementation, where we assume no modular reduction is required
-  // for intermediate additions
-  std::vector<uint64_t> t_ntt(coeff_count, 0);
-  uint64_t* t_ntt_ptr = t_ntt.data();
+  // Create a copy of target_iter
+  uint64_t* t_target_ptr = workspace.Target();
+  std::copy(t_target_iter_ptr,
+            t_target_iter_ptr + (coeff_count * decomp_modulus_size),
+            t_target_ptr);
 
   // In CKKS t_target is in NTT form; switch
   // back to normal form
-  for (size_t j = 0; j < decomp_modulus_size; ++j) {
-    GetNTT(n, moduli[j])
-        .ComputeInverse(&t_target_ptr[j * coeff_count],
-                        &t_target_ptr[j * coeff_count], 2, 1);
-  }
-
-  std::vector<uint64_t> t_poly_prod(
-      key_component_count * coeff_count * rns_modulus_size, 0);
-
-  for (size_t i = 0; i < rns_modulus_size; ++i) {
+  ForEachStrided(decomp_modulus_size, num_threads,
+                 [&](uint64_t thread, uint64_t j) {
+                   HEXL_UNUSED(thread);
+                   GetNTT(n, moduli[j])
+                       ->ComputeInverse(&t_target_ptr[j * coeff_count],
+                                        &t_target_ptr[j * coeff_count], 2, 1);
+                 });
+
+  uint64_t* t_poly_prod = workspace.PolyProd();
+
+  // Per coefficient, the accumulation reads the operand and, for each key
+  // component, the key, its precomputed factor and two accumulators
+  const uint64_t acc_tile_size = GetTileSize(
+      sizeof(uint64_t) * (1 + 4 * key_component_count), coeff_count);
+
+  // Inner products of the decomposed target with the keys, one RNS limb at a
+  // time
+  ForEachStrided(rns_modulus_size, num_threads, [&](uint64_t thread,
+                                                    uint64_t i) {
     size_t key_index = (i == decomp_modulus_size ? key_modulus_size - 1 : i);
+    const uint64_t key_modulus = moduli[key_index];
+
+    // Simplified implementation, where we assume no modular reduction is
+    // required for intermediate additions
+    uint64_t* t_ntt_ptr = workspace.NTT(thread);
+
+    // Lazy accumulators for the 128-bit inner products, split in high and low
+    // words so the products can be accumulated with vector instructions
+    uint64_t* t_acc_hi = workspace.AccumulatorHi(thread);
+    uint64_t* t_acc_lo = workspace.AccumulatorLo(thread);
+
+    // Operands are in [0, 4 * key_modulus) after the lazy forward NTT
+    auto accumulate = EltwiseLazyMultAccumulateNative;
+    auto reduce = EltwiseLazyReduceNative;
+#ifdef HEXL_HAS_AVX512DQ
+    if (has_avx512dq && key_modulus < (1ULL << 62)) {
+      accumulate = EltwiseLazyMultAccumulateAVX512DQ;
+      reduce = EltwiseLazyReduceAVX512DQ;
+    }
+#endif
+#ifdef HEXL_HAS_AVX512IFMA
+    bool use_ifma = has_avx512ifma && key_modulus < (1ULL << 50) &&
+                    decomp_modulus_size < (1ULL << 12);
+    for (size_t j = 0; use_ifma && j < decomp_modulus_size; ++j) {
+      use_ifma = moduli[j] < (1ULL << 50);
+    }
+    if (use_ifma) {
+      accumulate = EltwiseLazyMultAccumulateAVX512IFMA;
+      reduce = EltwiseLazyReduceAVX512IFMA;
+    }
+#endif
+
+    // Products with precomputed factors are reduced as they are accumulated
+    const bool use_shoup = prepared_keys != nullptr &&
+                           prepared_keys->HasPrecon() &&
+                           key_modulus < (1ULL << 62);
+    auto accumulate_shoup = KeySwitchAccumulateShoupNative;
+#ifdef HEXL_HAS_AVX512DQ
+    if (has_avx512dq) {
+      accumulate_shoup = KeySwitchAccumulateShoupAVX512;
+    }
+#endif
 
-    // Allocate memory for a lazy accumulator (128-bit coefficients)
-    std::vector<uint64_t> t_poly_lazy(key_component_count * coeff_count * 2, 0);
-    uint64_t* t_poly_lazy_ptr = &t_poly_lazy[0];
-    uint64_t* accumulator_ptr = &t_poly_lazy[0];
+    std::fill(t_acc_hi, t_acc_hi + acc_size, 0);
+    std::fill(t_acc_lo, t_acc_lo + acc_size, 0);
 
     for (size_t j = 0; j < decomp_modulus_size; ++j) {
       const uint64_t* t_operand;
@@ -73,43 +266,52 @@ void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
       } else {
         // Perform RNS-NTT conversion
         // No need to perform RNS conversion (modular reduction)
-        if (moduli[j] <= moduli[key_index]) {
+        if (moduli[j] <= key_modulus) {
           for (size_t l = 0; l < coeff_count; ++l) {
             t_ntt_ptr[l] = t_target_ptr[j * coeff_count + l];
           }
         } else {
           // Perform RNS conversion (modular reduction)
-          intel::hexl::EltwiseReduceMod(
-              t_ntt_ptr, &t_target_ptr[j * coeff_count], coeff_count,
-              moduli[key_index], moduli[key_index], 1);
+          intel::hexl::EltwiseReduceMod(t_ntt_ptr,
+                                        &t_target_ptr[j * coeff_count],
+                                        coeff_count, key_modulus, key_modulus,
+                                        1);
         }
 
         // NTT conversion lazy outputs in [0, 4q)
-        GetNTT(n, moduli[key_index]).ComputeForward(t_ntt_ptr, t_ntt_ptr, 4, 4);
+        GetNTT(n, key_modulus)->ComputeForward(t_ntt_ptr, t_ntt_ptr, 4, 4);
         t_operand = t_ntt_ptr;
       }
 
-      // Multiply with keys and modular accumulate products in a lazy fashion
-      for (size_t k = 0; k < key_component_count; ++k) {
-        // No reduction used; assume intermediate results don't overflow
-        for (size_t l = 0; l < coeff_count; ++l) {
-          uint64_t t_poly_idx = 2 * (k * coeff_count + l);
-
-          uint64_t mult_op2_idx =
-              coeff_count * key_index + k * key_modulus_size * coeff_count + l;
-
-          uint128_t prod =
-              MultiplyUInt64(t_operand[l], k_switch_keys[j][mult_op2_idx]);
-
-          // TODO(fboemer): add uint128
-          uint128_t low = t_poly_lazy_ptr[t_poly_idx];
-          uint128_t hi = t_poly_lazy_ptr[t_poly_idx + 1];
-          uint128_t x = (hi << 64) + low;
-          uint128_t sum = prod + x;
-          uint64_t sum_hi = static_cast<uint64_t>(sum >> 64);
-          uint64_t sum_lo = static_cast<uint64_t>(sum);
-          t_poly_lazy_ptr[t_poly_idx] = sum_lo;
-          t_poly_lazy_ptr[t_poly_idx + 1] = sum_hi;
+      // Multiply with keys and accumulate products in a lazy fashion, one
+      // tile of coefficients at a time, so the tile of the operand stays in
+      // cache across the key components
+      for (size_t l = 0; l < coeff_count; l += acc_tile_size) {
+        const uint64_t tile_size = std::min(acc_tile_size, coeff_count - l);
+        if (use_shoup) {
+          // The components of the keys are contiguous, and each product is
+          // reduced to [0, 2q) with the precomputed factors
+          const uint64_t* keys = prepared_keys->GetKeys(key_index, j);
+          const uint64_t* keys_precon =
+              prepared_keys->GetKeysPrecon(key_index, j);
+          for (size_t k = 0; k < key_component_count; ++k) {
+            accumulate_shoup(&t_acc_lo[k * coeff_count + l], &t_operand[l],
+                             &keys[k * coeff_count + l],
+                             &keys_precon[k * coeff_count + l], tile_size,
+                             key_modulus);
+          }
+          continue;
+        }
+        for (size_t k = 0; k < key_component_count; ++k) {
+          // No reduction used; assume intermediate results don't overflow
+          const uint64_t* key =
+              prepared_keys != nullptr
+                  ? &prepared_keys->GetKeys(key_index, j)[k * coeff_count]
+                  : &k_switch_keys[j][coeff_count * key_index +
+                                      k * key_modulus_size * coeff_count];
+          accumulate(&t_acc_hi[k * coeff_count + l],
+                     &t_acc_lo[k * coeff_count + l], &t_operand[l], &key[l],
+                     tile_size);
         }
       }
     }
@@ -120,84 +322,111 @@ void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
 
     // Final modular reduction
     for (size_t k = 0; k < key_component_count; ++k) {
-      for (size_t l = 0; l < coeff_count; ++l) {
-        uint64_t accumulator_idx = 2 * coeff_count * k + 2 * l;
-        uint64_t poly_iter_idx = coeff_count * rns_modulus_size * k + l;
-
-        t_poly_prod_iter_ptr[poly_iter_idx] = BarrettReduce128(
-            accumulator_ptr[accumulator_idx + 1],
-            accumulator_ptr[accumulator_idx], moduli[key_index]);
+      if (use_shoup) {
+        EltwiseReduceMod(
+            &t_poly_prod_iter_ptr[coeff_count * rns_modulus_size * k],
+            &t_acc_lo[k * coeff_count], coeff_count, key_modulus, 2, 1);
+        continue;
       }
+      reduce(&t_poly_prod_iter_ptr[coeff_count * rns_modulus_size * k],
+             &t_acc_hi[k * coeff_count], &t_acc_lo[k * coeff_count],
+             coeff_count, key_modulus);
     }
+  });
+
+  // Moduli of t_poly_prod, whose last modulus is dropped
+  uint64_t* rescale_moduli = workspace.Moduli();
+  std::copy(moduli, moduli + decomp_modulus_size, rescale_moduli);
+  const uint64_t last_modulus = moduli[key_modulus_size - 1];
+  rescale_moduli[decomp_modulus_size] = last_modulus;
+
+  // Factors of the Shoup multiplications by modswitch_factors, computed once
+  // for all key components
+  HEXL_CHECK(modswitch_factors != nullptr, "modswitch_factors == nullptr");
+  uint64_t* modswitch_precon = workspace.ModSwitchPrecon();
+  for (size_t i = 0; i < decomp_modulus_size; ++i) {
+    HEXL_CHECK(MultiplyMod(modswitch_factors[i], last_modulus % moduli[i],
+                           moduli[i]) == 1,
+               "modswitch_factors[" << i << "] is not the inverse of the "
+                                    << "last modulus");
+    modswitch_precon[i] =
+        MultiplyFactor(modswitch_factors[i], 64, moduli[i]).BarrettFactor();
   }
 
-  uint64_t* data_array = result;
-  for (size_t key_component = 0; key_component < key_component_count;
-       ++key_component) {
-    uint64_t* t_poly_prod_it =
-        &t_poly_prod[key_component * coeff_count * rns_modulus_size];
-    uint64_t* t_last = &t_poly_prod_it[decomp_modulus_size * coeff_count];
-
-    GetNTT(n, moduli[key_modulus_size - 1])
-        .ComputeInverse(t_last, t_last, 2, 2);
-
-    uint64_t qk = moduli[key_modulus_size - 1];
-    uint64_t qk_half = qk >> 1;
-
-    for (size_t i = 0; i < coeff_count; ++i) {
-      uint64_t barrett_factor =
-          MultiplyFactor(1, 64, moduli[key_modulus_size - 1]).BarrettFactor();
-      t_last[i] = BarrettReduce64(t_last[i] + qk_half,
-                                  moduli[key_modulus_size - 1], barrett_factor);
-    }
-
-    for (size_t i = 0; i < decomp_modulus_size; ++i) {
-      // (ct mod 4qk) mod qi
-      uint64_t qi = moduli[i];
+  // qk^(-1) * ((ct mod qi) - (ct mod qk)) mod qi, in place. Equivalent to
+  // RescaleDivideRoundLastModulus on each key component, with scratch memory
+  // from the workspace
+  uint64_t* t_last = workspace.Last();
+  ForEachStrided(key_component_count, num_threads,
+                 [&](uint64_t thread, uint64_t key_component) {
+                   HEXL_UNUSED(thread);
+                   const uint64_t* t_poly_prod_last =
+                       &t_poly_prod[(key_component * rns_modulus_size +
+                                     decomp_modulus_size) *
+                                    coeff_count];
+                   RescaleLastResidue(&t_last[key_component * coeff_count],
+                                      t_poly_prod_last, coeff_count,
+                                      last_modulus);
+                 });
 
-      // TODO(fboemer): Use input_mod_factor != 0 when qk / qi < 4
-      // TODO(fboemer): Use output_mod_factor == 4?
-      uint64_t input_mod_factor = (qk > qi) ? moduli[i] : 2;
-      if (qk > qi) {
-        intel::hexl::EltwiseReduceMod(t_ntt_ptr, t_last, coeff_count, moduli[i],
-                                      input_mod_factor, 1);
-      } else {
-        for (size_t coeff_idx = 0; coeff_idx < coeff_count; ++coeff_idx) {
-          t_ntt_ptr[coeff_idx] = t_last[coeff_idx];
-        }
-      }
-
-      // Lazy subtraction, results in [0, 2*qi), since fix is in [0, qi].
-      uint64_t barrett_factor =
-          MultiplyFactor(1, 64, moduli[i]).BarrettFactor();
-      uint64_t fix = qi - BarrettReduce64(qk_half, moduli[i], barrett_factor);
-      for (size_t l = 0; l < coeff_count; ++l) {
-        t_ntt_ptr[l] += fix;
-      }
-
-      uint64_t qi_lazy = qi << 1;  // some multiples of qi
-      GetNTT(n, moduli[i]).ComputeForward(t_ntt_ptr, t_ntt_ptr, 4, 4);
-      // Since SEAL uses at most 60bit moduli, 8*qi < 2^63.
-      qi_lazy = qi << 2;
-
-      // ((ct mod qi) - (ct mod qk)) mod qi
-      uint64_t* t_ith_poly = &t_poly_prod_it[i * coeff_count];
-      for (size_t k = 0; k < coeff_count; ++k) {
-        t_ith_poly[k] = t_ith_poly[k] + qi_lazy - t_ntt[k];
-      }
+  uint64_t* data_array = result;
+  ForEachStrided(
+      key_component_count * decomp_modulus_size, num_threads,
+      [&](uint64_t thread, uint64_t index) {
+        const uint64_t key_component = index / decomp_modulus_size;
+        const uint64_t i = index % decomp_modulus_size;
+        uint64_t* t_poly_prod_it =
+            &t_poly_prod[key_component * coeff_count * rns_modulus_size];
+
+        RescaleRemainingModuli(t_poly_prod_it, t_poly_prod_it, coeff_count,
+                               rescale_moduli, last_modulus,
+                               &t_last[key_component * coeff_count],
+                               modswitch_factors, modswitch_precon,
+                               workspace.NTT(thread), i, i + 1);
+
+        uint64_t data_ptr_offset =
+            coeff_count * (decomp_modulus_size * key_component + i);
+
+        uint64_t* data_ptr = &data_array[data_ptr_offset];
+        intel::hexl::EltwiseAddMod(data_ptr, data_ptr,
+                                   &t_poly_prod_it[i * coeff_count],
+                                   coeff_count, moduli[i]);
+      });
+}
 
-      // qk^(-1) * ((ct mod qi) - (ct mod qk)) mod qi
-      intel::hexl::EltwiseFMAMod(t_ith_poly, t_ith_poly, modswitch_factors[i],
-                                 nullptr, coeff_count, moduli[i], 8);
-      uint64_t data_ptr_offset =
-          coeff_count * (decomp_modulus_size * key_component + i);
+}  // namespace
 
-      uint64_t* data_ptr = &data_array[data_ptr_offset];
-      intel::hexl::EltwiseAddMod(data_ptr, data_ptr, t_ith_poly, coeff_count,
-                                 moduli[i]);
-    }
+void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
+               uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+               uint64_t rns_modulus_size, uint64_t key_component_count,
+               const uint64_t* moduli, const uint64_t** k_switch_keys,
+               const uint64_t* modswitch_factors,
+               KeySwitchWorkspace& workspace,
+               const uint64_t* root_of_unity_powers_ptr,
+               const ExecutionPolicy& policy) {
+  if (root_of_unity_powers_ptr != nullptr) {
+    throw std::invalid_argument(
+        "Parameter root_of_unity_powers_ptr is not supported yet.");
   }
-  return;
+  KeySwitchImpl(result, t_target_iter_ptr, n, decomp_modulus_size,
+                key_modulus_size, rns_modulus_size, key_component_count,
+                moduli, k_switch_keys, nullptr, modswitch_factors, workspace,
+                policy);
+}
+
+void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
+               uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+               uint64_t rns_modulus_size, uint64_t key_component_count,
+               const uint64_t* moduli, const KeySwitchKeys& k_switch_keys,
+               const uint64_t* modswitch_factors,
+               KeySwitchWorkspace& workspace, const ExecutionPolicy& policy) {
+  HEXL_CHECK(k_switch_keys.Fits(n, decomp_modulus_size, key_modulus_size,
+                                key_component_count),
+             "k_switch_keys do not match the key switching parameters");
+  KeySwitchImpl(result, t_target_iter_ptr, n, decomp_modulus_size,
+                key_modulus_size, rns_modulus_size, key_component_count,
+                moduli, nullptr, &k_switch_keys, modswitch_factors, workspace,
+                policy);
 }
 
 }  // namespace internal
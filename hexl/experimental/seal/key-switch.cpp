@@ -15,11 +15,38 @@ void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
                uint64_t rns_modulus_size, uint64_t key_component_count,
                const uint64_t* moduli, const uint64_t** k_switch_keys,
                const uint64_t* modswitch_factors,
-               const uint64_t* root_of_unity_powers_ptr) {
+               const uint64_t* root_of_unity_powers_ptr,
+               const ExecutionPolicy& policy) {
   intel::hexl::internal::KeySwitch(
       result, t_target_iter_ptr, n, decomp_modulus_size, key_modulus_size,
       rns_modulus_size, key_component_count, moduli, k_switch_keys,
-      modswitch_factors, root_of_unity_powers_ptr);
+      modswitch_factors, root_of_unity_powers_ptr, policy);
+}
+
+void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
+               uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+               uint64_t rns_modulus_size, uint64_t key_component_count,
+               const uint64_t* moduli, const uint64_t** k_switch_keys,
+               const uint64_t* modswitch_factors,
+               KeySwitchWorkspace& workspace,
+               const uint64_t* root_of_unity_powers_ptr,
+               const ExecutionPolicy& policy) {
+  intel::hexl::internal::KeySwitch(
+      result, t_target_iter_ptr, n, decomp_modulus_size, key_modulus_size,
+      rns_modulus_size, key_component_count, moduli, k_switch_keys,
+      modswitch_factors, workspace, root_of_unity_powers_ptr, policy);
+}
+
+void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
+               uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+               uint64_t rns_modulus_size, uint64_t key_component_count,
+               const uint64_t* moduli, const KeySwitchKeys& k_switch_keys,
+               const uint64_t* modswitch_factors,
+               KeySwitchWorkspace& workspace, const ExecutionPolicy& policy) {
+  intel::hexl::internal::KeySwitch(
+      result, t_target_iter_ptr, n, decomp_modulus_size, key_modulus_size,
+      rns_modulus_size, key_component_count, moduli, k_switch_keys,
+      modswitch_factors, workspace, policy);
 }
 
 }  // namespace hexl
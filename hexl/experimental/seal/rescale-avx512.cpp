@@ -0,0 +1,105 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <immintrin.h>
+
+#include "experimental/seal/rescale-internal.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/defines.hpp"
+#include "util/avx512-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+
+void RescaleReduceLastAVX512(uint64_t* result, const uint64_t* last,
+                             uint64_t n, uint64_t modulus,
+                             uint64_t last_modulus, uint64_t fix) {
+  const uint64_t n_tail = n % 8;
+  if (n_tail != 0) {
+    RescaleReduceLastNative(result, last, n_tail, modulus, last_modulus, fix);
+    result += n_tail;
+    last += n_tail;
+    n -= n_tail;
+  }
+
+  __m512i v_modulus = _mm512_set1_epi64(static_cast<int64_t>(modulus));
+  __m512i v_fix = _mm512_set1_epi64(static_cast<int64_t>(fix));
+  const __m512i* v_last = reinterpret_cast<const __m512i*>(last);
+  __m512i* v_result = reinterpret_cast<__m512i*>(result);
+
+  if (last_modulus <= modulus) {
+    for (size_t i = n / 8; i > 0; --i) {
+      __m512i v = _mm512_loadu_si512(v_last);
+      _mm512_storeu_si512(v_result, _mm512_add_epi64(v, v_fix));
+      ++v_last;
+      ++v_result;
+    }
+    return;
+  }
+
+  __m512i v_barr = _mm512_set1_epi64(
+      static_cast<int64_t>(MultiplyFactor(1, 64, modulus).BarrettFactor()));
+  __m512i v_neg_modulus = _mm512_set1_epi64(-static_cast<int64_t>(modulus));
+  for (size_t i = n / 8; i > 0; --i) {
+    __m512i v = _mm512_loadu_si512(v_last);
+    v = _mm512_hexl_barrett_reduce64<64, 1>(v, v_modulus, v_barr, v_barr, 0,
+                                            v_neg_modulus);
+    _mm512_storeu_si512(v_result, _mm512_add_epi64(v, v_fix));
+    ++v_last;
+    ++v_result;
+  }
+}
+
+void RescaleSubtractScaleAVX512(uint64_t* result, const uint64_t* operand,
+                                const uint64_t* last_ntt, uint64_t n,
+                                uint64_t modulus, uint64_t inv_last_modulus,
+                                uint64_t inv_last_modulus_precon) {
+  const uint64_t n_tail = n % 8;
+  if (n_tail != 0) {
+    RescaleSubtractScaleNative(result, operand, last_ntt, n_tail, modulus,
+                               inv_last_modulus, inv_last_modulus_precon);
+    result += n_tail;
+    operand += n_tail;
+    last_ntt += n_tail;
+    n -= n_tail;
+  }
+
+  __m512i v_modulus = _mm512_set1_epi64(static_cast<int64_t>(modulus));
+  __m512i v_modulus_times_4 =
+      _mm512_set1_epi64(static_cast<int64_t>(modulus << 2));
+  __m512i v_neg_modulus = _mm512_set1_epi64(-static_cast<int64_t>(modulus));
+  __m512i v_inv = _mm512_set1_epi64(static_cast<int64_t>(inv_last_modulus));
+  __m512i v_inv_precon =
+      _mm512_set1_epi64(static_cast<int64_t>(inv_last_modulus_precon));
+
+  const __m512i* v_operand = reinterpret_cast<const __m512i*>(operand);
+  const __m512i* v_last_ntt = reinterpret_cast<const __m512i*>(last_ntt);
+  __m512i* v_result = reinterpret_cast<__m512i*>(result);
+
+  for (size_t i = n / 8; i > 0; --i) {
+    __m512i v_x = _mm512_loadu_si512(v_operand);
+    __m512i v_y = _mm512_loadu_si512(v_last_ntt);
+
+    // In (0, 5q)
+    __m512i v_diff =
+        _mm512_sub_epi64(_mm512_add_epi64(v_x, v_modulus_times_4), v_y);
+
+    // Shoup multiplication, in [0, 2q)
+    __m512i v_prod = _mm512_hexl_mullo_epi<64>(v_diff, v_inv);
+    __m512i v_q = _mm512_hexl_mulhi_epi<64>(v_diff, v_inv_precon);
+    v_q = _mm512_hexl_mullo_add_lo_epi<64>(v_prod, v_q, v_neg_modulus);
+    v_q = _mm512_hexl_small_mod_epu64(v_q, v_modulus);
+
+    _mm512_storeu_si512(v_result, v_q);
+    ++v_operand;
+    ++v_last_ntt;
+    ++v_result;
+  }
+}
+
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,67 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include "hexl/util/defines.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Computes last = INTT(operand_last) + floor(last_modulus / 2) mod
+/// last_modulus, the rounded last residue in coefficient form
+/// @param[in] operand_last Last residue polynomial in NTT form
+void RescaleLastResidue(uint64_t* last, const uint64_t* operand_last,
+                        uint64_t n, uint64_t last_modulus);
+
+/// @brief Divides the residues begin through end - 1 of \p operand by the
+/// last modulus, as in RescaleDivideRoundLastModulus
+/// @param[in] last Output of RescaleLastResidue
+/// @param[in] inv_last_moduli Inverses of the last modulus, modulo each of
+/// \p moduli
+/// @param[in] inv_last_moduli_precon floor(2^64 * inv_last_moduli[i] /
+/// moduli[i]) for each modulus
+/// @param[out] last_ntt Scratch space of \p n elements
+void RescaleRemainingModuli(uint64_t* result, const uint64_t* operand,
+                            uint64_t n, const uint64_t* moduli,
+                            uint64_t last_modulus, const uint64_t* last,
+                            const uint64_t* inv_last_moduli,
+                            const uint64_t* inv_last_moduli_precon,
+                            uint64_t* last_ntt, uint64_t begin, uint64_t end);
+
+/// @brief Computes result = (last mod modulus) + fix, in [0, 2 * modulus)
+/// @param[in] last Values in [0, last_modulus)
+/// @param[in] fix Value in [0, modulus]
+void RescaleReduceLastNative(uint64_t* result, const uint64_t* last,
+                             uint64_t n, uint64_t modulus,
+                             uint64_t last_modulus, uint64_t fix);
+
+/// @brief Computes result = (operand + 4 * modulus - last_ntt) *
+/// inv_last_modulus mod modulus, in [0, modulus)
+/// @param[in] operand Values in [0, modulus)
+/// @param[in] last_ntt Values in [0, 4 * modulus)
+/// @param[in] inv_last_modulus Inverse of the dropped modulus, mod modulus
+/// @param[in] inv_last_modulus_precon floor(2^64 * inv_last_modulus /
+/// modulus)
+void RescaleSubtractScaleNative(uint64_t* result, const uint64_t* operand,
+                                const uint64_t* last_ntt, uint64_t n,
+                                uint64_t modulus, uint64_t inv_last_modulus,
+                                uint64_t inv_last_modulus_precon);
+
+#ifdef HEXL_HAS_AVX512DQ
+/// @brief AVX512-DQ implementation of RescaleReduceLastNative
+void RescaleReduceLastAVX512(uint64_t* result, const uint64_t* last,
+                             uint64_t n, uint64_t modulus,
+                             uint64_t last_modulus, uint64_t fix);
+
+/// @brief AVX512-DQ implementation of RescaleSubtractScaleNative
+void RescaleSubtractScaleAVX512(uint64_t* result, const uint64_t* operand,
+                                const uint64_t* last_ntt, uint64_t n,
+                                uint64_t modulus, uint64_t inv_last_modulus,
+                                uint64_t inv_last_modulus_precon);
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,142 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/experimental/seal/rescale.hpp"
+
+#include "experimental/seal/rescale-internal.hpp"
+#include "hexl/eltwise/eltwise-add-mod.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/ntt/ntt-cache.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "hexl/util/check.hpp"
+#include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
+
+namespace intel {
+namespace hexl {
+
+void RescaleDivideRoundLastModulus(uint64_t* result, const uint64_t* operand,
+                                   uint64_t n, const uint64_t* moduli,
+                                   uint64_t num_moduli,
+                                   const ExecutionPolicy& policy) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand != nullptr, "Require operand != nullptr");
+  HEXL_CHECK(moduli != nullptr, "Require moduli != nullptr");
+  HEXL_CHECK(num_moduli >= 2, "Require num_moduli >= 2");
+  for (uint64_t i = 0; i < num_moduli; ++i) {
+    HEXL_CHECK(moduli[i] < (1ULL << 61),
+               "Require modulus < 2^61, got " << moduli[i]);
+    HEXL_CHECK_BOUNDS(&operand[i * n], n, moduli[i],
+                      "operand exceeds bound " << moduli[i]);
+  }
+
+  const uint64_t num_remaining = num_moduli - 1;
+  const uint64_t last_modulus = moduli[num_remaining];
+
+  AlignedVector64<uint64_t> last(n);
+  RescaleLastResidue(last.data(), &operand[num_remaining * n], n,
+                     last_modulus);
+
+  AlignedVector64<uint64_t> inv_last_moduli(num_remaining);
+  AlignedVector64<uint64_t> inv_last_moduli_precon(num_remaining);
+  for (uint64_t i = 0; i < num_remaining; ++i) {
+    inv_last_moduli[i] = InverseMod(last_modulus % moduli[i], moduli[i]);
+    inv_last_moduli_precon[i] =
+        MultiplyFactor(inv_last_moduli[i], 64, moduli[i]).BarrettFactor();
+  }
+
+  auto rescale_range = [&](uint64_t begin, uint64_t end) {
+    AlignedVector64<uint64_t> last_ntt(n);
+    RescaleRemainingModuli(result, operand, n, moduli, last_modulus,
+                           last.data(), inv_last_moduli.data(),
+                           inv_last_moduli_precon.data(), last_ntt.data(),
+                           begin, end);
+  };
+
+  ParallelFor(num_remaining, policy, rescale_range, n);
+}
+
+void RescaleLastResidue(uint64_t* last, const uint64_t* operand_last,
+                        uint64_t n, uint64_t last_modulus) {
+  // Last residue in coefficient form, plus half the last modulus to round
+  // rather than floor
+  GetNTT(n, last_modulus)->ComputeInverse(last, operand_last, 1, 1);
+  EltwiseAddMod(last, last, last_modulus >> 1, n, last_modulus);
+}
+
+void RescaleRemainingModuli(uint64_t* result, const uint64_t* operand,
+                            uint64_t n, const uint64_t* moduli,
+                            uint64_t last_modulus, const uint64_t* last,
+                            const uint64_t* inv_last_moduli,
+                            const uint64_t* inv_last_moduli_precon,
+                            uint64_t* last_ntt, uint64_t begin, uint64_t end) {
+  const uint64_t half = last_modulus >> 1;
+  for (uint64_t i = begin; i < end; ++i) {
+    const uint64_t modulus = moduli[i];
+    // Subtracts half again, in the remaining modulus
+    const uint64_t fix = modulus - (half % modulus);
+    const uint64_t inv_last_modulus = inv_last_moduli[i];
+    const uint64_t inv_last_modulus_precon = inv_last_moduli_precon[i];
+
+#ifdef HEXL_HAS_AVX512DQ
+    if (has_avx512dq) {
+      RescaleReduceLastAVX512(last_ntt, last, n, modulus, last_modulus, fix);
+    } else {
+#endif
+      RescaleReduceLastNative(last_ntt, last, n, modulus, last_modulus, fix);
+#ifdef HEXL_HAS_AVX512DQ
+    }
+#endif
+
+    // Inputs in [0, 2q), outputs in [0, 4q)
+    GetNTT(n, modulus)->ComputeForward(last_ntt, last_ntt, 2, 4);
+
+#ifdef HEXL_HAS_AVX512DQ
+    if (has_avx512dq) {
+      HEXL_VLOG(3, "Calling RescaleSubtractScaleAVX512");
+      RescaleSubtractScaleAVX512(&result[i * n], &operand[i * n], last_ntt, n,
+                                 modulus, inv_last_modulus,
+                                 inv_last_modulus_precon);
+      continue;
+    }
+#endif
+    HEXL_VLOG(3, "Calling RescaleSubtractScaleNative");
+    RescaleSubtractScaleNative(&result[i * n], &operand[i * n], last_ntt, n,
+                               modulus, inv_last_modulus,
+                               inv_last_modulus_precon);
+  }
+}
+
+void RescaleReduceLastNative(uint64_t* result, const uint64_t* last,
+                             uint64_t n, uint64_t modulus,
+                             uint64_t last_modulus, uint64_t fix) {
+  if (last_modulus <= modulus) {
+    for (size_t i = 0; i < n; ++i) {
+      result[i] = last[i] + fix;
+    }
+    return;
+  }
+  const uint64_t barrett_factor =
+      MultiplyFactor(1, 64, modulus).BarrettFactor();
+  for (size_t i = 0; i < n; ++i) {
+    result[i] = BarrettReduce64(last[i], modulus, barrett_factor) + fix;
+  }
+}
+
+void RescaleSubtractScaleNative(uint64_t* result, const uint64_t* operand,
+                                const uint64_t* last_ntt, uint64_t n,
+                                uint64_t modulus, uint64_t inv_last_modulus,
+                                uint64_t inv_last_modulus_precon) {
+  // In (0, 5q), so below 2^64 for q < 2^61
+  const uint64_t modulus_times_4 = modulus << 2;
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t diff = operand[i] + modulus_times_4 - last_ntt[i];
+    uint64_t scaled = MultiplyModLazy<64>(diff, inv_last_modulus,
+                                          inv_last_modulus_precon, modulus);
+    result[i] = ReduceMod<2>(scaled, modulus);
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
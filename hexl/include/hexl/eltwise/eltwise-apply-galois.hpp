@@ -0,0 +1,134 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "hexl/util/aligned-allocator.hpp"
+#include "hexl/util/execution-policy.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Precomputed index tables of the Galois automorphism \f$ X \mapsto
+/// X^g \f$ of \f$ \mathbb{Z}_q[X] / (X^N + 1) \f$, for a degree N and odd
+/// Galois element g
+/// @details The tables are independent of the modulus, so one permutation
+/// serves every residue polynomial of an RNS basis.
+class GaloisPermutation {
+ public:
+  /// @brief Flags a coefficient-form source index whose value is negated
+  static constexpr uint32_t s_negate_flag{1U << 31};
+
+  /// @brief Computes the tables of the automorphism
+  /// @param[in] n Degree of the polynomial ring. Must be a power of two, less
+  /// than 2^31
+  /// @param[in] galois_elt Galois element g. Must be odd and less than 2 * n
+  GaloisPermutation(uint64_t n, uint64_t galois_elt);
+
+  /// @brief Returns the degree N
+  uint64_t GetDegree() const { return m_degree; }
+
+  /// @brief Returns the Galois element g
+  uint64_t GetGaloisElt() const { return m_galois_elt; }
+
+  /// @brief Returns, for each coefficient j of the result in coefficient
+  /// form, the index of its source coefficient, with s_negate_flag set if the
+  /// source is negated
+  const AlignedVector64<uint32_t>& GetCoeffSourceIndices() const {
+    return m_coeff_source;
+  }
+
+  /// @brief Returns, for each index j of the result in NTT form, the index of
+  /// its source value. Both are in the bit-reversed order of NTT outputs.
+  const AlignedVector64<uint32_t>& GetNTTSourceIndices() const {
+    return m_ntt_source;
+  }
+
+ private:
+  uint64_t m_degree;
+  uint64_t m_galois_elt;
+  AlignedVector64<uint32_t> m_coeff_source;
+  AlignedVector64<uint32_t> m_ntt_source;
+};
+
+/// @brief Maximum number of permutations cached per thread by
+/// GetGaloisPermutation
+constexpr size_t s_max_cached_galois_permutations{32};
+
+/// @brief Returns the permutation of degree \p n and Galois element \p
+/// galois_elt, computing it on first use
+/// @details Each thread caches its s_max_cached_galois_permutations most
+/// recently used permutations, so lookups take no lock. Callers which apply
+/// many Galois elements should own their permutations instead, and pass them
+/// to the GaloisPermutation overloads below.
+std::shared_ptr<const GaloisPermutation> GetGaloisPermutation(
+    uint64_t n, uint64_t galois_elt);
+
+/// @brief Applies the Galois automorphism \f$ X \mapsto X^g \f$ to a
+/// polynomial in coefficient form
+/// @details Coefficient i of \p operand moves to index i * g mod 2N, and is
+/// negated if that index is at least N, since \f$ X^N = -1 \f$.
+/// @param[out] result Stores the result. Must not alias \p operand
+/// @param[in] operand Polynomial in coefficient form, with coefficients in
+/// [0, modulus)
+/// @param[in] n Number of coefficients. Must be a power of two
+/// @param[in] galois_elt Galois element g. Must be odd and less than 2 * n
+/// @param[in] modulus Modulus of the coefficients
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
+void EltwiseApplyGalois(uint64_t* result, const uint64_t* operand, uint64_t n,
+                        uint64_t galois_elt, uint64_t modulus,
+                        const ExecutionPolicy& policy =
+                            ExecutionPolicy::Serial());
+
+/// @brief Applies the Galois automorphism of \p permutation to a polynomial
+/// in coefficient form, as in EltwiseApplyGalois
+/// @param[out] result Stores the result. Must not alias \p operand
+/// @param[in] operand Polynomial in coefficient form, with
+/// permutation.GetDegree() coefficients in [0, modulus)
+/// @param[in] permutation Permutation of the automorphism
+/// @param[in] modulus Modulus of the coefficients
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
+void EltwiseApplyGalois(uint64_t* result, const uint64_t* operand,
+                        const GaloisPermutation& permutation, uint64_t modulus,
+                        const ExecutionPolicy& policy =
+                            ExecutionPolicy::Serial());
+
+/// @brief Applies the Galois automorphism \f$ X \mapsto X^g \f$ to a
+/// polynomial in NTT form
+/// @details Permutes the evaluations, in the bit-reversed order output by
+/// NTT::ComputeForward, so that this commutes with the forward NTT:
+/// ComputeForward(EltwiseApplyGalois(x)) = EltwiseApplyGaloisNTT(
+/// ComputeForward(x)). No modular arithmetic is needed, so any input range is
+/// preserved.
+/// @param[out] result Stores the result. Must not alias \p operand
+/// @param[in] operand Polynomial in NTT form
+/// @param[in] n Number of values. Must be a power of two
+/// @param[in] galois_elt Galois element g. Must be odd and less than 2 * n
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
+void EltwiseApplyGaloisNTT(uint64_t* result, const uint64_t* operand,
+                           uint64_t n, uint64_t galois_elt,
+                           const ExecutionPolicy& policy =
+                               ExecutionPolicy::Serial());
+
+/// @brief Applies the Galois automorphism of \p permutation to a polynomial
+/// in NTT form, as in EltwiseApplyGaloisNTT
+/// @param[out] result Stores the result. Must not alias \p operand
+/// @param[in] operand Polynomial in NTT form, with permutation.GetDegree()
+/// values
+/// @param[in] permutation Permutation of the automorphism
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
+void EltwiseApplyGaloisNTT(uint64_t* result, const uint64_t* operand,
+                           const GaloisPermutation& permutation,
+                           const ExecutionPolicy& policy =
+                               ExecutionPolicy::Serial());
+
+}  // namespace hexl
+}  // namespace intel
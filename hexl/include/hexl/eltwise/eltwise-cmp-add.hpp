@@ -5,6 +5,7 @@
 
 #include <stdint.h>
 
+#include "hexl/util/execution-policy.hpp"
 #include "hexl/util/util.hpp"
 
 namespace intel {
@@ -17,10 +18,13 @@ namespace hexl {
 /// @param[in] cmp Comparison operation
 /// @param[in] bound Scalar to compare against
 /// @param[in] diff Scalar to conditionally add
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
 /// @details Computes result[i] = cmp(operand1[i], bound) ? operand1[i] +
 /// diff : operand1[i] for all \f$i=0, ..., n-1\f$.
 void EltwiseCmpAdd(uint64_t* result, const uint64_t* operand1, uint64_t n,
-                   CMPINT cmp, uint64_t bound, uint64_t diff);
+                   CMPINT cmp, uint64_t bound, uint64_t diff,
+                   const ExecutionPolicy& policy = ExecutionPolicy::Serial());
 
 }  // namespace hexl
 }  // namespace intel
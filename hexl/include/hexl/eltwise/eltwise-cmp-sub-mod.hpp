@@ -5,6 +5,7 @@
 
 #include <stdint.h>
 
+#include "hexl/util/execution-policy.hpp"
 #include "hexl/util/util.hpp"
 
 namespace intel {
@@ -18,12 +19,16 @@ namespace hexl {
 /// @param[in] cmp Comparison function
 /// @param[in] bound Scalar to compare against
 /// @param[in] diff Scalar to subtract by
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
 /// @details Computes \p operand1[i] = (\p cmp(\p operand1, \p bound)) ? (\p
 /// operand1 - \p diff) mod \p modulus : \p operand1 mod \p modulus for all i=0,
 /// ..., n-1
 void EltwiseCmpSubMod(uint64_t* result, const uint64_t* operand1, uint64_t n,
                       uint64_t modulus, CMPINT cmp, uint64_t bound,
-                      uint64_t diff);
+                      uint64_t diff,
+                      const ExecutionPolicy& policy =
+                          ExecutionPolicy::Serial());
 
 }  // namespace hexl
 }  // namespace intel
@@ -0,0 +1,38 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include "hexl/util/execution-policy.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Computes the element-wise dot product of two vectors of polynomials
+/// with modular reduction
+/// @param[out] result Stores the result. May alias an operand
+/// @param[in] operand1 Pointers to \p count vectors of \p n elements. Each
+/// element must be less than the modulus.
+/// @param[in] operand2 Pointers to \p count vectors of \p n elements. Each
+/// element must be less than the modulus.
+/// @param[in] count Number of vectors in each operand
+/// @param[in] n Number of elements in each vector
+/// @param[in] modulus Modulus with which to perform modular reduction. Must be
+/// in the range \f$ [2, 2^{62} - 1] \f$
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
+/// @details Computes \p result[j] = (sum_i \p operand1[i][j] * \p
+/// operand2[i][j]) mod \p modulus for j=0, ..., \p n - 1. The products are
+/// accumulated without reduction in 128-bit values, so each element is
+/// usually reduced only once, rather than once per product with
+/// EltwiseMultMod and EltwiseAddMod.
+void EltwiseDotProductMod(
+    uint64_t* result, const uint64_t* const* operand1,
+    const uint64_t* const* operand2, uint64_t count, uint64_t n,
+    uint64_t modulus,
+    const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+}  // namespace hexl
+}  // namespace intel
@@ -5,6 +5,8 @@
 
 #include <stdint.h>
 
+#include "hexl/util/execution-policy.hpp"
+
 namespace intel {
 namespace hexl {
 
@@ -19,9 +21,12 @@ namespace hexl {
 /// in the range \f$ [2, 2^{61} - 1]\f$
 /// @param[in] input_mod_factor Assumes input elements are in [0,
 /// input_mod_factor * modulus). Must be 1, 2, 4, or 8.
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
 void EltwiseFMAMod(uint64_t* result, const uint64_t* arg1, uint64_t arg2,
                    const uint64_t* arg3, uint64_t n, uint64_t modulus,
-                   uint64_t input_mod_factor);
+                   uint64_t input_mod_factor,
+                   const ExecutionPolicy& policy = ExecutionPolicy::Serial());
 
 }  // namespace hexl
 }  // namespace intel
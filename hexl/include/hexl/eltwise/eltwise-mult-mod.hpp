@@ -5,6 +5,8 @@
 
 #include <stdint.h>
 
+#include "hexl/util/execution-policy.hpp"
+
 namespace intel {
 namespace hexl {
 
@@ -18,11 +20,14 @@ namespace hexl {
 /// @param[in] modulus Modulus with which to perform modular reduction
 /// @param[in] input_mod_factor Assumes input elements are in [0,
 /// input_mod_factor * p) Must be 1, 2 or 4.
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
 /// @details Computes \p result[i] = (\p operand1[i] * \p operand2[i]) mod \p
 /// modulus for i=0, ..., \p n - 1
 void EltwiseMultMod(uint64_t* result, const uint64_t* operand1,
                     const uint64_t* operand2, uint64_t n, uint64_t modulus,
-                    uint64_t input_mod_factor);
+                    uint64_t input_mod_factor,
+                    const ExecutionPolicy& policy = ExecutionPolicy::Serial());
 
 }  // namespace hexl
 }  // namespace intel
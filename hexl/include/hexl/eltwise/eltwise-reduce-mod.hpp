@@ -5,6 +5,8 @@
 
 #include <stdint.h>
 
+#include "hexl/util/execution-policy.hpp"
+
 namespace intel {
 namespace hexl {
 
@@ -21,9 +23,13 @@ namespace hexl {
 /// @param[in] output_mod_factor output elements will be in [0,
 /// output_mod_factor * modulus) Must be 1 or 2. For input_mod_factor=0,
 /// output_mod_factor will be set to 1.
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
 void EltwiseReduceMod(uint64_t* result, const uint64_t* operand, uint64_t n,
                       uint64_t modulus, uint64_t input_mod_factor,
-                      uint64_t output_mod_factor);
+                      uint64_t output_mod_factor,
+                      const ExecutionPolicy& policy =
+                          ExecutionPolicy::Serial());
 
 }  // namespace hexl
 }  // namespace intel
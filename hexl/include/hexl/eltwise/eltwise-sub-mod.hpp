@@ -5,6 +5,8 @@
 
 #include <stdint.h>
 
+#include "hexl/util/execution-policy.hpp"
+
 namespace intel {
 namespace hexl {
 
@@ -17,10 +19,13 @@ namespace hexl {
 /// @param[in] n Number of elements in each vector
 /// @param[in] modulus Modulus with which to perform modular reduction. Must be
 /// in the range \f$[2, 2^{63} - 1]\f$
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
 /// @details Computes \f$ operand1[i] = (operand1[i] - operand2[i]) \mod modulus
 /// \f$ for \f$ i=0, ..., n-1\f$.
 void EltwiseSubMod(uint64_t* result, const uint64_t* operand1,
-                   const uint64_t* operand2, uint64_t n, uint64_t modulus);
+                   const uint64_t* operand2, uint64_t n, uint64_t modulus,
+                   const ExecutionPolicy& policy = ExecutionPolicy::Serial());
 
 /// @brief Subtracts a scalar from a vector elementwise with modular reduction
 /// @param[out] result Stores result
@@ -31,10 +36,13 @@ void EltwiseSubMod(uint64_t* result, const uint64_t* operand1,
 /// @param[in] n Number of elements in each vector
 /// @param[in] modulus Modulus with which to perform modular reduction. Must be
 /// in the range \f$[2, 2^{63} - 1]\f$
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
 /// @details Computes \f$ operand1[i] = (operand1[i] - operand2) \mod modulus
 /// \f$ for \f$ i=0, ..., n-1\f$.
 void EltwiseSubMod(uint64_t* result, const uint64_t* operand1,
-                   uint64_t operand2, uint64_t n, uint64_t modulus);
+                   uint64_t operand2, uint64_t n, uint64_t modulus,
+                   const ExecutionPolicy& policy = ExecutionPolicy::Serial());
 
 }  // namespace hexl
 }  // namespace intel
@@ -0,0 +1,36 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <complex>
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+
+/// @brief AVX2 implementation of FFTLike::BuildFloatingPoints
+/// @details Converts four coefficients at a time, with the same operations as
+/// BuildFloatingPointsNative, so the results are bit-exact with it.
+/// @param[out] res Stores coeff_count values with zero imaginary part
+/// @param[in] plain CRT-composed coefficients, each with mod_size 64-bit words
+/// from least to most significant
+/// @param[in] threshold Upper half threshold, with mod_size words
+/// @param[in] decryption_modulus Product of all primes in the coefficient
+/// modulus, with mod_size words
+/// @param[in] inv_scale Scale applied to output values
+/// @param[in] mod_size Number of words of each coefficient
+/// @param[in] coeff_count Number of coefficients
+void BuildFloatingPointsAVX2(std::complex<double>* res, const uint64_t* plain,
+                             const uint64_t* threshold,
+                             const uint64_t* decryption_modulus,
+                             const double inv_scale, size_t mod_size,
+                             size_t coeff_count);
+
+#endif  // HEXL_HAS_AVX256
+
+}  // namespace hexl
+}  // namespace intel
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <complex>
+
 #include "util/avx512-util.hpp"
 
 namespace intel {
@@ -396,6 +398,28 @@ inline void ComplexWriteInvInterleavedT8(__m512d* v_X_real, __m512d* v_X_imag,
   _mm512_storeu_pd(v_Y_pt++, v_Y1);
   _mm512_storeu_pd(v_Y_pt, v_Y2);
 }
+
+// ComplexMulBroadcast:
+// Multiplies 4 interleaved complex numbers by the same complex number w.
+//  @param arg = (3i, 3r, 2i, 2r, 1i, 1r, 0i, 0r)
+//  @param w_real = (wr, wr, wr, wr, wr, wr, wr, wr)
+//  @param w_imag = (wi, -wi, wi, -wi, wi, -wi, wi, -wi)
+// Returns (3r*wi + 3i*wr, 3r*wr - 3i*wi, ..., 0r*wi + 0i*wr, 0r*wr - 0i*wi)
+inline __m512d ComplexMulBroadcast(__m512d arg, __m512d w_real,
+                                   __m512d w_imag) {
+  // 3r, 3i, 2r, 2i, 1r, 1i, 0r, 0i
+  __m512d arg_swap = _mm512_permute_pd(arg, 0x55);
+  return _mm512_add_pd(_mm512_mul_pd(arg, w_real),
+                       _mm512_mul_pd(arg_swap, w_imag));
+}
+
+// Returns the vectors w_real and w_imag of ComplexMulBroadcast for w
+inline void ComplexLoadBroadcast(std::complex<double> w, __m512d* w_real,
+                                 __m512d* w_imag) {
+  *w_real = _mm512_set1_pd(w.real());
+  *w_imag = _mm512_set_pd(w.imag(), -w.imag(), w.imag(), -w.imag(),
+                          w.imag(), -w.imag(), w.imag(), -w.imag());
+}
 #endif  // HEXL_HAS_AVX512DQ
 
 }  // namespace hexl
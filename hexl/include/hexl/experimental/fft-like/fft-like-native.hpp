@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <complex>
 
 namespace intel {
@@ -34,5 +37,68 @@ void Inverse_FFTLike_FromBitReverseRadix2(
     const std::complex<double>* inv_root_of_unity_powers, const uint64_t n,
     const double* scale = nullptr);
 
+/// @brief Radix-2 native C++ implementation of the forward FFT like of
+/// \p batch_count vectors at once
+/// @param[out] result Output data, in the layout of \p operand
+/// @param[in] operand Input data. Holds coefficient k of vector b at index k *
+/// \p batch_stride + b
+/// @param[in] root_of_unity_powers Powers of 2n'th root of unity. In
+/// bit-reversed order
+/// @param[in] n Size of each transform. Must be a power of two.
+/// @param[in] batch_count Number of vectors
+/// @param[in] batch_stride Distance between consecutive coefficients of a
+/// vector; at least \p batch_count
+/// @param[in] scale Scale applied to output data
+/// @details Each root of unity is loaded once for all the vectors
+void Forward_FFTLike_ToBitReverseBatchRadix2(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* root_of_unity_powers, const uint64_t n,
+    uint64_t batch_count, uint64_t batch_stride,
+    const double* scale = nullptr);
+
+/// @brief Radix-2 native C++ implementation of the inverse FFT like of
+/// \p batch_count vectors at once
+/// @param[out] result Output data, in the layout of \p operand
+/// @param[in] operand Input data. Holds coefficient k of vector b at index k *
+/// \p batch_stride + b
+/// @param[in] inv_root_of_unity_powers Powers of inverse 2n'th root of unity.
+/// In bit-reversed order.
+/// @param[in] n Size of each transform. Must be a power of two.
+/// @param[in] batch_count Number of vectors
+/// @param[in] batch_stride Distance between consecutive coefficients of a
+/// vector; at least \p batch_count
+/// @param[in] scale Scale applied to output data
+/// @details Each root of unity is loaded once for all the vectors
+void Inverse_FFTLike_FromBitReverseBatchRadix2(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* inv_root_of_unity_powers, const uint64_t n,
+    uint64_t batch_count, uint64_t batch_stride,
+    const double* scale = nullptr);
+
+/// @brief Copies \p batch_count vectors of \p n coefficients, in the layout
+/// of Forward_FFTLike_ToBitReverseBatchRadix2
+void CopyFFTLikeBatch(std::complex<double>* result,
+                      const std::complex<double>* operand, const uint64_t n,
+                      uint64_t batch_count, uint64_t batch_stride);
+
+/// @brief Native C++ implementation of FFTLike::BuildFloatingPoints
+/// @details Coefficients at or above the threshold are negative; their
+/// distance to the decryption modulus is computed with multi-precision
+/// subtraction before conversion, so no words cancel in floating-point.
+/// @param[out] res Stores coeff_count values with zero imaginary part
+/// @param[in] plain CRT-composed coefficients, each with mod_size 64-bit words
+/// from least to most significant
+/// @param[in] threshold Upper half threshold, with mod_size words
+/// @param[in] decryption_modulus Product of all primes in the coefficient
+/// modulus, with mod_size words
+/// @param[in] inv_scale Scale applied to output values
+/// @param[in] mod_size Number of words of each coefficient
+/// @param[in] coeff_count Number of coefficients
+void BuildFloatingPointsNative(std::complex<double>* res, const uint64_t* plain,
+                               const uint64_t* threshold,
+                               const uint64_t* decryption_modulus,
+                               const double inv_scale, size_t mod_size,
+                               size_t coeff_count);
+
 }  // namespace hexl
 }  // namespace intel
@@ -9,6 +9,7 @@
 #include "hexl/experimental/fft-like/inv-fft-like-avx512.hpp"
 #include "hexl/util/aligned-allocator.hpp"
 #include "hexl/util/allocator.hpp"
+#include "hexl/util/execution-policy.hpp"
 
 namespace intel {
 namespace hexl {
@@ -75,6 +76,36 @@ class FFTLike {
                              const std::complex<double>* operand,
                              const double* in_scale = nullptr);
 
+  /// @brief Compute forward FFT like of \p batch_size vectors at once.
+  /// Results are bit-reversed.
+  /// @param[out] result Stores the result, in the layout of \p operand
+  /// @param[in] operand Data on which to compute the FFT like. Holds
+  /// coefficient k of vector b at index k * \p batch_size + b, so that each
+  /// root of unity is loaded once for the whole batch
+  /// @param[in] batch_size Number of vectors
+  /// @param[in] in_scale Scale applied to output values
+  /// @param[in] policy Selects the threads used; each thread transforms a
+  /// disjoint subset of the vectors
+  void ComputeForwardFFTLikeBatch(
+      std::complex<double>* result, const std::complex<double>* operand,
+      uint64_t batch_size, const double* in_scale = nullptr,
+      const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+  /// @brief Compute inverse FFT like of \p batch_size vectors at once.
+  /// Results are bit-reversed.
+  /// @param[out] result Stores the result, in the layout of \p operand
+  /// @param[in] operand Data on which to compute the FFT like. Holds
+  /// coefficient k of vector b at index k * \p batch_size + b, so that each
+  /// root of unity is loaded once for the whole batch
+  /// @param[in] batch_size Number of vectors
+  /// @param[in] in_scale Scale applied to output values
+  /// @param[in] policy Selects the threads used; each thread transforms a
+  /// disjoint subset of the vectors
+  void ComputeInverseFFTLikeBatch(
+      std::complex<double>* result, const std::complex<double>* operand,
+      uint64_t batch_size, const double* in_scale = nullptr,
+      const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
   /// @brief Construct floating-point values from CRT-composed polynomial with
   /// integer coefficients.
   /// @param[out] res Stores the result
@@ -86,11 +117,12 @@ class FFTLike {
   /// @param[in] inv_scale Scale applied to output values
   /// @param[in] mod_size Size of coefficient modulus parameter
   /// @param[in] coeff_count Degree of the polynomial modulus parameter
-  void BuildFloatingPoints(std::complex<double>* res, const uint64_t* plain,
-                           const uint64_t* threshold,
-                           const uint64_t* decryption_modulus,
-                           const double inv_scale, size_t mod_size,
-                           size_t coeff_count);
+  /// @param[in] policy Selects the threads used to convert the coefficients
+  void BuildFloatingPoints(
+      std::complex<double>* res, const uint64_t* plain,
+      const uint64_t* threshold, const uint64_t* decryption_modulus,
+      const double inv_scale, size_t mod_size, size_t coeff_count,
+      const ExecutionPolicy& policy = ExecutionPolicy::Serial());
 
   /// @brief Returns the root of unity power at bit-reversed index i.
   /// @param[in] i Index
@@ -36,6 +36,15 @@ void Forward_FFTLike_ToBitReverseAVX512(
     const double* scale = nullptr, uint64_t recursion_depth = 0,
     uint64_t recursion_half = 0);
 
+/// @brief AVX512 implementation of Forward_FFTLike_ToBitReverseBatchRadix2
+/// @details Processes 4 vectors per SIMD register; the remaining
+/// batch_count % 4 vectors use the native implementation
+void Forward_FFTLike_ToBitReverseBatchAVX512(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* root_of_unity_powers, const uint64_t n,
+    uint64_t batch_count, uint64_t batch_stride,
+    const double* scale = nullptr);
+
 /// @brief Construct floating-point values from CRT-composed polynomial with
 /// integer coefficients in AVX512.
 /// @param[out] res_cmplx_intrlvd Stores the result
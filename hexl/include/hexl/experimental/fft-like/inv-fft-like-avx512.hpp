@@ -36,6 +36,15 @@ void Inverse_FFTLike_FromBitReverseAVX512(
     const double* scale = nullptr, uint64_t recursion_depth = 0,
     uint64_t recursion_half = 0);
 
+/// @brief AVX512 implementation of Inverse_FFTLike_FromBitReverseBatchRadix2
+/// @details Processes 4 vectors per SIMD register; the remaining
+/// batch_count % 4 vectors use the native implementation
+void Inverse_FFTLike_FromBitReverseBatchAVX512(
+    std::complex<double>* result, const std::complex<double>* operand,
+    const std::complex<double>* inv_root_of_unity_powers, const uint64_t n,
+    uint64_t batch_count, uint64_t batch_stride,
+    const double* scale = nullptr);
+
 #endif  // HEXL_HAS_AVX512DQ
 
 }  // namespace hexl
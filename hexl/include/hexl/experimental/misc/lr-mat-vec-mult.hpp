@@ -5,11 +5,38 @@
 
 #include <cstdint>
 
+#include "hexl/util/execution-policy.hpp"
+
 namespace intel {
 namespace hexl {
 
 /// @brief Computes transposed linear regression
-/// @param[in,out] result Ciphertext data. Will be over-written with result. Has
+/// @param[in,out] result Ciphertext data. Will be over-written with result in
+/// its first (3 * n * num_moduli) elements, and with partial sums elsewhere.
+/// Has (num_weights * 3 * n * num_moduli) elements
+/// @param[in] operand1 Vector of ciphertext representing a matrix that encodes
+/// a transposed logistic regression model. Has (num_weights * 2 * n *
+/// num_moduli) elements.
+/// @param[in] operand2 Vector of ciphertext representing a matrix that encodes
+/// at most n/2 input samples with feature size num_weights. Has (num_weights *
+/// 2 * n * num_moduli) elements.
+/// @param[in] n Number of coefficients in each polynomial
+/// @param[in] moduli Pointer to contiguous array of num_moduli word-sized
+/// coefficient moduli
+/// @param[in] num_moduli Number of word-sized coefficient moduli
+/// @param[in] num_weights Feature size of the linear/logistic regression model
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
+void LinRegMatrixVectorMultiply(
+    uint64_t* result, const uint64_t* operand1, const uint64_t* operand2,
+    uint64_t n, const uint64_t* moduli, uint64_t num_moduli,
+    uint64_t num_weights,
+    const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+/// @brief Computes transposed linear regression like
+/// LinRegMatrixVectorMultiply, accumulating the products of all weights
+/// before a single modular reduction
+/// @param[out] result Ciphertext data. Will be over-written with result. Has
 /// (3 * n * num_moduli) elements
 /// @param[in] operand1 Vector of ciphertext representing a matrix that encodes
 /// a transposed logistic regression model. Has (num_weights * 2 * n *
@@ -22,10 +49,15 @@ namespace hexl {
 /// coefficient moduli
 /// @param[in] num_moduli Number of word-sized coefficient moduli
 /// @param[in] num_weights Feature size of the linear/logistic regression model
-void LinRegMatrixVectorMultiply(uint64_t* result, const uint64_t* operand1,
-                                const uint64_t* operand2, uint64_t n,
-                                const uint64_t* moduli, uint64_t num_moduli,
-                                uint64_t num_weights);
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
+/// @details The operands are streamed once, one tile of coefficients at a
+/// time, into 128-bit accumulators, so no partial sums are written to result
+void LinRegMatrixVectorMultiplyStreaming(
+    uint64_t* result, const uint64_t* operand1, const uint64_t* operand2,
+    uint64_t n, const uint64_t* moduli, uint64_t num_moduli,
+    uint64_t num_weights,
+    const ExecutionPolicy& policy = ExecutionPolicy::Serial());
 
 }  // namespace hexl
 }  // namespace intel
@@ -0,0 +1,102 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+
+#include "hexl/util/execution-policy.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Multiplies a plaintext matrix with a ciphertext vector with the
+/// diagonal method of Halevi and Shoup
+/// @details Computes result = sum_i diagonals[i] * rotated_operands[i] for i
+/// in [0, num_diagonals), where diagonal i of the matrix is encoded into the
+/// slots of plaintext i, and rotated_operands[i] is the ciphertext vector
+/// rotated by i slots. The products are accumulated in 128-bit values, with a
+/// single modular reduction per coefficient in most cases.
+/// @param[out] result Ciphertext data. Will be over-written with result. Has
+/// (ciphertext_size * n * num_moduli) elements
+/// @param[in] diagonals Plaintexts in NTT form, with values in [0, moduli[i])
+/// for residue i. Has (num_diagonals * n * num_moduli) elements
+/// @param[in] rotated_operands Pointers to num_diagonals ciphertexts in NTT
+/// form, with values in [0, moduli[i]) for residue i. Each has
+/// (ciphertext_size * n * num_moduli) elements
+/// @param[in] n Number of coefficients in each polynomial
+/// @param[in] moduli Pointer to contiguous array of num_moduli word-sized
+/// coefficient moduli
+/// @param[in] num_moduli Number of word-sized coefficient moduli
+/// @param[in] ciphertext_size Number of polynomials in each ciphertext
+/// @param[in] num_diagonals Number of diagonals of the matrix
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
+void PlainMatrixVectorMultiplyDiagonal(
+    uint64_t* result, const uint64_t* diagonals,
+    const uint64_t* const* rotated_operands, uint64_t n,
+    const uint64_t* moduli, uint64_t num_moduli, uint64_t ciphertext_size,
+    uint64_t num_diagonals,
+    const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+/// @brief Computes the giant-step sums of a plaintext matrix times a ciphertext
+/// vector with the baby-step giant-step diagonal method
+/// @details With b = baby_steps, the product of a matrix with b * giant_steps
+/// diagonals d_k and a vector v is sum_j rot_{j * b}(sum_i rot_{-j * b}(d_{j *
+/// b + i}) * rot_i(v)). Computes result[j] = sum_i diagonals[j * b + i] *
+/// rotated_operands[i] for j in [0, giant_steps), where diagonals holds the
+/// rotated diagonals rot_{-j * b}(d_{j * b + i}), e.g. from
+/// RotateDiagonalsBSGS. The caller rotates result[j] by j * b slots and adds
+/// up the giant steps, so only b + giant_steps - 2 ciphertext rotations are
+/// needed.
+/// @param[out] result Ciphertext data. Will be over-written with result. Has
+/// (giant_steps * ciphertext_size * n * num_moduli) elements
+/// @param[in] diagonals Rotated plaintexts in NTT form, with values in [0,
+/// moduli[i]) for residue i. Has (giant_steps * baby_steps * n * num_moduli)
+/// elements
+/// @param[in] rotated_operands Pointers to baby_steps ciphertexts in NTT form,
+/// the vector rotated by i slots for i in [0, baby_steps), with values in [0,
+/// moduli[i]) for residue i. Each has (ciphertext_size * n * num_moduli)
+/// elements
+/// @param[in] n Number of coefficients in each polynomial
+/// @param[in] moduli Pointer to contiguous array of num_moduli word-sized
+/// coefficient moduli
+/// @param[in] num_moduli Number of word-sized coefficient moduli
+/// @param[in] ciphertext_size Number of polynomials in each ciphertext
+/// @param[in] baby_steps Number of rotations of the vector
+/// @param[in] giant_steps Number of rotations of the giant-step sums
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
+void PlainMatrixVectorMultiplyBSGS(
+    uint64_t* result, const uint64_t* diagonals,
+    const uint64_t* const* rotated_operands, uint64_t n,
+    const uint64_t* moduli, uint64_t num_moduli, uint64_t ciphertext_size,
+    uint64_t baby_steps, uint64_t giant_steps,
+    const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+/// @brief Rotates the diagonals of a plaintext matrix for
+/// PlainMatrixVectorMultiplyBSGS
+/// @details Applies the Galois automorphism galois_elts[j], which rotates the
+/// slots by -j * baby_steps, to diagonals j * baby_steps + i in NTT form.
+/// Usually done once per matrix.
+/// @param[out] result Stores the rotated diagonals. Has (giant_steps *
+/// baby_steps * n * num_moduli) elements. Must not alias \p diagonals
+/// @param[in] diagonals Plaintexts in NTT form. Has (giant_steps * baby_steps
+/// * n * num_moduli) elements
+/// @param[in] n Number of coefficients in each polynomial. Must be a power of
+/// two
+/// @param[in] num_moduli Number of word-sized coefficient moduli
+/// @param[in] baby_steps Number of rotations of the vector
+/// @param[in] giant_steps Number of rotations of the giant-step sums
+/// @param[in] galois_elts Galois elements of the giant steps, each odd and
+/// less than 2 * n. Has giant_steps elements
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
+void RotateDiagonalsBSGS(
+    uint64_t* result, const uint64_t* diagonals, uint64_t n,
+    uint64_t num_moduli, uint64_t baby_steps, uint64_t giant_steps,
+    const uint64_t* galois_elts,
+    const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+}  // namespace hexl
+}  // namespace intel
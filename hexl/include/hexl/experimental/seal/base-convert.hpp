@@ -0,0 +1,91 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "hexl/util/execution-policy.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Converts polynomials in residue number system (RNS) form from one
+/// base of moduli to another
+/// @details Fast base conversion from base \f$ Q = q_0 \cdots q_{k-1} \f$ to
+/// base \f$ P = \{p_0, \dots, p_{l-1}\} \f$ computes, for each modulus \f$ p_j
+/// \f$, \f[ \sum_{i=0}^{k-1} \left[ x_i \hat{q}_i^{-1} \right]_{q_i} \hat{q}_i
+/// \bmod p_j \f] with \f$ \hat{q}_i = Q / q_i \f$. The result is congruent to
+/// \f$ x + a Q \f$ modulo each \f$ p_j \f$, for some integer \f$ 0 \le a < k
+/// \f$, where \f$ x \in [0, Q) \f$ is the integer with residues \f$ x_i \f$.
+/// This is the base extension used in BFV multiplication, CKKS rescaling and
+/// hybrid key switching. The tables depending on the moduli are computed once,
+/// on construction.
+class BaseConverter {
+ public:
+  /// @brief Initializes an empty BaseConverter object
+  BaseConverter() = default;
+
+  /// @brief Initializes a BaseConverter object from base \p from_moduli to
+  /// base \p to_moduli
+  /// @param[in] from_moduli Pairwise coprime moduli q_i, each less than 2^61
+  /// @param[in] to_moduli Moduli p_j, each less than 2^61
+  BaseConverter(const std::vector<uint64_t>& from_moduli,
+                const std::vector<uint64_t>& to_moduli);
+
+  /// @brief Converts \p operand from base GetFromModuli() to base
+  /// GetToModuli()
+  /// @param[out] result Stores the result. Holds GetToModuli().size()
+  /// contiguous residue polynomials of \p n coefficients in [0, p_j)
+  /// @param[in] operand Holds GetFromModuli().size() contiguous residue
+  /// polynomials of \p n coefficients in [0, q_i). Must not alias \p result
+  /// @param[in] n Number of coefficients in each residue polynomial
+  /// @param[in] policy Selects the threads used for the conversion
+  void FastBaseConvert(
+      uint64_t* result, const uint64_t* operand, uint64_t n,
+      const ExecutionPolicy& policy = ExecutionPolicy::Serial()) const;
+
+  /// @brief Returns the moduli q_i of the input base
+  const std::vector<uint64_t>& GetFromModuli() const { return m_from_moduli; }
+
+  /// @brief Returns the moduli p_j of the output base
+  const std::vector<uint64_t>& GetToModuli() const { return m_to_moduli; }
+
+  /// @brief Returns \f$ \hat{q}_i^{-1} \bmod q_i \f$ for each q_i
+  const std::vector<uint64_t>& GetQHatInvModQ() const {
+    return m_q_hat_inv_mod_q;
+  }
+
+  /// @brief Returns \f$ \hat{q}_i \bmod p_j \f$ at index j * k + i, with k the
+  /// number of moduli in the input base
+  const std::vector<uint64_t>& GetQHatModP() const { return m_q_hat_mod_p; }
+
+ private:
+  std::vector<uint64_t> m_from_moduli;
+  std::vector<uint64_t> m_to_moduli;
+  std::vector<uint64_t> m_q_hat_inv_mod_q;
+  std::vector<uint64_t> m_q_hat_mod_p;
+  // Barrett factors floor(2^52 * m_q_hat_mod_p / p_j) for the AVX512-IFMA
+  // implementation
+  std::vector<uint64_t> m_q_hat_mod_p_precon52;
+};
+
+/// @brief Converts \p operand from base \p from_moduli to base \p to_moduli.
+/// See BaseConverter, which avoids recomputing the tables on each call.
+/// @param[out] result Stores the result. Holds to_moduli.size() contiguous
+/// residue polynomials of \p n coefficients in [0, p_j)
+/// @param[in] operand Holds from_moduli.size() contiguous residue polynomials
+/// of \p n coefficients in [0, q_i). Must not alias \p result
+/// @param[in] from_moduli Pairwise coprime moduli q_i, each less than 2^61
+/// @param[in] to_moduli Moduli p_j, each less than 2^61
+/// @param[in] n Number of coefficients in each residue polynomial
+/// @param[in] policy Selects the threads used for the conversion
+void FastBaseConvert(uint64_t* result, const uint64_t* operand,
+                     const std::vector<uint64_t>& from_moduli,
+                     const std::vector<uint64_t>& to_moduli, uint64_t n,
+                     const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,134 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <complex>
+#include <memory>
+#include <vector>
+
+#include "hexl/experimental/fft-like/fft-like.hpp"
+#include "hexl/util/execution-policy.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Encodes complex slot values into CKKS plaintexts in RNS and NTT
+/// form, and decodes them back
+/// @details Encoding places the \p n / 2 slot values and their conjugates in
+/// the order used by SEAL, applies the inverse FFT like transform scaled by
+/// \f$ \Delta / n \f$, rounds the real parts to integers, reduces them modulo
+/// each \f$ q_i \f$ and applies the forward NTT modulo each \f$ q_i \f$.
+/// Decoding inverts these steps, composing the residues with the CRT and
+/// centering them around zero before the forward FFT like transform. Both
+/// directions use one intermediate buffer of \p n complex values, and the
+/// tables depending on \p n and the moduli are computed once, on
+/// construction.
+class CKKSEncoder {
+ public:
+  /// @brief Initializes an empty CKKSEncoder object
+  CKKSEncoder() = default;
+
+  /// @brief Initializes a CKKSEncoder object for polynomials of degree \p n
+  /// modulo \p moduli
+  /// @param[in] n Polynomial degree. Must be a power of two larger than 8
+  /// @param[in] moduli Pairwise coprime NTT-friendly primes q_i, each less than
+  /// 2^62 and congruent to 1 modulo 2 * \p n
+  CKKSEncoder(uint64_t n, const std::vector<uint64_t>& moduli);
+
+  /// @brief Encodes \p values into a plaintext in NTT form
+  /// @param[out] result Stores the result. Holds GetModuli().size() contiguous
+  /// residue polynomials of GetDegree() coefficients in [0, q_i)
+  /// @param[in] values Slot values. Slots past \p num_values are set to zero
+  /// @param[in] num_values Number of slot values, at most GetSlotCount()
+  /// @param[in] scale Scale \f$ \Delta \f$ applied to the values. The scaled
+  /// coefficients must be finite and have absolute value less than half the
+  /// product of the moduli
+  /// @param[in] policy Selects the threads used for the encoding
+  void Encode(uint64_t* result, const std::complex<double>* values,
+              uint64_t num_values, double scale,
+              const ExecutionPolicy& policy = ExecutionPolicy::Serial()) const;
+
+  /// @brief Decodes the plaintext \p plain in NTT form into slot values
+  /// @param[out] result Stores the GetSlotCount() slot values
+  /// @param[in] plain Holds GetModuli().size() contiguous residue polynomials
+  /// of GetDegree() coefficients in [0, q_i)
+  /// @param[in] scale Scale \f$ \Delta \f$ of the plaintext
+  /// @param[in] policy Selects the threads used for the decoding
+  void Decode(std::complex<double>* result, const uint64_t* plain,
+              double scale,
+              const ExecutionPolicy& policy = ExecutionPolicy::Serial()) const;
+
+  /// @brief Returns the polynomial degree n
+  uint64_t GetDegree() const { return m_degree; }
+
+  /// @brief Returns the number of slots, n / 2
+  uint64_t GetSlotCount() const { return m_degree / 2; }
+
+  /// @brief Returns the moduli q_i
+  const std::vector<uint64_t>& GetModuli() const { return m_moduli; }
+
+  /// @brief Returns the position of each slot, followed by the position of
+  /// its conjugate, in the input of the inverse FFT like transform
+  const std::vector<uint64_t>& GetSlotIndexMap() const {
+    return m_slot_index_map;
+  }
+
+  /// @brief Returns the product of the moduli, as GetModuli().size() 64-bit
+  /// words with the least significant word first
+  const std::vector<uint64_t>& GetDecryptionModulus() const {
+    return m_decryption_modulus;
+  }
+
+ private:
+  uint64_t m_degree{0};
+  std::vector<uint64_t> m_moduli;
+  std::vector<uint64_t> m_slot_index_map;
+  std::shared_ptr<FFTLike> m_fft_like;
+
+  // Q = q_0 * ... * q_{k-1}, Q / q_i and (Q + 1) / 2 as k words each
+  std::vector<uint64_t> m_decryption_modulus;
+  std::vector<uint64_t> m_q_hat;
+  std::vector<uint64_t> m_upper_half_threshold;
+  std::vector<uint64_t> m_q_hat_inv_mod_q;
+};
+
+/// @brief Encodes \p values into a CKKS plaintext in NTT form
+/// @details Constructs a CKKSEncoder on each call, so every call allocates and
+/// recomputes the FFT like roots of unity, n complex values, and the CRT
+/// tables, k^2 words computed with O(k^3) word multiplications for k moduli.
+/// Repeated encodings with the same \p n and \p moduli should reuse one
+/// CKKSEncoder instead.
+/// @param[out] result Stores the result. Holds moduli.size() contiguous
+/// residue polynomials of \p n coefficients in [0, q_i)
+/// @param[in] values Slot values. Slots past \p num_values are set to zero
+/// @param[in] num_values Number of slot values, at most \p n / 2
+/// @param[in] scale Scale applied to the values
+/// @param[in] moduli NTT-friendly primes q_i, each less than 2^62
+/// @param[in] n Polynomial degree. Must be a power of two larger than 8
+/// @param[in] policy Selects the threads used for the encoding
+void CKKSEncode(uint64_t* result, const std::complex<double>* values,
+                uint64_t num_values, double scale,
+                const std::vector<uint64_t>& moduli, uint64_t n,
+                const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+/// @brief Decodes the CKKS plaintext \p plain in NTT form into \p n / 2 slot
+/// values
+/// @details Constructs a CKKSEncoder on each call, with the same cost as in
+/// CKKSEncode. Repeated decodings with the same \p n and \p moduli should
+/// reuse one CKKSEncoder instead.
+/// @param[out] result Stores the \p n / 2 slot values
+/// @param[in] plain Holds moduli.size() contiguous residue polynomials of \p n
+/// coefficients in [0, q_i)
+/// @param[in] scale Scale of the plaintext
+/// @param[in] moduli NTT-friendly primes q_i, each less than 2^62
+/// @param[in] n Polynomial degree. Must be a power of two larger than 8
+/// @param[in] policy Selects the threads used for the decoding
+void CKKSDecode(std::complex<double>* result, const uint64_t* plain,
+                double scale, const std::vector<uint64_t>& moduli, uint64_t n,
+                const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+}  // namespace hexl
+}  // namespace intel
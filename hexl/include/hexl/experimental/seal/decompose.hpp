@@ -0,0 +1,102 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "hexl/experimental/seal/base-convert.hpp"
+#include "hexl/util/execution-policy.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Decomposes polynomials into digits in a power-of-two base
+/// @details Splits each coefficient \f$ x \f$ into digits \f$ d_k \in [0,
+/// 2^w) \f$ with \f$ x = \sum_k d_k 2^{k w} \f$, as in BV key switching. Each
+/// coefficient is read once and all its digits are written in the same pass.
+/// @param[out] result Stores num_polys * num_digits polynomials of \p n
+/// coefficients. Digit k of polynomial i is at result + (i * num_digits + k) *
+/// n. Must not alias \p operand
+/// @param[in] operand Holds \p num_polys contiguous polynomials of \p n
+/// coefficients, each less than 2^(log_base * num_digits)
+/// @param[in] n Number of coefficients in each polynomial
+/// @param[in] num_polys Number of polynomials, e.g. the residue polynomials of
+/// an RNS polynomial
+/// @param[in] log_base Number of bits w of each digit, in [1, 63]
+/// @param[in] num_digits Number of digits per coefficient
+/// @param[in] policy Selects the threads used for the decomposition
+void DecomposePowerOfTwoBase(
+    uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t num_polys,
+    uint64_t log_base, uint64_t num_digits,
+    const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+/// @brief Decomposes RNS polynomials into digits over groups of moduli, as in
+/// hybrid key switching
+/// @details The moduli \f$ q_0, \dots, q_{L-1} \f$ are split into consecutive
+/// groups of \f$ \alpha = \lceil L / dnum \rceil \f$ moduli, with products \f$
+/// Q_j \f$. Digit j is \f$ x \bmod Q_j \f$, extended to the remaining moduli
+/// and to the extension moduli \f$ p_0, \dots, p_{K-1} \f$ by fast base
+/// conversion, so it may be off by a small multiple of \f$ Q_j \f$ there. The
+/// digits satisfy \f$ \sum_j d_j \hat{Q}_j [\hat{Q}_j^{-1}]_{Q_j} \equiv x \f$
+/// modulo each \f$ q_i \f$, with \f$ \hat{Q}_j = Q / Q_j \f$. The tables
+/// depending on the moduli are computed once, on construction.
+class GroupDecomposer {
+ public:
+  /// @brief Initializes an empty GroupDecomposer object
+  GroupDecomposer() = default;
+
+  /// @brief Initializes a GroupDecomposer object
+  /// @param[in] moduli Pairwise coprime moduli q_i of the decomposed
+  /// polynomials, each less than 2^61
+  /// @param[in] dnum Requested number of digits, in [1, moduli.size()]
+  /// @param[in] extension_moduli Moduli p_j appended to each digit, e.g. the
+  /// special primes of hybrid key switching. May be empty
+  GroupDecomposer(const std::vector<uint64_t>& moduli, uint64_t dnum,
+                  const std::vector<uint64_t>& extension_moduli = {});
+
+  /// @brief Decomposes \p operand into GetNumDigits() digits
+  /// @param[out] result Stores GetNumDigits() digits, each with
+  /// GetDigitModuli().size() contiguous residue polynomials of \p n
+  /// coefficients in coefficient form. Digit j starts at result + j *
+  /// GetDigitModuli().size() * n. Must not alias \p operand
+  /// @param[in] operand Holds GetModuli().size() contiguous residue
+  /// polynomials of \p n coefficients in [0, q_i), in coefficient form
+  /// @param[in] n Number of coefficients in each residue polynomial
+  /// @param[in] policy Selects the threads used for the base conversions
+  void Decompose(
+      uint64_t* result, const uint64_t* operand, uint64_t n,
+      const ExecutionPolicy& policy = ExecutionPolicy::Serial()) const;
+
+  /// @brief Returns the number of digits, ceil(L / alpha). May be less than
+  /// the requested dnum
+  uint64_t GetNumDigits() const { return m_group_begin.size(); }
+
+  /// @brief Returns the number of moduli alpha in each group but the last
+  uint64_t GetGroupSize() const { return m_group_size; }
+
+  /// @brief Returns the moduli q_i of the decomposed polynomials
+  const std::vector<uint64_t>& GetModuli() const { return m_moduli; }
+
+  /// @brief Returns the moduli of each digit: the moduli q_i followed by the
+  /// extension moduli p_j
+  const std::vector<uint64_t>& GetDigitModuli() const {
+    return m_digit_moduli;
+  }
+
+ private:
+  std::vector<uint64_t> m_moduli;
+  std::vector<uint64_t> m_digit_moduli;
+  uint64_t m_group_size{0};
+  // Index of the first modulus of each group
+  std::vector<uint64_t> m_group_begin;
+  // Per group, converters to the moduli before the group, and to the moduli
+  // after the group followed by the extension moduli
+  std::vector<BaseConverter> m_converters_before;
+  std::vector<BaseConverter> m_converters_after;
+};
+
+}  // namespace hexl
+}  // namespace intel
@@ -5,6 +5,9 @@
 
 #include <cstdint>
 
+#include "hexl/util/defines.hpp"
+#include "hexl/util/execution-policy.hpp"
+
 namespace intel {
 namespace hexl {
 namespace internal {
@@ -20,9 +23,32 @@ namespace internal {
 /// @param[in] moduli Pointer to contiguous array of num_moduli word-sized
 /// coefficient moduli
 /// @param[in] num_moduli Number of word-sized coefficient moduli
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
 void DyadicMultiply(uint64_t* result, const uint64_t* operand1,
                     const uint64_t* operand2, uint64_t n,
-                    const uint64_t* moduli, uint64_t num_moduli);
+                    const uint64_t* moduli, uint64_t num_moduli,
+                    const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+/// @brief Computes the dyadic product of the ciphertexts (x0, x1) and (y0,
+/// y1) modulo \p modulus: result0 = x0 * y0, result1 = x0 * y1 + x1 * y0 and
+/// result2 = x1 * y1
+/// @details Computes result1 as (x0 + x1) * (y0 + y1) - result0 - result2,
+/// with three modular multiplications per coefficient. Each coefficient is
+/// read before any result at the same index is written, so the results may
+/// alias the operands. Requires inputs in [0, modulus) and modulus < 2^62.
+void DyadicMultiplyNative(uint64_t* result0, uint64_t* result1,
+                          uint64_t* result2, const uint64_t* x0,
+                          const uint64_t* x1, const uint64_t* y0,
+                          const uint64_t* y1, uint64_t n, uint64_t modulus);
+
+#ifdef HEXL_HAS_AVX512DQ
+/// @brief AVX512-DQ implementation of DyadicMultiplyNative
+void DyadicMultiplyAVX512(uint64_t* result0, uint64_t* result1,
+                          uint64_t* result2, const uint64_t* x0,
+                          const uint64_t* x1, const uint64_t* y0,
+                          const uint64_t* y1, uint64_t n, uint64_t modulus);
+#endif
 
 }  // namespace internal
 }  // namespace hexl
@@ -5,6 +5,8 @@
 
 #include <cstdint>
 
+#include "hexl/util/execution-policy.hpp"
+
 namespace intel {
 namespace hexl {
 
@@ -23,5 +25,24 @@ void DyadicMultiply(uint64_t* result, const uint64_t* operand1,
                     const uint64_t* operand2, uint64_t n,
                     const uint64_t* moduli, uint64_t num_moduli);
 
+/// @brief Computes dyadic multiplication, splitting the work as selected by
+/// \p policy
+/// @param[in,out] result Ciphertext data. Will be over-written with result. Has
+/// (2 * n * num_moduli) elements
+/// @param[in] operand1 First ciphertext argument. Has (2 * n * num_moduli)
+/// elements.
+/// @param[in] operand2 Second ciphertext argument. Has (2 * n * num_moduli)
+/// elements.
+/// @param[in] n Number of coefficients in each polynomial
+/// @param[in] moduli Pointer to contiguous array of num_moduli word-sized
+/// coefficient moduli
+/// @param[in] num_moduli Number of word-sized coefficient moduli
+/// @param[in] policy Selects whether to split the work across the library
+/// thread pool
+void DyadicMultiply(uint64_t* result, const uint64_t* operand1,
+                    const uint64_t* operand2, uint64_t n,
+                    const uint64_t* moduli, uint64_t num_moduli,
+                    const ExecutionPolicy& policy);
+
 }  // namespace hexl
 }  // namespace intel
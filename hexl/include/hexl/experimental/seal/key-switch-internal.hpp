@@ -5,6 +5,8 @@
 
 #include <stdint.h>
 
+#include "hexl/experimental/seal/key-switch.hpp"
+
 namespace intel {
 namespace hexl {
 namespace internal {
@@ -32,12 +34,35 @@ namespace internal {
 /// (key_modulus_size) + 1) entries
 /// @param[in] modswitch_factors Array of modulus switch factors
 /// @param[in] root_of_unity_powers_ptr Array of root of unity powers
+/// @param[in] policy Selects the threads used for the key switching
+void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
+               uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+               uint64_t rns_modulus_size, uint64_t key_component_count,
+               const uint64_t* moduli, const uint64_t** k_switch_keys,
+               const uint64_t* modswitch_factors,
+               const uint64_t* root_of_unity_powers_ptr = nullptr,
+               const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+/// @brief Computes key switching in-place, using the scratch memory in
+/// \p workspace
 void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
                uint64_t decomp_modulus_size, uint64_t key_modulus_size,
                uint64_t rns_modulus_size, uint64_t key_component_count,
                const uint64_t* moduli, const uint64_t** k_switch_keys,
                const uint64_t* modswitch_factors,
-               const uint64_t* root_of_unity_powers_ptr = nullptr);
+               KeySwitchWorkspace& workspace,
+               const uint64_t* root_of_unity_powers_ptr = nullptr,
+               const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+/// @brief Computes key switching in-place, with keys laid out by
+/// KeySwitchKeys
+void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
+               uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+               uint64_t rns_modulus_size, uint64_t key_component_count,
+               const uint64_t* moduli, const KeySwitchKeys& k_switch_keys,
+               const uint64_t* modswitch_factors,
+               KeySwitchWorkspace& workspace,
+               const ExecutionPolicy& policy = ExecutionPolicy::Serial());
 
 }  // namespace internal
 }  // namespace hexl
@@ -5,9 +5,176 @@
 
 #include <stdint.h>
 
+#include "hexl/util/aligned-allocator.hpp"
+#include "hexl/util/execution-policy.hpp"
+
 namespace intel {
 namespace hexl {
 
+/// @brief Scratch memory for KeySwitch, so that repeated key switching reuses
+/// its buffers
+/// @details The buffers are allocated and zeroed on construction, by the
+/// calling thread, so they are usually placed on its NUMA node. A workspace
+/// may be reused by any KeySwitch call with the same n and
+/// key_component_count, and at most the same decomp_modulus_size. It must not
+/// be shared between concurrent calls. Each thread of a parallel KeySwitch
+/// call has its own scratch memory, so the number of threads is limited to
+/// the number the workspace was created for. KeySwitch may still allocate
+/// when it creates the NTT of a modulus which is not in the NTT cache.
+class KeySwitchWorkspace {
+ public:
+  /// @brief Initializes an empty workspace
+  KeySwitchWorkspace() = default;
+
+  /// @brief Allocates a workspace for key switching
+  /// @param[in] n Number of coefficients in each polynomial
+  /// @param[in] decomp_modulus_size Largest number of moduli of the switched
+  /// ciphertexts, excluding the auxiliary prime
+  /// @param[in] key_modulus_size Number of moduli in the ciphertext at its top
+  /// level, including one auxiliary prime
+  /// @param[in] key_component_count Number of components in the resulting
+  /// ciphertext
+  /// @param[in] num_threads Maximum number of threads of the KeySwitch calls
+  /// using the workspace
+  KeySwitchWorkspace(uint64_t n, uint64_t decomp_modulus_size,
+                     uint64_t key_modulus_size, uint64_t key_component_count,
+                     size_t num_threads = 1);
+
+  /// @brief Returns true if the workspace is large enough for the given key
+  /// switching parameters. An empty workspace fits no parameters.
+  bool Fits(uint64_t n, uint64_t decomp_modulus_size,
+            uint64_t key_modulus_size, uint64_t key_component_count) const {
+    return m_n != 0 && n == m_n &&
+           decomp_modulus_size <= m_decomp_modulus_size &&
+           key_modulus_size <= m_key_modulus_size &&
+           key_component_count == m_key_component_count;
+  }
+
+  /// @brief Returns the number of threads with their own scratch memory
+  size_t GetNumThreads() const { return m_num_threads; }
+
+  /// @brief Copy of the decomposed ciphertext component, with
+  /// n * decomp_modulus_size elements
+  uint64_t* Target() { return m_target.data(); }
+
+  /// @brief Operand of the forward NTT of thread \p thread, with n elements
+  uint64_t* NTT(size_t thread = 0) { return &m_ntt[thread * m_n]; }
+
+  /// @brief Reduced inner products, with key_component_count * n *
+  /// (decomp_modulus_size + 1) elements
+  uint64_t* PolyProd() { return m_poly_prod.data(); }
+
+  /// @brief High words of the lazy accumulators of thread \p thread, with
+  /// key_component_count * n elements
+  uint64_t* AccumulatorHi(size_t thread = 0) {
+    return &m_acc_hi[thread * m_key_component_count * m_n];
+  }
+
+  /// @brief Low words of the lazy accumulators of thread \p thread, with
+  /// key_component_count * n elements
+  uint64_t* AccumulatorLo(size_t thread = 0) {
+    return &m_acc_lo[thread * m_key_component_count * m_n];
+  }
+
+  /// @brief Rounded last residues used by the final rescaling, with
+  /// key_component_count * n elements
+  uint64_t* Last() { return m_last.data(); }
+
+  /// @brief Moduli of the rescaled polynomials, with key_modulus_size
+  /// elements
+  uint64_t* Moduli() { return m_moduli.data(); }
+
+  /// @brief Factors floor(2^64 * modswitch_factors[i] / moduli[i]) of the
+  /// final rescaling, with decomp_modulus_size elements
+  uint64_t* ModSwitchPrecon() { return m_modswitch_precon.data(); }
+
+ private:
+  uint64_t m_n{0};
+  uint64_t m_decomp_modulus_size{0};
+  uint64_t m_key_modulus_size{0};
+  uint64_t m_key_component_count{0};
+  size_t m_num_threads{1};
+
+  AlignedVector64<uint64_t> m_target;
+  AlignedVector64<uint64_t> m_ntt;
+  AlignedVector64<uint64_t> m_poly_prod;
+  AlignedVector64<uint64_t> m_acc_hi;
+  AlignedVector64<uint64_t> m_acc_lo;
+  AlignedVector64<uint64_t> m_last;
+  AlignedVector64<uint64_t> m_moduli;
+  AlignedVector64<uint64_t> m_modswitch_precon;
+};
+
+/// @brief Key-switching keys, laid out for KeySwitch
+/// @details KeySwitch reads the keys of SEAL with a stride of key_modulus_size
+/// * n between the key components. This class copies them once so that, for
+/// each modulus index key_index and decomposition index j, the key components
+/// are contiguous and read as one stream. Optionally, it also stores the
+/// factors floor(2^64 * key / q) of each key, so that KeySwitch can reduce
+/// each product with a Shoup multiplication instead of accumulating 128-bit
+/// products.
+class KeySwitchKeys {
+ public:
+  /// @brief Initializes an empty KeySwitchKeys object
+  KeySwitchKeys() = default;
+
+  /// @brief Lays out the key-switching keys of SEAL
+  /// @param[in] k_switch_keys Array of evaluation key data, as in KeySwitch
+  /// @param[in] n Number of coefficients in each polynomial
+  /// @param[in] decomp_modulus_size Largest number of moduli of the switched
+  /// ciphertexts, excluding the auxiliary prime
+  /// @param[in] key_modulus_size Number of moduli in the ciphertext at its top
+  /// level, including one auxiliary prime
+  /// @param[in] key_component_count Number of components in the resulting
+  /// ciphertext
+  /// @param[in] moduli Array of key_modulus_size coefficient moduli. Each must
+  /// be less than 2^62 if \p precompute_shoup is true
+  /// @param[in] precompute_shoup Whether to store the factors for Shoup
+  /// multiplication, which doubles the memory of the keys
+  KeySwitchKeys(const uint64_t** k_switch_keys, uint64_t n,
+                uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+                uint64_t key_component_count, const uint64_t* moduli,
+                bool precompute_shoup = true);
+
+  /// @brief Returns true if the keys can be used for the given key switching
+  /// parameters
+  bool Fits(uint64_t n, uint64_t decomp_modulus_size,
+            uint64_t key_modulus_size, uint64_t key_component_count) const {
+    return n == m_n && decomp_modulus_size <= m_decomp_modulus_size &&
+           key_modulus_size == m_key_modulus_size &&
+           key_component_count == m_key_component_count;
+  }
+
+  /// @brief Returns the key_component_count contiguous key polynomials of
+  /// decomposition index \p j, modulo moduli[key_index]
+  const uint64_t* GetKeys(uint64_t key_index, uint64_t j) const {
+    return &m_keys[BlockOffset(key_index, j)];
+  }
+
+  /// @brief Returns the factors for Shoup multiplication of GetKeys(key_index,
+  /// j), or nullptr if they were not precomputed
+  const uint64_t* GetKeysPrecon(uint64_t key_index, uint64_t j) const {
+    return HasPrecon() ? &m_keys_precon[BlockOffset(key_index, j)] : nullptr;
+  }
+
+  /// @brief Returns true if the factors for Shoup multiplication are stored
+  bool HasPrecon() const { return !m_keys_precon.empty(); }
+
+ private:
+  uint64_t BlockOffset(uint64_t key_index, uint64_t j) const {
+    return (key_index * m_decomp_modulus_size + j) * m_key_component_count *
+           m_n;
+  }
+
+  uint64_t m_n{0};
+  uint64_t m_decomp_modulus_size{0};
+  uint64_t m_key_modulus_size{0};
+  uint64_t m_key_component_count{0};
+
+  AlignedVector64<uint64_t> m_keys;
+  AlignedVector64<uint64_t> m_keys_precon;
+};
+
 /// @brief Computes key switching in-place
 /// @param[in,out] result Ciphertext data. Will be over-written with result. Has
 /// (n * decomp_modulus_size * key_component_count) elements
@@ -29,14 +196,49 @@ namespace hexl {
 /// decomp_modulus_size entries, each with
 /// coeff_count * ((key_modulus_size - 1)+ (key_component_count - 1) *
 /// (key_modulus_size) + 1) entries
-/// @param[in] modswitch_factors Array of modulus switch factors
+/// @param[in] modswitch_factors Array of modulus switch factors, i.e. the
+/// inverse of moduli[key_modulus_size - 1] modulo each of the first
+/// decomp_modulus_size moduli. The final division by the last modulus
+/// multiplies by these factors
 /// @param[in] root_of_unity_powers_ptr Array of root of unity powers
+/// @param[in] policy Selects the threads used for the key switching. The RNS
+/// limbs of the inner products and the key components of the rescaling are
+/// spread over the threads; the result does not depend on the policy
 void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
                uint64_t decomp_modulus_size, uint64_t key_modulus_size,
                uint64_t rns_modulus_size, uint64_t key_component_count,
                const uint64_t* moduli, const uint64_t** k_switch_keys,
                const uint64_t* modswitch_factors,
-               const uint64_t* root_of_unity_powers_ptr = nullptr);
+               const uint64_t* root_of_unity_powers_ptr = nullptr,
+               const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+/// @brief Computes key switching in-place, using the scratch memory in
+/// \p workspace instead of allocating it
+/// @details The parameters are as in the KeySwitch overload above. Requires
+/// workspace.Fits(n, decomp_modulus_size, key_modulus_size,
+/// key_component_count). Uses at most workspace.GetNumThreads() threads
+void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
+               uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+               uint64_t rns_modulus_size, uint64_t key_component_count,
+               const uint64_t* moduli, const uint64_t** k_switch_keys,
+               const uint64_t* modswitch_factors,
+               KeySwitchWorkspace& workspace,
+               const uint64_t* root_of_unity_powers_ptr = nullptr,
+               const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+/// @brief Computes key switching in-place, with keys laid out by
+/// KeySwitchKeys
+/// @details The parameters are as in the KeySwitch overloads above. Requires
+/// k_switch_keys.Fits(n, decomp_modulus_size, key_modulus_size,
+/// key_component_count). If the keys store the factors for Shoup
+/// multiplication, each product is reduced as it is accumulated
+void KeySwitch(uint64_t* result, const uint64_t* t_target_iter_ptr, uint64_t n,
+               uint64_t decomp_modulus_size, uint64_t key_modulus_size,
+               uint64_t rns_modulus_size, uint64_t key_component_count,
+               const uint64_t* moduli, const KeySwitchKeys& k_switch_keys,
+               const uint64_t* modswitch_factors,
+               KeySwitchWorkspace& workspace,
+               const ExecutionPolicy& policy = ExecutionPolicy::Serial());
 
 }  // namespace hexl
 }  // namespace intel
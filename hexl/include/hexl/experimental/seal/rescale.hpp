@@ -0,0 +1,39 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include "hexl/util/execution-policy.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Divides a polynomial in RNS and NTT form by its last modulus,
+/// rounding to the nearest integer, and drops the last modulus
+/// @details With moduli \f$ q_0, \dots, q_L \f$, computes the residues of
+/// \f$ \lfloor x / q_L \rceil \f$ modulo \f$ q_0, \dots, q_{L-1} \f$, as in
+/// CKKS rescaling and the modulus switch at the end of key switching. The
+/// last residue polynomial is transformed to coefficient form once. Each
+/// remaining residue polynomial then takes a single pass to reduce the last
+/// residue, a forward NTT, and a single pass to subtract and scale by \f$
+/// q_L^{-1} \f$.
+/// @param[out] result Stores the num_moduli - 1 residue polynomials of the
+/// result, in NTT form with coefficients in [0, q_i). May alias \p operand
+/// @param[in] operand Holds \p num_moduli contiguous residue polynomials in
+/// NTT form, with coefficients in [0, q_i)
+/// @param[in] n Number of coefficients in each residue polynomial. Must be a
+/// power of two
+/// @param[in] moduli Array of num_moduli NTT-friendly moduli, each less than
+/// 2^61. The last modulus is dropped
+/// @param[in] num_moduli Number of moduli; must be at least 2
+/// @param[in] policy Selects the threads used for the remaining residue
+/// polynomials
+void RescaleDivideRoundLastModulus(
+    uint64_t* result, const uint64_t* operand, uint64_t n,
+    const uint64_t* moduli, uint64_t num_moduli,
+    const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+}  // namespace hexl
+}  // namespace intel
@@ -4,23 +4,34 @@
 #pragma once
 
 #include "hexl/eltwise/eltwise-add-mod.hpp"
+#include "hexl/eltwise/eltwise-apply-galois.hpp"
 #include "hexl/eltwise/eltwise-cmp-add.hpp"
 #include "hexl/eltwise/eltwise-cmp-sub-mod.hpp"
+#include "hexl/eltwise/eltwise-dot-product-mod.hpp"
 #include "hexl/eltwise/eltwise-fma-mod.hpp"
 #include "hexl/eltwise/eltwise-mult-mod.hpp"
 #include "hexl/eltwise/eltwise-reduce-mod.hpp"
 #include "hexl/eltwise/eltwise-sub-mod.hpp"
 #include "hexl/experimental/fft-like/fft-like.hpp"
 #include "hexl/experimental/misc/lr-mat-vec-mult.hpp"
+#include "hexl/experimental/misc/plain-mat-vec-mult.hpp"
+#include "hexl/experimental/seal/base-convert.hpp"
+#include "hexl/experimental/seal/decompose.hpp"
 #include "hexl/experimental/seal/dyadic-multiply-internal.hpp"
 #include "hexl/experimental/seal/dyadic-multiply.hpp"
 #include "hexl/experimental/seal/key-switch-internal.hpp"
 #include "hexl/experimental/seal/key-switch.hpp"
+#include "hexl/experimental/seal/rescale.hpp"
 #include "hexl/logging/logging.hpp"
+#include "hexl/ntt/ntt-cache.hpp"
+#include "hexl/ntt/ntt-tables.hpp"
 #include "hexl/ntt/ntt.hpp"
+#include "hexl/ntt/poly-multiply-mod.hpp"
+#include "hexl/ntt/rns-ntt.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "hexl/util/check.hpp"
 #include "hexl/util/compiler.hpp"
 #include "hexl/util/defines.hpp"
+#include "hexl/util/execution-policy.hpp"
 #include "hexl/util/types.hpp"
 #include "hexl/util/util.hpp"
@@ -0,0 +1,203 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "hexl/ntt/ntt.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Counters describing the state of an NTTCache
+struct NTTCacheStats {
+  /// @brief Number of lookups which found their NTT in the cache
+  uint64_t hits{0};
+  /// @brief Number of lookups which had to create their NTT
+  uint64_t misses{0};
+  /// @brief Number of NTTs removed to stay within the memory budget
+  uint64_t evictions{0};
+  /// @brief Number of NTTs currently in the cache
+  uint64_t num_entries{0};
+  /// @brief Approximate memory held by the NTTs currently in the cache
+  uint64_t memory_bytes{0};
+  /// @brief Approximate memory held by removed NTTs which may still be
+  /// referenced by an NTTHandle
+  uint64_t retired_bytes{0};
+};
+
+class NTTHandle;
+
+/// @brief Per-thread state of the NTTCache readers, defined in ntt-cache.cpp
+struct NTTCacheReaderSlot;
+
+/// @brief Thread-safe cache of NTT precomputations, keyed by degree and
+/// modulus
+/// @details Lookups search an immutable table of the cached NTTs, which is
+/// read with a single atomic load. Cache hits take no lock and write no memory
+/// shared with other threads. Inserting or evicting NTTs publishes a new
+/// table. When the NTTs in the cache exceed the memory budget, the least
+/// recently used ones are evicted. Removed NTTs and tables are freed by the
+/// next insertion, eviction, SetBudget() or Clear() once no NTTHandle created
+/// before their removal is alive, i.e. by epoch-based reclamation.
+class NTTCache {
+ public:
+  /// @brief Default memory budget in bytes
+  static constexpr uint64_t s_default_budget_bytes{256ULL << 20};
+
+  /// @brief Returns the cache used by the library
+  static NTTCache& Instance();
+
+  /// @brief Creates an empty cache
+  /// @param[in] budget_bytes Memory budget in bytes
+  explicit NTTCache(uint64_t budget_bytes = s_default_budget_bytes);
+
+  /// @brief Frees all NTTs. No NTTHandle of the cache may be alive.
+  ~NTTCache();
+
+  NTTCache(const NTTCache&) = delete;
+  NTTCache& operator=(const NTTCache&) = delete;
+
+  /// @brief Returns the NTT of degree \p N and modulus \p modulus, creating
+  /// it on a miss. A miss creates the NTT without holding the cache lock.
+  NTTHandle Get(uint64_t N, uint64_t modulus);
+
+  /// @brief Creates the NTTs of degree \p N for each of \p moduli which are
+  /// not yet cached. Does not count as hits or misses.
+  void Prewarm(uint64_t N, const std::vector<uint64_t>& moduli);
+
+  /// @brief Adds copies of \p ntts which are not yet cached, e.g. NTTs
+  /// viewing tables loaded by MappedNTTTables. Does not count as hits or
+  /// misses.
+  void Prewarm(const std::vector<NTT>& ntts);
+
+  /// @brief Sets the memory budget in bytes, evicting NTTs as needed
+  /// @details The most recently used NTT is never evicted, so the cache may
+  /// exceed a budget smaller than a single NTT.
+  void SetBudget(uint64_t budget_bytes);
+
+  /// @brief Returns the memory budget in bytes
+  uint64_t GetBudget() const;
+
+  /// @brief Returns the current counters
+  NTTCacheStats GetStats() const;
+
+  /// @brief Removes all NTTs and resets the counters
+  void Clear();
+
+ private:
+  friend class NTTHandle;
+
+  struct Entry;
+  struct Table;
+  struct Retired;
+  using Key = std::pair<uint64_t, uint64_t>;
+
+  struct HashKey {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  using EntryMap = std::unordered_map<Key, std::unique_ptr<Entry>, HashKey>;
+
+  // Hits are counted per reader slot, so lookups only write to counters of
+  // their own thread. Counters are allocated in chunks on first use.
+  static constexpr size_t s_hit_chunk_size{64};
+  static constexpr size_t s_max_hit_chunks{64};
+  struct alignas(64) HitCounter {
+    std::atomic<uint64_t> value{0};
+  };
+
+  static NTTCacheReaderSlot* Pin();
+  static void Unpin(NTTCacheReaderSlot* slot);
+
+  void CountHit(const NTTCacheReaderSlot* slot);
+  Entry* Insert(uint64_t N, uint64_t modulus);
+  void Add(std::vector<std::unique_ptr<Entry>> entries,
+           const std::vector<Key>& keys);
+  void EvictToBudget(std::vector<std::unique_ptr<Entry>>* evicted);
+  void Publish(std::vector<std::unique_ptr<Entry>> removed);
+
+  std::atomic<const Table*> m_table;
+  std::atomic<HitCounter*> m_hit_chunks[s_max_hit_chunks];
+  HitCounter m_overflow_hits;
+
+  mutable std::mutex m_mutex;
+  EntryMap m_entries;
+  std::vector<Retired> m_retired;
+  uint64_t m_generation{1};
+  uint64_t m_budget_bytes;
+  uint64_t m_memory_bytes{0};
+  uint64_t m_retired_bytes{0};
+  uint64_t m_misses{0};
+  uint64_t m_evictions{0};
+};
+
+/// @brief Non-owning reference to an NTT in an NTTCache
+/// @details Keeps the NTT alive while the handle exists, also if the NTT is
+/// evicted meanwhile. Handles should be short-lived, since NTTs evicted while
+/// any handle of the thread exists are only freed once all of them are
+/// destroyed. A handle must be destroyed on the thread which created it, and
+/// before the cache.
+class NTTHandle {
+ public:
+  NTTHandle() = default;
+  NTTHandle(NTTHandle&& other) noexcept
+      : m_ntt(other.m_ntt), m_slot(other.m_slot) {
+    other.m_ntt = nullptr;
+    other.m_slot = nullptr;
+  }
+  NTTHandle& operator=(NTTHandle&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      m_ntt = other.m_ntt;
+      m_slot = other.m_slot;
+      other.m_ntt = nullptr;
+      other.m_slot = nullptr;
+    }
+    return *this;
+  }
+  NTTHandle(const NTTHandle&) = delete;
+  NTTHandle& operator=(const NTTHandle&) = delete;
+  ~NTTHandle() { Reset(); }
+
+  /// @brief Returns the NTT, or nullptr for a default-constructed handle
+  NTT* get() const { return m_ntt; }
+  NTT& operator*() const { return *m_ntt; }
+  NTT* operator->() const { return m_ntt; }
+  explicit operator bool() const { return m_ntt != nullptr; }
+
+ private:
+  friend class NTTCache;
+
+  explicit NTTHandle(NTTCacheReaderSlot* slot) : m_slot(slot) {}
+
+  void Reset() {
+    if (m_slot != nullptr) {
+      NTTCache::Unpin(m_slot);
+      m_slot = nullptr;
+    }
+    m_ntt = nullptr;
+  }
+
+  NTT* m_ntt{nullptr};
+  NTTCacheReaderSlot* m_slot{nullptr};
+};
+
+/// @brief Returns the NTT of degree \p N and modulus \p modulus from the
+/// library cache, creating it on first use
+/// @details The returned NTT is shared by all callers. Safe to call
+/// concurrently.
+inline NTTHandle GetNTT(uint64_t N, uint64_t modulus) {
+  return NTTCache::Instance().Get(N, modulus);
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,58 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "hexl/ntt/ntt.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Saves the precomputed tables of \p ntts to the file \p path, for
+/// loading with MappedNTTTables
+/// @details The file stores, in native byte order, a versioned header, the
+/// degree, modulus and root of unity of each NTT, and the tables of each NTT
+/// aligned to 64 bytes. Computes any tables of \p ntts not yet computed, so
+/// the file holds all tables. Throws std::runtime_error if the file cannot be
+/// written.
+void SaveNTTTables(const std::string& path,
+                   const std::vector<const NTT*>& ntts);
+
+/// @brief Read-only memory mapping of NTT tables saved by SaveNTTTables
+/// @details Processes mapping the same file share its pages. The NTTs returned
+/// by GetNTT() view the mapped tables without copying them, unless they are
+/// read through the vector accessors of NTT, and keep the mapping alive after
+/// this object is destroyed. Tables absent from the file are computed on
+/// first use.
+class MappedNTTTables {
+ public:
+  /// @brief File format version written by SaveNTTTables
+  static constexpr uint32_t s_version{1};
+
+  /// @brief Maps the file \p path. Throws std::runtime_error if the file
+  /// cannot be read, and std::invalid_argument if it is not a valid table
+  /// file of version s_version.
+  /// @details Checks each degree, modulus, root of unity and table size, but
+  /// not the table contents, so the file should come from a trusted source.
+  explicit MappedNTTTables(const std::string& path);
+
+  /// @brief Returns the number of NTTs in the file
+  size_t NumNTTs() const { return m_records.size(); }
+
+  /// @brief Returns the i'th NTT in the file, viewing the mapped tables
+  NTT GetNTT(size_t i) const;
+
+  /// @brief Returns all NTTs in the file, viewing the mapped tables
+  std::vector<NTT> GetNTTs() const;
+
+ private:
+  std::vector<NTT::PrecomputedTables> m_records;
+};
+
+}  // namespace hexl
+}  // namespace intel
@@ -5,11 +5,13 @@
 
 #include <stdint.h>
 
+#include <array>
 #include <memory>
 #include <vector>
 
 #include "hexl/util/aligned-allocator.hpp"
 #include "hexl/util/allocator.hpp"
+#include "hexl/util/execution-policy.hpp"
 
 namespace intel {
 namespace hexl {
@@ -36,6 +38,48 @@ class NTT {
     Adaptee alloc;
   };
 
+  /// @brief Transform directions, for Precompute()
+  enum class Direction { Forward, Inverse, Both };
+
+  /// @brief Precomputed tables used by the transforms
+  enum class Table {
+    RootOfUnityPowers = 0,            ///< GetRootOfUnityPowers()
+    Precon32RootOfUnityPowers,        ///< GetPrecon32RootOfUnityPowers()
+    Precon64RootOfUnityPowers,        ///< GetPrecon64RootOfUnityPowers()
+    AVX512RootOfUnityPowers,          ///< GetAVX512RootOfUnityPowers()
+    AVX512Precon32RootOfUnityPowers,  ///< GetAVX512Precon32RootOfUnityPowers()
+    AVX512Precon52RootOfUnityPowers,  ///< GetAVX512Precon52RootOfUnityPowers()
+    AVX512Precon64RootOfUnityPowers,  ///< GetAVX512Precon64RootOfUnityPowers()
+    InvRootOfUnityPowers,             ///< GetInvRootOfUnityPowers()
+    Precon32InvRootOfUnityPowers,     ///< GetPrecon32InvRootOfUnityPowers()
+    Precon52InvRootOfUnityPowers,     ///< GetPrecon52InvRootOfUnityPowers()
+    Precon64InvRootOfUnityPowers      ///< GetPrecon64InvRootOfUnityPowers()
+  };
+
+  /// @brief Number of values of Table
+  static constexpr size_t s_num_tables{11};
+
+  /// @brief Read-only view of a precomputed table
+  struct TableView {
+    const uint64_t* data{nullptr};  ///< First element; nullptr if absent
+    uint64_t size{0};               ///< Number of elements
+  };
+
+  /// @brief Views of each precomputed table, indexed by Table
+  using TableViews = std::array<TableView, s_num_tables>;
+
+  /// @brief Precomputed tables of an NTT held in external memory
+  struct PrecomputedTables {
+    uint64_t degree{0};   ///< Degree N
+    uint64_t modulus{0};  ///< Prime modulus q
+    /// 2N'th root of unity from which the tables were computed
+    uint64_t root_of_unity{0};
+    /// Tables to view; tables which are absent are computed on first use
+    TableViews tables{};
+    /// Keeps the viewed tables alive, e.g. a memory mapping
+    std::shared_ptr<const void> owner;
+  };
+
   /// @brief Initializes an empty NTT object
   NTT() = default;
 
@@ -49,8 +93,8 @@ class NTT {
   /// @param[in] q Prime modulus. Must satisfy \f$ q == 1 \mod 2N \f$
   /// @param[in] alloc_ptr Custom memory allocator used for intermediate
   /// calculations
-  /// @brief Performs pre-computation necessary for forward and inverse
-  /// transforms
+  /// @details The precomputed tables are computed on first use; see
+  /// Precompute()
   NTT(uint64_t degree, uint64_t q,
       std::shared_ptr<AllocatorBase> alloc_ptr = {});
 
@@ -70,8 +114,8 @@ class NTT {
   /// @param[in] root_of_unity 2N'th root of unity in \f$ \mathbb{Z_q} \f$.
   /// @param[in] alloc_ptr Custom memory allocator used for intermediate
   /// calculations
-  /// @details  Performs pre-computation necessary for forward and inverse
-  /// transforms
+  /// @details The precomputed tables are computed on first use; see
+  /// Precompute()
   NTT(uint64_t degree, uint64_t q, uint64_t root_of_unity,
       std::shared_ptr<AllocatorBase> alloc_ptr = {});
 
@@ -83,12 +127,30 @@ class NTT {
                 std::make_shared<AllocatorAdapter<Allocator, AllocatorArgs...>>(
                     std::move(a), std::forward<AllocatorArgs>(args)...))) {}
 
+  /// @brief Initializes an NTT object which views existing precomputed tables
+  /// instead of computing them, e.g. tables memory-mapped by MappedNTTTables
+  /// @param[in] tables Degree, modulus and tables to view. The NTT and its
+  /// copies share ownership of tables.owner. Throws std::invalid_argument if
+  /// a viewed table does not have ExpectedTableSize() elements.
+  /// @param[in] alloc_ptr Custom memory allocator used for intermediate
+  /// calculations
+  /// @details The Get*RootOfUnityPowers() accessors only return tables owned
+  /// by this object, and are empty for viewed tables; use GetTable() instead.
+  explicit NTT(const PrecomputedTables& tables,
+               std::shared_ptr<AllocatorBase> alloc_ptr = {});
+
   /// @brief Returns true if arguments satisfy constraints for negacyclic NTT
   /// @param[in] degree N. Size of the transform, i.e. the polynomial degree.
   /// Must be a power of two.
   /// @param[in] modulus Prime modulus q. Must satisfy q mod 2N = 1
   static bool CheckArguments(uint64_t degree, uint64_t modulus);
 
+  /// @brief Returns the number of elements of the table \p table of an NTT
+  /// of degree \p degree
+  /// @details The AVX512 forward tables duplicate the roots of the last two
+  /// stages, so hold 13N/8 elements for N >= 8; the others hold N.
+  static uint64_t ExpectedTableSize(uint64_t degree, Table table);
+
   /// @brief Compute forward NTT. Results are bit-reversed.
   /// @param[out] result Stores the result
   /// @param[in] operand Data on which to compute the NTT
@@ -96,18 +158,44 @@ class NTT {
   /// input_mod_factor * q). Must be 1, 2 or 4.
   /// @param[in] output_mod_factor Returns output \p result in [0,
   /// output_mod_factor * q). Must be 1 or 4.
-  void ComputeForward(uint64_t* result, const uint64_t* operand,
-                      uint64_t input_mod_factor, uint64_t output_mod_factor);
-
-  /// Compute inverse NTT. Results are bit-reversed.
+  /// @param[in] policy Selects whether the transform may split its outer
+  /// butterfly stages across the thread pool
+  /// @details Only transforms of degree at least 2^MinParallelDegreeBits()
+  /// run in parallel; the grain size of \p policy is not used. Outputs are
+  /// congruent to those of the serial transform, and identical when fully
+  /// reduced, i.e. for output_mod_factor == 1.
+  void ComputeForward(
+      uint64_t* result, const uint64_t* operand, uint64_t input_mod_factor,
+      uint64_t output_mod_factor,
+      const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+  /// @brief Compute inverse NTT. Takes bit-reversed input and returns results
+  /// in natural order.
   /// @param[out] result Stores the result
   /// @param[in] operand Data on which to compute the NTT
   /// @param[in] input_mod_factor Assume input \p operand are in [0,
   /// input_mod_factor * q). Must be 1 or 2.
   /// @param[in] output_mod_factor Returns output \p result in [0,
   /// output_mod_factor * q). Must be 1 or 2.
-  void ComputeInverse(uint64_t* result, const uint64_t* operand,
-                      uint64_t input_mod_factor, uint64_t output_mod_factor);
+  /// @param[in] policy Selects whether the transform may split its outer
+  /// butterfly stages across the thread pool, as for ComputeForward
+  void ComputeInverse(
+      uint64_t* result, const uint64_t* operand, uint64_t input_mod_factor,
+      uint64_t output_mod_factor,
+      const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+  /// @brief Computes the tables used by transforms in direction \p direction
+  /// on this CPU, under the execution policy \p policy
+  /// @details Otherwise, each table is computed by the first transform or
+  /// accessor which uses it. Copies of an NTT share their computed tables, and
+  /// tables are computed at most once, also when used concurrently.
+  void Precompute(
+      Direction direction = Direction::Both,
+      const ExecutionPolicy& policy = ExecutionPolicy::Serial()) const;
+
+  /// @brief Returns the bytes of memory held by the tables computed so far,
+  /// excluding viewed tables
+  uint64_t GetTableMemoryBytes() const;
 
   /// @brief Returns the minimal 2N'th root of unity
   uint64_t GetMinimalRootOfUnity() const { return m_w; }
@@ -118,84 +206,109 @@ class NTT {
   /// @brief Returns the word-sized prime modulus
   uint64_t GetModulus() const { return m_q; }
 
+  /// @brief Returns the precomputed table \p table, whether owned or viewed.
+  /// Computes the table if needed.
+  const uint64_t* GetTable(Table table) const {
+    const TableView& view = m_table_views[static_cast<size_t>(table)];
+    return (view.data != nullptr) ? view.data : GetOwnedTable(table).data();
+  }
+
+  /// @brief Returns the number of elements in the precomputed table \p table
+  uint64_t GetTableSize(Table table) const {
+    const TableView& view = m_table_views[static_cast<size_t>(table)];
+    return (view.data != nullptr) ? view.size : GetOwnedTable(table).size();
+  }
+
   /// @brief Returns the root of unity powers in bit-reversed order
+  /// @details This and the following table accessors return a copy of a
+  /// viewed table, made on first use. GetTable() avoids the copy.
   const AlignedVector64<uint64_t>& GetRootOfUnityPowers() const {
-    return m_root_of_unity_powers;
+    return GetOwnedTable(Table::RootOfUnityPowers);
   }
 
   /// @brief Returns the root of unity power at bit-reversed index i.
-  uint64_t GetRootOfUnityPower(size_t i) { return GetRootOfUnityPowers()[i]; }
+  uint64_t GetRootOfUnityPower(size_t i) {
+    HEXL_CHECK(i < GetTableSize(Table::RootOfUnityPowers),
+               "Index " << i << " exceeds degree " << m_degree);
+    return GetTable(Table::RootOfUnityPowers)[i];
+  }
 
   /// @brief Returns 32-bit pre-conditioned root of unity powers in
   /// bit-reversed order
   const AlignedVector64<uint64_t>& GetPrecon32RootOfUnityPowers() const {
-    return m_precon32_root_of_unity_powers;
+    return GetOwnedTable(Table::Precon32RootOfUnityPowers);
   }
 
   /// @brief Returns 64-bit pre-conditioned root of unity powers in
   /// bit-reversed order
   const AlignedVector64<uint64_t>& GetPrecon64RootOfUnityPowers() const {
-    return m_precon64_root_of_unity_powers;
+    return GetOwnedTable(Table::Precon64RootOfUnityPowers);
   }
 
   /// @brief Returns the root of unity powers in bit-reversed order with
   /// modifications for use by AVX512 implementation
   const AlignedVector64<uint64_t>& GetAVX512RootOfUnityPowers() const {
-    return m_avx512_root_of_unity_powers;
+    return GetOwnedTable(Table::AVX512RootOfUnityPowers);
   }
 
   /// @brief Returns 32-bit pre-conditioned AVX512 root of unity powers in
   /// bit-reversed order
   const AlignedVector64<uint64_t>& GetAVX512Precon32RootOfUnityPowers() const {
-    return m_avx512_precon32_root_of_unity_powers;
+    return GetOwnedTable(Table::AVX512Precon32RootOfUnityPowers);
   }
 
   /// @brief Returns 52-bit pre-conditioned AVX512 root of unity powers in
   /// bit-reversed order
   const AlignedVector64<uint64_t>& GetAVX512Precon52RootOfUnityPowers() const {
-    return m_avx512_precon52_root_of_unity_powers;
+    return GetOwnedTable(Table::AVX512Precon52RootOfUnityPowers);
   }
 
   /// @brief Returns 64-bit pre-conditioned AVX512 root of unity powers in
   /// bit-reversed order
   const AlignedVector64<uint64_t>& GetAVX512Precon64RootOfUnityPowers() const {
-    return m_avx512_precon64_root_of_unity_powers;
+    return GetOwnedTable(Table::AVX512Precon64RootOfUnityPowers);
   }
 
   /// @brief Returns the inverse root of unity powers in bit-reversed order
   const AlignedVector64<uint64_t>& GetInvRootOfUnityPowers() const {
-    return m_inv_root_of_unity_powers;
+    return GetOwnedTable(Table::InvRootOfUnityPowers);
   }
 
   /// @brief Returns the inverse root of unity power at bit-reversed index i.
   uint64_t GetInvRootOfUnityPower(size_t i) {
-    return GetInvRootOfUnityPowers()[i];
+    HEXL_CHECK(i < GetTableSize(Table::InvRootOfUnityPowers),
+               "Index " << i << " exceeds degree " << m_degree);
+    return GetTable(Table::InvRootOfUnityPowers)[i];
   }
 
   /// @brief Returns the vector of 32-bit pre-conditioned pre-computed root of
   /// unity
   // powers for the modulus and root of unity.
   const AlignedVector64<uint64_t>& GetPrecon32InvRootOfUnityPowers() const {
-    return m_precon32_inv_root_of_unity_powers;
+    return GetOwnedTable(Table::Precon32InvRootOfUnityPowers);
   }
 
   /// @brief Returns the vector of 52-bit pre-conditioned pre-computed root of
   /// unity
   // powers for the modulus and root of unity.
   const AlignedVector64<uint64_t>& GetPrecon52InvRootOfUnityPowers() const {
-    return m_precon52_inv_root_of_unity_powers;
+    return GetOwnedTable(Table::Precon52InvRootOfUnityPowers);
   }
 
   /// @brief Returns the vector of 64-bit pre-conditioned pre-computed root of
   /// unity
   // powers for the modulus and root of unity.
   const AlignedVector64<uint64_t>& GetPrecon64InvRootOfUnityPowers() const {
-    return m_precon64_inv_root_of_unity_powers;
+    return GetOwnedTable(Table::Precon64InvRootOfUnityPowers);
   }
 
   /// @brief Maximum power of 2 in degree
   static size_t MaxDegreeBits() { return 20; }
 
+  /// @brief Minimum power of 2 in degree for which a parallel execution
+  /// policy takes effect
+  static size_t MinParallelDegreeBits() { return 15; }
+
   /// @brief Maximum number of bits in modulus;
   static size_t MaxModulusBits() { return 62; }
 
@@ -251,7 +364,17 @@ class NTT {
   }
 
  private:
-  void ComputeRootOfUnityPowers();
+  struct LazyTables;
+
+  // Computes table, which is not computed yet, or copies it if it is viewed
+  void ComputeTable(Table table) const;
+
+  AlignedVector64<uint64_t> ComputeBarrettVector(Table table,
+                                                 uint64_t bit_shift) const;
+
+  // Returns the table, computing or copying it on first use. Returns an empty
+  // table for a default-constructed NTT.
+  const AlignedVector64<uint64_t>& GetOwnedTable(Table table) const;
 
   uint64_t m_degree;  // N: size of NTT transform, should be power of 2
   uint64_t m_q;       // prime modulus. Must satisfy q == 1 mod 2n
@@ -265,31 +388,13 @@ class NTT {
 
   AlignedAllocator<uint64_t, 64> m_aligned_alloc;
 
-  // powers of the minimal root of unity
-  AlignedVector64<uint64_t> m_root_of_unity_powers;
-  // vector of floor(W * 2**32 / m_q), with W the root of unity powers
-  AlignedVector64<uint64_t> m_precon32_root_of_unity_powers;
-  // vector of floor(W * 2**64 / m_q), with W the root of unity powers
-  AlignedVector64<uint64_t> m_precon64_root_of_unity_powers;
-
-  // powers of the minimal root of unity adjusted for use in AVX512
-  // implementations
-  AlignedVector64<uint64_t> m_avx512_root_of_unity_powers;
-  // vector of floor(W * 2**32 / m_q), with W the AVX512 root of unity powers
-  AlignedVector64<uint64_t> m_avx512_precon32_root_of_unity_powers;
-  // vector of floor(W * 2**52 / m_q), with W the AVX512 root of unity powers
-  AlignedVector64<uint64_t> m_avx512_precon52_root_of_unity_powers;
-  // vector of floor(W * 2**64 / m_q), with W the AVX512 root of unity powers
-  AlignedVector64<uint64_t> m_avx512_precon64_root_of_unity_powers;
-
-  // vector of floor(W * 2**32 / m_q), with W the inverse root of unity powers
-  AlignedVector64<uint64_t> m_precon32_inv_root_of_unity_powers;
-  // vector of floor(W * 2**52 / m_q), with W the inverse root of unity powers
-  AlignedVector64<uint64_t> m_precon52_inv_root_of_unity_powers;
-  // vector of floor(W * 2**64 / m_q), with W the inverse root of unity powers
-  AlignedVector64<uint64_t> m_precon64_inv_root_of_unity_powers;
-
-  AlignedVector64<uint64_t> m_inv_root_of_unity_powers;
+  // Tables computed so far, shared with copies of this object
+  std::shared_ptr<LazyTables> m_lazy_tables;
+
+  // Tables viewed rather than owned, which take precedence over
+  // m_lazy_tables
+  TableViews m_table_views{};
+  std::shared_ptr<const void> m_table_owner;
 };
 
 }  // namespace hexl
@@ -0,0 +1,55 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include "hexl/util/execution-policy.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Multiplies two polynomials in \f$ \mathbb{Z}_q[X]/(X^N + 1) \f$
+/// @param[out] result Stores the product. May alias \p operand1 or \p
+/// operand2
+/// @param[in] operand1 Coefficients of the first polynomial. Each must be less
+/// than the modulus
+/// @param[in] operand2 Coefficients of the second polynomial. Each must be
+/// less than the modulus
+/// @param[in] n Number of coefficients N in each polynomial. Must be a power of
+/// 2
+/// @param[in] modulus Prime modulus q. Must satisfy \f$ q == 1 \mod 2N \f$
+/// @details Computes the negacyclic convolution of \p operand1 and \p operand2
+/// with forward NTTs, a dyadic product and an inverse NTT. The transforms are
+/// fused: once the outer stages of both forward transforms have split the
+/// polynomials into cache-sized sub-blocks, each pair of sub-blocks is
+/// transformed, multiplied and inverse transformed before the next is loaded.
+/// Intermediate values are kept in [0, 4q) where possible, so each stage skips
+/// reductions the next stage performs anyway. The NTT tables for (\p n, \p
+/// modulus) are computed on first use and reused by later calls.
+void PolyMultiplyMod(uint64_t* result, const uint64_t* operand1,
+                     const uint64_t* operand2, uint64_t n, uint64_t modulus);
+
+/// @brief Multiplies two polynomials in RNS form, one residue polynomial per
+/// modulus
+/// @param[out] result Stores the product. Has n * num_moduli elements. May
+/// alias \p operand1 or \p operand2
+/// @param[in] operand1 First polynomial, stored as num_moduli contiguous
+/// residue polynomials of n coefficients each
+/// @param[in] operand2 Second polynomial, stored as num_moduli contiguous
+/// residue polynomials of n coefficients each
+/// @param[in] n Number of coefficients N in each residue polynomial. Must be a
+/// power of 2
+/// @param[in] moduli Pointer to contiguous array of num_moduli prime moduli,
+/// each satisfying \f$ q == 1 \mod 2N \f$
+/// @param[in] num_moduli Number of moduli
+/// @param[in] policy Selects whether to split the residues across the library
+/// thread pool
+void PolyMultiplyMod(uint64_t* result, const uint64_t* operand1,
+                     const uint64_t* operand2, uint64_t n,
+                     const uint64_t* moduli, uint64_t num_moduli,
+                     const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,97 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "hexl/ntt/ntt.hpp"
+#include "hexl/util/allocator.hpp"
+#include "hexl/util/execution-policy.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Performs negacyclic forward and inverse NTTs on batches of
+/// polynomials in residue number system (RNS) form.
+/// @details Holds one NTT object per modulus. Operands are stored as \p
+/// num_polys contiguous polynomials, each consisting of GetNumModuli()
+/// contiguous residue polynomials of GetDegree() coefficients, i.e. a
+/// row-major num_polys x L x N block. All residues for the same modulus are
+/// transformed back-to-back, so each modulus' root of unity tables are loaded
+/// into cache once per call rather than once per polynomial.
+class RNSNTT {
+ public:
+  /// @brief Initializes an empty RNSNTT object
+  RNSNTT() = default;
+
+  /// @brief Initializes an RNSNTT object with degree \p degree and moduli \p
+  /// moduli.
+  /// @param[in] degree also known as N. Size of each NTT transform. Must be a
+  /// power of 2
+  /// @param[in] moduli Prime moduli. Each must satisfy \f$ q == 1 \mod 2N \f$
+  /// @param[in] alloc_ptr Custom memory allocator used for intermediate
+  /// calculations
+  RNSNTT(uint64_t degree, const std::vector<uint64_t>& moduli,
+         std::shared_ptr<AllocatorBase> alloc_ptr = {});
+
+  /// @brief Compute forward NTT of each residue polynomial. Results are
+  /// bit-reversed.
+  /// @param[out] result Stores the result. Must hold num_polys *
+  /// GetNumModuli() * GetDegree() elements
+  /// @param[in] operand Data on which to compute the NTT. May alias \p result
+  /// @param[in] num_polys Number of RNS polynomials in \p operand
+  /// @param[in] input_mod_factor Assume input \p operand are in [0,
+  /// input_mod_factor * q). Must be 1, 2 or 4.
+  /// @param[in] output_mod_factor Returns output \p result in [0,
+  /// output_mod_factor * q). Must be 1 or 4.
+  /// @param[in] policy Selects the threads used for the transforms. The
+  /// num_polys * GetNumModuli() residue transforms are split into contiguous,
+  /// modulus-major ranges; each residue transform runs on a single thread.
+  void ComputeForward(
+      uint64_t* result, const uint64_t* operand, uint64_t num_polys,
+      uint64_t input_mod_factor, uint64_t output_mod_factor,
+      const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+  /// @brief Compute inverse NTT of each residue polynomial. Takes
+  /// bit-reversed input, as produced by ComputeForward, and returns results
+  /// in natural order.
+  /// @param[out] result Stores the result. Must hold num_polys *
+  /// GetNumModuli() * GetDegree() elements
+  /// @param[in] operand Data on which to compute the inverse NTT, in
+  /// bit-reversed order. May alias \p result
+  /// @param[in] num_polys Number of RNS polynomials in \p operand
+  /// @param[in] input_mod_factor Assume input \p operand are in [0,
+  /// input_mod_factor * q). Must be 1 or 2.
+  /// @param[in] output_mod_factor Returns output \p result in [0,
+  /// output_mod_factor * q). Must be 1 or 2.
+  /// @param[in] policy Selects the threads used for the transforms, as in
+  /// ComputeForward
+  void ComputeInverse(
+      uint64_t* result, const uint64_t* operand, uint64_t num_polys,
+      uint64_t input_mod_factor, uint64_t output_mod_factor,
+      const ExecutionPolicy& policy = ExecutionPolicy::Serial());
+
+  /// @brief Returns the degree N
+  uint64_t GetDegree() const { return m_degree; }
+
+  /// @brief Returns the number of moduli L
+  size_t GetNumModuli() const { return m_moduli.size(); }
+
+  /// @brief Returns the prime moduli
+  const std::vector<uint64_t>& GetModuli() const { return m_moduli; }
+
+  /// @brief Returns the NTT object for the modulus at index \p i
+  NTT& GetNTT(size_t i) { return m_ntts[i]; }
+
+ private:
+  uint64_t m_degree{0};
+  std::vector<uint64_t> m_moduli;
+  std::vector<NTT> m_ntts;
+};
+
+}  // namespace hexl
+}  // namespace intel
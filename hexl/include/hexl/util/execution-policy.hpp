@@ -0,0 +1,55 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace intel {
+namespace hexl {
+
+/// @brief Selects whether a function runs entirely on the calling thread, or
+/// may split its work across the library thread pool.
+/// @details The thread pool is shared by all HEXL functions and is started
+/// on first use of a parallel policy. Its size defaults to the number of
+/// hardware threads and may be overridden with the HEXL_NUM_THREADS
+/// environment variable. Results do not depend on the policy.
+class ExecutionPolicy {
+ public:
+  /// @brief Default minimum number of elements handled by each task
+  static constexpr uint64_t s_default_grain_size{1ULL << 14};
+
+  /// @brief Returns a policy which runs on the calling thread only
+  static ExecutionPolicy Serial() { return ExecutionPolicy(1, 0); }
+
+  /// @brief Returns a policy which splits work across the thread pool
+  /// @param[in] grain_size Minimum number of elements handled by each task.
+  /// Smaller inputs run on the calling thread
+  /// @param[in] num_threads Maximum number of threads, including the calling
+  /// thread. 0 uses all threads of the pool
+  static ExecutionPolicy Parallel(uint64_t grain_size = s_default_grain_size,
+                                  size_t num_threads = 0) {
+    return ExecutionPolicy(num_threads, grain_size == 0 ? 1 : grain_size);
+  }
+
+  /// @brief Returns true if the policy runs on the calling thread only
+  bool IsSerial() const { return m_num_threads == 1; }
+
+  /// @brief Returns the maximum number of threads; 0 denotes all threads of
+  /// the pool
+  size_t GetNumThreads() const { return m_num_threads; }
+
+  /// @brief Returns the minimum number of elements handled by each task
+  uint64_t GetGrainSize() const { return m_grain_size; }
+
+ private:
+  ExecutionPolicy(size_t num_threads, uint64_t grain_size)
+      : m_num_threads(num_threads), m_grain_size(grain_size) {}
+
+  size_t m_num_threads;
+  uint64_t m_grain_size;
+};
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,346 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ntt/fwd-ntt-avx2.hpp"
+
+#include <immintrin.h>
+
+#include <cstring>
+#include <vector>
+
+#include "hexl/logging/logging.hpp"
+#include "hexl/ntt/ntt.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "ntt/ntt-internal.hpp"
+#include "util/avx2-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+template void ForwardTransformToBitReverseAVX2<32>(
+    uint64_t* result, const uint64_t* operand, uint64_t degree, uint64_t mod,
+    const uint64_t* root_of_unity_powers,
+    const uint64_t* precon_root_of_unity_powers, uint64_t input_mod_factor,
+    uint64_t output_mod_factor, uint64_t recursion_depth,
+    uint64_t recursion_half);
+
+template void ForwardTransformToBitReverseAVX2<NTT::s_default_shift_bits>(
+    uint64_t* result, const uint64_t* operand, uint64_t degree, uint64_t mod,
+    const uint64_t* root_of_unity_powers,
+    const uint64_t* precon_root_of_unity_powers, uint64_t input_mod_factor,
+    uint64_t output_mod_factor, uint64_t recursion_depth,
+    uint64_t recursion_half);
+
+template void ForwardOuterStageAVX2<32>(
+    uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t modulus,
+    const uint64_t* root_of_unity_powers,
+    const uint64_t* precon_root_of_unity_powers, uint64_t recursion_depth,
+    uint64_t recursion_half);
+
+template void ForwardOuterStageAVX2<NTT::s_default_shift_bits>(
+    uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t modulus,
+    const uint64_t* root_of_unity_powers,
+    const uint64_t* precon_root_of_unity_powers, uint64_t recursion_depth,
+    uint64_t recursion_half);
+#endif
+
+#ifdef HEXL_HAS_AVX256
+
+/// @brief The Harvey butterfly: assume \p X, \p Y in [0, 4q), and return X', Y'
+/// in [0, 4q) such that X', Y' = X + WY, X - WY (mod q).
+/// @param[in,out] X Input representing 4 64-bit unsigned integers in SIMD form
+/// @param[in,out] Y Input representing 4 64-bit unsigned integers in SIMD form
+/// @param[in] W Root of unity represented as 4 64-bit unsigned integers in
+/// SIMD form
+/// @param[in] W_precon Preconditioned \p W for BitShift-bit Barrett
+/// reduction
+/// @param[in] modulus Modulus, i.e. q represented as 4 64-bit unsigned
+/// integers in SIMD form
+/// @param[in] twice_modulus Twice the modulus, i.e. 2*q represented as 4 64-bit
+/// unsigned integers in SIMD form
+/// @param InputLessThanMod If true, assumes \p X, \p Y < \p q. Otherwise,
+/// assumes \p X, \p Y < 4*\p q
+/// @details See Algorithm 4 of https://arxiv.org/pdf/1205.2926.pdf
+template <int BitShift, bool InputLessThanMod>
+inline void FwdButterflyAVX2(__m256i* X, __m256i* Y, __m256i W,
+                             __m256i W_precon, __m256i modulus,
+                             __m256i twice_modulus) {
+  if (!InputLessThanMod) {
+    *X = _mm256_hexl_small_mod_epu64(*X, twice_modulus);
+  }
+
+  // T in [0, 2q)
+  __m256i T = _mm256_hexl_mul_mod_lazy_epi64<BitShift>(*Y, W, W_precon,
+                                                       modulus, twice_modulus);
+
+  __m256i twice_mod_minus_T = _mm256_sub_epi64(twice_modulus, T);
+  *Y = _mm256_add_epi64(*X, twice_mod_minus_T);
+  *X = _mm256_add_epi64(*X, T);
+}
+
+// Butterflies with t == 1, i.e. on adjacent pairs (X, Y). Processes four
+// butterflies, i.e. eight coefficients, per iteration.
+template <int BitShift>
+void FwdT1AVX2(uint64_t* operand, __m256i v_modulus, __m256i v_twice_mod,
+               uint64_t m, const uint64_t* W, const uint64_t* W_precon) {
+  __m256i* v_X_pt = reinterpret_cast<__m256i*>(operand);
+
+  // 4 | m guaranteed by n >= 16
+  HEXL_LOOP_UNROLL_4
+  for (size_t i = m / 4; i > 0; --i) {
+    // v_in0 = [x0 y0 x1 y1], v_in1 = [x2 y2 x3 y3]
+    __m256i v_in0 = _mm256_loadu_si256(v_X_pt);
+    __m256i v_in1 = _mm256_loadu_si256(v_X_pt + 1);
+
+    // v_X = [x0 x2 x1 x3], v_Y = [y0 y2 y1 y3]
+    __m256i v_X = _mm256_unpacklo_epi64(v_in0, v_in1);
+    __m256i v_Y = _mm256_unpackhi_epi64(v_in0, v_in1);
+
+    // Permute [W0 W1 W2 W3] to [W0 W2 W1 W3] to match
+    __m256i v_W = _mm256_permute4x64_epi64(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(W)), 0xD8);
+    __m256i v_W_precon = _mm256_permute4x64_epi64(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(W_precon)), 0xD8);
+
+    FwdButterflyAVX2<BitShift, false>(&v_X, &v_Y, v_W, v_W_precon, v_modulus,
+                                      v_twice_mod);
+
+    _mm256_storeu_si256(v_X_pt++, _mm256_unpacklo_epi64(v_X, v_Y));
+    _mm256_storeu_si256(v_X_pt++, _mm256_unpackhi_epi64(v_X, v_Y));
+
+    W += 4;
+    W_precon += 4;
+  }
+}
+
+// Butterflies with t == 2. Processes two groups, i.e. eight coefficients, per
+// iteration.
+template <int BitShift>
+void FwdT2AVX2(uint64_t* operand, __m256i v_modulus, __m256i v_twice_mod,
+               uint64_t m, const uint64_t* W, const uint64_t* W_precon) {
+  __m256i* v_X_pt = reinterpret_cast<__m256i*>(operand);
+
+  // 2 | m guaranteed by n >= 16
+  HEXL_LOOP_UNROLL_4
+  for (size_t i = m / 2; i > 0; --i) {
+    // v_in0 = [x0 x1 y0 y1], v_in1 = [x2 x3 y2 y3]
+    __m256i v_in0 = _mm256_loadu_si256(v_X_pt);
+    __m256i v_in1 = _mm256_loadu_si256(v_X_pt + 1);
+
+    // v_X = [x0 x1 x2 x3], v_Y = [y0 y1 y2 y3]
+    __m256i v_X = _mm256_permute2x128_si256(v_in0, v_in1, 0x20);
+    __m256i v_Y = _mm256_permute2x128_si256(v_in0, v_in1, 0x31);
+
+    // [W0 W1] => [W0 W0 W1 W1]
+    __m256i v_W = _mm256_permute4x64_epi64(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(W))),
+        0x50);
+    __m256i v_W_precon = _mm256_permute4x64_epi64(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(W_precon))),
+        0x50);
+
+    FwdButterflyAVX2<BitShift, false>(&v_X, &v_Y, v_W, v_W_precon, v_modulus,
+                                      v_twice_mod);
+
+    _mm256_storeu_si256(v_X_pt++, _mm256_permute2x128_si256(v_X, v_Y, 0x20));
+    _mm256_storeu_si256(v_X_pt++, _mm256_permute2x128_si256(v_X, v_Y, 0x31));
+
+    W += 2;
+    W_precon += 2;
+  }
+}
+
+// Out-of-place implementation for t >= 4
+template <int BitShift, bool InputLessThanMod>
+void FwdT4AVX2(uint64_t* result, const uint64_t* operand, __m256i v_modulus,
+               __m256i v_twice_mod, uint64_t t, uint64_t m, const uint64_t* W,
+               const uint64_t* W_precon) {
+  size_t j1 = 0;
+
+  HEXL_LOOP_UNROLL_4
+  for (size_t i = 0; i < m; i++) {
+    // Referencing operand
+    const __m256i* v_X_op_pt = reinterpret_cast<const __m256i*>(operand + j1);
+    const __m256i* v_Y_op_pt =
+        reinterpret_cast<const __m256i*>(operand + j1 + t);
+
+    // Referencing result
+    __m256i* v_X_r_pt = reinterpret_cast<__m256i*>(result + j1);
+    __m256i* v_Y_r_pt = reinterpret_cast<__m256i*>(result + j1 + t);
+
+    // Weights and weights' preconditions
+    __m256i v_W = _mm256_set1_epi64x(static_cast<int64_t>(*W++));
+    __m256i v_W_precon = _mm256_set1_epi64x(static_cast<int64_t>(*W_precon++));
+
+    // assume 4 | t
+    for (size_t j = t / 4; j > 0; --j) {
+      __m256i v_X = _mm256_loadu_si256(v_X_op_pt++);
+      __m256i v_Y = _mm256_loadu_si256(v_Y_op_pt++);
+
+      FwdButterflyAVX2<BitShift, InputLessThanMod>(
+          &v_X, &v_Y, v_W, v_W_precon, v_modulus, v_twice_mod);
+
+      _mm256_storeu_si256(v_X_r_pt++, v_X);
+      _mm256_storeu_si256(v_Y_r_pt++, v_Y);
+    }
+    j1 += (t << 1);
+  }
+}
+
+template <int BitShift>
+void ForwardOuterStageAVX2(uint64_t* result, const uint64_t* operand,
+                           uint64_t n, uint64_t modulus,
+                           const uint64_t* root_of_unity_powers,
+                           const uint64_t* precon_root_of_unity_powers,
+                           uint64_t recursion_depth, uint64_t recursion_half) {
+  HEXL_CHECK(n >= 8, "ForwardOuterStageAVX2 needs n >= 8, got n = " << n);
+  __m256i v_modulus = _mm256_set1_epi64x(static_cast<int64_t>(modulus));
+  __m256i v_twice_mod = _mm256_set1_epi64x(static_cast<int64_t>(modulus << 1));
+
+  size_t t = (n >> 1);
+  size_t W_idx = (1ULL << recursion_depth) + recursion_half;
+  const uint64_t* W = &root_of_unity_powers[W_idx];
+  const uint64_t* W_precon = &precon_root_of_unity_powers[W_idx];
+
+  FwdT4AVX2<BitShift, false>(result, operand, v_modulus, v_twice_mod, t, 1, W,
+                             W_precon);
+}
+
+template <int BitShift>
+void ForwardTransformToBitReverseAVX2(
+    uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t modulus,
+    const uint64_t* root_of_unity_powers,
+    const uint64_t* precon_root_of_unity_powers, uint64_t input_mod_factor,
+    uint64_t output_mod_factor, uint64_t recursion_depth,
+    uint64_t recursion_half) {
+  HEXL_CHECK(NTT::CheckArguments(n, modulus), "");
+  HEXL_CHECK(BitShift == 32 || BitShift == 64,
+             "Invalid BitShift " << BitShift << "; need 32 or 64");
+  HEXL_CHECK(modulus < NTT::s_max_fwd_modulus(BitShift),
+             "modulus " << modulus << " too large for BitShift " << BitShift
+                        << " => maximum value "
+                        << NTT::s_max_fwd_modulus(BitShift));
+  HEXL_CHECK_BOUNDS(precon_root_of_unity_powers, n, MaximumValue(BitShift),
+                    "precon_root_of_unity_powers too large");
+  HEXL_CHECK_BOUNDS(operand, n, MaximumValue(BitShift), "operand too large");
+  // Skip input bound checking for recursive steps
+  HEXL_CHECK_BOUNDS(operand, (recursion_depth == 0) ? n : 0,
+                    input_mod_factor * modulus,
+                    "operand larger than input_mod_factor * modulus ("
+                        << input_mod_factor << " * " << modulus << ")");
+  HEXL_CHECK(n >= 16,
+             "Don't support small transforms. Need n >= 16, got n = " << n);
+  HEXL_CHECK(
+      input_mod_factor == 1 || input_mod_factor == 2 || input_mod_factor == 4,
+      "input_mod_factor must be 1, 2, or 4; got " << input_mod_factor);
+  HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 4,
+             "output_mod_factor must be 1 or 4; got " << output_mod_factor);
+
+  uint64_t twice_mod = modulus << 1;
+
+  __m256i v_modulus = _mm256_set1_epi64x(static_cast<int64_t>(modulus));
+  __m256i v_twice_mod = _mm256_set1_epi64x(static_cast<int64_t>(twice_mod));
+
+  HEXL_VLOG(5, "root_of_unity_powers " << std::vector<uint64_t>(
+                   root_of_unity_powers, root_of_unity_powers + n))
+  HEXL_VLOG(5,
+            "precon_root_of_unity_powers " << std::vector<uint64_t>(
+                precon_root_of_unity_powers, precon_root_of_unity_powers + n));
+  HEXL_VLOG(5, "operand " << std::vector<uint64_t>(operand, operand + n));
+
+  static const size_t base_ntt_size = 1024;
+
+  if (n <= base_ntt_size) {  // Perform breadth-first NTT
+    size_t t = (n >> 1);
+    size_t m = 1;
+    size_t W_idx = (m << recursion_depth) + (recursion_half * m);
+
+    // Copy for out-of-place in case m is <= base_ntt_size from start
+    if (result != operand) {
+      std::memcpy(result, operand, n * sizeof(uint64_t));
+    }
+
+    // First iteration assumes input in [0,p)
+    if (m < (n >> 2)) {
+      const uint64_t* W = &root_of_unity_powers[W_idx];
+      const uint64_t* W_precon = &precon_root_of_unity_powers[W_idx];
+
+      if ((input_mod_factor <= 2) && (recursion_depth == 0)) {
+        FwdT4AVX2<BitShift, true>(result, result, v_modulus, v_twice_mod, t, m,
+                                  W, W_precon);
+      } else {
+        FwdT4AVX2<BitShift, false>(result, result, v_modulus, v_twice_mod, t,
+                                   m, W, W_precon);
+      }
+
+      t >>= 1;
+      m <<= 1;
+      W_idx <<= 1;
+    }
+    for (; m < (n >> 2); m <<= 1) {
+      const uint64_t* W = &root_of_unity_powers[W_idx];
+      const uint64_t* W_precon = &precon_root_of_unity_powers[W_idx];
+      FwdT4AVX2<BitShift, false>(result, result, v_modulus, v_twice_mod, t, m,
+                                 W, W_precon);
+      t >>= 1;
+      W_idx <<= 1;
+    }
+
+    // Do T=2, T=1 separately
+    {
+      const uint64_t* W = &root_of_unity_powers[W_idx];
+      const uint64_t* W_precon = &precon_root_of_unity_powers[W_idx];
+      FwdT2AVX2<BitShift>(result, v_modulus, v_twice_mod, m, W, W_precon);
+
+      m <<= 1;
+      W_idx <<= 1;
+      W = &root_of_unity_powers[W_idx];
+      W_precon = &precon_root_of_unity_powers[W_idx];
+      FwdT1AVX2<BitShift>(result, v_modulus, v_twice_mod, m, W, W_precon);
+    }
+
+    if (output_mod_factor == 1) {
+      // n power of two at least 16 => n divisible by 4
+      HEXL_CHECK(n % 4 == 0, "n " << n << " not a power of 2");
+      __m256i* v_X_pt = reinterpret_cast<__m256i*>(result);
+      for (size_t i = 0; i < n; i += 4) {
+        __m256i v_X = _mm256_loadu_si256(v_X_pt);
+
+        // Reduce from [0, 4q) to [0, q)
+        v_X = _mm256_hexl_small_mod_epu64(v_X, v_twice_mod);
+        v_X = _mm256_hexl_small_mod_epu64(v_X, v_modulus);
+
+        HEXL_CHECK_BOUNDS(ExtractValues(v_X).data(), 4, modulus,
+                          "v_X exceeds bound " << modulus);
+
+        _mm256_storeu_si256(v_X_pt, v_X);
+
+        ++v_X_pt;
+      }
+    }
+  } else {
+    // Perform depth-first NTT via recursive call
+    ForwardOuterStageAVX2<BitShift>(result, operand, n, modulus,
+                                    root_of_unity_powers,
+                                    precon_root_of_unity_powers,
+                                    recursion_depth, recursion_half);
+
+    ForwardTransformToBitReverseAVX2<BitShift>(
+        result, result, n / 2, modulus, root_of_unity_powers,
+        precon_root_of_unity_powers, input_mod_factor, output_mod_factor,
+        recursion_depth + 1, recursion_half * 2);
+
+    ForwardTransformToBitReverseAVX2<BitShift>(
+        &result[n / 2], &result[n / 2], n / 2, modulus, root_of_unity_powers,
+        precon_root_of_unity_powers, input_mod_factor, output_mod_factor,
+        recursion_depth + 1, recursion_half * 2 + 1);
+  }
+}
+
+#endif  // HEXL_HAS_AVX256
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,67 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "hexl/ntt/ntt.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+
+/// @brief AVX2 implementation of the forward NTT
+/// @param[out] result Output data. Overwritten with NTT output
+/// @param[in] operand Input data.
+/// @param[in] n Size of the transform, i.e. the polynomial degree. Must be a
+/// power of two, at least 16.
+/// @param[in] modulus Prime modulus q. Must satisfy q == 1 mod 2n
+/// @param[in] root_of_unity_powers Powers of 2n'th root of unity in F_q. In
+/// bit-reversed order.
+/// @param[in] precon_root_of_unity_powers Pre-conditioned Powers of 2n'th root
+/// of unity in F_q. In bit-reversed order.
+/// @param[in] input_mod_factor Upper bound for inputs; inputs must be in [0,
+/// input_mod_factor * q)
+/// @param[in] output_mod_factor Upper bound for result; result must be in [0,
+/// output_mod_factor * q)
+/// @param[in] recursion_depth Depth of recursive call
+/// @param[in] recursion_half Helper for indexing roots of unity
+/// @details Follows the same recursive structure as
+/// ForwardTransformToBitReverseAVX512, on 4-lane vectors. Unlike the AVX512
+/// implementation, the roots of unity are read from the standard (not
+/// duplicated) tables, i.e. NTT::GetRootOfUnityPowers() together with
+/// NTT::GetPrecon32RootOfUnityPowers() or NTT::GetPrecon64RootOfUnityPowers().
+/// BitShift must be 32 or 64.
+template <int BitShift>
+void ForwardTransformToBitReverseAVX2(
+    uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t modulus,
+    const uint64_t* root_of_unity_powers,
+    const uint64_t* precon_root_of_unity_powers, uint64_t input_mod_factor,
+    uint64_t output_mod_factor, uint64_t recursion_depth = 0,
+    uint64_t recursion_half = 0);
+
+/// @brief AVX2 implementation of a single outer stage of the forward NTT
+/// @param[out] result Output data
+/// @param[in] operand Input data, in [0, 4q). May alias \p result
+/// @param[in] n Size of the sub-block. Must be a power of two, at least 8
+/// @param[in] modulus Prime modulus q
+/// @param[in] root_of_unity_powers Roots of unity, as for
+/// ForwardTransformToBitReverseAVX2
+/// @param[in] precon_root_of_unity_powers Pre-conditioned roots of unity, as
+/// for ForwardTransformToBitReverseAVX2
+/// @param[in] recursion_depth Depth of the sub-block within the transform
+/// @param[in] recursion_half Index of the sub-block at its depth
+/// @details Runs the butterflies between the two halves of the sub-block,
+/// i.e. the stage the depth-first recursion runs before transforming each
+/// half. Outputs are in [0, 4q).
+template <int BitShift>
+void ForwardOuterStageAVX2(uint64_t* result, const uint64_t* operand,
+                           uint64_t n, uint64_t modulus,
+                           const uint64_t* root_of_unity_powers,
+                           const uint64_t* precon_root_of_unity_powers,
+                           uint64_t recursion_depth, uint64_t recursion_half);
+
+#endif  // HEXL_HAS_AVX256
+
+}  // namespace hexl
+}  // namespace intel
@@ -24,6 +24,12 @@ template void ForwardTransformToBitReverseAVX512<NTT::s_ifma_shift_bits>(
     const uint64_t* precon_root_of_unity_powers, uint64_t input_mod_factor,
     uint64_t output_mod_factor, uint64_t recursion_depth,
     uint64_t recursion_half);
+
+template void ForwardOuterStageAVX512<NTT::s_ifma_shift_bits>(
+    uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t modulus,
+    const uint64_t* root_of_unity_powers,
+    const uint64_t* precon_root_of_unity_powers, uint64_t recursion_depth,
+    uint64_t recursion_half);
 #endif
 
 #ifdef HEXL_HAS_AVX512DQ
@@ -40,6 +46,18 @@ template void ForwardTransformToBitReverseAVX512<NTT::s_default_shift_bits>(
     const uint64_t* precon_root_of_unity_powers, uint64_t input_mod_factor,
     uint64_t output_mod_factor, uint64_t recursion_depth,
     uint64_t recursion_half);
+
+template void ForwardOuterStageAVX512<32>(
+    uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t modulus,
+    const uint64_t* root_of_unity_powers,
+    const uint64_t* precon_root_of_unity_powers, uint64_t recursion_depth,
+    uint64_t recursion_half);
+
+template void ForwardOuterStageAVX512<NTT::s_default_shift_bits>(
+    uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t modulus,
+    const uint64_t* root_of_unity_powers,
+    const uint64_t* precon_root_of_unity_powers, uint64_t recursion_depth,
+    uint64_t recursion_half);
 #endif
 
 #ifdef HEXL_HAS_AVX512DQ
@@ -230,6 +248,26 @@ void FwdT8(uint64_t* result, const uint64_t* operand, __m512i v_neg_modulus,
   }
 }
 
+template <int BitShift>
+void ForwardOuterStageAVX512(uint64_t* result, const uint64_t* operand,
+                             uint64_t n, uint64_t modulus,
+                             const uint64_t* root_of_unity_powers,
+                             const uint64_t* precon_root_of_unity_powers,
+                             uint64_t recursion_depth,
+                             uint64_t recursion_half) {
+  HEXL_CHECK(n >= 16, "ForwardOuterStageAVX512 needs n >= 16, got n = " << n);
+  __m512i v_neg_modulus = _mm512_set1_epi64(-static_cast<int64_t>(modulus));
+  __m512i v_twice_mod = _mm512_set1_epi64(static_cast<int64_t>(modulus << 1));
+
+  size_t t = (n >> 1);
+  size_t W_idx = (1ULL << recursion_depth) + recursion_half;
+  const uint64_t* W = &root_of_unity_powers[W_idx];
+  const uint64_t* W_precon = &precon_root_of_unity_powers[W_idx];
+
+  FwdT8<BitShift, false>(result, operand, v_neg_modulus, v_twice_mod, t, 1, W,
+                         W_precon);
+}
+
 template <int BitShift>
 void ForwardTransformToBitReverseAVX512(
     uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t modulus,
@@ -383,13 +421,10 @@ void ForwardTransformToBitReverseAVX512(
     }
   } else {
     // Perform depth-first NTT via recursive call
-    size_t t = (n >> 1);
-    size_t W_idx = (1ULL << recursion_depth) + recursion_half;
-    const uint64_t* W = &root_of_unity_powers[W_idx];
-    const uint64_t* W_precon = &precon_root_of_unity_powers[W_idx];
-
-    FwdT8<BitShift, false>(result, operand, v_neg_modulus, v_twice_mod, t, 1, W,
-                           W_precon);
+    ForwardOuterStageAVX512<BitShift>(result, operand, n, modulus,
+                                      root_of_unity_powers,
+                                      precon_root_of_unity_powers,
+                                      recursion_depth, recursion_half);
 
     ForwardTransformToBitReverseAVX512<BitShift>(
         result, result, n / 2, modulus, root_of_unity_powers,
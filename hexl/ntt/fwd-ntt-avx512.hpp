@@ -40,6 +40,27 @@ void ForwardTransformToBitReverseAVX512(
     uint64_t output_mod_factor, uint64_t recursion_depth = 0,
     uint64_t recursion_half = 0);
 
+/// @brief AVX512 implementation of a single outer stage of the forward NTT
+/// @param[out] result Output data
+/// @param[in] operand Input data, in [0, 4q). May alias \p result
+/// @param[in] n Size of the sub-block. Must be a power of two, at least 16
+/// @param[in] modulus Prime modulus q
+/// @param[in] root_of_unity_powers Roots of unity, as for
+/// ForwardTransformToBitReverseAVX512
+/// @param[in] precon_root_of_unity_powers Pre-conditioned roots of unity, as
+/// for ForwardTransformToBitReverseAVX512
+/// @param[in] recursion_depth Depth of the sub-block within the transform
+/// @param[in] recursion_half Index of the sub-block at its depth
+/// @details Runs the butterflies between the two halves of the sub-block,
+/// i.e. the stage the depth-first recursion runs before transforming each
+/// half. Outputs are in [0, 4q).
+template <int BitShift>
+void ForwardOuterStageAVX512(uint64_t* result, const uint64_t* operand,
+                             uint64_t n, uint64_t modulus,
+                             const uint64_t* root_of_unity_powers,
+                             const uint64_t* precon_root_of_unity_powers,
+                             uint64_t recursion_depth, uint64_t recursion_half);
+
 #endif  // HEXL_HAS_AVX512DQ
 
 }  // namespace hexl
@@ -0,0 +1,411 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ntt/inv-ntt-avx2.hpp"
+
+#include <immintrin.h>
+
+#include <cstring>
+#include <vector>
+
+#include "hexl/logging/logging.hpp"
+#include "hexl/ntt/ntt.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "ntt/ntt-internal.hpp"
+#include "util/avx2-util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+template void InverseTransformFromBitReverseAVX2<32>(
+    uint64_t* result, const uint64_t* operand, uint64_t degree,
+    uint64_t modulus, const uint64_t* inv_root_of_unity_powers,
+    const uint64_t* precon_inv_root_of_unity_powers, uint64_t input_mod_factor,
+    uint64_t output_mod_factor, uint64_t recursion_depth,
+    uint64_t recursion_half);
+
+template void InverseTransformFromBitReverseAVX2<NTT::s_default_shift_bits>(
+    uint64_t* result, const uint64_t* operand, uint64_t degree,
+    uint64_t modulus, const uint64_t* inv_root_of_unity_powers,
+    const uint64_t* precon_inv_root_of_unity_powers, uint64_t input_mod_factor,
+    uint64_t output_mod_factor, uint64_t recursion_depth,
+    uint64_t recursion_half);
+
+template void InverseOuterStagesAVX2<32>(
+    uint64_t* result, uint64_t n, uint64_t modulus,
+    const uint64_t* inv_root_of_unity_powers,
+    const uint64_t* precon_inv_root_of_unity_powers, uint64_t output_mod_factor,
+    uint64_t recursion_depth, uint64_t recursion_half);
+
+template void InverseOuterStagesAVX2<NTT::s_default_shift_bits>(
+    uint64_t* result, uint64_t n, uint64_t modulus,
+    const uint64_t* inv_root_of_unity_powers,
+    const uint64_t* precon_inv_root_of_unity_powers, uint64_t output_mod_factor,
+    uint64_t recursion_depth, uint64_t recursion_half);
+#endif
+
+#ifdef HEXL_HAS_AVX256
+
+/// @brief The Harvey butterfly: assume X, Y in [0, 2q), and return X', Y' in
+/// [0, 2q). such that X', Y' = X + Y (mod q), W(X - Y) (mod q).
+/// @param[in,out] X Input representing 4 64-bit unsigned integers in SIMD form
+/// @param[in,out] Y Input representing 4 64-bit unsigned integers in SIMD form
+/// @param[in] W Root of unity representing 4 64-bit unsigned integers in SIMD
+/// form
+/// @param[in] W_precon Preconditioned \p W for BitShift-bit Barrett
+/// reduction
+/// @param[in] modulus Modulus, i.e. q represented as 4 64-bit unsigned
+/// integers in SIMD form
+/// @param[in] twice_modulus Twice the modulus, i.e. 2*q represented as 4 64-bit
+/// unsigned integers in SIMD form
+/// @param InputLessThanMod If true, assumes \p X, \p Y < \p q. Otherwise,
+/// assumes \p X, \p Y < 2*\p q
+/// @details See Algorithm 3 of https://arxiv.org/pdf/1205.2926.pdf
+template <int BitShift, bool InputLessThanMod>
+inline void InvButterflyAVX2(__m256i* X, __m256i* Y, __m256i W,
+                             __m256i W_precon, __m256i modulus,
+                             __m256i twice_modulus) {
+  // Compute T first to allow in-place update of X
+  __m256i Y_minus_2q = _mm256_sub_epi64(*Y, twice_modulus);
+  __m256i T = _mm256_sub_epi64(*X, Y_minus_2q);
+
+  *X = _mm256_add_epi64(*X, *Y);
+  if (!InputLessThanMod) {
+    // No need for modulus reduction if inputs are in [0, q)
+    *X = _mm256_hexl_small_mod_epu64(*X, twice_modulus);
+  }
+
+  *Y = _mm256_hexl_mul_mod_lazy_epi64<BitShift>(T, W, W_precon, modulus,
+                                                twice_modulus);
+}
+
+// Butterflies with t == 1. Processes four butterflies, i.e. eight
+// coefficients, per iteration.
+template <int BitShift, bool InputLessThanMod>
+void InvT1AVX2(uint64_t* operand, __m256i v_modulus, __m256i v_twice_mod,
+               uint64_t m, const uint64_t* W, const uint64_t* W_precon) {
+  __m256i* v_X_pt = reinterpret_cast<__m256i*>(operand);
+
+  // 4 | m guaranteed by n >= 16
+  HEXL_LOOP_UNROLL_4
+  for (size_t i = m / 4; i > 0; --i) {
+    // v_in0 = [x0 y0 x1 y1], v_in1 = [x2 y2 x3 y3]
+    __m256i v_in0 = _mm256_loadu_si256(v_X_pt);
+    __m256i v_in1 = _mm256_loadu_si256(v_X_pt + 1);
+
+    // v_X = [x0 x2 x1 x3], v_Y = [y0 y2 y1 y3]
+    __m256i v_X = _mm256_unpacklo_epi64(v_in0, v_in1);
+    __m256i v_Y = _mm256_unpackhi_epi64(v_in0, v_in1);
+
+    // Permute [W0 W1 W2 W3] to [W0 W2 W1 W3] to match
+    __m256i v_W = _mm256_permute4x64_epi64(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(W)), 0xD8);
+    __m256i v_W_precon = _mm256_permute4x64_epi64(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(W_precon)), 0xD8);
+
+    InvButterflyAVX2<BitShift, InputLessThanMod>(&v_X, &v_Y, v_W, v_W_precon,
+                                                 v_modulus, v_twice_mod);
+
+    _mm256_storeu_si256(v_X_pt++, _mm256_unpacklo_epi64(v_X, v_Y));
+    _mm256_storeu_si256(v_X_pt++, _mm256_unpackhi_epi64(v_X, v_Y));
+
+    W += 4;
+    W_precon += 4;
+  }
+}
+
+// Butterflies with t == 2. Processes two groups, i.e. eight coefficients, per
+// iteration.
+template <int BitShift>
+void InvT2AVX2(uint64_t* operand, __m256i v_modulus, __m256i v_twice_mod,
+               uint64_t m, const uint64_t* W, const uint64_t* W_precon) {
+  __m256i* v_X_pt = reinterpret_cast<__m256i*>(operand);
+
+  // 2 | m guaranteed by n >= 16
+  HEXL_LOOP_UNROLL_4
+  for (size_t i = m / 2; i > 0; --i) {
+    // v_in0 = [x0 x1 y0 y1], v_in1 = [x2 x3 y2 y3]
+    __m256i v_in0 = _mm256_loadu_si256(v_X_pt);
+    __m256i v_in1 = _mm256_loadu_si256(v_X_pt + 1);
+
+    // v_X = [x0 x1 x2 x3], v_Y = [y0 y1 y2 y3]
+    __m256i v_X = _mm256_permute2x128_si256(v_in0, v_in1, 0x20);
+    __m256i v_Y = _mm256_permute2x128_si256(v_in0, v_in1, 0x31);
+
+    // [W0 W1] => [W0 W0 W1 W1]
+    __m256i v_W = _mm256_permute4x64_epi64(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(W))),
+        0x50);
+    __m256i v_W_precon = _mm256_permute4x64_epi64(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(W_precon))),
+        0x50);
+
+    InvButterflyAVX2<BitShift, false>(&v_X, &v_Y, v_W, v_W_precon, v_modulus,
+                                      v_twice_mod);
+
+    _mm256_storeu_si256(v_X_pt++, _mm256_permute2x128_si256(v_X, v_Y, 0x20));
+    _mm256_storeu_si256(v_X_pt++, _mm256_permute2x128_si256(v_X, v_Y, 0x31));
+
+    W += 2;
+    W_precon += 2;
+  }
+}
+
+// In-place implementation for t >= 4
+template <int BitShift>
+void InvT4AVX2(uint64_t* operand, __m256i v_modulus, __m256i v_twice_mod,
+               uint64_t t, uint64_t m, const uint64_t* W,
+               const uint64_t* W_precon) {
+  size_t j1 = 0;
+
+  HEXL_LOOP_UNROLL_4
+  for (size_t i = 0; i < m; i++) {
+    __m256i* v_X_pt = reinterpret_cast<__m256i*>(operand + j1);
+    __m256i* v_Y_pt = reinterpret_cast<__m256i*>(operand + j1 + t);
+
+    __m256i v_W = _mm256_set1_epi64x(static_cast<int64_t>(*W++));
+    __m256i v_W_precon = _mm256_set1_epi64x(static_cast<int64_t>(*W_precon++));
+
+    // assume 4 | t
+    for (size_t j = t / 4; j > 0; --j) {
+      __m256i v_X = _mm256_loadu_si256(v_X_pt);
+      __m256i v_Y = _mm256_loadu_si256(v_Y_pt);
+
+      InvButterflyAVX2<BitShift, false>(&v_X, &v_Y, v_W, v_W_precon,
+                                        v_modulus, v_twice_mod);
+
+      _mm256_storeu_si256(v_X_pt++, v_X);
+      _mm256_storeu_si256(v_Y_pt++, v_Y);
+    }
+    j1 += (t << 1);
+  }
+}
+
+// Runs the final stage of the inverse NTT of size n, which folds in the
+// multiplication by N^{-1}, given its root of unity W
+template <int BitShift>
+void InvFinalStageAVX2(uint64_t* result, uint64_t n, uint64_t modulus,
+                       uint64_t W, uint64_t output_mod_factor) {
+  __m256i v_modulus = _mm256_set1_epi64x(static_cast<int64_t>(modulus));
+  __m256i v_twice_mod = _mm256_set1_epi64x(static_cast<int64_t>(modulus << 1));
+
+  HEXL_VLOG(4, "AVX2 intermediate result "
+                   << std::vector<uint64_t>(result, result + n));
+
+  MultiplyFactor mf_inv_n(InverseMod(n, modulus), BitShift, modulus);
+  const uint64_t inv_n = mf_inv_n.Operand();
+  const uint64_t inv_n_prime = mf_inv_n.BarrettFactor();
+
+  MultiplyFactor mf_inv_n_w(MultiplyMod(inv_n, W, modulus), BitShift,
+                            modulus);
+  const uint64_t inv_n_w = mf_inv_n_w.Operand();
+  const uint64_t inv_n_w_prime = mf_inv_n_w.BarrettFactor();
+
+  HEXL_VLOG(4, "inv_n_w " << inv_n_w);
+
+  uint64_t* X = result;
+  uint64_t* Y = X + (n >> 1);
+
+  __m256i v_inv_n = _mm256_set1_epi64x(static_cast<int64_t>(inv_n));
+  __m256i v_inv_n_prime =
+      _mm256_set1_epi64x(static_cast<int64_t>(inv_n_prime));
+  __m256i v_inv_n_w = _mm256_set1_epi64x(static_cast<int64_t>(inv_n_w));
+  __m256i v_inv_n_w_prime =
+      _mm256_set1_epi64x(static_cast<int64_t>(inv_n_w_prime));
+
+  __m256i* v_X_pt = reinterpret_cast<__m256i*>(X);
+  __m256i* v_Y_pt = reinterpret_cast<__m256i*>(Y);
+
+  // Merge final InvNTT loop with modulus reduction baked-in
+  HEXL_LOOP_UNROLL_4
+  for (size_t j = n / 8; j > 0; --j) {
+    __m256i v_X = _mm256_loadu_si256(v_X_pt);
+    __m256i v_Y = _mm256_loadu_si256(v_Y_pt);
+
+    // Slightly different from regular InvButterfly because different W is
+    // used for X and Y
+    __m256i Y_minus_2q = _mm256_sub_epi64(v_Y, v_twice_mod);
+    __m256i X_plus_Y_mod2q =
+        _mm256_hexl_small_add_mod_epi64(v_X, v_Y, v_twice_mod);
+    // T = *X + twice_mod - *Y
+    __m256i T = _mm256_sub_epi64(v_X, Y_minus_2q);
+
+    // X = inv_N * X_plus_Y_mod2q mod q, Y = inv_N_W * T mod q, in [0, 2q)
+    v_X = _mm256_hexl_mul_mod_lazy_epi64<BitShift>(
+        X_plus_Y_mod2q, v_inv_n, v_inv_n_prime, v_modulus, v_twice_mod);
+    v_Y = _mm256_hexl_mul_mod_lazy_epi64<BitShift>(
+        T, v_inv_n_w, v_inv_n_w_prime, v_modulus, v_twice_mod);
+
+    if (output_mod_factor == 1) {
+      // Modulus reduction from [0, 2q), to [0, q)
+      v_X = _mm256_hexl_small_mod_epu64(v_X, v_modulus);
+      v_Y = _mm256_hexl_small_mod_epu64(v_Y, v_modulus);
+    }
+
+    _mm256_storeu_si256(v_X_pt++, v_X);
+    _mm256_storeu_si256(v_Y_pt++, v_Y);
+  }
+
+  HEXL_VLOG(5, "AVX2 returning result "
+                   << std::vector<uint64_t>(result, result + n));
+}
+
+template <int BitShift>
+void InverseOuterStagesAVX2(uint64_t* result, uint64_t n, uint64_t modulus,
+                            const uint64_t* inv_root_of_unity_powers,
+                            const uint64_t* precon_inv_root_of_unity_powers,
+                            uint64_t output_mod_factor,
+                            uint64_t recursion_depth,
+                            uint64_t recursion_half) {
+  HEXL_CHECK(n >= 16, "InverseOuterStagesAVX2 needs n >= 16, got n = " << n);
+  __m256i v_modulus = _mm256_set1_epi64x(static_cast<int64_t>(modulus));
+  __m256i v_twice_mod = _mm256_set1_epi64x(static_cast<int64_t>(modulus << 1));
+
+  size_t t = 1;
+  size_t m = (n >> 1);
+  size_t W_idx = 1 + m * recursion_half;
+
+  uint64_t W_idx_delta =
+      m * ((1ULL << (recursion_depth + 1)) - recursion_half);
+  for (; m > 2; m >>= 1) {
+    t <<= 1;
+    W_idx_delta >>= 1;
+    W_idx += W_idx_delta;
+  }
+  if (m == 2) {
+    const uint64_t* W = &inv_root_of_unity_powers[W_idx];
+    const uint64_t* W_precon = &precon_inv_root_of_unity_powers[W_idx];
+    InvT4AVX2<BitShift>(result, v_modulus, v_twice_mod, t, m, W, W_precon);
+    t <<= 1;
+    m >>= 1;
+    W_idx_delta >>= 1;
+    W_idx += W_idx_delta;
+  }
+
+  if (recursion_depth == 0) {
+    InvFinalStageAVX2<BitShift>(result, n, modulus,
+                                inv_root_of_unity_powers[W_idx],
+                                output_mod_factor);
+  }
+}
+
+template <int BitShift>
+void InverseTransformFromBitReverseAVX2(
+    uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t modulus,
+    const uint64_t* inv_root_of_unity_powers,
+    const uint64_t* precon_inv_root_of_unity_powers, uint64_t input_mod_factor,
+    uint64_t output_mod_factor, uint64_t recursion_depth,
+    uint64_t recursion_half) {
+  HEXL_CHECK(NTT::CheckArguments(n, modulus), "");
+  HEXL_CHECK(BitShift == 32 || BitShift == 64,
+             "Invalid BitShift " << BitShift << "; need 32 or 64");
+  HEXL_CHECK(n >= 16,
+             "InverseTransformFromBitReverseAVX2 doesn't support small "
+             "transforms. Need n >= 16, got n = "
+                 << n);
+  HEXL_CHECK(modulus < NTT::s_max_inv_modulus(BitShift),
+             "modulus " << modulus << " too large for BitShift " << BitShift
+                        << " => maximum value "
+                        << NTT::s_max_inv_modulus(BitShift));
+  HEXL_CHECK_BOUNDS(precon_inv_root_of_unity_powers, n, MaximumValue(BitShift),
+                    "precon_inv_root_of_unity_powers too large");
+  HEXL_CHECK_BOUNDS(operand, n, MaximumValue(BitShift), "operand too large");
+  // Skip input bound checking for recursive steps
+  HEXL_CHECK_BOUNDS(operand, (recursion_depth == 0) ? n : 0,
+                    input_mod_factor * modulus,
+                    "operand larger than input_mod_factor * modulus ("
+                        << input_mod_factor << " * " << modulus << ")");
+  HEXL_CHECK(input_mod_factor == 1 || input_mod_factor == 2,
+             "input_mod_factor must be 1 or 2; got " << input_mod_factor);
+  HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 2,
+             "output_mod_factor must be 1 or 2; got " << output_mod_factor);
+
+  uint64_t twice_mod = modulus << 1;
+  __m256i v_modulus = _mm256_set1_epi64x(static_cast<int64_t>(modulus));
+  __m256i v_twice_mod = _mm256_set1_epi64x(static_cast<int64_t>(twice_mod));
+
+  size_t t = 1;
+  size_t m = (n >> 1);
+  size_t W_idx = 1 + m * recursion_half;
+
+  static const size_t base_ntt_size = 1024;
+
+  if (n <= base_ntt_size) {  // Perform breadth-first InvNTT
+    if (operand != result) {
+      std::memcpy(result, operand, n * sizeof(uint64_t));
+    }
+
+    // Extract t=1, t=2 loops separately
+    {
+      // t = 1
+      const uint64_t* W = &inv_root_of_unity_powers[W_idx];
+      const uint64_t* W_precon = &precon_inv_root_of_unity_powers[W_idx];
+      if ((input_mod_factor == 1) && (recursion_depth == 0)) {
+        InvT1AVX2<BitShift, true>(result, v_modulus, v_twice_mod, m, W,
+                                  W_precon);
+      } else {
+        InvT1AVX2<BitShift, false>(result, v_modulus, v_twice_mod, m, W,
+                                   W_precon);
+      }
+
+      t <<= 1;
+      m >>= 1;
+      uint64_t W_idx_delta =
+          m * ((1ULL << (recursion_depth + 1)) - recursion_half);
+      W_idx += W_idx_delta;
+
+      // t = 2
+      W = &inv_root_of_unity_powers[W_idx];
+      W_precon = &precon_inv_root_of_unity_powers[W_idx];
+      InvT2AVX2<BitShift>(result, v_modulus, v_twice_mod, m, W, W_precon);
+
+      t <<= 1;
+      m >>= 1;
+      W_idx_delta >>= 1;
+      W_idx += W_idx_delta;
+
+      // t >= 4
+      for (; m > 1;) {
+        W = &inv_root_of_unity_powers[W_idx];
+        W_precon = &precon_inv_root_of_unity_powers[W_idx];
+        InvT4AVX2<BitShift>(result, v_modulus, v_twice_mod, t, m, W,
+                            W_precon);
+        t <<= 1;
+        m >>= 1;
+        W_idx_delta >>= 1;
+        W_idx += W_idx_delta;
+      }
+    }
+  } else {
+    InverseTransformFromBitReverseAVX2<BitShift>(
+        result, operand, n / 2, modulus, inv_root_of_unity_powers,
+        precon_inv_root_of_unity_powers, input_mod_factor, output_mod_factor,
+        recursion_depth + 1, 2 * recursion_half);
+    InverseTransformFromBitReverseAVX2<BitShift>(
+        &result[n / 2], &operand[n / 2], n / 2, modulus,
+        inv_root_of_unity_powers, precon_inv_root_of_unity_powers,
+        input_mod_factor, output_mod_factor, recursion_depth + 1,
+        2 * recursion_half + 1);
+
+    InverseOuterStagesAVX2<BitShift>(
+        result, n, modulus, inv_root_of_unity_powers,
+        precon_inv_root_of_unity_powers, output_mod_factor, recursion_depth,
+        recursion_half);
+    return;
+  }
+
+  // Final loop through data
+  if (recursion_depth == 0) {
+    InvFinalStageAVX2<BitShift>(result, n, modulus,
+                                inv_root_of_unity_powers[W_idx],
+                                output_mod_factor);
+  }
+}
+
+#endif  // HEXL_HAS_AVX256
+
+}  // namespace hexl
+}  // namespace intel
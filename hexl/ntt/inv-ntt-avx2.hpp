@@ -0,0 +1,69 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "ntt/ntt-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+
+/// @brief AVX2 implementation of the inverse NTT
+/// @param[out] result Output data. Overwritten with NTT output
+/// @param[in] operand Input data.
+/// @param[in] n Size of the transform, i.e. the polynomial degree. Must be a
+/// power of two, at least 16.
+/// @param[in] modulus Prime modulus q. Must satisfy q == 1 mod 2n
+/// @param[in] inv_root_of_unity_powers Powers of inverse 2n'th root of unity in
+/// F_q. In bit-reversed order.
+/// @param[in] precon_inv_root_of_unity_powers Pre-conditioned powers of inverse
+/// 2n'th root of unity in F_q. In bit-reversed order.
+/// @param[in] input_mod_factor Upper bound for inputs; inputs must be in [0,
+/// input_mod_factor * q)
+/// @param[in] output_mod_factor Upper bound for result; result must be in [0,
+/// output_mod_factor * q)
+/// @param[in] recursion_depth Depth of recursive call
+/// @param[in] recursion_half Helper for indexing roots of unity
+/// @details Follows the same recursive structure as
+/// InverseTransformFromBitReverseAVX512, on 4-lane vectors. BitShift must be
+/// 32 or 64.
+template <int BitShift>
+void InverseTransformFromBitReverseAVX2(
+    uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t modulus,
+    const uint64_t* inv_root_of_unity_powers,
+    const uint64_t* precon_inv_root_of_unity_powers, uint64_t input_mod_factor,
+    uint64_t output_mod_factor, uint64_t recursion_depth = 0,
+    uint64_t recursion_half = 0);
+
+/// @brief AVX2 implementation of the outer stages of the inverse NTT
+/// @param[in, out] result Sub-block whose halves have been transformed by
+/// InverseTransformFromBitReverseAVX2 at depth recursion_depth + 1, in [0,
+/// 2q)
+/// @param[in] n Size of the sub-block. Must be a power of two, at least 16
+/// @param[in] modulus Prime modulus q
+/// @param[in] inv_root_of_unity_powers Inverse roots of unity, as for
+/// InverseTransformFromBitReverseAVX2
+/// @param[in] precon_inv_root_of_unity_powers Pre-conditioned inverse roots of
+/// unity, as for InverseTransformFromBitReverseAVX2
+/// @param[in] output_mod_factor Upper bound for result; result must be in [0,
+/// output_mod_factor * q)
+/// @param[in] recursion_depth Depth of the sub-block within the transform
+/// @param[in] recursion_half Index of the sub-block at its depth
+/// @details Runs the stages the depth-first recursion runs after transforming
+/// both halves: the final stage of each half and, for recursion_depth == 0,
+/// the final stage of the transform, which folds in the multiplication by
+/// N^{-1}.
+template <int BitShift>
+void InverseOuterStagesAVX2(uint64_t* result, uint64_t n, uint64_t modulus,
+                            const uint64_t* inv_root_of_unity_powers,
+                            const uint64_t* precon_inv_root_of_unity_powers,
+                            uint64_t output_mod_factor,
+                            uint64_t recursion_depth,
+                            uint64_t recursion_half);
+
+#endif  // HEXL_HAS_AVX256
+
+}  // namespace hexl
+}  // namespace intel
@@ -26,6 +26,12 @@ template void InverseTransformFromBitReverseAVX512<NTT::s_ifma_shift_bits>(
     const uint64_t* precon_inv_root_of_unity_powers, uint64_t input_mod_factor,
     uint64_t output_mod_factor, uint64_t recursion_depth,
     uint64_t recursion_half);
+
+template void InverseOuterStagesAVX512<NTT::s_ifma_shift_bits>(
+    uint64_t* result, uint64_t n, uint64_t modulus,
+    const uint64_t* inv_root_of_unity_powers,
+    const uint64_t* precon_inv_root_of_unity_powers, uint64_t output_mod_factor,
+    uint64_t recursion_depth, uint64_t recursion_half);
 #endif
 
 #ifdef HEXL_HAS_AVX512DQ
@@ -42,6 +48,18 @@ template void InverseTransformFromBitReverseAVX512<NTT::s_default_shift_bits>(
     const uint64_t* precon_inv_root_of_unity_powers, uint64_t input_mod_factor,
     uint64_t output_mod_factor, uint64_t recursion_depth,
     uint64_t recursion_half);
+
+template void InverseOuterStagesAVX512<32>(
+    uint64_t* result, uint64_t n, uint64_t modulus,
+    const uint64_t* inv_root_of_unity_powers,
+    const uint64_t* precon_inv_root_of_unity_powers, uint64_t output_mod_factor,
+    uint64_t recursion_depth, uint64_t recursion_half);
+
+template void InverseOuterStagesAVX512<NTT::s_default_shift_bits>(
+    uint64_t* result, uint64_t n, uint64_t modulus,
+    const uint64_t* inv_root_of_unity_powers,
+    const uint64_t* precon_inv_root_of_unity_powers, uint64_t output_mod_factor,
+    uint64_t recursion_depth, uint64_t recursion_half);
 #endif
 
 #ifdef HEXL_HAS_AVX512DQ
@@ -221,6 +239,138 @@ void InvT8(uint64_t* operand, __m512i v_neg_modulus, __m512i v_twice_mod,
   }
 }
 
+// Runs the final stage of the inverse NTT of size n, which folds in the
+// multiplication by N^{-1}, given its root of unity W
+template <int BitShift>
+void InvFinalStage(uint64_t* result, uint64_t n, uint64_t modulus, uint64_t W,
+                   uint64_t output_mod_factor) {
+  __m512i v_modulus = _mm512_set1_epi64(static_cast<int64_t>(modulus));
+  __m512i v_neg_modulus = _mm512_set1_epi64(-static_cast<int64_t>(modulus));
+  __m512i v_twice_mod = _mm512_set1_epi64(static_cast<int64_t>(modulus << 1));
+
+  HEXL_VLOG(4, "AVX512 intermediate result "
+                   << std::vector<uint64_t>(result, result + n));
+
+  MultiplyFactor mf_inv_n(InverseMod(n, modulus), BitShift, modulus);
+  const uint64_t inv_n = mf_inv_n.Operand();
+  const uint64_t inv_n_prime = mf_inv_n.BarrettFactor();
+
+  MultiplyFactor mf_inv_n_w(MultiplyMod(inv_n, W, modulus), BitShift,
+                            modulus);
+  const uint64_t inv_n_w = mf_inv_n_w.Operand();
+  const uint64_t inv_n_w_prime = mf_inv_n_w.BarrettFactor();
+
+  HEXL_VLOG(4, "inv_n_w " << inv_n_w);
+
+  uint64_t* X = result;
+  uint64_t* Y = X + (n >> 1);
+
+  __m512i v_inv_n = _mm512_set1_epi64(static_cast<int64_t>(inv_n));
+  __m512i v_inv_n_prime =
+      _mm512_set1_epi64(static_cast<int64_t>(inv_n_prime));
+  __m512i v_inv_n_w = _mm512_set1_epi64(static_cast<int64_t>(inv_n_w));
+  __m512i v_inv_n_w_prime =
+      _mm512_set1_epi64(static_cast<int64_t>(inv_n_w_prime));
+
+  __m512i* v_X_pt = reinterpret_cast<__m512i*>(X);
+  __m512i* v_Y_pt = reinterpret_cast<__m512i*>(Y);
+
+  // Merge final InvNTT loop with modulus reduction baked-in
+  HEXL_LOOP_UNROLL_4
+  for (size_t j = n / 16; j > 0; --j) {
+    __m512i v_X = _mm512_loadu_si512(v_X_pt);
+    __m512i v_Y = _mm512_loadu_si512(v_Y_pt);
+
+    // Slightly different from regular InvButterfly because different W is
+    // used for X and Y
+    __m512i Y_minus_2q = _mm512_sub_epi64(v_Y, v_twice_mod);
+    __m512i X_plus_Y_mod2q =
+        _mm512_hexl_small_add_mod_epi64(v_X, v_Y, v_twice_mod);
+    // T = *X + twice_mod - *Y
+    __m512i T = _mm512_sub_epi64(v_X, Y_minus_2q);
+
+    if (BitShift == 32) {
+      __m512i Q1 = _mm512_hexl_mullo_epi<64>(v_inv_n_prime, X_plus_Y_mod2q);
+      Q1 = _mm512_srli_epi64(Q1, 32);
+      // X = inv_N * X_plus_Y_mod2q - Q1 * modulus;
+      __m512i inv_N_tx = _mm512_hexl_mullo_epi<64>(v_inv_n, X_plus_Y_mod2q);
+      v_X = _mm512_hexl_mullo_add_lo_epi<64>(inv_N_tx, Q1, v_neg_modulus);
+
+      __m512i Q2 = _mm512_hexl_mullo_epi<64>(v_inv_n_w_prime, T);
+      Q2 = _mm512_srli_epi64(Q2, 32);
+
+      // Y = inv_N_W * T - Q2 * modulus;
+      __m512i inv_N_W_T = _mm512_hexl_mullo_epi<64>(v_inv_n_w, T);
+      v_Y = _mm512_hexl_mullo_add_lo_epi<64>(inv_N_W_T, Q2, v_neg_modulus);
+    } else {
+      __m512i Q1 =
+          _mm512_hexl_mulhi_epi<BitShift>(v_inv_n_prime, X_plus_Y_mod2q);
+      // X = inv_N * X_plus_Y_mod2q - Q1 * modulus;
+      __m512i inv_N_tx =
+          _mm512_hexl_mullo_epi<BitShift>(v_inv_n, X_plus_Y_mod2q);
+      v_X =
+          _mm512_hexl_mullo_add_lo_epi<BitShift>(inv_N_tx, Q1, v_neg_modulus);
+
+      __m512i Q2 = _mm512_hexl_mulhi_epi<BitShift>(v_inv_n_w_prime, T);
+      // Y = inv_N_W * T - Q2 * modulus;
+      __m512i inv_N_W_T = _mm512_hexl_mullo_epi<BitShift>(v_inv_n_w, T);
+      v_Y = _mm512_hexl_mullo_add_lo_epi<BitShift>(inv_N_W_T, Q2,
+                                                   v_neg_modulus);
+    }
+
+    if (output_mod_factor == 1) {
+      // Modulus reduction from [0, 2q), to [0, q)
+      v_X = _mm512_hexl_small_mod_epu64(v_X, v_modulus);
+      v_Y = _mm512_hexl_small_mod_epu64(v_Y, v_modulus);
+    }
+
+    _mm512_storeu_si512(v_X_pt++, v_X);
+    _mm512_storeu_si512(v_Y_pt++, v_Y);
+  }
+
+  HEXL_VLOG(5, "AVX512 returning result "
+                   << std::vector<uint64_t>(result, result + n));
+}
+
+template <int BitShift>
+void InverseOuterStagesAVX512(uint64_t* result, uint64_t n, uint64_t modulus,
+                              const uint64_t* inv_root_of_unity_powers,
+                              const uint64_t* precon_inv_root_of_unity_powers,
+                              uint64_t output_mod_factor,
+                              uint64_t recursion_depth,
+                              uint64_t recursion_half) {
+  HEXL_CHECK(n >= 32,
+             "InverseOuterStagesAVX512 needs n >= 32, got n = " << n);
+  __m512i v_neg_modulus = _mm512_set1_epi64(-static_cast<int64_t>(modulus));
+  __m512i v_twice_mod = _mm512_set1_epi64(static_cast<int64_t>(modulus << 1));
+
+  size_t t = 1;
+  size_t m = (n >> 1);
+  size_t W_idx = 1 + m * recursion_half;
+
+  uint64_t W_idx_delta =
+      m * ((1ULL << (recursion_depth + 1)) - recursion_half);
+  for (; m > 2; m >>= 1) {
+    t <<= 1;
+    W_idx_delta >>= 1;
+    W_idx += W_idx_delta;
+  }
+  if (m == 2) {
+    const uint64_t* W = &inv_root_of_unity_powers[W_idx];
+    const uint64_t* W_precon = &precon_inv_root_of_unity_powers[W_idx];
+    InvT8<BitShift>(result, v_neg_modulus, v_twice_mod, t, m, W, W_precon);
+    t <<= 1;
+    m >>= 1;
+    W_idx_delta >>= 1;
+    W_idx += W_idx_delta;
+  }
+
+  if (recursion_depth == 0) {
+    InvFinalStage<BitShift>(result, n, modulus, inv_root_of_unity_powers[W_idx],
+                           output_mod_factor);
+  }
+}
+
 template <int BitShift>
 void InverseTransformFromBitReverseAVX512(
     uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t modulus,
@@ -251,7 +401,6 @@ void InverseTransformFromBitReverseAVX512(
              "output_mod_factor must be 1 or 2; got " << output_mod_factor);
 
   uint64_t twice_mod = modulus << 1;
-  __m512i v_modulus = _mm512_set1_epi64(static_cast<int64_t>(modulus));
   __m512i v_neg_modulus = _mm512_set1_epi64(-static_cast<int64_t>(modulus));
   __m512i v_twice_mod = _mm512_set1_epi64(static_cast<int64_t>(twice_mod));
 
@@ -326,109 +475,17 @@ void InverseTransformFromBitReverseAVX512(
         input_mod_factor, output_mod_factor, recursion_depth + 1,
         2 * recursion_half + 1);
 
-    uint64_t W_idx_delta =
-        m * ((1ULL << (recursion_depth + 1)) - recursion_half);
-    for (; m > 2; m >>= 1) {
-      t <<= 1;
-      W_idx_delta >>= 1;
-      W_idx += W_idx_delta;
-    }
-    if (m == 2) {
-      const uint64_t* W = &inv_root_of_unity_powers[W_idx];
-      const uint64_t* W_precon = &precon_inv_root_of_unity_powers[W_idx];
-      InvT8<BitShift>(result, v_neg_modulus, v_twice_mod, t, m, W, W_precon);
-      t <<= 1;
-      m >>= 1;
-      W_idx_delta >>= 1;
-      W_idx += W_idx_delta;
-    }
+    InverseOuterStagesAVX512<BitShift>(
+        result, n, modulus, inv_root_of_unity_powers,
+        precon_inv_root_of_unity_powers, output_mod_factor, recursion_depth,
+        recursion_half);
+    return;
   }
 
   // Final loop through data
   if (recursion_depth == 0) {
-    HEXL_VLOG(4, "AVX512 intermediate result "
-                     << std::vector<uint64_t>(result, result + n));
-
-    const uint64_t W = inv_root_of_unity_powers[W_idx];
-    MultiplyFactor mf_inv_n(InverseMod(n, modulus), BitShift, modulus);
-    const uint64_t inv_n = mf_inv_n.Operand();
-    const uint64_t inv_n_prime = mf_inv_n.BarrettFactor();
-
-    MultiplyFactor mf_inv_n_w(MultiplyMod(inv_n, W, modulus), BitShift,
-                              modulus);
-    const uint64_t inv_n_w = mf_inv_n_w.Operand();
-    const uint64_t inv_n_w_prime = mf_inv_n_w.BarrettFactor();
-
-    HEXL_VLOG(4, "inv_n_w " << inv_n_w);
-
-    uint64_t* X = result;
-    uint64_t* Y = X + (n >> 1);
-
-    __m512i v_inv_n = _mm512_set1_epi64(static_cast<int64_t>(inv_n));
-    __m512i v_inv_n_prime =
-        _mm512_set1_epi64(static_cast<int64_t>(inv_n_prime));
-    __m512i v_inv_n_w = _mm512_set1_epi64(static_cast<int64_t>(inv_n_w));
-    __m512i v_inv_n_w_prime =
-        _mm512_set1_epi64(static_cast<int64_t>(inv_n_w_prime));
-
-    __m512i* v_X_pt = reinterpret_cast<__m512i*>(X);
-    __m512i* v_Y_pt = reinterpret_cast<__m512i*>(Y);
-
-    // Merge final InvNTT loop with modulus reduction baked-in
-    HEXL_LOOP_UNROLL_4
-    for (size_t j = n / 16; j > 0; --j) {
-      __m512i v_X = _mm512_loadu_si512(v_X_pt);
-      __m512i v_Y = _mm512_loadu_si512(v_Y_pt);
-
-      // Slightly different from regular InvButterfly because different W is
-      // used for X and Y
-      __m512i Y_minus_2q = _mm512_sub_epi64(v_Y, v_twice_mod);
-      __m512i X_plus_Y_mod2q =
-          _mm512_hexl_small_add_mod_epi64(v_X, v_Y, v_twice_mod);
-      // T = *X + twice_mod - *Y
-      __m512i T = _mm512_sub_epi64(v_X, Y_minus_2q);
-
-      if (BitShift == 32) {
-        __m512i Q1 = _mm512_hexl_mullo_epi<64>(v_inv_n_prime, X_plus_Y_mod2q);
-        Q1 = _mm512_srli_epi64(Q1, 32);
-        // X = inv_N * X_plus_Y_mod2q - Q1 * modulus;
-        __m512i inv_N_tx = _mm512_hexl_mullo_epi<64>(v_inv_n, X_plus_Y_mod2q);
-        v_X = _mm512_hexl_mullo_add_lo_epi<64>(inv_N_tx, Q1, v_neg_modulus);
-
-        __m512i Q2 = _mm512_hexl_mullo_epi<64>(v_inv_n_w_prime, T);
-        Q2 = _mm512_srli_epi64(Q2, 32);
-
-        // Y = inv_N_W * T - Q2 * modulus;
-        __m512i inv_N_W_T = _mm512_hexl_mullo_epi<64>(v_inv_n_w, T);
-        v_Y = _mm512_hexl_mullo_add_lo_epi<64>(inv_N_W_T, Q2, v_neg_modulus);
-      } else {
-        __m512i Q1 =
-            _mm512_hexl_mulhi_epi<BitShift>(v_inv_n_prime, X_plus_Y_mod2q);
-        // X = inv_N * X_plus_Y_mod2q - Q1 * modulus;
-        __m512i inv_N_tx =
-            _mm512_hexl_mullo_epi<BitShift>(v_inv_n, X_plus_Y_mod2q);
-        v_X =
-            _mm512_hexl_mullo_add_lo_epi<BitShift>(inv_N_tx, Q1, v_neg_modulus);
-
-        __m512i Q2 = _mm512_hexl_mulhi_epi<BitShift>(v_inv_n_w_prime, T);
-        // Y = inv_N_W * T - Q2 * modulus;
-        __m512i inv_N_W_T = _mm512_hexl_mullo_epi<BitShift>(v_inv_n_w, T);
-        v_Y = _mm512_hexl_mullo_add_lo_epi<BitShift>(inv_N_W_T, Q2,
-                                                     v_neg_modulus);
-      }
-
-      if (output_mod_factor == 1) {
-        // Modulus reduction from [0, 2q), to [0, q)
-        v_X = _mm512_hexl_small_mod_epu64(v_X, v_modulus);
-        v_Y = _mm512_hexl_small_mod_epu64(v_Y, v_modulus);
-      }
-
-      _mm512_storeu_si512(v_X_pt++, v_X);
-      _mm512_storeu_si512(v_Y_pt++, v_Y);
-    }
-
-    HEXL_VLOG(5, "AVX512 returning result "
-                     << std::vector<uint64_t>(result, result + n));
+    InvFinalStage<BitShift>(result, n, modulus, inv_root_of_unity_powers[W_idx],
+                            output_mod_factor);
   }
 }
 
@@ -40,6 +40,32 @@ void InverseTransformFromBitReverseAVX512(
     uint64_t output_mod_factor, uint64_t recursion_depth = 0,
     uint64_t recursion_half = 0);
 
+/// @brief AVX512 implementation of the outer stages of the inverse NTT
+/// @param[in, out] result Sub-block whose halves have been transformed by
+/// InverseTransformFromBitReverseAVX512 at depth recursion_depth + 1, in [0,
+/// 2q)
+/// @param[in] n Size of the sub-block. Must be a power of two, at least 32
+/// @param[in] modulus Prime modulus q
+/// @param[in] inv_root_of_unity_powers Inverse roots of unity, as for
+/// InverseTransformFromBitReverseAVX512
+/// @param[in] precon_inv_root_of_unity_powers Pre-conditioned inverse roots of
+/// unity, as for InverseTransformFromBitReverseAVX512
+/// @param[in] output_mod_factor Upper bound for result; result must be in [0,
+/// output_mod_factor * q)
+/// @param[in] recursion_depth Depth of the sub-block within the transform
+/// @param[in] recursion_half Index of the sub-block at its depth
+/// @details Runs the stages the depth-first recursion runs after transforming
+/// both halves: the final stage of each half and, for recursion_depth == 0,
+/// the final stage of the transform, which folds in the multiplication by
+/// N^{-1}.
+template <int BitShift>
+void InverseOuterStagesAVX512(uint64_t* result, uint64_t n, uint64_t modulus,
+                              const uint64_t* inv_root_of_unity_powers,
+                              const uint64_t* precon_inv_root_of_unity_powers,
+                              uint64_t output_mod_factor,
+                              uint64_t recursion_depth,
+                              uint64_t recursion_half);
+
 #endif  // HEXL_HAS_AVX512DQ
 
 }  // namespace hexl
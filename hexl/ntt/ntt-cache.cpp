@@ -0,0 +1,389 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/ntt/ntt-cache.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Computes the tables used on this CPU, so that they count towards the
+// budget, and returns the bytes held by ntt
+uint64_t PrecomputeNTT(const NTT& ntt) {
+  ntt.Precompute(NTT::Direction::Both);
+  return sizeof(NTT) + ntt.GetTableMemoryBytes();
+}
+
+// Epoch of a reader slot which holds no handle
+constexpr uint64_t idle_epoch = std::numeric_limits<uint64_t>::max();
+
+}  // namespace
+
+struct NTTCache::Entry {
+  Entry(uint64_t N, uint64_t modulus)
+      : ntt(N, modulus), bytes(PrecomputeNTT(ntt)) {}
+  explicit Entry(const NTT& ntt_) : ntt(ntt_), bytes(PrecomputeNTT(ntt)) {}
+
+  NTT ntt;
+  uint64_t bytes;
+  // Table generation of the most recent lookup, used for LRU eviction. Only
+  // written when it changes, so hits on a hot NTT stay read-only.
+  std::atomic<uint64_t> last_use{0};
+};
+
+// Immutable lookup table of the cached NTTs
+struct NTTCache::Table {
+  uint64_t generation{0};
+  std::unordered_map<Key, Entry*, HashKey> entries;
+};
+
+// Entry or table removed from the cache, which is freed once no reader pinned
+// an epoch older than epoch
+struct NTTCache::Retired {
+  uint64_t epoch;
+  std::unique_ptr<Entry> entry;
+  std::unique_ptr<const Table> table;
+};
+
+// Per-thread state of the epoch-based reclamation, shared by all caches.
+// Slots are never freed; the slot of an exited thread is reused by the next
+// new thread.
+struct alignas(64) NTTCacheReaderSlot {
+  // Global epoch when the thread pinned its first live handle, or idle_epoch
+  std::atomic<uint64_t> epoch{idle_epoch};
+  // Number of live handles of the owning thread. Only accessed by the owner.
+  uint64_t pin_count{0};
+  size_t index{0};
+  bool in_use{false};
+  NTTCacheReaderSlot* next{nullptr};
+};
+
+namespace {
+
+std::atomic<uint64_t> global_epoch{1};
+std::atomic<NTTCacheReaderSlot*> slot_list{nullptr};
+std::mutex slot_mutex;
+size_t num_slots{0};
+
+thread_local NTTCacheReaderSlot* thread_slot{nullptr};
+
+// Returns the slot of the calling thread to the free slots on thread exit
+struct SlotReleaser {
+  ~SlotReleaser() {
+    std::lock_guard<std::mutex> lock(slot_mutex);
+    thread_slot->epoch.store(idle_epoch, std::memory_order_release);
+    thread_slot->pin_count = 0;
+    thread_slot->in_use = false;
+    thread_slot = nullptr;
+  }
+};
+
+NTTCacheReaderSlot* AcquireSlot() {
+  {
+    std::lock_guard<std::mutex> lock(slot_mutex);
+    NTTCacheReaderSlot* slot = slot_list.load(std::memory_order_relaxed);
+    while (slot != nullptr && slot->in_use) {
+      slot = slot->next;
+    }
+    if (slot == nullptr) {
+      slot = new NTTCacheReaderSlot;
+      slot->index = num_slots++;
+      slot->next = slot_list.load(std::memory_order_relaxed);
+      slot_list.store(slot, std::memory_order_release);
+    }
+    slot->in_use = true;
+    thread_slot = slot;
+  }
+  thread_local SlotReleaser releaser;
+  return thread_slot;
+}
+
+// Returns the smallest epoch pinned by any reader, or idle_epoch
+uint64_t MinPinnedEpoch() {
+  uint64_t min_epoch = idle_epoch;
+  for (NTTCacheReaderSlot* slot = slot_list.load(std::memory_order_acquire);
+       slot != nullptr; slot = slot->next) {
+    min_epoch = std::min(min_epoch, slot->epoch.load());
+  }
+  return min_epoch;
+}
+
+}  // namespace
+
+std::size_t NTTCache::HashKey::operator()(const Key& key) const {
+  std::size_t hash1 = std::hash<uint64_t>{}(key.first);
+  std::size_t hash2 = std::hash<uint64_t>{}(key.second);
+  // Golden Ratio Hashing with seeds
+  return hash1 ^ (hash2 + 0x9e3779b9 + (hash1 << 6) + (hash1 >> 2));
+}
+
+NTTCache& NTTCache::Instance() {
+  // Intentionally never destroyed, so that the NTTs stay valid during static
+  // destruction
+  static NTTCache* cache = new NTTCache();
+  return *cache;
+}
+
+NTTCache::NTTCache(uint64_t budget_bytes)
+    : m_table(new Table), m_budget_bytes(budget_bytes) {
+  for (auto& chunk : m_hit_chunks) {
+    chunk.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+NTTCache::~NTTCache() {
+  delete m_table.load(std::memory_order_relaxed);
+  for (auto& chunk : m_hit_chunks) {
+    delete[] chunk.load(std::memory_order_relaxed);
+  }
+}
+
+NTTCacheReaderSlot* NTTCache::Pin() {
+  NTTCacheReaderSlot* slot = thread_slot;
+  if (slot == nullptr) {
+    slot = AcquireSlot();
+  }
+  if (slot->pin_count++ == 0) {
+    // Sequentially consistent, so that a writer which doesn't see the pinned
+    // epoch has published its table before our next table load
+    slot->epoch.store(global_epoch.load(std::memory_order_acquire));
+  }
+  return slot;
+}
+
+void NTTCache::Unpin(NTTCacheReaderSlot* slot) {
+  if (--slot->pin_count == 0) {
+    slot->epoch.store(idle_epoch, std::memory_order_release);
+  }
+}
+
+void NTTCache::CountHit(const NTTCacheReaderSlot* slot) {
+  size_t chunk_index = slot->index / s_hit_chunk_size;
+  if (chunk_index >= s_max_hit_chunks) {
+    m_overflow_hits.value.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  HitCounter* chunk =
+      m_hit_chunks[chunk_index].load(std::memory_order_acquire);
+  if (chunk == nullptr) {
+    HitCounter* new_chunk = new HitCounter[s_hit_chunk_size];
+    if (m_hit_chunks[chunk_index].compare_exchange_strong(
+            chunk, new_chunk, std::memory_order_acq_rel)) {
+      chunk = new_chunk;
+    } else {
+      delete[] new_chunk;
+    }
+  }
+  // Only the owner of the slot writes its counter, so no read-modify-write
+  // is needed
+  std::atomic<uint64_t>& hits = chunk[slot->index % s_hit_chunk_size].value;
+  hits.store(hits.load(std::memory_order_relaxed) + 1,
+             std::memory_order_relaxed);
+}
+
+NTTHandle NTTCache::Get(uint64_t N, uint64_t modulus) {
+  NTTHandle handle(Pin());
+  const Table* table = m_table.load();
+  auto it = table->entries.find(Key{N, modulus});
+  if (it != table->entries.end()) {
+    Entry* entry = it->second;
+    CountHit(handle.m_slot);
+    if (entry->last_use.load(std::memory_order_relaxed) !=
+        table->generation) {
+      entry->last_use.store(table->generation, std::memory_order_relaxed);
+    }
+    handle.m_ntt = &entry->ntt;
+  } else {
+    // The handle pins an epoch older than the insertion, so the entry stays
+    // alive also if another thread evicts it right away
+    handle.m_ntt = &Insert(N, modulus)->ntt;
+  }
+  return handle;
+}
+
+NTTCache::Entry* NTTCache::Insert(uint64_t N, uint64_t modulus) {
+  // Created outside the lock, so other threads' misses don't wait for it.
+  // Concurrent misses on the same NTT may each create it.
+  auto entry = std::make_unique<Entry>(N, modulus);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_misses;
+  auto it = m_entries.find(Key{N, modulus});
+  if (it != m_entries.end()) {
+    return it->second.get();
+  }
+  Entry* result = entry.get();
+  entry->last_use.store(m_generation + 1, std::memory_order_relaxed);
+  m_memory_bytes += entry->bytes;
+  m_entries.emplace(Key{N, modulus}, std::move(entry));
+  std::vector<std::unique_ptr<Entry>> evicted;
+  EvictToBudget(&evicted);
+  Publish(std::move(evicted));
+  return result;
+}
+
+void NTTCache::Prewarm(uint64_t N, const std::vector<uint64_t>& moduli) {
+  std::vector<Key> keys;
+  std::vector<std::unique_ptr<Entry>> entries;
+  {
+    NTTHandle handle(Pin());
+    const Table* table = m_table.load();
+    for (uint64_t modulus : moduli) {
+      keys.emplace_back(N, modulus);
+      if (table->entries.find(keys.back()) == table->entries.end()) {
+        entries.push_back(std::make_unique<Entry>(N, modulus));
+      }
+    }
+  }
+  Add(std::move(entries), keys);
+}
+
+void NTTCache::Prewarm(const std::vector<NTT>& ntts) {
+  std::vector<Key> keys;
+  std::vector<std::unique_ptr<Entry>> entries;
+  {
+    NTTHandle handle(Pin());
+    const Table* table = m_table.load();
+    for (const NTT& ntt : ntts) {
+      keys.emplace_back(ntt.GetDegree(), ntt.GetModulus());
+      if (table->entries.find(keys.back()) == table->entries.end()) {
+        entries.push_back(std::make_unique<Entry>(ntt));
+      }
+    }
+  }
+  Add(std::move(entries), keys);
+}
+
+// Adds the entries which are not cached yet, created outside the lock, and
+// marks the NTTs with the given keys as most recently used
+void NTTCache::Add(std::vector<std::unique_ptr<Entry>> entries,
+                   const std::vector<Key>& keys) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& entry : entries) {
+    Key key{entry->ntt.GetDegree(), entry->ntt.GetModulus()};
+    if (m_entries.find(key) == m_entries.end()) {
+      m_memory_bytes += entry->bytes;
+      m_entries.emplace(key, std::move(entry));
+    }
+  }
+  for (const Key& key : keys) {
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+      it->second->last_use.store(m_generation + 1,
+                                 std::memory_order_relaxed);
+    }
+  }
+  std::vector<std::unique_ptr<Entry>> evicted;
+  EvictToBudget(&evicted);
+  Publish(std::move(evicted));
+}
+
+void NTTCache::EvictToBudget(std::vector<std::unique_ptr<Entry>>* evicted) {
+  while (m_memory_bytes > m_budget_bytes && m_entries.size() > 1) {
+    auto lru = std::min_element(
+        m_entries.begin(), m_entries.end(), [](const auto& a, const auto& b) {
+          return a.second->last_use.load(std::memory_order_relaxed) <
+                 b.second->last_use.load(std::memory_order_relaxed);
+        });
+    m_memory_bytes -= lru->second->bytes;
+    evicted->push_back(std::move(lru->second));
+    m_entries.erase(lru);
+    ++m_evictions;
+  }
+}
+
+void NTTCache::Publish(std::vector<std::unique_ptr<Entry>> removed) {
+  auto table = std::make_unique<Table>();
+  table->generation = ++m_generation;
+  table->entries.reserve(m_entries.size());
+  for (const auto& entry : m_entries) {
+    table->entries.emplace(entry.first, entry.second.get());
+  }
+  const Table* old_table = m_table.exchange(table.release());
+
+  // Readers which pin this epoch or a later one load the new table, so they
+  // can't reach the removed entries
+  uint64_t epoch = global_epoch.fetch_add(1) + 1;
+  m_retired.push_back(Retired{epoch, nullptr, std::unique_ptr<const Table>(
+                                                  old_table)});
+  for (auto& entry : removed) {
+    m_retired_bytes += entry->bytes;
+    m_retired.push_back(Retired{epoch, std::move(entry), nullptr});
+  }
+
+  uint64_t min_epoch = MinPinnedEpoch();
+  auto it = std::remove_if(
+      m_retired.begin(), m_retired.end(), [&](Retired& retired) {
+        if (retired.epoch > min_epoch) {
+          return false;
+        }
+        if (retired.entry) {
+          m_retired_bytes -= retired.entry->bytes;
+        }
+        return true;
+      });
+  m_retired.erase(it, m_retired.end());
+}
+
+void NTTCache::SetBudget(uint64_t budget_bytes) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_budget_bytes = budget_bytes;
+  std::vector<std::unique_ptr<Entry>> evicted;
+  EvictToBudget(&evicted);
+  Publish(std::move(evicted));
+}
+
+uint64_t NTTCache::GetBudget() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_budget_bytes;
+}
+
+NTTCacheStats NTTCache::GetStats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  NTTCacheStats stats;
+  for (const auto& chunk : m_hit_chunks) {
+    const HitCounter* counters = chunk.load(std::memory_order_acquire);
+    if (counters != nullptr) {
+      for (size_t i = 0; i < s_hit_chunk_size; ++i) {
+        stats.hits += counters[i].value.load(std::memory_order_relaxed);
+      }
+    }
+  }
+  stats.hits += m_overflow_hits.value.load(std::memory_order_relaxed);
+  stats.misses = m_misses;
+  stats.evictions = m_evictions;
+  stats.num_entries = m_entries.size();
+  stats.memory_bytes = m_memory_bytes;
+  stats.retired_bytes = m_retired_bytes;
+  return stats;
+}
+
+void NTTCache::Clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::vector<std::unique_ptr<Entry>> removed;
+  for (auto& entry : m_entries) {
+    removed.push_back(std::move(entry.second));
+  }
+  m_entries.clear();
+  m_memory_bytes = 0;
+  m_misses = 0;
+  m_evictions = 0;
+  for (auto& chunk : m_hit_chunks) {
+    HitCounter* counters = chunk.load(std::memory_order_acquire);
+    if (counters != nullptr) {
+      for (size_t i = 0; i < s_hit_chunk_size; ++i) {
+        counters[i].value.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+  m_overflow_hits.value.store(0, std::memory_order_relaxed);
+  Publish(std::move(removed));
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -3,24 +3,46 @@
 
 #include "ntt/ntt-internal.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "hexl/eltwise/eltwise-mult-mod.hpp"
 #include "hexl/logging/logging.hpp"
 #include "hexl/ntt/ntt.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "hexl/util/aligned-allocator.hpp"
 #include "hexl/util/check.hpp"
 #include "hexl/util/defines.hpp"
+#include "ntt/fwd-ntt-avx2.hpp"
 #include "ntt/fwd-ntt-avx512.hpp"
+#include "ntt/inv-ntt-avx2.hpp"
 #include "ntt/inv-ntt-avx512.hpp"
+#include "ntt/ntt-default.hpp"
 #include "util/cpu-features.hpp"
+#include "util/parallel.hpp"
 
 namespace intel {
 namespace hexl {
 
 AllocatorStrategyPtr mallocStrategy = AllocatorStrategyPtr(new MallocStrategy);
 
+// Tables are immutable once computed, so copies of an NTT share them
+struct NTT::LazyTables {
+  explicit LazyTables(const AlignedAllocator<uint64_t, 64>& alloc)
+      : tables(s_num_tables, AlignedVector64<uint64_t>(alloc)) {}
+
+  std::vector<AlignedVector64<uint64_t>> tables;
+  std::array<std::once_flag, s_num_tables> computed;
+  std::atomic<uint64_t> memory_bytes{0};
+};
+
 NTT::NTT(uint64_t degree, uint64_t q, uint64_t root_of_unity,
          std::shared_ptr<AllocatorBase> alloc_ptr)
     : m_degree(degree),
@@ -28,144 +50,202 @@ NTT::NTT(uint64_t degree, uint64_t q, uint64_t root_of_unity,
       m_w(root_of_unity),
       m_alloc(alloc_ptr),
       m_aligned_alloc(AlignedAllocator<uint64_t, 64>(m_alloc)),
-      m_root_of_unity_powers(m_aligned_alloc),
-      m_precon32_root_of_unity_powers(m_aligned_alloc),
-      m_precon64_root_of_unity_powers(m_aligned_alloc),
-      m_avx512_root_of_unity_powers(m_aligned_alloc),
-      m_avx512_precon32_root_of_unity_powers(m_aligned_alloc),
-      m_avx512_precon52_root_of_unity_powers(m_aligned_alloc),
-      m_avx512_precon64_root_of_unity_powers(m_aligned_alloc),
-      m_precon32_inv_root_of_unity_powers(m_aligned_alloc),
-      m_precon52_inv_root_of_unity_powers(m_aligned_alloc),
-      m_precon64_inv_root_of_unity_powers(m_aligned_alloc),
-      m_inv_root_of_unity_powers(m_aligned_alloc) {
+      m_lazy_tables(std::make_shared<LazyTables>(m_aligned_alloc)) {
   HEXL_CHECK(CheckArguments(degree, q), "");
   HEXL_CHECK(IsPrimitiveRoot(m_w, 2 * degree, q),
              m_w << " is not a primitive 2*" << degree << "'th root of unity");
 
   m_degree_bits = Log2(m_degree);
   m_w_inv = InverseMod(m_w, m_q);
-  ComputeRootOfUnityPowers();
 }
 
 NTT::NTT(uint64_t degree, uint64_t q, std::shared_ptr<AllocatorBase> alloc_ptr)
     : NTT(degree, q, MinimalPrimitiveRoot(2 * degree, q), alloc_ptr) {}
 
-void NTT::ComputeRootOfUnityPowers() {
-  AlignedVector64<uint64_t> root_of_unity_powers(m_degree, 0, m_aligned_alloc);
-  AlignedVector64<uint64_t> inv_root_of_unity_powers(m_degree, 0,
-                                                     m_aligned_alloc);
-
-  // 64-bit preconditioned inverse and root of unity powers
-  root_of_unity_powers[0] = 1;
-  inv_root_of_unity_powers[0] = InverseMod(1, m_q);
-  uint64_t idx = 0;
-  uint64_t prev_idx = idx;
-
-  for (size_t i = 1; i < m_degree; i++) {
-    idx = ReverseBits(i, m_degree_bits);
-    root_of_unity_powers[idx] =
-        MultiplyMod(root_of_unity_powers[prev_idx], m_w, m_q);
-    inv_root_of_unity_powers[idx] = InverseMod(root_of_unity_powers[idx], m_q);
-
-    prev_idx = idx;
-  }
-
-  m_root_of_unity_powers = root_of_unity_powers;
-  m_avx512_root_of_unity_powers = m_root_of_unity_powers;
-
-  // Duplicate each root of unity at indices [N/4, N/2].
-  // These are the roots of unity used in the FwdNTT FwdT2 function
-  // By creating these duplicates, we avoid extra permutations while loading the
-  // roots of unity
-  AlignedVector64<uint64_t> W2_roots;
-  W2_roots.reserve(m_degree / 2);
-  for (size_t i = m_degree / 4; i < m_degree / 2; ++i) {
-    W2_roots.push_back(m_root_of_unity_powers[i]);
-    W2_roots.push_back(m_root_of_unity_powers[i]);
-  }
-  m_avx512_root_of_unity_powers.erase(
-      m_avx512_root_of_unity_powers.begin() + m_degree / 4,
-      m_avx512_root_of_unity_powers.begin() + m_degree / 2);
-  m_avx512_root_of_unity_powers.insert(
-      m_avx512_root_of_unity_powers.begin() + m_degree / 4, W2_roots.begin(),
-      W2_roots.end());
-
-  // Duplicate each root of unity at indices [N/8, N/4].
-  // These are the roots of unity used in the FwdNTT FwdT4 function
-  // By creating these duplicates, we avoid extra permutations while loading the
-  // roots of unity
-  AlignedVector64<uint64_t> W4_roots;
-  W4_roots.reserve(m_degree / 2);
-  for (size_t i = m_degree / 8; i < m_degree / 4; ++i) {
-    W4_roots.push_back(m_root_of_unity_powers[i]);
-    W4_roots.push_back(m_root_of_unity_powers[i]);
-    W4_roots.push_back(m_root_of_unity_powers[i]);
-    W4_roots.push_back(m_root_of_unity_powers[i]);
-  }
-  m_avx512_root_of_unity_powers.erase(
-      m_avx512_root_of_unity_powers.begin() + m_degree / 8,
-      m_avx512_root_of_unity_powers.begin() + m_degree / 4);
-  m_avx512_root_of_unity_powers.insert(
-      m_avx512_root_of_unity_powers.begin() + m_degree / 8, W4_roots.begin(),
-      W4_roots.end());
-
-  auto compute_barrett_vector = [&](const AlignedVector64<uint64_t>& values,
-                                    uint64_t bit_shift) {
-    AlignedVector64<uint64_t> barrett_vector(m_aligned_alloc);
-    for (uint64_t value : values) {
-      MultiplyFactor mf(value, bit_shift, m_q);
-      barrett_vector.push_back(mf.BarrettFactor());
+NTT::NTT(const PrecomputedTables& tables,
+         std::shared_ptr<AllocatorBase> alloc_ptr)
+    : m_degree(tables.degree),
+      m_q(tables.modulus),
+      m_w(tables.root_of_unity),
+      m_alloc(alloc_ptr),
+      m_aligned_alloc(AlignedAllocator<uint64_t, 64>(m_alloc)),
+      m_lazy_tables(std::make_shared<LazyTables>(m_aligned_alloc)),
+      m_table_views(tables.tables),
+      m_table_owner(tables.owner) {
+  HEXL_CHECK(CheckArguments(m_degree, m_q), "");
+  HEXL_CHECK(IsPrimitiveRoot(m_w, 2 * m_degree, m_q),
+             m_w << " is not a primitive 2*" << m_degree
+                 << "'th root of unity");
+  // The kernels read the full tables, so a short view would be read past
+  // its end
+  for (size_t t = 0; t < s_num_tables; ++t) {
+    const TableView& view = m_table_views[t];
+    if (view.data != nullptr &&
+        view.size != ExpectedTableSize(m_degree, static_cast<Table>(t))) {
+      throw std::invalid_argument("Viewed NTT table " + std::to_string(t) +
+                                  " has the wrong size");
     }
-    return barrett_vector;
-  };
+  }
 
-  m_precon32_root_of_unity_powers =
-      compute_barrett_vector(root_of_unity_powers, 32);
-  m_precon64_root_of_unity_powers =
-      compute_barrett_vector(root_of_unity_powers, 64);
+  m_degree_bits = Log2(m_degree);
+  m_w_inv = InverseMod(m_w, m_q);
+}
 
-  // 52-bit preconditioned root of unity powers
-  if (has_avx512ifma) {
-    m_avx512_precon52_root_of_unity_powers =
-        compute_barrett_vector(m_avx512_root_of_unity_powers, 52);
-  }
+void NTT::ComputeTable(Table table) const {
+  AlignedVector64<uint64_t> values(m_aligned_alloc);
 
-  if (has_avx512dq) {
-    m_avx512_precon32_root_of_unity_powers =
-        compute_barrett_vector(m_avx512_root_of_unity_powers, 32);
-    m_avx512_precon64_root_of_unity_powers =
-        compute_barrett_vector(m_avx512_root_of_unity_powers, 64);
+  const TableView& view = m_table_views[static_cast<size_t>(table)];
+  if (view.data != nullptr) {
+    values.assign(view.data, view.data + view.size);
+    m_lazy_tables->memory_bytes.fetch_add(values.size() * sizeof(uint64_t));
+    m_lazy_tables->tables[static_cast<size_t>(table)] = std::move(values);
+    return;
   }
 
-  // Inverse root of unity powers
-
-  // Reordering inv_root_of_powers
-  AlignedVector64<uint64_t> temp(m_degree, 0, m_aligned_alloc);
-  temp[0] = inv_root_of_unity_powers[0];
-  idx = 1;
+  switch (table) {
+    case Table::RootOfUnityPowers:
+    case Table::InvRootOfUnityPowers: {
+      // Powers of the (inverse) root of unity in bit-reversed order
+      uint64_t w = (table == Table::RootOfUnityPowers) ? m_w : m_w_inv;
+      AlignedVector64<uint64_t> powers(m_degree, 0, m_aligned_alloc);
+      powers[0] = 1;
+      uint64_t prev_idx = 0;
+      for (size_t i = 1; i < m_degree; i++) {
+        uint64_t idx = ReverseBits(i, m_degree_bits);
+        powers[idx] = MultiplyMod(powers[prev_idx], w, m_q);
+        prev_idx = idx;
+      }
+      if (table == Table::RootOfUnityPowers) {
+        values = std::move(powers);
+        break;
+      }
+
+      // Reordering inv_root_of_powers
+      values.resize(m_degree);
+      values[0] = powers[0];
+      uint64_t idx = 1;
+      for (size_t m = (m_degree >> 1); m > 0; m >>= 1) {
+        for (size_t i = 0; i < m; i++) {
+          values[idx] = powers[m + i];
+          idx++;
+        }
+      }
+      break;
+    }
 
-  for (size_t m = (m_degree >> 1); m > 0; m >>= 1) {
-    for (size_t i = 0; i < m; i++) {
-      temp[idx] = inv_root_of_unity_powers[m + i];
-      idx++;
+    case Table::AVX512RootOfUnityPowers: {
+      const uint64_t* root_of_unity_powers = GetTable(Table::RootOfUnityPowers);
+      values.assign(root_of_unity_powers, root_of_unity_powers + m_degree);
+
+      // Duplicate each root of unity at indices [N/4, N/2].
+      // These are the roots of unity used in the FwdNTT FwdT2 function
+      // By creating these duplicates, we avoid extra permutations while
+      // loading the roots of unity
+      AlignedVector64<uint64_t> W2_roots;
+      W2_roots.reserve(m_degree / 2);
+      for (size_t i = m_degree / 4; i < m_degree / 2; ++i) {
+        W2_roots.push_back(root_of_unity_powers[i]);
+        W2_roots.push_back(root_of_unity_powers[i]);
+      }
+      values.erase(values.begin() + m_degree / 4,
+                   values.begin() + m_degree / 2);
+      values.insert(values.begin() + m_degree / 4, W2_roots.begin(),
+                    W2_roots.end());
+
+      // Duplicate each root of unity at indices [N/8, N/4].
+      // These are the roots of unity used in the FwdNTT FwdT4 function
+      // By creating these duplicates, we avoid extra permutations while
+      // loading the roots of unity
+      AlignedVector64<uint64_t> W4_roots;
+      W4_roots.reserve(m_degree / 2);
+      for (size_t i = m_degree / 8; i < m_degree / 4; ++i) {
+        W4_roots.push_back(root_of_unity_powers[i]);
+        W4_roots.push_back(root_of_unity_powers[i]);
+        W4_roots.push_back(root_of_unity_powers[i]);
+        W4_roots.push_back(root_of_unity_powers[i]);
+      }
+      values.erase(values.begin() + m_degree / 8,
+                   values.begin() + m_degree / 4);
+      values.insert(values.begin() + m_degree / 8, W4_roots.begin(),
+                    W4_roots.end());
+      break;
     }
+
+    case Table::Precon32RootOfUnityPowers:
+      values = ComputeBarrettVector(Table::RootOfUnityPowers, 32);
+      break;
+    case Table::Precon64RootOfUnityPowers:
+      values = ComputeBarrettVector(Table::RootOfUnityPowers, 64);
+      break;
+    case Table::AVX512Precon32RootOfUnityPowers:
+      values = ComputeBarrettVector(Table::AVX512RootOfUnityPowers, 32);
+      break;
+    case Table::AVX512Precon52RootOfUnityPowers:
+      values = ComputeBarrettVector(Table::AVX512RootOfUnityPowers, 52);
+      break;
+    case Table::AVX512Precon64RootOfUnityPowers:
+      values = ComputeBarrettVector(Table::AVX512RootOfUnityPowers, 64);
+      break;
+    case Table::Precon32InvRootOfUnityPowers:
+      values = ComputeBarrettVector(Table::InvRootOfUnityPowers, 32);
+      break;
+    case Table::Precon52InvRootOfUnityPowers:
+      values = ComputeBarrettVector(Table::InvRootOfUnityPowers, 52);
+      break;
+    case Table::Precon64InvRootOfUnityPowers:
+      values = ComputeBarrettVector(Table::InvRootOfUnityPowers, 64);
+      break;
   }
-  m_inv_root_of_unity_powers = std::move(temp);
 
-  // 32-bit preconditioned inverse root of unity powers
-  m_precon32_inv_root_of_unity_powers =
-      compute_barrett_vector(m_inv_root_of_unity_powers, 32);
+  m_lazy_tables->memory_bytes.fetch_add(values.size() * sizeof(uint64_t));
+  m_lazy_tables->tables[static_cast<size_t>(table)] = std::move(values);
+}
 
-  // 52-bit preconditioned inverse root of unity powers
-  if (has_avx512ifma) {
-    m_precon52_inv_root_of_unity_powers =
-        compute_barrett_vector(m_inv_root_of_unity_powers, 52);
+AlignedVector64<uint64_t> NTT::ComputeBarrettVector(Table table,
+                                                    uint64_t bit_shift) const {
+  const uint64_t* values = GetTable(table);
+  uint64_t size = GetTableSize(table);
+  AlignedVector64<uint64_t> barrett_vector(m_aligned_alloc);
+  barrett_vector.reserve(size);
+  for (uint64_t i = 0; i < size; ++i) {
+    MultiplyFactor mf(values[i], bit_shift, m_q);
+    barrett_vector.push_back(mf.BarrettFactor());
   }
+  return barrett_vector;
+}
 
-  // 64-bit preconditioned inverse root of unity powers
-  m_precon64_inv_root_of_unity_powers =
-      compute_barrett_vector(m_inv_root_of_unity_powers, 64);
+const AlignedVector64<uint64_t>& NTT::GetOwnedTable(Table table) const {
+  if (m_lazy_tables == nullptr) {
+    // Default-constructed NTT, which has no tables
+    static const AlignedVector64<uint64_t> empty_table;
+    return empty_table;
+  }
+  size_t index = static_cast<size_t>(table);
+  std::call_once(m_lazy_tables->computed[index],
+                 [this, table]() { ComputeTable(table); });
+  return m_lazy_tables->tables[index];
+}
+
+uint64_t NTT::GetTableMemoryBytes() const {
+  if (m_lazy_tables == nullptr) {
+    return 0;
+  }
+  return m_lazy_tables->memory_bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t NTT::ExpectedTableSize(uint64_t degree, Table table) {
+  switch (table) {
+    case Table::AVX512RootOfUnityPowers:
+    case Table::AVX512Precon32RootOfUnityPowers:
+    case Table::AVX512Precon52RootOfUnityPowers:
+    case Table::AVX512Precon64RootOfUnityPowers:
+      // As built by ComputeTable: the roots at [N/4, N/2) appear twice and
+      // those at [N/8, N/4) four times
+      return degree + (degree / 2 - degree / 4) +
+             3 * (degree / 4 - degree / 8);
+    default:
+      return degree;
+  }
 }
 
 bool NTT::CheckArguments(uint64_t degree, uint64_t modulus) {
@@ -185,128 +265,703 @@ bool NTT::CheckArguments(uint64_t degree, uint64_t modulus) {
   return true;
 }
 
-void NTT::ComputeForward(uint64_t* result, const uint64_t* operand,
-                         uint64_t input_mod_factor,
-                         uint64_t output_mod_factor) {
-  HEXL_CHECK(result != nullptr, "result == nullptr");
-  HEXL_CHECK(operand != nullptr, "operand == nullptr");
-  HEXL_CHECK(
-      input_mod_factor == 1 || input_mod_factor == 2 || input_mod_factor == 4,
-      "input_mod_factor must be 1, 2 or 4; got " << input_mod_factor);
-  HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 4,
-             "output_mod_factor must be 1 or 4; got " << output_mod_factor);
-  HEXL_CHECK_BOUNDS(
-      operand, m_degree, m_q * input_mod_factor,
-      "value in operand exceeds bound " << m_q * input_mod_factor);
+namespace {
+
+// Computes the forward transform of sub-block recursion_half of size n, at
+// depth recursion_depth of the full transform, with the fastest available
+// implementation
+void ForwardTransformToBitReverse(const NTT& ntt, uint64_t* result,
+                                  const uint64_t* operand, uint64_t n,
+                                  uint64_t input_mod_factor,
+                                  uint64_t output_mod_factor,
+                                  uint64_t recursion_depth,
+                                  uint64_t recursion_half) {
+  const uint64_t modulus = ntt.GetModulus();
 
 #ifdef HEXL_HAS_AVX512IFMA
-  if (has_avx512ifma && (m_q < s_max_fwd_ifma_modulus && (m_degree >= 16))) {
-    const uint64_t* root_of_unity_powers = GetAVX512RootOfUnityPowers().data();
+  if (has_avx512ifma && (modulus < NTT::s_max_fwd_ifma_modulus && (n >= 16))) {
+    const uint64_t* root_of_unity_powers =
+        ntt.GetTable(NTT::Table::AVX512RootOfUnityPowers);
     const uint64_t* precon_root_of_unity_powers =
-        GetAVX512Precon52RootOfUnityPowers().data();
+        ntt.GetTable(NTT::Table::AVX512Precon52RootOfUnityPowers);
 
     HEXL_VLOG(3, "Calling 52-bit AVX512-IFMA FwdNTT");
-    ForwardTransformToBitReverseAVX512<s_ifma_shift_bits>(
-        result, operand, m_degree, m_q, root_of_unity_powers,
-        precon_root_of_unity_powers, input_mod_factor, output_mod_factor);
+    ForwardTransformToBitReverseAVX512<NTT::s_ifma_shift_bits>(
+        result, operand, n, modulus, root_of_unity_powers,
+        precon_root_of_unity_powers, input_mod_factor, output_mod_factor,
+        recursion_depth, recursion_half);
     return;
   }
 #endif
 
 #ifdef HEXL_HAS_AVX512DQ
-  if (has_avx512dq && m_degree >= 16) {
-    if (m_q < s_max_fwd_32_modulus) {
+  if (has_avx512dq && n >= 16) {
+    if (modulus < NTT::s_max_fwd_32_modulus) {
       HEXL_VLOG(3, "Calling 32-bit AVX512-DQ FwdNTT");
       const uint64_t* root_of_unity_powers =
-          GetAVX512RootOfUnityPowers().data();
+          ntt.GetTable(NTT::Table::AVX512RootOfUnityPowers);
       const uint64_t* precon_root_of_unity_powers =
-          GetAVX512Precon32RootOfUnityPowers().data();
+          ntt.GetTable(NTT::Table::AVX512Precon32RootOfUnityPowers);
       ForwardTransformToBitReverseAVX512<32>(
-          result, operand, m_degree, m_q, root_of_unity_powers,
-          precon_root_of_unity_powers, input_mod_factor, output_mod_factor);
+          result, operand, n, modulus, root_of_unity_powers,
+          precon_root_of_unity_powers, input_mod_factor, output_mod_factor,
+          recursion_depth, recursion_half);
     } else {
       HEXL_VLOG(3, "Calling 64-bit AVX512-DQ FwdNTT");
       const uint64_t* root_of_unity_powers =
-          GetAVX512RootOfUnityPowers().data();
+          ntt.GetTable(NTT::Table::AVX512RootOfUnityPowers);
       const uint64_t* precon_root_of_unity_powers =
-          GetAVX512Precon64RootOfUnityPowers().data();
+          ntt.GetTable(NTT::Table::AVX512Precon64RootOfUnityPowers);
+
+      ForwardTransformToBitReverseAVX512<NTT::s_default_shift_bits>(
+          result, operand, n, modulus, root_of_unity_powers,
+          precon_root_of_unity_powers, input_mod_factor, output_mod_factor,
+          recursion_depth, recursion_half);
+    }
+    return;
+  }
+#endif
 
-      ForwardTransformToBitReverseAVX512<s_default_shift_bits>(
-          result, operand, m_degree, m_q, root_of_unity_powers,
-          precon_root_of_unity_powers, input_mod_factor, output_mod_factor);
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2 && n >= 16) {
+    const uint64_t* root_of_unity_powers =
+        ntt.GetTable(NTT::Table::RootOfUnityPowers);
+    if (modulus < NTT::s_max_fwd_32_modulus) {
+      HEXL_VLOG(3, "Calling 32-bit AVX2 FwdNTT");
+      const uint64_t* precon_root_of_unity_powers =
+          ntt.GetTable(NTT::Table::Precon32RootOfUnityPowers);
+      ForwardTransformToBitReverseAVX2<32>(
+          result, operand, n, modulus, root_of_unity_powers,
+          precon_root_of_unity_powers, input_mod_factor, output_mod_factor,
+          recursion_depth, recursion_half);
+    } else {
+      HEXL_VLOG(3, "Calling 64-bit AVX2 FwdNTT");
+      const uint64_t* precon_root_of_unity_powers =
+          ntt.GetTable(NTT::Table::Precon64RootOfUnityPowers);
+      ForwardTransformToBitReverseAVX2<NTT::s_default_shift_bits>(
+          result, operand, n, modulus, root_of_unity_powers,
+          precon_root_of_unity_powers, input_mod_factor, output_mod_factor,
+          recursion_depth, recursion_half);
     }
     return;
   }
 #endif
 
   HEXL_VLOG(3, "Calling ForwardTransformToBitReverseRadix2");
-  const uint64_t* root_of_unity_powers = GetRootOfUnityPowers().data();
+  const uint64_t* root_of_unity_powers =
+      ntt.GetTable(NTT::Table::RootOfUnityPowers);
   const uint64_t* precon_root_of_unity_powers =
-      GetPrecon64RootOfUnityPowers().data();
+      ntt.GetTable(NTT::Table::Precon64RootOfUnityPowers);
 
   ForwardTransformToBitReverseRadix2(
-      result, operand, m_degree, m_q, root_of_unity_powers,
-      precon_root_of_unity_powers, input_mod_factor, output_mod_factor);
+      result, operand, n, modulus, root_of_unity_powers,
+      precon_root_of_unity_powers, input_mod_factor, output_mod_factor,
+      recursion_depth, recursion_half);
 }
 
-void NTT::ComputeInverse(uint64_t* result, const uint64_t* operand,
-                         uint64_t input_mod_factor,
-                         uint64_t output_mod_factor) {
-  HEXL_CHECK(result != nullptr, "result == nullptr");
-  HEXL_CHECK(operand != nullptr, "operand == nullptr");
-  HEXL_CHECK(input_mod_factor == 1 || input_mod_factor == 2,
-             "input_mod_factor must be 1 or 2; got " << input_mod_factor);
-  HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 2,
-             "output_mod_factor must be 1 or 2; got " << output_mod_factor);
-  HEXL_CHECK_BOUNDS(operand, m_degree, m_q * input_mod_factor,
-                    "operand exceeds bound " << m_q * input_mod_factor);
+// Computes the inverse transform of sub-block recursion_half of size n, at
+// depth recursion_depth of the full transform, with the fastest available
+// implementation. For recursion_depth > 0, the final stage is skipped.
+void InverseTransformFromBitReverse(const NTT& ntt, uint64_t* result,
+                                    const uint64_t* operand, uint64_t n,
+                                    uint64_t input_mod_factor,
+                                    uint64_t output_mod_factor,
+                                    uint64_t recursion_depth,
+                                    uint64_t recursion_half) {
+  const uint64_t modulus = ntt.GetModulus();
+  const uint64_t* inv_root_of_unity_powers =
+      ntt.GetTable(NTT::Table::InvRootOfUnityPowers);
 
 #ifdef HEXL_HAS_AVX512IFMA
-  if (has_avx512ifma && (m_q < s_max_inv_ifma_modulus) && (m_degree >= 16)) {
+  if (has_avx512ifma && (modulus < NTT::s_max_inv_ifma_modulus) &&
+      (n >= 16)) {
     HEXL_VLOG(3, "Calling 52-bit AVX512-IFMA InvNTT");
-    const uint64_t* inv_root_of_unity_powers = GetInvRootOfUnityPowers().data();
     const uint64_t* precon_inv_root_of_unity_powers =
-        GetPrecon52InvRootOfUnityPowers().data();
-    InverseTransformFromBitReverseAVX512<s_ifma_shift_bits>(
-        result, operand, m_degree, m_q, inv_root_of_unity_powers,
-        precon_inv_root_of_unity_powers, input_mod_factor, output_mod_factor);
+        ntt.GetTable(NTT::Table::Precon52InvRootOfUnityPowers);
+    InverseTransformFromBitReverseAVX512<NTT::s_ifma_shift_bits>(
+        result, operand, n, modulus, inv_root_of_unity_powers,
+        precon_inv_root_of_unity_powers, input_mod_factor, output_mod_factor,
+        recursion_depth, recursion_half);
     return;
   }
 #endif
 
 #ifdef HEXL_HAS_AVX512DQ
-  if (has_avx512dq && m_degree >= 16) {
-    if (m_q < s_max_inv_32_modulus) {
+  if (has_avx512dq && n >= 16) {
+    if (modulus < NTT::s_max_inv_32_modulus) {
       HEXL_VLOG(3, "Calling 32-bit AVX512-DQ InvNTT");
-      const uint64_t* inv_root_of_unity_powers =
-          GetInvRootOfUnityPowers().data();
       const uint64_t* precon_inv_root_of_unity_powers =
-          GetPrecon32InvRootOfUnityPowers().data();
+          ntt.GetTable(NTT::Table::Precon32InvRootOfUnityPowers);
       InverseTransformFromBitReverseAVX512<32>(
-          result, operand, m_degree, m_q, inv_root_of_unity_powers,
-          precon_inv_root_of_unity_powers, input_mod_factor, output_mod_factor);
+          result, operand, n, modulus, inv_root_of_unity_powers,
+          precon_inv_root_of_unity_powers, input_mod_factor, output_mod_factor,
+          recursion_depth, recursion_half);
     } else {
       HEXL_VLOG(3, "Calling 64-bit AVX512 InvNTT");
-      const uint64_t* inv_root_of_unity_powers =
-          GetInvRootOfUnityPowers().data();
       const uint64_t* precon_inv_root_of_unity_powers =
-          GetPrecon64InvRootOfUnityPowers().data();
+          ntt.GetTable(NTT::Table::Precon64InvRootOfUnityPowers);
 
-      InverseTransformFromBitReverseAVX512<s_default_shift_bits>(
-          result, operand, m_degree, m_q, inv_root_of_unity_powers,
-          precon_inv_root_of_unity_powers, input_mod_factor, output_mod_factor);
+      InverseTransformFromBitReverseAVX512<NTT::s_default_shift_bits>(
+          result, operand, n, modulus, inv_root_of_unity_powers,
+          precon_inv_root_of_unity_powers, input_mod_factor, output_mod_factor,
+          recursion_depth, recursion_half);
+    }
+    return;
+  }
+#endif
+
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2 && n >= 16) {
+    if (modulus < NTT::s_max_inv_32_modulus) {
+      HEXL_VLOG(3, "Calling 32-bit AVX2 InvNTT");
+      const uint64_t* precon_inv_root_of_unity_powers =
+          ntt.GetTable(NTT::Table::Precon32InvRootOfUnityPowers);
+      InverseTransformFromBitReverseAVX2<32>(
+          result, operand, n, modulus, inv_root_of_unity_powers,
+          precon_inv_root_of_unity_powers, input_mod_factor, output_mod_factor,
+          recursion_depth, recursion_half);
+    } else {
+      HEXL_VLOG(3, "Calling 64-bit AVX2 InvNTT");
+      const uint64_t* precon_inv_root_of_unity_powers =
+          ntt.GetTable(NTT::Table::Precon64InvRootOfUnityPowers);
+      InverseTransformFromBitReverseAVX2<NTT::s_default_shift_bits>(
+          result, operand, n, modulus, inv_root_of_unity_powers,
+          precon_inv_root_of_unity_powers, input_mod_factor, output_mod_factor,
+          recursion_depth, recursion_half);
     }
     return;
   }
 #endif
 
   HEXL_VLOG(3, "Calling 64-bit default InvNTT");
-  const uint64_t* inv_root_of_unity_powers = GetInvRootOfUnityPowers().data();
   const uint64_t* precon_inv_root_of_unity_powers =
-      GetPrecon64InvRootOfUnityPowers().data();
+      ntt.GetTable(NTT::Table::Precon64InvRootOfUnityPowers);
   InverseTransformFromBitReverseRadix2(
-      result, operand, m_degree, m_q, inv_root_of_unity_powers,
-      precon_inv_root_of_unity_powers, input_mod_factor, output_mod_factor);
+      result, operand, n, modulus, inv_root_of_unity_powers,
+      precon_inv_root_of_unity_powers, input_mod_factor, output_mod_factor,
+      recursion_depth, recursion_half);
+}
+
+// Returns the tables used by ForwardTransformToBitReverse for a transform of
+// size n, mirroring its dispatch
+std::vector<NTT::Table> ForwardTables(const NTT& ntt, uint64_t n) {
+  const uint64_t modulus = ntt.GetModulus();
+  HEXL_UNUSED(modulus);
+
+#ifdef HEXL_HAS_AVX512IFMA
+  if (has_avx512ifma && (modulus < NTT::s_max_fwd_ifma_modulus && (n >= 16))) {
+    return {NTT::Table::AVX512RootOfUnityPowers,
+            NTT::Table::AVX512Precon52RootOfUnityPowers};
+  }
+#endif
+
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq && n >= 16) {
+    if (modulus < NTT::s_max_fwd_32_modulus) {
+      return {NTT::Table::AVX512RootOfUnityPowers,
+              NTT::Table::AVX512Precon32RootOfUnityPowers};
+    }
+    return {NTT::Table::AVX512RootOfUnityPowers,
+            NTT::Table::AVX512Precon64RootOfUnityPowers};
+  }
+#endif
+
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2 && n >= 16 && modulus < NTT::s_max_fwd_32_modulus) {
+    return {NTT::Table::RootOfUnityPowers,
+            NTT::Table::Precon32RootOfUnityPowers};
+  }
+#endif
+
+  return {NTT::Table::RootOfUnityPowers,
+          NTT::Table::Precon64RootOfUnityPowers};
+}
+
+// Returns the tables used by InverseTransformFromBitReverse for a transform of
+// size n, mirroring its dispatch
+std::vector<NTT::Table> InverseTables(const NTT& ntt, uint64_t n) {
+  const uint64_t modulus = ntt.GetModulus();
+  HEXL_UNUSED(modulus);
+
+#ifdef HEXL_HAS_AVX512IFMA
+  if (has_avx512ifma && (modulus < NTT::s_max_inv_ifma_modulus) &&
+      (n >= 16)) {
+    return {NTT::Table::InvRootOfUnityPowers,
+            NTT::Table::Precon52InvRootOfUnityPowers};
+  }
+#endif
+
+#if defined(HEXL_HAS_AVX512DQ) || defined(HEXL_HAS_AVX256)
+  if ((has_avx512dq || has_avx2) && n >= 16 &&
+      modulus < NTT::s_max_inv_32_modulus) {
+    return {NTT::Table::InvRootOfUnityPowers,
+            NTT::Table::Precon32InvRootOfUnityPowers};
+  }
+#endif
+
+  return {NTT::Table::InvRootOfUnityPowers,
+          NTT::Table::Precon64InvRootOfUnityPowers};
+}
+
+// Returns the number of threads a transform of degree 2^degree_bits uses
+// under policy, or 1 if it runs on the calling thread
+size_t NumTransformThreads(uint64_t degree_bits,
+                           const ExecutionPolicy& policy) {
+  if (policy.IsSerial() || degree_bits < NTT::MinParallelDegreeBits()) {
+    return 1;
+  }
+  size_t num_threads = policy.GetNumThreads();
+  if (num_threads == 0) {
+    num_threads = ThreadPool::Instance().NumWorkers() + 1;
+  }
+  return num_threads;
+}
+
+// Returns the number of outer stages to split across num_threads threads for
+// a transform of size 2^degree_bits. Keeps the remaining sub-blocks at least
+// 1024 elements, so they run the depth-first kernels
+uint64_t NumParallelStages(uint64_t degree_bits, size_t num_threads) {
+  uint64_t stages = 0;
+  while ((1ULL << stages) < num_threads) {
+    ++stages;
+  }
+  return std::min<uint64_t>(stages, degree_bits - 10);
+}
+
+// Runs the final stage of the inverse transform, which folds in the
+// multiplication by N^{-1}, on the pairs (X[j], X[j + N / 2]) for j in [begin,
+// end). Assumes inputs in [0, 2q)
+void InverseFinalStageRadix2(const NTT& ntt, uint64_t* result,
+                             uint64_t output_mod_factor, uint64_t begin,
+                             uint64_t end) {
+  const uint64_t n = ntt.GetDegree();
+  const uint64_t modulus = ntt.GetModulus();
+  const uint64_t twice_modulus = modulus << 1;
+
+  // Fold multiplication by N^{-1} to final stage butterfly
+  const uint64_t W = ntt.GetTable(NTT::Table::InvRootOfUnityPowers)[n - 1];
+  const uint64_t inv_n = InverseMod(n, modulus);
+  const uint64_t inv_n_precon =
+      MultiplyFactor(inv_n, 64, modulus).BarrettFactor();
+  const uint64_t inv_n_w = MultiplyMod(inv_n, W, modulus);
+  const uint64_t inv_n_w_precon =
+      MultiplyFactor(inv_n_w, 64, modulus).BarrettFactor();
+
+  uint64_t* X = result;
+  uint64_t* Y = X + n / 2;
+  for (uint64_t j = begin; j < end; ++j) {
+    // Assume X, Y in [0, 2q) and compute
+    // X' = N^{-1} (X + Y) (mod q)
+    // Y' = N^{-1} * W * (X - Y) (mod q)
+    uint64_t tx = AddUIntMod(X[j], Y[j], twice_modulus);
+    uint64_t ty = X[j] + twice_modulus - Y[j];
+    X[j] = MultiplyModLazy<64>(tx, inv_n, inv_n_precon, modulus);
+    Y[j] = MultiplyModLazy<64>(ty, inv_n_w, inv_n_w_precon, modulus);
+    if (output_mod_factor == 1) {
+      X[j] = ReduceMod<2>(X[j], modulus);
+      Y[j] = ReduceMod<2>(Y[j], modulus);
+    }
+  }
+}
+
+// Runs the first stage of the forward transform of sub-block recursion_half of
+// size n, at depth recursion_depth of the full transform, with the same
+// implementation as ForwardTransformToBitReverse. Inputs and outputs are in
+// [0, 4q)
+void ForwardOuterStage(const NTT& ntt, uint64_t* result,
+                       const uint64_t* operand, uint64_t n,
+                       uint64_t recursion_depth, uint64_t recursion_half) {
+  const uint64_t modulus = ntt.GetModulus();
+
+#ifdef HEXL_HAS_AVX512IFMA
+  if (has_avx512ifma && (modulus < NTT::s_max_fwd_ifma_modulus && (n >= 16))) {
+    ForwardOuterStageAVX512<NTT::s_ifma_shift_bits>(
+        result, operand, n, modulus,
+        ntt.GetTable(NTT::Table::AVX512RootOfUnityPowers),
+        ntt.GetTable(NTT::Table::AVX512Precon52RootOfUnityPowers),
+        recursion_depth, recursion_half);
+    return;
+  }
+#endif
+
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq && n >= 16) {
+    const uint64_t* root_of_unity_powers =
+        ntt.GetTable(NTT::Table::AVX512RootOfUnityPowers);
+    if (modulus < NTT::s_max_fwd_32_modulus) {
+      ForwardOuterStageAVX512<32>(
+          result, operand, n, modulus, root_of_unity_powers,
+          ntt.GetTable(NTT::Table::AVX512Precon32RootOfUnityPowers),
+          recursion_depth, recursion_half);
+    } else {
+      ForwardOuterStageAVX512<NTT::s_default_shift_bits>(
+          result, operand, n, modulus, root_of_unity_powers,
+          ntt.GetTable(NTT::Table::AVX512Precon64RootOfUnityPowers),
+          recursion_depth, recursion_half);
+    }
+    return;
+  }
+#endif
+
+  const uint64_t* root_of_unity_powers =
+      ntt.GetTable(NTT::Table::RootOfUnityPowers);
+
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2 && n >= 16) {
+    if (modulus < NTT::s_max_fwd_32_modulus) {
+      ForwardOuterStageAVX2<32>(
+          result, operand, n, modulus, root_of_unity_powers,
+          ntt.GetTable(NTT::Table::Precon32RootOfUnityPowers),
+          recursion_depth, recursion_half);
+    } else {
+      ForwardOuterStageAVX2<NTT::s_default_shift_bits>(
+          result, operand, n, modulus, root_of_unity_powers,
+          ntt.GetTable(NTT::Table::Precon64RootOfUnityPowers),
+          recursion_depth, recursion_half);
+    }
+    return;
+  }
+#endif
+
+  const uint64_t* precon_root_of_unity_powers =
+      ntt.GetTable(NTT::Table::Precon64RootOfUnityPowers);
+  const uint64_t W_idx = (1ULL << recursion_depth) + recursion_half;
+  const uint64_t W = root_of_unity_powers[W_idx];
+  const uint64_t W_precon = precon_root_of_unity_powers[W_idx];
+  const uint64_t t = n >> 1;
+  for (uint64_t j = 0; j < t; ++j) {
+    FwdButterflyRadix2(result + j, result + j + t, operand + j,
+                       operand + j + t, W, W_precon, modulus, modulus << 1);
+  }
+}
+
+// Runs the stages which complete the inverse transform of sub-block
+// recursion_half of size n, at depth recursion_depth of the full transform,
+// once both of its halves have been transformed at depth recursion_depth + 1:
+// the final stage of each half and, for recursion_depth == 0, the final stage
+// of the transform. Uses the same implementation as
+// InverseTransformFromBitReverse. Inputs are in [0, 2q)
+void InverseOuterStages(const NTT& ntt, uint64_t* result, uint64_t n,
+                        uint64_t output_mod_factor, uint64_t recursion_depth,
+                        uint64_t recursion_half) {
+  const uint64_t modulus = ntt.GetModulus();
+  const uint64_t* inv_root_of_unity_powers =
+      ntt.GetTable(NTT::Table::InvRootOfUnityPowers);
+
+#ifdef HEXL_HAS_AVX512IFMA
+  if (has_avx512ifma && (modulus < NTT::s_max_inv_ifma_modulus) &&
+      (n >= 32)) {
+    InverseOuterStagesAVX512<NTT::s_ifma_shift_bits>(
+        result, n, modulus, inv_root_of_unity_powers,
+        ntt.GetTable(NTT::Table::Precon52InvRootOfUnityPowers),
+        output_mod_factor, recursion_depth, recursion_half);
+    return;
+  }
+#endif
+
+#ifdef HEXL_HAS_AVX512DQ
+  if (has_avx512dq && n >= 32) {
+    if (modulus < NTT::s_max_inv_32_modulus) {
+      InverseOuterStagesAVX512<32>(
+          result, n, modulus, inv_root_of_unity_powers,
+          ntt.GetTable(NTT::Table::Precon32InvRootOfUnityPowers),
+          output_mod_factor, recursion_depth, recursion_half);
+    } else {
+      InverseOuterStagesAVX512<NTT::s_default_shift_bits>(
+          result, n, modulus, inv_root_of_unity_powers,
+          ntt.GetTable(NTT::Table::Precon64InvRootOfUnityPowers),
+          output_mod_factor, recursion_depth, recursion_half);
+    }
+    return;
+  }
+#endif
+
+#ifdef HEXL_HAS_AVX256
+  if (has_avx2 && n >= 16) {
+    if (modulus < NTT::s_max_inv_32_modulus) {
+      InverseOuterStagesAVX2<32>(
+          result, n, modulus, inv_root_of_unity_powers,
+          ntt.GetTable(NTT::Table::Precon32InvRootOfUnityPowers),
+          output_mod_factor, recursion_depth, recursion_half);
+    } else {
+      InverseOuterStagesAVX2<NTT::s_default_shift_bits>(
+          result, n, modulus, inv_root_of_unity_powers,
+          ntt.GetTable(NTT::Table::Precon64InvRootOfUnityPowers),
+          output_mod_factor, recursion_depth, recursion_half);
+    }
+    return;
+  }
+#endif
+
+  const uint64_t* precon_inv_root_of_unity_powers =
+      ntt.GetTable(NTT::Table::Precon64InvRootOfUnityPowers);
+  // The final stage of half i has 2^(recursion_depth + 1) groups across the
+  // full transform, of which it is group 2 * recursion_half + i
+  const uint64_t m = 2ULL << recursion_depth;
+  const uint64_t t = n >> 2;
+  for (uint64_t i = 0; i < 2; ++i) {
+    const uint64_t W_idx = ntt.GetDegree() - 2 * m + 1 + 2 * recursion_half + i;
+    const uint64_t W = inv_root_of_unity_powers[W_idx];
+    const uint64_t W_precon = precon_inv_root_of_unity_powers[W_idx];
+    uint64_t* X = result + i * (n >> 1);
+    for (uint64_t j = 0; j < t; ++j) {
+      InvButterflyRadix2(X + j, X + j + t, X + j, X + j + t, W, W_precon,
+                         modulus, modulus << 1);
+    }
+  }
+  if (recursion_depth == 0) {
+    InverseFinalStageRadix2(ntt, result, output_mod_factor, 0, n >> 1);
+  }
+}
+
+// Multiplies sub-block recursion_half of size n, at depth recursion_depth of
+// the full transform. Recurses like the depth-first transforms, interleaving
+// the two forward transforms, until the sub-blocks have at most block_size
+// coefficients. These are transformed, multiplied and inverse transformed
+// while they are in the cache.
+void PolyMultiplyModFusedRecursive(const NTT& ntt, uint64_t* result,
+                                   const uint64_t* operand1,
+                                   const uint64_t* operand2, uint64_t* temp,
+                                   uint64_t n, uint64_t block_size,
+                                   uint64_t input_mod_factor,
+                                   uint64_t recursion_depth,
+                                   uint64_t recursion_half) {
+  const uint64_t modulus = ntt.GetModulus();
+
+  // Transform operand2 first, in case result aliases it
+  if (n <= block_size) {
+    // EltwiseMultMod reduces its inputs, so the forward transforms may skip
+    // their final reduction from [0, 4q) whenever 4q fits its input bound
+    const uint64_t mod_factor = (modulus < (1ULL << 61)) ? 4 : 1;
+    ForwardTransformToBitReverse(ntt, temp, operand2, n, input_mod_factor,
+                                 mod_factor, recursion_depth, recursion_half);
+    ForwardTransformToBitReverse(ntt, result, operand1, n, input_mod_factor,
+                                 mod_factor, recursion_depth, recursion_half);
+    EltwiseMultMod(result, result, temp, n, modulus, mod_factor);
+    InverseTransformFromBitReverse(ntt, result, result, n, 1, 1,
+                                   recursion_depth, recursion_half);
+    return;
+  }
+
+  ForwardOuterStage(ntt, temp, operand2, n, recursion_depth, recursion_half);
+  ForwardOuterStage(ntt, result, operand1, n, recursion_depth, recursion_half);
+  const uint64_t half = n >> 1;
+  for (uint64_t i = 0; i < 2; ++i) {
+    PolyMultiplyModFusedRecursive(ntt, result + i * half, result + i * half,
+                                  temp + i * half, temp + i * half, half,
+                                  block_size, 4, recursion_depth + 1,
+                                  2 * recursion_half + i);
+  }
+  InverseOuterStages(ntt, result, n, 1, recursion_depth, recursion_half);
+}
+
+// Forward transform which splits the outer stages across threads. The first
+// `stages` stages act independently on each strided column {j + k *
+// block_size}, so are split across threads by column. The 2^stages
+// contiguous sub-blocks of size block_size are then transformed in parallel.
+void ForwardTransformToBitReverseParallel(const NTT& ntt, uint64_t* result,
+                                          const uint64_t* operand,
+                                          uint64_t input_mod_factor,
+                                          uint64_t output_mod_factor,
+                                          size_t num_threads) {
+  const uint64_t n = ntt.GetDegree();
+  const uint64_t modulus = ntt.GetModulus();
+  const uint64_t twice_modulus = modulus << 1;
+  const uint64_t stages = NumParallelStages(Log2(n), num_threads);
+  const uint64_t num_blocks = 1ULL << stages;
+  const uint64_t block_size = n >> stages;
+  const uint64_t* root_of_unity_powers =
+      ntt.GetTable(NTT::Table::RootOfUnityPowers);
+  const uint64_t* precon_root_of_unity_powers =
+      ntt.GetTable(NTT::Table::Precon64RootOfUnityPowers);
+  HEXL_UNUSED(input_mod_factor);
+
+  ParallelFor(block_size, num_threads, [&](uint64_t begin, uint64_t end) {
+    // Outputs in [0, 4q), so the first stage reads any input_mod_factor
+    const uint64_t* input = operand;
+    for (uint64_t m = 1; m < num_blocks; m <<= 1) {
+      uint64_t t = n / (2 * m);
+      for (uint64_t i = 0; i < m; ++i) {
+        const uint64_t W = root_of_unity_powers[m + i];
+        const uint64_t W_precon = precon_root_of_unity_powers[m + i];
+        for (uint64_t offset = 2 * i * t; offset < 2 * i * t + t;
+             offset += block_size) {
+          uint64_t* X_r = result + offset + begin;
+          uint64_t* Y_r = X_r + t;
+          const uint64_t* X_op = input + offset + begin;
+          const uint64_t* Y_op = X_op + t;
+          for (uint64_t j = begin; j < end; ++j) {
+            FwdButterflyRadix2(X_r++, Y_r++, X_op++, Y_op++, W, W_precon,
+                               modulus, twice_modulus);
+          }
+        }
+      }
+      input = result;
+    }
+  });
+
+  ParallelFor(num_blocks, num_threads, [&](uint64_t begin, uint64_t end) {
+    for (uint64_t block = begin; block < end; ++block) {
+      uint64_t* block_result = result + block * block_size;
+      ForwardTransformToBitReverse(ntt, block_result, block_result, block_size,
+                                   4, output_mod_factor, stages, block);
+    }
+  });
+}
+
+// Inverse transform which mirrors ForwardTransformToBitReverseParallel. The
+// 2^stages sub-blocks are transformed in parallel, skipping the final stage
+// of each sub-block. The remaining stages act independently on each strided
+// column {j + k * block_size / 2}, so are split across threads by column.
+void InverseTransformFromBitReverseParallel(const NTT& ntt, uint64_t* result,
+                                            const uint64_t* operand,
+                                            uint64_t input_mod_factor,
+                                            uint64_t output_mod_factor,
+                                            size_t num_threads) {
+  const uint64_t n = ntt.GetDegree();
+  const uint64_t modulus = ntt.GetModulus();
+  const uint64_t twice_modulus = modulus << 1;
+  const uint64_t stages = NumParallelStages(Log2(n), num_threads);
+  const uint64_t num_blocks = 1ULL << stages;
+  const uint64_t block_size = n >> stages;
+  const uint64_t* inv_root_of_unity_powers =
+      ntt.GetTable(NTT::Table::InvRootOfUnityPowers);
+  const uint64_t* precon_inv_root_of_unity_powers =
+      ntt.GetTable(NTT::Table::Precon64InvRootOfUnityPowers);
+
+  ParallelFor(num_blocks, num_threads, [&](uint64_t begin, uint64_t end) {
+    for (uint64_t block = begin; block < end; ++block) {
+      uint64_t offset = block * block_size;
+      InverseTransformFromBitReverse(ntt, result + offset, operand + offset,
+                                     block_size, input_mod_factor,
+                                     output_mod_factor, stages, block);
+    }
+  });
+
+  const uint64_t column_stride = block_size >> 1;
+  ParallelFor(column_stride, num_threads, [&](uint64_t begin, uint64_t end) {
+    for (uint64_t m = num_blocks; m > 1; m >>= 1) {
+      uint64_t t = n / (2 * m);
+      uint64_t root_index = n - 2 * m + 1;
+      for (uint64_t i = 0; i < m; ++i) {
+        const uint64_t W_i = inv_root_of_unity_powers[root_index + i];
+        const uint64_t W_i_precon =
+            precon_inv_root_of_unity_powers[root_index + i];
+        for (uint64_t offset = 2 * i * t; offset < 2 * i * t + t;
+             offset += column_stride) {
+          uint64_t* X_r = result + offset + begin;
+          uint64_t* Y_r = X_r + t;
+          for (uint64_t j = begin; j < end; ++j, ++X_r, ++Y_r) {
+            InvButterflyRadix2(X_r, Y_r, X_r, Y_r, W_i, W_i_precon, modulus,
+                               twice_modulus);
+          }
+        }
+      }
+    }
+
+    for (uint64_t offset = 0; offset < n / 2; offset += column_stride) {
+      InverseFinalStageRadix2(ntt, result, output_mod_factor, offset + begin,
+                              offset + end);
+    }
+  });
+}
+
+}  // namespace
+
+void PolyMultiplyModFused(const NTT& ntt, uint64_t* result,
+                          const uint64_t* operand1, const uint64_t* operand2,
+                          uint64_t* temp, uint64_t block_size) {
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(operand1 != nullptr, "operand1 == nullptr");
+  HEXL_CHECK(operand2 != nullptr, "operand2 == nullptr");
+  HEXL_CHECK(temp != nullptr, "temp == nullptr");
+  HEXL_CHECK(block_size != 0, "Require block_size != 0");
+  PolyMultiplyModFusedRecursive(ntt, result, operand1, operand2, temp,
+                                ntt.GetDegree(), block_size, 1, 0, 0);
+}
+
+void NTT::ComputeForward(uint64_t* result, const uint64_t* operand,
+                         uint64_t input_mod_factor, uint64_t output_mod_factor,
+                         const ExecutionPolicy& policy) {
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(
+      input_mod_factor == 1 || input_mod_factor == 2 || input_mod_factor == 4,
+      "input_mod_factor must be 1, 2 or 4; got " << input_mod_factor);
+  HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 4,
+             "output_mod_factor must be 1 or 4; got " << output_mod_factor);
+  HEXL_CHECK_BOUNDS(
+      operand, m_degree, m_q * input_mod_factor,
+      "value in operand exceeds bound " << m_q * input_mod_factor);
+
+  size_t num_threads = NumTransformThreads(m_degree_bits, policy);
+  if (num_threads > 1) {
+    HEXL_VLOG(3, "Calling parallel FwdNTT with " << num_threads
+                                                 << " threads");
+    ForwardTransformToBitReverseParallel(*this, result, operand,
+                                         input_mod_factor, output_mod_factor,
+                                         num_threads);
+    return;
+  }
+  ForwardTransformToBitReverse(*this, result, operand, m_degree,
+                               input_mod_factor, output_mod_factor, 0, 0);
+}
+
+void NTT::ComputeInverse(uint64_t* result, const uint64_t* operand,
+                         uint64_t input_mod_factor, uint64_t output_mod_factor,
+                         const ExecutionPolicy& policy) {
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(input_mod_factor == 1 || input_mod_factor == 2,
+             "input_mod_factor must be 1 or 2; got " << input_mod_factor);
+  HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 2,
+             "output_mod_factor must be 1 or 2; got " << output_mod_factor);
+  HEXL_CHECK_BOUNDS(operand, m_degree, m_q * input_mod_factor,
+                    "operand exceeds bound " << m_q * input_mod_factor);
+
+  size_t num_threads = NumTransformThreads(m_degree_bits, policy);
+  if (num_threads > 1) {
+    HEXL_VLOG(3, "Calling parallel InvNTT with " << num_threads
+                                                 << " threads");
+    InverseTransformFromBitReverseParallel(*this, result, operand,
+                                           input_mod_factor, output_mod_factor,
+                                           num_threads);
+    return;
+  }
+  InverseTransformFromBitReverse(*this, result, operand, m_degree,
+                                 input_mod_factor, output_mod_factor, 0, 0);
+}
+
+void NTT::Precompute(Direction direction,
+                     const ExecutionPolicy& policy) const {
+  std::vector<Table> tables;
+  uint64_t n = m_degree;
+  size_t num_threads = NumTransformThreads(m_degree_bits, policy);
+  if (num_threads > 1) {
+    // The outer stages use the 64-bit tables, and the sub-blocks dispatch
+    // as usual
+    if (direction != Direction::Inverse) {
+      tables.push_back(Table::RootOfUnityPowers);
+      tables.push_back(Table::Precon64RootOfUnityPowers);
+    }
+    if (direction != Direction::Forward) {
+      tables.push_back(Table::InvRootOfUnityPowers);
+      tables.push_back(Table::Precon64InvRootOfUnityPowers);
+    }
+    n >>= NumParallelStages(m_degree_bits, num_threads);
+  }
+  if (direction != Direction::Inverse) {
+    std::vector<Table> forward_tables = ForwardTables(*this, n);
+    tables.insert(tables.end(), forward_tables.begin(), forward_tables.end());
+  }
+  if (direction != Direction::Forward) {
+    std::vector<Table> inverse_tables = InverseTables(*this, n);
+    tables.insert(tables.end(), inverse_tables.begin(), inverse_tables.end());
+  }
+  // Viewed tables are used in place
+  for (Table table : tables) {
+    GetTable(table);
+  }
 }
 
 }  // namespace hexl
@@ -31,11 +31,16 @@ namespace hexl {
 /// input_mod_factor * q)
 /// @param[in] output_mod_factor Upper bound for result; result must be in [0,
 /// output_mod_factor * q)
+/// @param[in] recursion_depth Number of outer stages of a larger transform
+/// already applied; \p n is the size of the remaining sub-block
+/// @param[in] recursion_half Index of the sub-block within the larger
+/// transform. Used for indexing roots of unity
 void ForwardTransformToBitReverseRadix2(
     uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t modulus,
     const uint64_t* root_of_unity_powers,
     const uint64_t* precon_root_of_unity_powers, uint64_t input_mod_factor = 1,
-    uint64_t output_mod_factor = 1);
+    uint64_t output_mod_factor = 1, uint64_t recursion_depth = 0,
+    uint64_t recursion_half = 0);
 
 /// @brief Radix-4 native C++ NTT implementation of the forward NTT
 /// @param[out] result Output data. Overwritten with NTT output
@@ -95,11 +100,17 @@ void ReferenceInverseTransformFromBitReverse(
 /// input_mod_factor * q)
 /// @param[in] output_mod_factor Upper bound for result; result must be in [0,
 /// output_mod_factor * q)
+/// @param[in] recursion_depth Depth of the sub-block within a larger
+/// transform. If non-zero, the final stage, which spans sub-blocks, is skipped
+/// and the result is in [0, 2q)
+/// @param[in] recursion_half Index of the sub-block within the larger
+/// transform. Used for indexing roots of unity
 void InverseTransformFromBitReverseRadix2(
     uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t modulus,
     const uint64_t* inv_root_of_unity_powers,
     const uint64_t* precon_inv_root_of_unity_powers,
-    uint64_t input_mod_factor = 1, uint64_t output_mod_factor = 1);
+    uint64_t input_mod_factor = 1, uint64_t output_mod_factor = 1,
+    uint64_t recursion_depth = 0, uint64_t recursion_half = 0);
 
 /// @brief Radix-4 native C++ NTT implementation of the inverse NTT
 /// @param[out] result Output data. Overwritten with NTT output
@@ -121,5 +132,26 @@ void InverseTransformFromBitReverseRadix4(
     const uint64_t* precon_root_of_unity_powers, uint64_t input_mod_factor = 1,
     uint64_t output_mod_factor = 1);
 
+/// @brief Multiplies two polynomials in \f$ \mathbb{Z}_q[X]/(X^N + 1) \f$
+/// with the NTT \p ntt, fusing the transforms and the dyadic product
+/// @param[in] ntt NTT of degree N and modulus q
+/// @param[out] result Stores the product in [0, q). May alias \p operand1 or
+/// \p operand2
+/// @param[in] operand1 Coefficients of the first polynomial in [0, q)
+/// @param[in] operand2 Coefficients of the second polynomial in [0, q)
+/// @param[in] temp Scratch space of N elements
+/// @param[in] block_size Number of coefficients of the sub-blocks which are
+/// multiplied while in the cache
+/// @details Runs the outer stages of both forward transforms depth-first, as
+/// the AVX512 and AVX2 transforms do. Each sub-block of at most \p
+/// block_size coefficients is then forward transformed, multiplied and
+/// inverse transformed back to back, before the outer inverse stages combine
+/// the sub-blocks. Unlike separate transforms and EltwiseMultMod, no pass
+/// over the full polynomials sits between the forward and inverse stages of a
+/// sub-block.
+void PolyMultiplyModFused(const NTT& ntt, uint64_t* result,
+                          const uint64_t* operand1, const uint64_t* operand2,
+                          uint64_t* temp, uint64_t block_size);
+
 }  // namespace hexl
 }  // namespace intel
@@ -18,7 +18,8 @@ void ForwardTransformToBitReverseRadix2(
     uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t modulus,
     const uint64_t* root_of_unity_powers,
     const uint64_t* precon_root_of_unity_powers, uint64_t input_mod_factor,
-    uint64_t output_mod_factor) {
+    uint64_t output_mod_factor, uint64_t recursion_depth,
+    uint64_t recursion_half) {
   HEXL_CHECK(NTT::CheckArguments(n, modulus), "");
   HEXL_CHECK_BOUNDS(operand, n, modulus * input_mod_factor,
                     "operand exceeds bound " << modulus * input_mod_factor);
@@ -35,11 +36,15 @@ void ForwardTransformToBitReverseRadix2(
 
   uint64_t twice_modulus = modulus << 1;
   size_t t = (n >> 1);
+  // The roots for group i of the stage with m groups are at index
+  // m * W_scale + i when transforming sub-block recursion_half of size n at
+  // depth recursion_depth of a larger transform
+  size_t W_scale = (1ULL << recursion_depth) + recursion_half;
 
   // In case of out-of-place operation do first pass and convert to in-place
   {
-    const uint64_t W = root_of_unity_powers[1];
-    const uint64_t W_precon = precon_root_of_unity_powers[1];
+    const uint64_t W = root_of_unity_powers[W_scale];
+    const uint64_t W_precon = precon_root_of_unity_powers[W_scale];
 
     uint64_t* X_r = result;
     uint64_t* Y_r = X_r + t;
@@ -125,8 +130,9 @@ void ForwardTransformToBitReverseRadix2(
           if (i != 0) {
             offset += (t << 1);
           }
-          const uint64_t W = root_of_unity_powers[m + i];
-          const uint64_t W_precon = precon_root_of_unity_powers[m + i];
+          const uint64_t W = root_of_unity_powers[m * W_scale + i];
+          const uint64_t W_precon =
+              precon_root_of_unity_powers[m * W_scale + i];
 
           uint64_t* X_r = result + offset;
           uint64_t* Y_r = X_r + t;
@@ -157,8 +163,9 @@ void ForwardTransformToBitReverseRadix2(
           if (i != 0) {
             offset += (t << 1);
           }
-          const uint64_t W = root_of_unity_powers[m + i];
-          const uint64_t W_precon = precon_root_of_unity_powers[m + i];
+          const uint64_t W = root_of_unity_powers[m * W_scale + i];
+          const uint64_t W_precon =
+              precon_root_of_unity_powers[m * W_scale + i];
 
           uint64_t* X_r = result + offset;
           uint64_t* Y_r = X_r + t;
@@ -181,8 +188,9 @@ void ForwardTransformToBitReverseRadix2(
           if (i != 0) {
             offset += (t << 1);
           }
-          const uint64_t W = root_of_unity_powers[m + i];
-          const uint64_t W_precon = precon_root_of_unity_powers[m + i];
+          const uint64_t W = root_of_unity_powers[m * W_scale + i];
+          const uint64_t W_precon =
+              precon_root_of_unity_powers[m * W_scale + i];
 
           uint64_t* X_r = result + offset;
           uint64_t* Y_r = X_r + t;
@@ -201,8 +209,9 @@ void ForwardTransformToBitReverseRadix2(
           if (i != 0) {
             offset += (t << 1);
           }
-          const uint64_t W = root_of_unity_powers[m + i];
-          const uint64_t W_precon = precon_root_of_unity_powers[m + i];
+          const uint64_t W = root_of_unity_powers[m * W_scale + i];
+          const uint64_t W_precon =
+              precon_root_of_unity_powers[m * W_scale + i];
 
           uint64_t* X_r = result + offset;
           uint64_t* Y_r = X_r + t;
@@ -219,8 +228,9 @@ void ForwardTransformToBitReverseRadix2(
           if (i != 0) {
             offset += (t << 1);
           }
-          const uint64_t W = root_of_unity_powers[m + i];
-          const uint64_t W_precon = precon_root_of_unity_powers[m + i];
+          const uint64_t W = root_of_unity_powers[m * W_scale + i];
+          const uint64_t W_precon =
+              precon_root_of_unity_powers[m * W_scale + i];
 
           uint64_t* X_r = result + offset;
           uint64_t* Y_r = X_r + t;
@@ -331,7 +341,8 @@ void InverseTransformFromBitReverseRadix2(
     uint64_t* result, const uint64_t* operand, uint64_t n, uint64_t modulus,
     const uint64_t* inv_root_of_unity_powers,
     const uint64_t* precon_inv_root_of_unity_powers, uint64_t input_mod_factor,
-    uint64_t output_mod_factor) {
+    uint64_t output_mod_factor, uint64_t recursion_depth,
+    uint64_t recursion_half) {
   HEXL_CHECK(NTT::CheckArguments(n, modulus), "");
   HEXL_CHECK(inv_root_of_unity_powers != nullptr,
              "inv_root_of_unity_powers == nullptr");
@@ -351,6 +362,9 @@ void InverseTransformFromBitReverseRadix2(
 
   for (size_t m = n_div_2; m > 1; m >>= 1) {
     size_t offset = 0;
+    // Roots for the stage with m groups of sub-block recursion_half of size n
+    // at depth recursion_depth of a larger transform
+    root_index = ((n - 2 * m) << recursion_depth) + 1 + recursion_half * m;
 
     switch (t) {
       case 1: {
@@ -481,6 +495,11 @@ void InverseTransformFromBitReverseRadix2(
     t <<= 1;
   }
 
+  // The final stage spans sub-blocks, so is left to the caller
+  if (recursion_depth > 0) {
+    return;
+  }
+
   // When M is too short it only needs the final stage butterfly. Copying here
   // in the case of out-of-place.
   if (result != operand && n == 2) {
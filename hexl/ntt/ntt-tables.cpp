@@ -0,0 +1,261 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/ntt/ntt-tables.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "hexl/util/check.hpp"
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+constexpr char s_magic[8] = {'H', 'E', 'X', 'L', 'N', 'T', 'T', '\0'};
+constexpr uint64_t s_table_alignment = 64;
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_tables;
+  uint64_t num_ntts;
+};
+
+struct FileRecord {
+  uint64_t degree;
+  uint64_t modulus;
+  uint64_t root_of_unity;
+  // Byte offset from the start of the file, and number of elements. Absent
+  // tables have size 0.
+  uint64_t table_offsets[NTT::s_num_tables];
+  uint64_t table_sizes[NTT::s_num_tables];
+};
+
+uint64_t AlignUp(uint64_t offset) {
+  return (offset + s_table_alignment - 1) / s_table_alignment *
+         s_table_alignment;
+}
+
+// Read-only contents of a table file
+class FileMapping {
+ public:
+  explicit FileMapping(const std::string& path) {
+#ifdef _WIN32
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+      throw std::runtime_error("Cannot open NTT table file " + path);
+    }
+    std::vector<char> bytes((std::istreambuf_iterator<char>(file)),
+                            std::istreambuf_iterator<char>());
+    m_size = bytes.size();
+    m_buffer.resize((m_size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    std::memcpy(m_buffer.data(), bytes.data(), m_size);
+    m_data = reinterpret_cast<const uint8_t*>(m_buffer.data());
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Cannot open NTT table file " + path);
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+      close(fd);
+      throw std::runtime_error("Cannot stat NTT table file " + path);
+    }
+    m_size = static_cast<uint64_t>(file_stat.st_size);
+    if (m_size >= sizeof(FileHeader)) {
+      void* data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+      if (data == MAP_FAILED) {
+        close(fd);
+        throw std::runtime_error("Cannot map NTT table file " + path);
+      }
+      m_data = static_cast<const uint8_t*>(data);
+    }
+    close(fd);
+#endif
+  }
+
+  ~FileMapping() {
+#ifndef _WIN32
+    if (m_data != nullptr) {
+      munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+#endif
+  }
+
+  FileMapping(const FileMapping&) = delete;
+  FileMapping& operator=(const FileMapping&) = delete;
+
+  const uint8_t* Data() const { return m_data; }
+  uint64_t Size() const { return m_size; }
+
+ private:
+  const uint8_t* m_data{nullptr};
+  uint64_t m_size{0};
+#ifdef _WIN32
+  AlignedVector64<uint64_t> m_buffer;
+#endif
+};
+
+}  // namespace
+
+void SaveNTTTables(const std::string& path,
+                   const std::vector<const NTT*>& ntts) {
+  FileHeader header;
+  std::memcpy(header.magic, s_magic, sizeof(s_magic));
+  header.version = MappedNTTTables::s_version;
+  header.num_tables = NTT::s_num_tables;
+  header.num_ntts = ntts.size();
+
+  std::vector<FileRecord> records(ntts.size());
+  uint64_t offset =
+      AlignUp(sizeof(FileHeader) + ntts.size() * sizeof(FileRecord));
+  for (size_t i = 0; i < ntts.size(); ++i) {
+    HEXL_CHECK(ntts[i] != nullptr, "Require ntts[" << i << "] != nullptr");
+    FileRecord& record = records[i];
+    record.degree = ntts[i]->GetDegree();
+    record.modulus = ntts[i]->GetModulus();
+    record.root_of_unity = ntts[i]->GetMinimalRootOfUnity();
+    for (size_t t = 0; t < NTT::s_num_tables; ++t) {
+      record.table_offsets[t] = offset;
+      record.table_sizes[t] =
+          ntts[i]->GetTableSize(static_cast<NTT::Table>(t));
+      offset = AlignUp(offset + record.table_sizes[t] * sizeof(uint64_t));
+    }
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    throw std::runtime_error("Cannot open NTT table file " + path);
+  }
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(records.data()),
+             static_cast<std::streamsize>(records.size() * sizeof(FileRecord)));
+
+  const char padding[s_table_alignment] = {};
+  uint64_t written = sizeof(FileHeader) + records.size() * sizeof(FileRecord);
+  for (size_t i = 0; i < ntts.size(); ++i) {
+    for (size_t t = 0; t < NTT::s_num_tables; ++t) {
+      uint64_t table_offset = records[i].table_offsets[t];
+      file.write(padding,
+                 static_cast<std::streamsize>(table_offset - written));
+      uint64_t table_bytes = records[i].table_sizes[t] * sizeof(uint64_t);
+      file.write(
+          reinterpret_cast<const char*>(
+              ntts[i]->GetTable(static_cast<NTT::Table>(t))),
+          static_cast<std::streamsize>(table_bytes));
+      written = table_offset + table_bytes;
+    }
+  }
+  file.write(padding, static_cast<std::streamsize>(offset - written));
+  if (!file) {
+    throw std::runtime_error("Cannot write NTT table file " + path);
+  }
+}
+
+MappedNTTTables::MappedNTTTables(const std::string& path) {
+  auto mapping = std::make_shared<FileMapping>(path);
+  const uint8_t* data = mapping->Data();
+  uint64_t size = mapping->Size();
+  auto invalid = [&](const std::string& reason) {
+    return std::invalid_argument("Invalid NTT table file " + path + ": " +
+                                 reason);
+  };
+
+  FileHeader header;
+  if (size < sizeof(FileHeader)) {
+    throw invalid("truncated header");
+  }
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, s_magic, sizeof(s_magic)) != 0) {
+    throw invalid("bad magic");
+  }
+  if (header.version != s_version) {
+    throw invalid("unsupported version " + std::to_string(header.version));
+  }
+  if (header.num_tables != NTT::s_num_tables) {
+    throw invalid("unexpected number of tables");
+  }
+  if (header.num_ntts > (size - sizeof(FileHeader)) / sizeof(FileRecord)) {
+    throw invalid("truncated records");
+  }
+
+  m_records.reserve(header.num_ntts);
+  for (uint64_t i = 0; i < header.num_ntts; ++i) {
+    FileRecord file_record;
+    std::memcpy(&file_record,
+                data + sizeof(FileHeader) + i * sizeof(FileRecord),
+                sizeof(FileRecord));
+    if (!IsPowerOfTwo(file_record.degree) ||
+        file_record.degree > (1ULL << NTT::MaxDegreeBits())) {
+      throw invalid("bad degree");
+    }
+    if (file_record.modulus <= 2 * file_record.degree ||
+        file_record.modulus > (1ULL << NTT::MaxModulusBits()) ||
+        file_record.modulus % (2 * file_record.degree) != 1 ||
+        !IsPrime(file_record.modulus)) {
+      throw invalid("bad modulus");
+    }
+    if (file_record.root_of_unity >= file_record.modulus ||
+        !IsPrimitiveRoot(file_record.root_of_unity, 2 * file_record.degree,
+                         file_record.modulus)) {
+      throw invalid("bad root of unity");
+    }
+
+    NTT::PrecomputedTables record;
+    record.degree = file_record.degree;
+    record.modulus = file_record.modulus;
+    record.root_of_unity = file_record.root_of_unity;
+    record.owner = mapping;
+    for (size_t t = 0; t < NTT::s_num_tables; ++t) {
+      uint64_t offset = file_record.table_offsets[t];
+      uint64_t num_elements = file_record.table_sizes[t];
+      // Absent tables are computed on first use. Present tables must have
+      // the size the kernels read.
+      uint64_t expected_elements = NTT::ExpectedTableSize(
+          file_record.degree, static_cast<NTT::Table>(t));
+      if ((num_elements != 0 && num_elements != expected_elements) ||
+          offset % s_table_alignment != 0 || offset > size ||
+          num_elements * sizeof(uint64_t) > size - offset) {
+        throw invalid("bad table");
+      }
+      if (num_elements != 0) {
+        record.tables[t].data =
+            reinterpret_cast<const uint64_t*>(data + offset);
+        record.tables[t].size = num_elements;
+      }
+    }
+    m_records.push_back(std::move(record));
+  }
+}
+
+NTT MappedNTTTables::GetNTT(size_t i) const {
+  HEXL_CHECK(i < m_records.size(),
+             "Index " << i << " exceeds number of NTTs " << m_records.size());
+  return NTT(m_records[i]);
+}
+
+std::vector<NTT> MappedNTTTables::GetNTTs() const {
+  std::vector<NTT> ntts;
+  ntts.reserve(m_records.size());
+  for (size_t i = 0; i < m_records.size(); ++i) {
+    ntts.push_back(GetNTT(i));
+  }
+  return ntts;
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,74 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/ntt/poly-multiply-mod.hpp"
+
+#include "hexl/ntt/ntt-cache.hpp"
+#include "hexl/ntt/ntt.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "hexl/util/check.hpp"
+#include "ntt/ntt-internal.hpp"
+#include "util/parallel.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Sub-blocks of result and temp together fill 32 KiB, so each is transformed,
+// multiplied and inverse transformed without leaving the L1 or L2 cache
+constexpr uint64_t s_fused_block_size{2048};
+
+// Multiplies a single residue polynomial, using temp to hold n elements
+void PolyMultiplyModResidue(uint64_t* result, const uint64_t* operand1,
+                            const uint64_t* operand2, uint64_t n,
+                            uint64_t modulus, uint64_t* temp) {
+  NTTHandle ntt = GetNTT(n, modulus);
+  PolyMultiplyModFused(*ntt, result, operand1, operand2, temp,
+                       s_fused_block_size);
+}
+
+}  // namespace
+
+void PolyMultiplyMod(uint64_t* result, const uint64_t* operand1,
+                     const uint64_t* operand2, uint64_t n, uint64_t modulus) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
+  HEXL_CHECK(operand2 != nullptr, "Require operand2 != nullptr");
+  HEXL_CHECK(NTT::CheckArguments(n, modulus), "");
+  HEXL_CHECK_BOUNDS(operand1, n, modulus, "operand1 exceeds bound " << modulus);
+  HEXL_CHECK_BOUNDS(operand2, n, modulus, "operand2 exceeds bound " << modulus);
+
+  AlignedVector64<uint64_t> temp(n);
+  PolyMultiplyModResidue(result, operand1, operand2, n, modulus, temp.data());
+}
+
+void PolyMultiplyMod(uint64_t* result, const uint64_t* operand1,
+                     const uint64_t* operand2, uint64_t n,
+                     const uint64_t* moduli, uint64_t num_moduli,
+                     const ExecutionPolicy& policy) {
+  HEXL_CHECK(result != nullptr, "Require result != nullptr");
+  HEXL_CHECK(operand1 != nullptr, "Require operand1 != nullptr");
+  HEXL_CHECK(operand2 != nullptr, "Require operand2 != nullptr");
+  HEXL_CHECK(moduli != nullptr, "Require moduli != nullptr");
+  HEXL_CHECK(num_moduli != 0, "Require num_moduli != 0");
+  for (uint64_t i = 0; i < num_moduli; ++i) {
+    HEXL_CHECK(NTT::CheckArguments(n, moduli[i]), "");
+    HEXL_CHECK_BOUNDS(operand1 + i * n, n, moduli[i],
+                      "operand1 exceeds bound " << moduli[i]);
+    HEXL_CHECK_BOUNDS(operand2 + i * n, n, moduli[i],
+                      "operand2 exceeds bound " << moduli[i]);
+  }
+
+  auto multiply_residues = [&](uint64_t begin, uint64_t end) {
+    AlignedVector64<uint64_t> temp(n);
+    for (uint64_t i = begin; i < end; ++i) {
+      PolyMultiplyModResidue(result + i * n, operand1 + i * n, operand2 + i * n,
+                             n, moduli[i], temp.data());
+    }
+  };
+  ParallelFor(num_moduli, policy, multiply_residues, n);
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,98 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hexl/ntt/rns-ntt.hpp"
+
+#include <vector>
+
+#include "hexl/logging/logging.hpp"
+#include "hexl/util/check.hpp"
+#include "util/parallel.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Calls transform(modulus_index, poly_index) for each of the num_polys *
+// num_moduli residues, in modulus-major order so that consecutive transforms
+// share root of unity tables. Under a parallel policy, the residues are split
+// into contiguous ranges of at least the grain size of coefficients.
+template <typename Transform>
+void ForEachResidue(uint64_t num_polys, size_t num_moduli, uint64_t degree,
+                    const ExecutionPolicy& policy, Transform transform) {
+  ParallelFor(
+      num_polys * num_moduli, policy,
+      [&](uint64_t begin, uint64_t end) {
+        for (uint64_t t = begin; t < end; ++t) {
+          transform(static_cast<size_t>(t / num_polys), t % num_polys);
+        }
+      },
+      degree);
+}
+
+}  // namespace
+
+RNSNTT::RNSNTT(uint64_t degree, const std::vector<uint64_t>& moduli,
+               std::shared_ptr<AllocatorBase> alloc_ptr)
+    : m_degree(degree), m_moduli(moduli) {
+  HEXL_CHECK(!moduli.empty(), "Require at least one modulus");
+  m_ntts.reserve(moduli.size());
+  for (uint64_t modulus : moduli) {
+    m_ntts.emplace_back(degree, modulus, alloc_ptr);
+  }
+}
+
+void RNSNTT::ComputeForward(uint64_t* result, const uint64_t* operand,
+                            uint64_t num_polys, uint64_t input_mod_factor,
+                            uint64_t output_mod_factor,
+                            const ExecutionPolicy& policy) {
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(num_polys != 0, "Require num_polys != 0");
+  HEXL_CHECK(
+      input_mod_factor == 1 || input_mod_factor == 2 || input_mod_factor == 4,
+      "input_mod_factor must be 1, 2 or 4; got " << input_mod_factor);
+  HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 4,
+             "output_mod_factor must be 1 or 4; got " << output_mod_factor);
+
+  HEXL_VLOG(3, "RNSNTT::ComputeForward on " << num_polys << " x "
+                                            << m_moduli.size() << " residues");
+  const uint64_t num_moduli = m_moduli.size();
+  ForEachResidue(num_polys, m_moduli.size(), m_degree, policy,
+                 [&](size_t modulus_idx, uint64_t poly_idx) {
+                   uint64_t offset =
+                       (poly_idx * num_moduli + modulus_idx) * m_degree;
+                   m_ntts[modulus_idx].ComputeForward(
+                       result + offset, operand + offset, input_mod_factor,
+                       output_mod_factor);
+                 });
+}
+
+void RNSNTT::ComputeInverse(uint64_t* result, const uint64_t* operand,
+                            uint64_t num_polys, uint64_t input_mod_factor,
+                            uint64_t output_mod_factor,
+                            const ExecutionPolicy& policy) {
+  HEXL_CHECK(result != nullptr, "result == nullptr");
+  HEXL_CHECK(operand != nullptr, "operand == nullptr");
+  HEXL_CHECK(num_polys != 0, "Require num_polys != 0");
+  HEXL_CHECK(input_mod_factor == 1 || input_mod_factor == 2,
+             "input_mod_factor must be 1 or 2; got " << input_mod_factor);
+  HEXL_CHECK(output_mod_factor == 1 || output_mod_factor == 2,
+             "output_mod_factor must be 1 or 2; got " << output_mod_factor);
+
+  HEXL_VLOG(3, "RNSNTT::ComputeInverse on " << num_polys << " x "
+                                            << m_moduli.size() << " residues");
+  const uint64_t num_moduli = m_moduli.size();
+  ForEachResidue(num_polys, m_moduli.size(), m_degree, policy,
+                 [&](size_t modulus_idx, uint64_t poly_idx) {
+                   uint64_t offset =
+                       (poly_idx * num_moduli + modulus_idx) * m_degree;
+                   m_ntts[modulus_idx].ComputeInverse(
+                       result + offset, operand + offset, input_mod_factor,
+                       output_mod_factor);
+                 });
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,227 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <immintrin.h>
+
+#include <vector>
+
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/check.hpp"
+#include "hexl/util/defines.hpp"
+#include "hexl/util/util.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+
+/// @brief Returns the unsigned 64-bit integer values in x as a vector
+inline std::vector<uint64_t> ExtractValues(__m256i x) {
+  std::vector<uint64_t> xs{static_cast<uint64_t>(_mm256_extract_epi64(x, 0)),
+                           static_cast<uint64_t>(_mm256_extract_epi64(x, 1)),
+                           static_cast<uint64_t>(_mm256_extract_epi64(x, 2)),
+                           static_cast<uint64_t>(_mm256_extract_epi64(x, 3))};
+  return xs;
+}
+
+// Returns a mask whose 64-bit lanes are all ones where x < y, treating x and
+// y as unsigned integers. AVX2 only provides signed 64-bit comparisons, so the
+// sign bit of each operand is flipped first.
+inline __m256i _mm256_hexl_cmplt_epu64(__m256i x, __m256i y) {
+  const __m256i sign_bit =
+      _mm256_set1_epi64x(static_cast<int64_t>(1ULL << 63));
+  return _mm256_cmpgt_epi64(_mm256_xor_si256(y, sign_bit),
+                            _mm256_xor_si256(x, sign_bit));
+}
+
+// Returns x if x < bound, else x - bound, in each 64-bit lane
+inline __m256i _mm256_hexl_cond_sub_epi64(__m256i x, __m256i bound) {
+  __m256i x_lt_bound = _mm256_hexl_cmplt_epu64(x, bound);
+  return _mm256_sub_epi64(x, _mm256_andnot_si256(x_lt_bound, bound));
+}
+
+// Returns x mod q across each 64-bit integer SIMD lanes
+// Assumes x < InputModFactor * q in all lanes
+template <int InputModFactor = 2>
+inline __m256i _mm256_hexl_small_mod_epu64(__m256i x, __m256i q,
+                                           __m256i* q_times_2 = nullptr,
+                                           __m256i* q_times_4 = nullptr) {
+  HEXL_CHECK(InputModFactor == 1 || InputModFactor == 2 ||
+                 InputModFactor == 4 || InputModFactor == 8,
+             "InputModFactor must be 1, 2, 4, or 8");
+  if (InputModFactor == 1) {
+    return x;
+  }
+  if (InputModFactor == 2) {
+    return _mm256_hexl_cond_sub_epi64(x, q);
+  }
+  if (InputModFactor == 4) {
+    HEXL_CHECK(q_times_2 != nullptr, "q_times_2 must not be nullptr");
+    x = _mm256_hexl_cond_sub_epi64(x, *q_times_2);
+    return _mm256_hexl_cond_sub_epi64(x, q);
+  }
+  if (InputModFactor == 8) {
+    HEXL_CHECK(q_times_2 != nullptr, "q_times_2 must not be nullptr");
+    HEXL_CHECK(q_times_4 != nullptr, "q_times_4 must not be nullptr");
+    x = _mm256_hexl_cond_sub_epi64(x, *q_times_4);
+    x = _mm256_hexl_cond_sub_epi64(x, *q_times_2);
+    return _mm256_hexl_cond_sub_epi64(x, q);
+  }
+  HEXL_CHECK(false, "Invalid InputModFactor");
+  return x;  // Return dummy value
+}
+
+// Returns (x + y) mod q; assumes 0 < x, y < q
+inline __m256i _mm256_hexl_small_add_mod_epi64(__m256i x, __m256i y,
+                                               __m256i q) {
+  return _mm256_hexl_small_mod_epu64(_mm256_add_epi64(x, y), q);
+}
+
+// Returns (x - y) mod q; assumes 0 < x, y < q
+inline __m256i _mm256_hexl_small_sub_mod_epi64(__m256i x, __m256i y,
+                                               __m256i q) {
+  // diff = x - y;
+  // return (x < y) ? (diff + q) : diff
+  __m256i v_diff = _mm256_sub_epi64(x, y);
+  __m256i x_lt_y = _mm256_hexl_cmplt_epu64(x, y);
+  return _mm256_add_epi64(v_diff, _mm256_and_si256(x_lt_y, q));
+}
+
+// Returns an all-ones mask in each 64-bit lane where a cmp b holds, treating a
+// and b as unsigned integers
+inline __m256i _mm256_hexl_cmp_epu64_mask(__m256i a, __m256i b, CMPINT cmp) {
+  const __m256i all_ones = _mm256_set1_epi64x(-1);
+  switch (cmp) {
+    case CMPINT::EQ:
+      return _mm256_cmpeq_epi64(a, b);
+    case CMPINT::LT:
+      return _mm256_hexl_cmplt_epu64(a, b);
+    case CMPINT::LE:
+      return _mm256_xor_si256(_mm256_hexl_cmplt_epu64(b, a), all_ones);
+    case CMPINT::FALSE:
+      return _mm256_setzero_si256();
+    case CMPINT::NE:
+      return _mm256_xor_si256(_mm256_cmpeq_epi64(a, b), all_ones);
+    case CMPINT::NLT:
+      return _mm256_xor_si256(_mm256_hexl_cmplt_epu64(a, b), all_ones);
+    case CMPINT::NLE:
+      return _mm256_hexl_cmplt_epu64(b, a);
+    case CMPINT::TRUE:
+      return all_ones;
+  }
+  return _mm256_setzero_si256();
+}
+
+// Returns c[i] = a[i] CMP b[i] ? match_value : 0
+inline __m256i _mm256_hexl_cmp_epi64(__m256i a, __m256i b, CMPINT cmp,
+                                     uint64_t match_value) {
+  __m256i mask = _mm256_hexl_cmp_epu64_mask(a, b, cmp);
+  return _mm256_and_si256(
+      mask, _mm256_set1_epi64x(static_cast<int64_t>(match_value)));
+}
+
+// Multiply packed unsigned 64-bit integers in each 64-bit element of x and y
+// to form a 128-bit intermediate result. Returns the low 64-bit unsigned
+// integer from the intermediate result
+inline __m256i _mm256_hexl_mullo_epi64(__m256i x, __m256i y) {
+  __m256i x_hi = _mm256_srli_epi64(x, 32);
+  __m256i y_hi = _mm256_srli_epi64(y, 32);
+  __m256i z_lo_lo = _mm256_mul_epu32(x, y);
+  __m256i z_cross = _mm256_add_epi64(_mm256_mul_epu32(x_hi, y),
+                                     _mm256_mul_epu32(x, y_hi));
+  return _mm256_add_epi64(z_lo_lo, _mm256_slli_epi64(z_cross, 32));
+}
+
+// Multiply packed unsigned 64-bit integers in each 64-bit element of x and y
+// to form a 128-bit intermediate result. Returns the high 64-bit unsigned
+// integer from the intermediate result
+inline __m256i _mm256_hexl_mulhi_epi64(__m256i x, __m256i y) {
+  // See _mm512_hexl_mulhi_epi<64> for a description of the partial products
+  __m256i lo_mask = _mm256_set1_epi64x(0x00000000ffffffff);
+  __m256i x_hi = _mm256_srli_epi64(x, 32);
+  __m256i y_hi = _mm256_srli_epi64(y, 32);
+  __m256i z_lo_lo = _mm256_mul_epu32(x, y);        // x_lo * y_lo
+  __m256i z_lo_hi = _mm256_mul_epu32(x, y_hi);     // x_lo * y_hi
+  __m256i z_hi_lo = _mm256_mul_epu32(x_hi, y);     // x_hi * y_lo
+  __m256i z_hi_hi = _mm256_mul_epu32(x_hi, y_hi);  // x_hi * y_hi
+
+  __m256i z_lo_lo_shift = _mm256_srli_epi64(z_lo_lo, 32);
+  __m256i sum_tmp = _mm256_add_epi64(z_lo_hi, z_lo_lo_shift);
+  __m256i sum_lo = _mm256_and_si256(sum_tmp, lo_mask);
+  __m256i sum_mid = _mm256_srli_epi64(sum_tmp, 32);
+  __m256i sum_mid2 = _mm256_add_epi64(z_hi_lo, sum_lo);
+  __m256i sum_mid2_hi = _mm256_srli_epi64(sum_mid2, 32);
+  __m256i sum_hi = _mm256_add_epi64(z_hi_hi, sum_mid);
+  return _mm256_add_epi64(sum_hi, sum_mid2_hi);
+}
+
+// Multiply packed unsigned 64-bit integers in each 64-bit element of x and y
+// to form a 128-bit intermediate result. Returns the high 64-bit unsigned
+// integer from the intermediate result, with approximation error at most 1
+inline __m256i _mm256_hexl_mulhi_approx_epi64(__m256i x, __m256i y) {
+  // See _mm512_hexl_mulhi_approx_epi<64>; the x_lo * y_lo term is dropped
+  __m256i lo_mask = _mm256_set1_epi64x(0x00000000ffffffff);
+  __m256i x_hi = _mm256_srli_epi64(x, 32);
+  __m256i y_hi = _mm256_srli_epi64(y, 32);
+  __m256i z_lo_hi = _mm256_mul_epu32(x, y_hi);     // x_lo * y_hi
+  __m256i z_hi_lo = _mm256_mul_epu32(x_hi, y);     // x_hi * y_lo
+  __m256i z_hi_hi = _mm256_mul_epu32(x_hi, y_hi);  // x_hi * y_hi
+
+  __m256i sum_lo = _mm256_and_si256(z_lo_hi, lo_mask);
+  __m256i sum_mid = _mm256_srli_epi64(z_lo_hi, 32);
+  __m256i sum_mid2 = _mm256_add_epi64(z_hi_lo, sum_lo);
+  __m256i sum_mid2_hi = _mm256_srli_epi64(sum_mid2, 32);
+  __m256i sum_hi = _mm256_add_epi64(z_hi_hi, sum_mid);
+  return _mm256_add_epi64(sum_hi, sum_mid2_hi);
+}
+
+// Returns x mod q in [0, OutputModFactor * q), computed using the 64-bit
+// Barrett factor q_barr = floor(2^64 / q)
+template <int OutputModFactor = 1>
+inline __m256i _mm256_hexl_barrett_reduce64(__m256i x, __m256i q,
+                                            __m256i q_barr) {
+  HEXL_CHECK(OutputModFactor == 1 || OutputModFactor == 2,
+             "OutputModFactor must be 1 or 2");
+  __m256i rnd1_hi = _mm256_hexl_mulhi_epi64(x, q_barr);
+  __m256i tmp1_times_mod = _mm256_hexl_mullo_epi64(rnd1_hi, q);
+  x = _mm256_sub_epi64(x, tmp1_times_mod);
+  // Correction
+  if (OutputModFactor == 1) {
+    x = _mm256_hexl_small_mod_epu64<2>(x, q);
+  }
+  return x;
+}
+
+// Returns the lazy modular product W * x mod q in [0, 2q), using the
+// BitShift-bit Barrett factor W_precon = floor(W * 2^BitShift / q).
+// For BitShift == 32, assumes q < 2^30 and x < 2^32. For BitShift == 64,
+// assumes q < 2^62.
+template <int BitShift>
+inline __m256i _mm256_hexl_mul_mod_lazy_epi64(__m256i x, __m256i W,
+                                              __m256i W_precon, __m256i q,
+                                              __m256i twice_q) {
+  HEXL_CHECK(BitShift == 32 || BitShift == 64,
+             "Invalid BitShift " << BitShift << "; need 32 or 64");
+  if (BitShift == 32) {
+    // All operands fit in 32 bits, so a single _mm256_mul_epu32 suffices
+    __m256i Q = _mm256_srli_epi64(_mm256_mul_epu32(W_precon, x), 32);
+    __m256i W_x = _mm256_mul_epu32(W, x);
+    return _mm256_sub_epi64(W_x, _mm256_mul_epu32(Q, q));
+  }
+  // Perform approximate computation of Q, as described in page 7 of
+  // https://arxiv.org/pdf/2003.04510.pdf
+  __m256i Q = _mm256_hexl_mulhi_approx_epi64(W_precon, x);
+  __m256i W_x = _mm256_hexl_mullo_epi64(W, x);
+  // Compute result in range [0, 4q)
+  __m256i result = _mm256_sub_epi64(W_x, _mm256_hexl_mullo_epi64(Q, q));
+  // Reduce result to range [0, 2q)
+  return _mm256_hexl_small_mod_epu64<2>(result, twice_q);
+}
+
+#endif  // HEXL_HAS_AVX256
+
+}  // namespace hexl
+}  // namespace intel
@@ -494,6 +494,33 @@ inline __m512i _mm512_hexl_barrett_reduce64(__m512i x, __m512i q,
   return x;
 }
 
+// Returns (x_hi * 2^64 + x_lo) mod q, for q < 2^62
+// @param q_barr_64 floor(2^64 / q)
+// @param two_pow_64 2^64 mod q
+// @param two_pow_64_precon floor(2^64 * two_pow_64 / q)
+inline __m512i _mm512_hexl_barrett_reduce128(__m512i x_hi, __m512i x_lo,
+                                             __m512i q, __m512i q_barr_64,
+                                             __m512i two_pow_64,
+                                             __m512i two_pow_64_precon) {
+  // x_hi mod q, in [0, q)
+  __m512i q_hat = _mm512_hexl_mulhi_epi<64>(x_hi, q_barr_64);
+  __m512i hi = _mm512_sub_epi64(x_hi, _mm512_mullo_epi64(q_hat, q));
+  hi = _mm512_hexl_small_mod_epu64<2>(hi, q);
+
+  // hi * 2^64 mod q via Shoup multiplication, in [0, 2q)
+  q_hat = _mm512_hexl_mulhi_epi<64>(hi, two_pow_64_precon);
+  hi = _mm512_sub_epi64(_mm512_mullo_epi64(hi, two_pow_64),
+                        _mm512_mullo_epi64(q_hat, q));
+
+  // x_lo mod q, in [0, 2q)
+  q_hat = _mm512_hexl_mulhi_epi<64>(x_lo, q_barr_64);
+  __m512i lo = _mm512_sub_epi64(x_lo, _mm512_mullo_epi64(q_hat, q));
+
+  __m512i q_times_2 = _mm512_add_epi64(q, q);
+  return _mm512_hexl_small_mod_epu64<4>(_mm512_add_epi64(hi, lo), q,
+                                        &q_times_2);
+}
+
 // Concatenate packed 64-bit integers in x and y, producing an intermediate
 // 128-bit result. Shift the result right by bit_shift bits, and return the
 // lower 64 bits. The bit_shift is a run-time argument, rather than a
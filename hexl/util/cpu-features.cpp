@@ -0,0 +1,150 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "util/cpu-features.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <string>
+
+#include "hexl/util/check.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// L2 cache size assumed when the probe fails
+constexpr uint64_t s_default_l2_bytes{256 * 1024};
+
+// Parses a cache size as written in /sys, e.g. "48K" or "2M"
+uint64_t ParseCacheSize(const std::string& size) {
+  size_t end = 0;
+  uint64_t bytes = 0;
+  try {
+    bytes = std::stoull(size, &end);
+  } catch (const std::exception&) {
+    return 0;
+  }
+  if (end < size.size()) {
+    switch (size[end]) {
+      case 'K':
+        bytes <<= 10;
+        break;
+      case 'M':
+        bytes <<= 20;
+        break;
+      case 'G':
+        bytes <<= 30;
+        break;
+      default:
+        break;
+    }
+  }
+  return bytes;
+}
+
+void SetCacheSize(CacheSizes* sizes, uint64_t level, bool is_data,
+                  uint64_t bytes) {
+  if (!is_data) {
+    return;
+  }
+  switch (level) {
+    case 1:
+      sizes->l1d_bytes = bytes;
+      break;
+    case 2:
+      sizes->l2_bytes = bytes;
+      break;
+    case 3:
+      sizes->l3_bytes = bytes;
+      break;
+    default:
+      break;
+  }
+}
+
+// Reads the caches of cpu0 from /sys/devices/system/cpu/cpu0/cache/index*
+CacheSizes ProbeSysCacheSizes() {
+  CacheSizes sizes;
+  const std::string cache_dir = "/sys/devices/system/cpu/cpu0/cache/index";
+  for (size_t index = 0; index < 8; ++index) {
+    const std::string dir = cache_dir + std::to_string(index) + "/";
+    std::ifstream level_file(dir + "level");
+    std::ifstream type_file(dir + "type");
+    std::ifstream size_file(dir + "size");
+    uint64_t level = 0;
+    std::string type;
+    std::string size;
+    if (!(level_file >> level) || !(type_file >> type) ||
+        !(size_file >> size)) {
+      continue;
+    }
+    SetCacheSize(&sizes, level, type == "Data" || type == "Unified",
+                 ParseCacheSize(size));
+  }
+  return sizes;
+}
+
+CacheSizes ProbeCacheSizes() {
+  CacheSizes sizes;
+  const cpu_features::CacheInfo info = cpu_features::GetX86CacheInfo();
+  for (int i = 0; i < info.size; ++i) {
+    const cpu_features::CacheLevelInfo& level = info.levels[i];
+    if (level.cache_size <= 0) {
+      continue;
+    }
+    SetCacheSize(&sizes, static_cast<uint64_t>(level.level),
+                 level.cache_type == cpu_features::CPU_FEATURE_CACHE_DATA ||
+                     level.cache_type ==
+                         cpu_features::CPU_FEATURE_CACHE_UNIFIED,
+                 static_cast<uint64_t>(level.cache_size));
+  }
+  // cpu_features only decodes the cache leaves of Intel CPUs
+  if (sizes.l2_bytes == 0) {
+    sizes = ProbeSysCacheSizes();
+  }
+  return sizes;
+}
+
+uint64_t ProbeTileBytes() {
+  const char* tile_bytes = std::getenv("HEXL_TILE_BYTES");
+  if (tile_bytes != nullptr) {
+    uint64_t bytes = ParseCacheSize(tile_bytes);
+    if (bytes != 0) {
+      return bytes;
+    }
+  }
+  // The other half holds the data of the caller, e.g. twiddle factors
+  const uint64_t l2_bytes = GetCacheSizes().l2_bytes;
+  return (l2_bytes == 0 ? s_default_l2_bytes : l2_bytes) / 2;
+}
+
+}  // namespace
+
+const CacheSizes& GetCacheSizes() {
+  static const CacheSizes sizes = ProbeCacheSizes();
+  return sizes;
+}
+
+uint64_t GetTileBytes() {
+  static const uint64_t tile_bytes = ProbeTileBytes();
+  return tile_bytes;
+}
+
+uint64_t GetTileSize(uint64_t bytes_per_element, uint64_t max_tile_size) {
+  HEXL_CHECK(bytes_per_element != 0, "Require bytes_per_element != 0");
+  HEXL_CHECK(max_tile_size != 0, "Require max_tile_size != 0");
+
+  const uint64_t max_elements =
+      std::max<uint64_t>(GetTileBytes() / bytes_per_element, 1);
+  uint64_t tile_size = 8;
+  while (tile_size * 2 <= max_elements) {
+    tile_size *= 2;
+  }
+  return std::min(tile_size, max_tile_size);
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include <cstdlib>
 
@@ -12,9 +13,13 @@
 namespace intel {
 namespace hexl {
 
-// Use to disable avx512 dispatching at runtime
+// Use to disable avx2 and avx512 dispatching at runtime. Disabling an
+// instruction set also disables the ones built on top of it, so
+// HEXL_DISABLE_AVX2 selects the native kernels, and HEXL_DISABLE_AVX512DQ
+// selects the avx2 kernels where they exist.
+static const bool disable_avx2 = (std::getenv("HEXL_DISABLE_AVX2") != nullptr);
 static const bool disable_avx512dq =
-    (std::getenv("HEXL_DISABLE_AVX512DQ") != nullptr);
+    disable_avx2 || (std::getenv("HEXL_DISABLE_AVX512DQ") != nullptr);
 static const bool disable_avx512ifma =
     disable_avx512dq || (std::getenv("HEXL_DISABLE_AVX512IFMA") != nullptr);
 static const bool disable_avx512vbmi2 =
@@ -31,5 +36,31 @@ static const bool has_avx512ifma = features.avx512ifma && !disable_avx512ifma;
 static const bool has_avx512vbmi2 =
     features.avx512vbmi2 && !disable_avx512vbmi2;
 
+static const bool has_avx2 = features.avx2 && !disable_avx2;
+
+/// @brief Sizes in bytes of the data caches of a core, or 0 for a level that
+/// was not found
+struct CacheSizes {
+  uint64_t l1d_bytes{0};
+  uint64_t l2_bytes{0};
+  uint64_t l3_bytes{0};
+};
+
+/// @brief Returns the cache sizes of the CPU, probed once with cpu_features,
+/// or from /sys/devices/system/cpu where cpu_features doesn't report them
+const CacheSizes& GetCacheSizes();
+
+/// @brief Returns the number of bytes a tiled kernel should touch per tile:
+/// half of the L2 cache, or 128 KiB if its size is unknown. Can be set with
+/// the HEXL_TILE_BYTES environment variable
+uint64_t GetTileBytes();
+
+/// @brief Returns the number of elements per tile of a tiled kernel, the
+/// largest power of two whose tile fits into GetTileBytes() bytes, clamped to
+/// [8, \p max_tile_size]
+/// @param[in] bytes_per_element Bytes read or written per element of a tile
+/// @param[in] max_tile_size Maximum number of elements per tile
+uint64_t GetTileSize(uint64_t bytes_per_element, uint64_t max_tile_size);
+
 }  // namespace hexl
 }  // namespace intel
@@ -0,0 +1,63 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "hexl/util/execution-policy.hpp"
+#include "util/thread-pool.hpp"
+
+namespace intel {
+namespace hexl {
+
+/// @brief Calls range_func(begin, end) on disjoint, contiguous sub-ranges
+/// covering [0, size), using at most num_threads threads.
+/// @details Splits [0, size) into one sub-range per thread. Returns once all
+/// sub-ranges have been processed.
+template <typename RangeFunc>
+void ParallelFor(uint64_t size, size_t num_threads, RangeFunc range_func) {
+  num_threads = static_cast<size_t>(
+      std::min<uint64_t>(std::max<size_t>(num_threads, 1), size));
+  if (num_threads <= 1) {
+    if (size > 0) {
+      range_func(uint64_t(0), size);
+    }
+    return;
+  }
+  uint64_t chunk_size = (size + num_threads - 1) / num_threads;
+  ParallelForChunks(size, chunk_size, num_threads, range_func);
+}
+
+/// @brief Calls range_func(begin, end) on disjoint, contiguous sub-ranges
+/// covering [0, size), as selected by policy.
+/// @param[in] elements_per_item Number of elements each of the size items
+/// spans, used to convert the grain size of the policy to items
+/// @details Under a serial policy, or if the work fits into a single grain,
+/// calls range_func(0, size) on the calling thread.
+template <typename RangeFunc>
+void ParallelFor(uint64_t size, const ExecutionPolicy& policy,
+                 RangeFunc range_func, uint64_t elements_per_item = 1) {
+  elements_per_item = std::max<uint64_t>(elements_per_item, 1);
+  // Round to whole cache lines of 64-bit elements, so threads don't write to
+  // the same cache line
+  uint64_t grain_size = (policy.GetGrainSize() + 7) / 8 * 8;
+  uint64_t chunk_size =
+      (grain_size + elements_per_item - 1) / elements_per_item;
+  if (policy.IsSerial() || size <= chunk_size) {
+    if (size > 0) {
+      range_func(uint64_t(0), size);
+    }
+    return;
+  }
+  size_t num_threads = policy.GetNumThreads();
+  if (num_threads == 0) {
+    num_threads = ThreadPool::Instance().NumWorkers() + 1;
+  }
+  ParallelForChunks(size, chunk_size, num_threads, range_func);
+}
+
+}  // namespace hexl
+}  // namespace intel
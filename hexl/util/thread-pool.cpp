@@ -0,0 +1,165 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "util/thread-pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <utility>
+
+#include "hexl/util/check.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+size_t DefaultNumThreads() {
+  if (const char* env = std::getenv("HEXL_NUM_THREADS")) {
+    int64_t num_threads = std::strtoll(env, nullptr, 10);
+    if (num_threads > 0) {
+      return static_cast<size_t>(num_threads);
+    }
+  }
+  return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+// Shared between the threads processing one ParallelForChunks call. Workers
+// which start after all chunks are claimed only touch the counters, so the
+// state is reference-counted rather than owned by the calling thread.
+struct ParallelForState {
+  uint64_t size;
+  uint64_t chunk_size;
+  uint64_t num_chunks;
+  const std::function<void(uint64_t, uint64_t)>* range_func;
+
+  std::atomic<uint64_t> next_chunk{0};
+  std::atomic<uint64_t> remaining_chunks;
+
+  std::mutex mutex;
+  std::condition_variable done;
+  std::exception_ptr exception;
+
+  void RunChunks() {
+    for (;;) {
+      uint64_t chunk = next_chunk.fetch_add(1);
+      if (chunk >= num_chunks) {
+        return;
+      }
+      uint64_t begin = chunk * chunk_size;
+      uint64_t end = std::min(begin + chunk_size, size);
+      try {
+        (*range_func)(begin, end);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!exception) {
+          exception = std::current_exception();
+        }
+      }
+      if (remaining_chunks.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(mutex);
+        done.notify_all();
+      }
+    }
+  }
+};
+
+}  // namespace
+
+ThreadPool& ThreadPool::Instance() {
+  // Intentionally never destroyed, so that no threads are joined during
+  // static destruction
+  static ThreadPool* pool = new ThreadPool(DefaultNumThreads() - 1);
+  return *pool;
+}
+
+ThreadPool::ThreadPool(size_t num_workers) {
+  m_workers.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; ++i) {
+    m_workers.emplace_back([this]() { WorkerLoop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  for (auto& worker : m_workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push_back(std::move(task));
+  }
+  m_cv.notify_one();
+}
+
+void ThreadPool::WorkerLoop() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+      if (m_tasks.empty()) {
+        return;
+      }
+      task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+    }
+    task();
+  }
+}
+
+void ParallelForChunks(
+    uint64_t size, uint64_t chunk_size, size_t num_threads,
+    const std::function<void(uint64_t, uint64_t)>& range_func) {
+  HEXL_CHECK(chunk_size > 0, "Require chunk_size > 0");
+  if (size == 0) {
+    return;
+  }
+  uint64_t num_chunks = (size + chunk_size - 1) / chunk_size;
+
+  size_t num_helpers = 0;
+  if (num_threads > 1 && num_chunks > 1) {
+    ThreadPool& pool = ThreadPool::Instance();
+    num_helpers = static_cast<size_t>(
+        std::min<uint64_t>({num_threads - 1, num_chunks - 1,
+                            static_cast<uint64_t>(pool.NumWorkers())}));
+  }
+  if (num_helpers == 0) {
+    for (uint64_t begin = 0; begin < size; begin += chunk_size) {
+      range_func(begin, std::min(begin + chunk_size, size));
+    }
+    return;
+  }
+
+  auto state = std::make_shared<ParallelForState>();
+  state->size = size;
+  state->chunk_size = chunk_size;
+  state->num_chunks = num_chunks;
+  state->range_func = &range_func;
+  state->remaining_chunks = num_chunks;
+
+  ThreadPool& pool = ThreadPool::Instance();
+  for (size_t i = 0; i < num_helpers; ++i) {
+    pool.Submit([state]() { state->RunChunks(); });
+  }
+  state->RunChunks();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done.wait(lock, [&]() { return state->remaining_chunks == 0; });
+  if (state->exception) {
+    std::rethrow_exception(state->exception);
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
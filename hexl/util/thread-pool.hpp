@@ -0,0 +1,67 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace intel {
+namespace hexl {
+
+/// @brief Fixed-size pool of worker threads
+/// @details Tasks run in submission order on whichever worker becomes idle
+/// first.
+class ThreadPool {
+ public:
+  /// @brief Returns the library thread pool, starting it on first use. The
+  /// pool has one fewer worker than the number of hardware threads, or than
+  /// the HEXL_NUM_THREADS environment variable if set, since the calling
+  /// thread also runs tasks in ParallelForChunks.
+  static ThreadPool& Instance();
+
+  /// @brief Starts \p num_workers worker threads
+  explicit ThreadPool(size_t num_workers);
+
+  /// @brief Finishes the queued tasks and joins the worker threads
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// @brief Returns the number of worker threads
+  size_t NumWorkers() const { return m_workers.size(); }
+
+  /// @brief Queues \p task to run on a worker thread
+  void Submit(std::function<void()> task);
+
+ private:
+  void WorkerLoop();
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<std::function<void()>> m_tasks;
+  bool m_stop{false};
+  std::vector<std::thread> m_workers;
+};
+
+/// @brief Calls range_func(begin, end) on consecutive chunks of \p chunk_size
+/// elements covering [0, size), using the calling thread and up to
+/// num_threads - 1 workers of the library thread pool.
+/// @details Each thread repeatedly claims the next unprocessed chunk, so
+/// threads which finish early take over the remaining work. Since the calling
+/// thread claims chunks too, the call completes even if no worker is free,
+/// e.g. when nested within another ParallelForChunks. Returns once all chunks
+/// are processed, rethrowing the first exception thrown by \p range_func.
+void ParallelForChunks(
+    uint64_t size, uint64_t chunk_size, size_t num_threads,
+    const std::function<void(uint64_t, uint64_t)>& range_func);
+
+}  // namespace hexl
+}  // namespace intel
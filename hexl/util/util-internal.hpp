@@ -49,8 +49,8 @@ inline double GenerateInsecureUniformRealRandomValue(double min_value,
                                                      double max_value) {
   HEXL_CHECK(min_value < max_value, "min_value must be > max_value");
 
-  static std::random_device rd;
-  static std::mt19937 mersenne_engine(rd());
+  // Per thread, as NTTs may be created concurrently
+  static thread_local std::mt19937 mersenne_engine(std::random_device{}());
   std::uniform_real_distribution<double> distrib(min_value, max_value);
   double res = distrib(mersenne_engine);
   return (res == max_value) ? min_value : res;
@@ -64,8 +64,8 @@ inline uint64_t GenerateInsecureUniformIntRandomValue(uint64_t min_value,
                                                       uint64_t max_value) {
   HEXL_CHECK(min_value < max_value, "min_value must be > max_value");
 
-  static std::random_device rd;
-  static std::mt19937 mersenne_engine(rd());
+  // Per thread, as NTTs may be created concurrently
+  static thread_local std::mt19937 mersenne_engine(std::random_device{}());
   std::uniform_int_distribution<uint64_t> distrib(min_value, max_value - 1);
   return distrib(mersenne_engine);
 }
@@ -0,0 +1,65 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <vector>
+
+#include "hexl/experimental/fft-like/fft-like-avx2.hpp"
+#include "hexl/experimental/fft-like/fft-like-native.hpp"
+#include "hexl/util/defines.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+
+// The AVX2 conversion is bit-exact with the native one, also for coefficients
+// equal to the threshold or with more words than 2^(64 j) can scale
+TEST(FFTLike, BuildFloatingPointsAVX2) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+  const double inv_scale = 1.0 / static_cast<double>(1ULL << 40);
+  for (size_t mod_size : {1, 2, 3, 18}) {
+    std::vector<uint64_t> decryption_modulus(mod_size);
+    std::vector<uint64_t> threshold(mod_size);
+    for (size_t j = 0; j < mod_size; ++j) {
+      decryption_modulus[j] = 0xF0F0F0F0F0F0F0F1ULL - j;
+      threshold[j] = decryption_modulus[j] >> 1;
+    }
+
+    const size_t coeff_count = 61;
+    std::vector<uint64_t> plain(coeff_count * mod_size);
+    for (size_t i = 0; i < coeff_count; ++i) {
+      uint64_t* coeff = &plain[i * mod_size];
+      auto words = GenerateInsecureUniformIntRandomValues(mod_size, 0,
+                                                          0xFFFFFFFFFFFFFFFF);
+      std::copy(words.begin(), words.end(), coeff);
+      coeff[mod_size - 1] %= decryption_modulus[mod_size - 1];
+      if (i % 7 == 0) {
+        std::copy(threshold.begin(), threshold.end(), coeff);
+      } else if (i % 11 == 0) {
+        std::fill(coeff, coeff + mod_size, 0);
+      }
+    }
+
+    std::vector<std::complex<double>> expected(coeff_count);
+    std::vector<std::complex<double>> result(coeff_count);
+    BuildFloatingPointsNative(expected.data(), plain.data(), threshold.data(),
+                              decryption_modulus.data(), inv_scale, mod_size,
+                              coeff_count);
+    BuildFloatingPointsAVX2(result.data(), plain.data(), threshold.data(),
+                            decryption_modulus.data(), inv_scale, mod_size,
+                            coeff_count);
+    ASSERT_EQ(result, expected);
+  }
+}
+
+#endif  // HEXL_HAS_AVX256
+
+}  // namespace hexl
+}  // namespace intel
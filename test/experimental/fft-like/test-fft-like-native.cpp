@@ -191,5 +191,127 @@ TEST(FFTLike, ForwardInverseFFTLikeNative) {
   }
 }
 
+TEST(FFTLike, BuildFloatingPointsNative) {
+  {
+    const uint64_t poly_mod_degree = 16;
+    const uint64_t coeff_mod_size = 4;
+    const double scale = 1099511627776;  // (1 << 40)
+    const double inv_scale = 1.0 / scale;
+
+    std::vector<std::complex<double>> result(poly_mod_degree);
+
+    std::vector<std::complex<double>> expected{{469095144.125, 0},
+                                               {32109980.057216156, 0},
+                                               {133969900.94656014, 0},
+                                               {1327830.7073135898, 0},
+                                               {-72732310.45981437, 0},
+                                               {-55123198.89089907, 0},
+                                               {-130250344.32255825, 0},
+                                               {66152794.724299073, 0},
+                                               {0, 0},
+                                               {-66152794.724299081, 0},
+                                               {130250344.32255828, 0},
+                                               {55123198.89089907, 0},
+                                               {72732310.459814355, 0},
+                                               {-1327830.7073136102, 0},
+                                               {-133969900.94656017, 0},
+                                               {-32109980.05721616, 0}};
+
+    const uint64_t operand[] = {17713475508538179584ULL,
+                                27,
+                                0,
+                                0,
+                                16858552366855081984ULL,
+                                1,
+                                0,
+                                0,
+                                18174255346774966272ULL,
+                                7,
+                                0,
+                                0,
+                                1459965302409322496ULL,
+                                0,
+                                0,
+                                0,
+                                10852157353743343297ULL,
+                                72057091796482622ULL,
+                                0,
+                                0,
+                                11766836204861046465ULL,
+                                72057091796482623ULL,
+                                0,
+                                0,
+                                2950642535971380929ULL,
+                                72057091796482619ULL,
+                                0,
+                                0,
+                                17395534788117004288ULL,
+                                3,
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                18086411410077564609ULL,
+                                72057091796482622ULL,
+                                0,
+                                0,
+                                14084559588513677312ULL,
+                                7,
+                                0,
+                                0,
+                                5268365919623979008ULL,
+                                3,
+                                0,
+                                0,
+                                6183044770741665792ULL,
+                                4,
+                                0,
+                                0,
+                                15575236822075680449ULL,
+                                72057091796482626ULL,
+                                0,
+                                0,
+                                17307690851419578049ULL,
+                                72057091796482618ULL,
+                                0,
+                                0,
+                                176649757629939393ULL,
+                                72057091796482625ULL,
+                                0,
+                                0};
+
+    const uint64_t upper_half_threshold[] = {8517601062242512737ULL,
+                                             36028545898241313ULL, 0, 0};
+    const uint64_t decryption_modulus[] = {17035202124485025473ULL,
+                                           72057091796482626ULL, 0, 0};
+
+    BuildFloatingPointsNative(result.data(), operand, upper_half_threshold,
+                              decryption_modulus, inv_scale, coeff_mod_size,
+                              poly_mod_degree);
+
+    for (size_t i = 0; i < poly_mod_degree; ++i) {
+      CheckClose(result[i], expected[i], 1e-6);
+    }
+  }
+  {
+    // Decryption modulus 2^64 + 5; the negative values borrow across words
+    const uint64_t decryption_modulus[] = {5, 1};
+    const uint64_t upper_half_threshold[] = {(1ULL << 63) + 3, 0};
+    const uint64_t operand[] = {7, 0, 2, 1, (1ULL << 63) + 3, 0, 0, 0};
+    std::vector<std::complex<double>> result(4);
+
+    BuildFloatingPointsNative(result.data(), operand, upper_half_threshold,
+                              decryption_modulus, 0.5, 2, 4);
+
+    EXPECT_EQ(result[0], std::complex<double>(3.5, 0));
+    EXPECT_EQ(result[1], std::complex<double>(-1.5, 0));
+    EXPECT_EQ(result[2],
+              std::complex<double>(-static_cast<double>(1ULL << 62) - 1, 0));
+    EXPECT_EQ(result[3], std::complex<double>(0, 0));
+  }
+}
+
 }  // namespace hexl
 }  // namespace intel
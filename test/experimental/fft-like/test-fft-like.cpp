@@ -3,12 +3,18 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
+#include "hexl/experimental/fft-like/fft-like-native.hpp"
 #include "hexl/experimental/fft-like/fft-like.hpp"
+#include "hexl/experimental/fft-like/fwd-fft-like-avx512.hpp"
+#include "hexl/experimental/fft-like/inv-fft-like-avx512.hpp"
 #include "hexl/logging/logging.hpp"
 #include "hexl/util/defines.hpp"
 #include "ntt/ntt-internal.hpp"
 #include "test/test-util.hpp"
 #include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
@@ -171,5 +177,167 @@ TEST(FFTLike, fft_like_with_allocator) {
   CheckClose(exp_out, input4, 0.5);
 }
 
+// Serial, parallel and native conversions agree, also for coefficient counts
+// which are not a multiple of 8
+TEST(FFTLike, BuildFloatingPointsParallel) {
+  const uint64_t coeff_mod_size = 3;
+  const double inv_scale = 1.0 / static_cast<double>(1ULL << 40);
+  const uint64_t decryption_modulus[] = {17035202124485025473ULL,
+                                         17035202124485025473ULL,
+                                         72057091796482626ULL};
+  const uint64_t upper_half_threshold[] = {8517601062242512737ULL,
+                                           8517601062242512737ULL,
+                                           36028545898241313ULL};
+  FFTLike fft_like(1024, nullptr);
+
+  for (uint64_t coeff_count : {1024, 100}) {
+    std::vector<uint64_t> plain(coeff_count * coeff_mod_size);
+    for (size_t i = 0; i < coeff_count; ++i) {
+      auto words = GenerateInsecureUniformIntRandomValues(
+          coeff_mod_size, 0, 0xFFFFFFFFFFFFFFFF);
+      words[coeff_mod_size - 1] %= decryption_modulus[coeff_mod_size - 1];
+      std::copy(words.begin(), words.end(), &plain[i * coeff_mod_size]);
+    }
+
+    std::vector<std::complex<double>> expected(coeff_count);
+    std::vector<std::complex<double>> native(coeff_count);
+    std::vector<std::complex<double>> result(coeff_count);
+    fft_like.BuildFloatingPoints(expected.data(), plain.data(),
+                                 upper_half_threshold, decryption_modulus,
+                                 inv_scale, coeff_mod_size, coeff_count);
+    fft_like.BuildFloatingPoints(result.data(), plain.data(),
+                                 upper_half_threshold, decryption_modulus,
+                                 inv_scale, coeff_mod_size, coeff_count,
+                                 ExecutionPolicy::Parallel(64, 4));
+    ASSERT_EQ(result, expected);
+
+    BuildFloatingPointsNative(native.data(), plain.data(),
+                              upper_half_threshold, decryption_modulus,
+                              inv_scale, coeff_mod_size, coeff_count);
+    for (size_t i = 0; i < coeff_count; ++i) {
+      // Relative error of the conversion of values up to 2^130
+      CheckClose(native[i], expected[i],
+                 std::max(1.0, std::abs(expected[i].real())) * 1e-12);
+    }
+  }
+}
+
+namespace {
+
+std::vector<std::complex<double>> RandomComplexValues(uint64_t size) {
+  std::vector<std::complex<double>> values(size);
+  auto real = GenerateInsecureUniformRealRandomValues(size, -10.0, 10.0);
+  auto imag = GenerateInsecureUniformRealRandomValues(size, -10.0, 10.0);
+  for (size_t i = 0; i < size; ++i) {
+    values[i] = std::complex<double>(real[i], imag[i]);
+  }
+  return values;
+}
+
+}  // namespace
+
+// Batched transforms match the transforms of the individual vectors
+TEST(FFTLike, ForwardInverseBatch) {
+  const double scale = 1.0 / 3.0;
+  for (uint64_t n : {16, 256}) {
+    FFTLike fft_like(n, nullptr);
+    for (uint64_t batch_size : {1, 7, 32}) {
+      auto operand = RandomComplexValues(n * batch_size);
+
+      for (const double* in_scale : {static_cast<const double*>(nullptr),
+                                     &scale}) {
+        std::vector<std::complex<double>> forward(n * batch_size);
+        std::vector<std::complex<double>> inverse(operand);
+        fft_like.ComputeForwardFFTLikeBatch(forward.data(), operand.data(),
+                                            batch_size, in_scale);
+        fft_like.ComputeInverseFFTLikeBatch(inverse.data(), inverse.data(),
+                                            batch_size, in_scale);
+
+        for (uint64_t b = 0; b < batch_size; ++b) {
+          std::vector<std::complex<double>> vector(n);
+          for (uint64_t k = 0; k < n; ++k) {
+            vector[k] = operand[k * batch_size + b];
+          }
+          std::vector<std::complex<double>> expected_forward(n);
+          std::vector<std::complex<double>> expected_inverse(n);
+          Forward_FFTLike_ToBitReverseRadix2(
+              expected_forward.data(), vector.data(),
+              fft_like.GetComplexRootsOfUnity().data(), n, in_scale);
+          Inverse_FFTLike_FromBitReverseRadix2(
+              expected_inverse.data(), vector.data(),
+              fft_like.GetInvComplexRootsOfUnity().data(), n, in_scale);
+          for (uint64_t k = 0; k < n; ++k) {
+            CheckClose(forward[k * batch_size + b], expected_forward[k],
+                       1e-10);
+            CheckClose(inverse[k * batch_size + b], expected_inverse[k],
+                       1e-10);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(FFTLike, ForwardInverseBatchParallel) {
+  uint64_t n = 1024;
+  uint64_t batch_size = 37;
+  FFTLike fft_like(n, nullptr);
+  auto operand = RandomComplexValues(n * batch_size);
+
+  std::vector<std::complex<double>> expected(n * batch_size);
+  std::vector<std::complex<double>> result(n * batch_size);
+  fft_like.ComputeForwardFFTLikeBatch(expected.data(), operand.data(),
+                                      batch_size);
+  fft_like.ComputeForwardFFTLikeBatch(result.data(), operand.data(),
+                                      batch_size, nullptr,
+                                      ExecutionPolicy::Parallel(64, 4));
+  ASSERT_EQ(result, expected);
+
+  fft_like.ComputeInverseFFTLikeBatch(expected.data(), operand.data(),
+                                      batch_size);
+  fft_like.ComputeInverseFFTLikeBatch(result.data(), operand.data(),
+                                      batch_size, nullptr,
+                                      ExecutionPolicy::Parallel(64, 4));
+  ASSERT_EQ(result, expected);
+}
+
+#ifdef HEXL_HAS_AVX512DQ
+TEST(FFTLike, ForwardInverseBatchAVX512) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+
+  uint64_t n = 64;
+  uint64_t batch_size = 13;
+  double scale = 0.25;
+  FFTLike fft_like(n, nullptr);
+  auto operand = RandomComplexValues(n * batch_size);
+
+  std::vector<std::complex<double>> expected(n * batch_size);
+  std::vector<std::complex<double>> result(n * batch_size);
+  Forward_FFTLike_ToBitReverseBatchRadix2(
+      expected.data(), operand.data(), fft_like.GetComplexRootsOfUnity().data(),
+      n, batch_size, batch_size, &scale);
+  Forward_FFTLike_ToBitReverseBatchAVX512(
+      result.data(), operand.data(), fft_like.GetComplexRootsOfUnity().data(),
+      n, batch_size, batch_size, &scale);
+  for (size_t i = 0; i < result.size(); ++i) {
+    CheckClose(result[i], expected[i], 1e-10);
+  }
+
+  Inverse_FFTLike_FromBitReverseBatchRadix2(
+      expected.data(), operand.data(),
+      fft_like.GetInvComplexRootsOfUnity().data(), n, batch_size, batch_size,
+      &scale);
+  Inverse_FFTLike_FromBitReverseBatchAVX512(
+      result.data(), operand.data(),
+      fft_like.GetInvComplexRootsOfUnity().data(), n, batch_size, batch_size,
+      &scale);
+  for (size_t i = 0; i < result.size(); ++i) {
+    CheckClose(result[i], expected[i], 1e-10);
+  }
+}
+#endif
+
 }  // namespace hexl
 }  // namespace intel
@@ -9,6 +9,7 @@
 #include "hexl/logging/logging.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "test/test-util.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
@@ -57,5 +58,119 @@ TEST(LinRegMatrixVectorMultiply, small_one_mod) {
   CheckEqual(out, exp_out);
 }
 
+// With a number of weights that is not a power of two, the adder tree must
+// not read past the last ciphertext
+TEST(LinRegMatrixVectorMultiply, three_weights) {
+  uint64_t n = 8;
+  size_t num_weights = 3;
+  std::vector<uint64_t> moduli{97, 101};
+  uint64_t poly_size = n * moduli.size();
+  uint64_t cipher_size = 2 * poly_size;
+  uint64_t output_size = 3 * poly_size;
+
+  std::vector<uint64_t> op1(num_weights * cipher_size);
+  std::vector<uint64_t> op2(num_weights * cipher_size);
+  for (size_t k = 0; k < op1.size(); ++k) {
+    op1[k] = (3 * k + 1) % 97;
+    op2[k] = (5 * k + 2) % 97;
+  }
+
+  // Sum of the single-weight results
+  std::vector<uint64_t> expected(output_size, 0);
+  std::vector<uint64_t> single(output_size);
+  for (size_t r = 0; r < num_weights; ++r) {
+    LinRegMatrixVectorMultiply(single.data(), &op1[r * cipher_size],
+                               &op2[r * cipher_size], n, moduli.data(),
+                               moduli.size(), 1);
+    for (size_t k = 0; k < output_size; ++k) {
+      uint64_t modulus = moduli[(k % poly_size) / n];
+      expected[k] = (expected[k] + single[k]) % modulus;
+    }
+  }
+
+  // Poison the output of the weight past the end, which the adder tree used
+  // to add to the last ciphertext
+  std::vector<uint64_t> out((num_weights + 1) * output_size, 1);
+  LinRegMatrixVectorMultiply(out.data(), op1.data(), op2.data(), n,
+                             moduli.data(), moduli.size(), num_weights);
+  out.resize(output_size);
+  CheckEqual(out, expected);
+}
+
+// Checks splitting across threads matches the serial result
+TEST(LinRegMatrixVectorMultiply, parallel) {
+  uint64_t n = 64;
+  size_t num_weights = 5;
+  std::vector<uint64_t> moduli = GeneratePrimes(2, 50, true, n);
+  uint64_t poly_size = n * moduli.size();
+
+  std::vector<uint64_t> op1(num_weights * 2 * poly_size);
+  std::vector<uint64_t> op2(num_weights * 2 * poly_size);
+  for (size_t poly = 0; poly < 2 * num_weights; ++poly) {
+    for (size_t i = 0; i < moduli.size(); ++i) {
+      uint64_t offset = poly * poly_size + i * n;
+      auto values1 = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      auto values2 = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      std::copy(values1.begin(), values1.end(), op1.begin() + offset);
+      std::copy(values2.begin(), values2.end(), op2.begin() + offset);
+    }
+  }
+
+  std::vector<uint64_t> expected(num_weights * 3 * poly_size);
+  std::vector<uint64_t> result(num_weights * 3 * poly_size);
+  LinRegMatrixVectorMultiply(expected.data(), op1.data(), op2.data(), n,
+                             moduli.data(), moduli.size(), num_weights);
+  LinRegMatrixVectorMultiply(result.data(), op1.data(), op2.data(), n,
+                             moduli.data(), moduli.size(), num_weights,
+                             ExecutionPolicy::Parallel(n, 4));
+  ASSERT_EQ(result, expected);
+}
+
+// Checks the streaming kernel against the products summed with the adder tree
+TEST(LinRegMatrixVectorMultiply, streaming) {
+  uint64_t n = 203;
+  // 40 weights overflow the 128-bit accumulators of 62-bit moduli, and 2100
+  // weights those of the AVX512-IFMA kernels
+  for (size_t num_weights : {1, 3, 40, 2100}) {
+    for (uint64_t bits : {20, 50, 62}) {
+      std::vector<uint64_t> moduli = GeneratePrimes(2, bits, true, 1024);
+      uint64_t poly_size = n * moduli.size();
+
+      std::vector<uint64_t> op1(num_weights * 2 * poly_size);
+      std::vector<uint64_t> op2(num_weights * 2 * poly_size);
+      for (size_t poly = 0; poly < 2 * num_weights; ++poly) {
+        for (size_t i = 0; i < moduli.size(); ++i) {
+          uint64_t offset = poly * poly_size + i * n;
+          auto values1 =
+              GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+          auto values2 =
+              GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+          values1[0] = moduli[i] - 1;
+          values2[0] = moduli[i] - 1;
+          std::copy(values1.begin(), values1.end(), op1.begin() + offset);
+          std::copy(values2.begin(), values2.end(), op2.begin() + offset);
+        }
+      }
+
+      std::vector<uint64_t> expected(num_weights * 3 * poly_size);
+      LinRegMatrixVectorMultiply(expected.data(), op1.data(), op2.data(), n,
+                                 moduli.data(), moduli.size(), num_weights);
+      expected.resize(3 * poly_size);
+
+      std::vector<uint64_t> result(3 * poly_size);
+      LinRegMatrixVectorMultiplyStreaming(result.data(), op1.data(),
+                                          op2.data(), n, moduli.data(),
+                                          moduli.size(), num_weights);
+      ASSERT_EQ(result, expected);
+
+      std::fill(result.begin(), result.end(), 0);
+      LinRegMatrixVectorMultiplyStreaming(
+          result.data(), op1.data(), op2.data(), n, moduli.data(),
+          moduli.size(), num_weights, ExecutionPolicy::Parallel(8, 4));
+      ASSERT_EQ(result, expected);
+    }
+  }
+}
+
 }  // namespace hexl
 }  // namespace intel
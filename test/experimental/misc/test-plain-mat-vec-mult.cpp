@@ -0,0 +1,171 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "hexl/eltwise/eltwise-add-mod.hpp"
+#include "hexl/eltwise/eltwise-apply-galois.hpp"
+#include "hexl/eltwise/eltwise-mult-mod.hpp"
+#include "hexl/experimental/misc/plain-mat-vec-mult.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Random polynomials in NTT form, each of n values per modulus
+std::vector<uint64_t> RandomPolys(uint64_t num_polys, uint64_t n,
+                                  const std::vector<uint64_t>& moduli) {
+  std::vector<uint64_t> polys(num_polys * n * moduli.size());
+  for (size_t poly = 0; poly < num_polys; ++poly) {
+    for (size_t i = 0; i < moduli.size(); ++i) {
+      auto values = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      values[0] = moduli[i] - 1;
+      std::copy(values.begin(), values.end(),
+                polys.begin() + (poly * moduli.size() + i) * n);
+    }
+  }
+  return polys;
+}
+
+// Rotates the slots of the ciphertext by step, with the Galois element 3^step
+// of the automorphism, which has order n / 2
+std::vector<uint64_t> Rotate(const std::vector<uint64_t>& cipher, uint64_t n,
+                             int64_t step) {
+  const int64_t order = static_cast<int64_t>(n / 2);
+  uint64_t galois_elt =
+      PowMod(3, static_cast<uint64_t>(((step % order) + order) % order), 2 * n);
+  std::vector<uint64_t> rotated(cipher.size());
+  for (size_t offset = 0; offset < cipher.size(); offset += n) {
+    EltwiseApplyGaloisNTT(&rotated[offset], &cipher[offset], n, galois_elt);
+  }
+  return rotated;
+}
+
+// Sets acc += diagonal * cipher, one residue polynomial at a time
+void MultiplyAdd(std::vector<uint64_t>* acc, const uint64_t* diagonal,
+                 const std::vector<uint64_t>& cipher, uint64_t n,
+                 const std::vector<uint64_t>& moduli) {
+  uint64_t poly_size = n * moduli.size();
+  std::vector<uint64_t> product(n);
+  for (size_t offset = 0; offset < cipher.size(); offset += n) {
+    size_t i = (offset % poly_size) / n;
+    EltwiseMultMod(product.data(), &diagonal[offset % poly_size],
+                   &cipher[offset], n, moduli[i], 1);
+    EltwiseAddMod(&(*acc)[offset], &(*acc)[offset], product.data(), n,
+                  moduli[i]);
+  }
+}
+
+}  // namespace
+
+// Checks sum_i d_i * rot_i(v) against products summed one at a time
+TEST(PlainMatrixVectorMultiply, diagonal) {
+  uint64_t n = 64;
+  uint64_t ciphertext_size = 2;
+  // 40 diagonals overflow the 128-bit accumulators of 62-bit moduli
+  for (uint64_t num_diagonals : {1, 5, 40}) {
+    for (uint64_t bits : {30, 50, 62}) {
+      std::vector<uint64_t> moduli = GeneratePrimes(2, bits, true, n);
+      uint64_t poly_size = n * moduli.size();
+
+      auto diagonals = RandomPolys(num_diagonals, n, moduli);
+      auto cipher = RandomPolys(ciphertext_size, n, moduli);
+      std::vector<std::vector<uint64_t>> rotated;
+      std::vector<const uint64_t*> rotated_ptrs;
+      for (uint64_t d = 0; d < num_diagonals; ++d) {
+        rotated.push_back(Rotate(cipher, n, static_cast<int64_t>(d)));
+      }
+      std::vector<uint64_t> expected(ciphertext_size * poly_size);
+      for (uint64_t d = 0; d < num_diagonals; ++d) {
+        rotated_ptrs.push_back(rotated[d].data());
+        MultiplyAdd(&expected, &diagonals[d * poly_size], rotated[d], n,
+                    moduli);
+      }
+
+      std::vector<uint64_t> result(ciphertext_size * poly_size);
+      PlainMatrixVectorMultiplyDiagonal(
+          result.data(), diagonals.data(), rotated_ptrs.data(), n,
+          moduli.data(), moduli.size(), ciphertext_size, num_diagonals);
+      ASSERT_EQ(result, expected);
+
+      std::fill(result.begin(), result.end(), 0);
+      PlainMatrixVectorMultiplyDiagonal(
+          result.data(), diagonals.data(), rotated_ptrs.data(), n,
+          moduli.data(), moduli.size(), ciphertext_size, num_diagonals,
+          ExecutionPolicy::Parallel(8, 4));
+      ASSERT_EQ(result, expected);
+    }
+  }
+}
+
+// Checks the baby-step giant-step sums, rotated back and added up, match the
+// diagonal method
+TEST(PlainMatrixVectorMultiply, bsgs) {
+  uint64_t n = 64;
+  uint64_t ciphertext_size = 2;
+  uint64_t baby_steps = 4;
+  uint64_t giant_steps = 3;
+  uint64_t num_diagonals = baby_steps * giant_steps;
+  std::vector<uint64_t> moduli = GeneratePrimes(3, 50, true, n);
+  uint64_t poly_size = n * moduli.size();
+
+  auto diagonals = RandomPolys(num_diagonals, n, moduli);
+  auto cipher = RandomPolys(ciphertext_size, n, moduli);
+  std::vector<std::vector<uint64_t>> rotated;
+  std::vector<const uint64_t*> rotated_ptrs;
+  for (uint64_t d = 0; d < num_diagonals; ++d) {
+    rotated.push_back(Rotate(cipher, n, static_cast<int64_t>(d)));
+  }
+  for (uint64_t d = 0; d < num_diagonals; ++d) {
+    rotated_ptrs.push_back(rotated[d].data());
+  }
+  std::vector<uint64_t> expected(ciphertext_size * poly_size);
+  PlainMatrixVectorMultiplyDiagonal(expected.data(), diagonals.data(),
+                                    rotated_ptrs.data(), n, moduli.data(),
+                                    moduli.size(), ciphertext_size,
+                                    num_diagonals);
+
+  // Galois elements of the rotations by -j * baby_steps slots
+  std::vector<uint64_t> galois_elts;
+  for (uint64_t j = 0; j < giant_steps; ++j) {
+    uint64_t step = (n / 2 - (j * baby_steps) % (n / 2)) % (n / 2);
+    galois_elts.push_back(PowMod(3, step, 2 * n));
+  }
+  std::vector<uint64_t> rotated_diagonals(diagonals.size());
+  RotateDiagonalsBSGS(rotated_diagonals.data(), diagonals.data(), n,
+                      moduli.size(), baby_steps, giant_steps,
+                      galois_elts.data());
+
+  for (auto policy :
+       {ExecutionPolicy::Serial(), ExecutionPolicy::Parallel(8, 4)}) {
+    std::vector<uint64_t> sums(giant_steps * ciphertext_size * poly_size);
+    PlainMatrixVectorMultiplyBSGS(sums.data(), rotated_diagonals.data(),
+                                  rotated_ptrs.data(), n, moduli.data(),
+                                  moduli.size(), ciphertext_size, baby_steps,
+                                  giant_steps, policy);
+
+    std::vector<uint64_t> result(ciphertext_size * poly_size);
+    for (uint64_t j = 0; j < giant_steps; ++j) {
+      std::vector<uint64_t> sum(
+          sums.begin() + j * ciphertext_size * poly_size,
+          sums.begin() + (j + 1) * ciphertext_size * poly_size);
+      auto sum_rotated =
+          Rotate(sum, n, static_cast<int64_t>(j * baby_steps));
+      for (size_t offset = 0; offset < result.size(); offset += n) {
+        uint64_t modulus = moduli[(offset % poly_size) / n];
+        EltwiseAddMod(&result[offset], &result[offset], &sum_rotated[offset],
+                      n, modulus);
+      }
+    }
+    ASSERT_EQ(result, expected);
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
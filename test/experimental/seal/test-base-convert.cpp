@@ -0,0 +1,184 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "experimental/seal/base-convert-internal.hpp"
+#include "hexl/experimental/seal/base-convert.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/defines.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Returns Q / q_i mod modulus
+uint64_t QHatMod(const std::vector<uint64_t>& from_moduli, size_t i,
+                 uint64_t modulus) {
+  uint64_t q_hat = 1 % modulus;
+  for (size_t m = 0; m < from_moduli.size(); ++m) {
+    if (m != i) {
+      q_hat = MultiplyMod(q_hat, from_moduli[m] % modulus, modulus);
+    }
+  }
+  return q_hat;
+}
+
+std::vector<uint64_t> ReferenceFastBaseConvert(
+    const std::vector<uint64_t>& operand,
+    const std::vector<uint64_t>& from_moduli,
+    const std::vector<uint64_t>& to_moduli, uint64_t n) {
+  std::vector<uint64_t> result(to_moduli.size() * n, 0);
+  for (size_t j = 0; j < to_moduli.size(); ++j) {
+    uint64_t p = to_moduli[j];
+    for (size_t i = 0; i < from_moduli.size(); ++i) {
+      uint64_t q = from_moduli[i];
+      uint64_t q_hat_inv = InverseMod(QHatMod(from_moduli, i, q), q);
+      uint64_t q_hat_mod_p = QHatMod(from_moduli, i, p);
+      for (size_t m = 0; m < n; ++m) {
+        uint64_t scaled = MultiplyMod(operand[i * n + m], q_hat_inv, q);
+        result[j * n + m] =
+            AddUIntMod(result[j * n + m],
+                       MultiplyMod(scaled % p, q_hat_mod_p, p), p);
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<uint64_t> RandomRNSOperand(const std::vector<uint64_t>& moduli,
+                                       uint64_t n) {
+  std::vector<uint64_t> operand;
+  for (uint64_t modulus : moduli) {
+    auto residues = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+    operand.insert(operand.end(), residues.begin(), residues.end());
+  }
+  return operand;
+}
+
+}  // namespace
+
+// With a single input modulus, the conversion is exact
+TEST(BaseConverter, single_modulus) {
+  std::vector<uint64_t> operand{0, 1, 2, 3, 100, 768, 767, 500};
+  std::vector<uint64_t> to_moduli{17, 97, 1153};
+  uint64_t n = operand.size();
+
+  std::vector<uint64_t> result(to_moduli.size() * n);
+  FastBaseConvert(result.data(), operand.data(), {769}, to_moduli, n);
+  for (size_t j = 0; j < to_moduli.size(); ++j) {
+    for (size_t m = 0; m < n; ++m) {
+      ASSERT_EQ(result[j * n + m], operand[m] % to_moduli[j]);
+    }
+  }
+}
+
+// The result is congruent to x + a * Q for some 0 <= a < k
+TEST(BaseConverter, exact_up_to_multiple_of_q) {
+  uint64_t n = 64;
+  std::vector<uint64_t> from_moduli = GeneratePrimes(2, 30, true, n);
+  std::vector<uint64_t> to_moduli = GeneratePrimes(2, 60, true, n);
+  uint64_t q = from_moduli[0] * from_moduli[1];
+
+  auto x = GenerateInsecureUniformIntRandomValues(n, 0, q);
+  std::vector<uint64_t> operand;
+  for (uint64_t modulus : from_moduli) {
+    for (uint64_t value : x) {
+      operand.push_back(value % modulus);
+    }
+  }
+
+  std::vector<uint64_t> result(to_moduli.size() * n);
+  BaseConverter converter(from_moduli, to_moduli);
+  converter.FastBaseConvert(result.data(), operand.data(), n);
+  for (size_t j = 0; j < to_moduli.size(); ++j) {
+    uint64_t p = to_moduli[j];
+    for (size_t m = 0; m < n; ++m) {
+      uint64_t x_mod_p = x[m] % p;
+      uint64_t x_plus_q_mod_p = AddUIntMod(x_mod_p, q % p, p);
+      EXPECT_TRUE(result[j * n + m] == x_mod_p ||
+                  result[j * n + m] == x_plus_q_mod_p);
+    }
+  }
+}
+
+TEST(BaseConverter, random) {
+  for (uint64_t bits : {20, 40, 50, 60}) {
+    for (uint64_t n : {1, 7, 100, 1024, 4096}) {
+      std::vector<uint64_t> from_moduli = GeneratePrimes(5, bits, true, 1024);
+      std::vector<uint64_t> to_moduli = GeneratePrimes(3, 45, true, 1024);
+      auto operand = RandomRNSOperand(from_moduli, n);
+      auto expected =
+          ReferenceFastBaseConvert(operand, from_moduli, to_moduli, n);
+
+      BaseConverter converter(from_moduli, to_moduli);
+      std::vector<uint64_t> result(to_moduli.size() * n);
+      converter.FastBaseConvert(result.data(), operand.data(), n);
+      ASSERT_EQ(result, expected);
+
+      std::vector<uint64_t> parallel_result(to_moduli.size() * n);
+      converter.FastBaseConvert(parallel_result.data(), operand.data(), n,
+                                ExecutionPolicy::Parallel(64));
+      ASSERT_EQ(parallel_result, expected);
+    }
+  }
+}
+
+// Many moduli, requiring intermediate reductions of the 128-bit sums
+TEST(BaseConverter, many_moduli) {
+  uint64_t n = 40;
+  std::vector<uint64_t> from_moduli = GeneratePrimes(40, 60, true, 1024);
+  std::vector<uint64_t> to_moduli = GeneratePrimes(2, 60, false, 1024);
+  auto operand = RandomRNSOperand(from_moduli, n);
+
+  std::vector<uint64_t> result(to_moduli.size() * n);
+  FastBaseConvert(result.data(), operand.data(), from_moduli, to_moduli, n);
+  ASSERT_EQ(result,
+            ReferenceFastBaseConvert(operand, from_moduli, to_moduli, n));
+}
+
+#ifdef HEXL_HAS_AVX512IFMA
+TEST(BaseConverter, AVX512IFMA) {
+  if (!has_avx512ifma) {
+    GTEST_SKIP();
+  }
+
+  for (uint64_t num_from_moduli : {1, 3, 200}) {
+    uint64_t n = 203;
+    std::vector<uint64_t> from_moduli =
+        GeneratePrimes(num_from_moduli, 50, true, 1024);
+    std::vector<uint64_t> to_moduli = GeneratePrimes(3, 49, true, 1024);
+    BaseConverter converter(from_moduli, to_moduli);
+    const std::vector<uint64_t>& q_hat_mod_p = converter.GetQHatModP();
+    std::vector<uint64_t> q_hat_mod_p_precon52;
+    for (size_t t = 0; t < q_hat_mod_p.size(); ++t) {
+      uint64_t p = to_moduli[t / num_from_moduli];
+      q_hat_mod_p_precon52.push_back(
+          MultiplyFactor(q_hat_mod_p[t], 52, p).BarrettFactor());
+    }
+
+    // Scaled operands in [0, 2^52)
+    auto scaled_operand = GenerateInsecureUniformIntRandomValues(
+        num_from_moduli * n, 0, 1ULL << 52);
+    std::vector<uint64_t> result(to_moduli.size() * n);
+    std::vector<uint64_t> expected(to_moduli.size() * n);
+    FastBaseConvertNative(expected.data(), n, scaled_operand.data(), n, n,
+                          num_from_moduli, 52, to_moduli.data(),
+                          to_moduli.size(), q_hat_mod_p.data());
+    FastBaseConvertAVX512IFMA(result.data(), n, scaled_operand.data(), n, n,
+                              num_from_moduli, to_moduli.data(),
+                              to_moduli.size(), q_hat_mod_p.data(),
+                              q_hat_mod_p_precon52.data());
+    ASSERT_EQ(result, expected);
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,185 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "experimental/seal/ckks-encode-internal.hpp"
+#include "hexl/experimental/seal/ckks-encode.hpp"
+#include "hexl/ntt/ntt-cache.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/defines.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+std::vector<std::complex<double>> RandomSlots(uint64_t num_values,
+                                              double bound) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(-bound, bound);
+  std::vector<std::complex<double>> values(num_values);
+  for (auto& value : values) {
+    value = std::complex<double>(dist(gen), dist(gen));
+  }
+  return values;
+}
+
+void CheckRoundTrip(uint64_t n, const std::vector<uint64_t>& moduli,
+                    double scale, double tolerance) {
+  CKKSEncoder encoder(n, moduli);
+  auto values = RandomSlots(encoder.GetSlotCount(), 10.0);
+
+  std::vector<uint64_t> plain(moduli.size() * n);
+  encoder.Encode(plain.data(), values.data(), values.size(), scale);
+  for (size_t j = 0; j < moduli.size(); ++j) {
+    for (uint64_t i = 0; i < n; ++i) {
+      ASSERT_LT(plain[j * n + i], moduli[j]);
+    }
+  }
+
+  std::vector<std::complex<double>> decoded(encoder.GetSlotCount());
+  encoder.Decode(decoded.data(), plain.data(), scale);
+  for (size_t i = 0; i < values.size(); ++i) {
+    CheckClose(decoded[i], values[i], tolerance);
+  }
+}
+
+}  // namespace
+
+TEST(CKKSEncode, round_trip) {
+  for (uint64_t n : {16, 1024}) {
+    CheckRoundTrip(n, GeneratePrimes(1, 60, true, n), std::pow(2.0, 40), 1e-6);
+    CheckRoundTrip(n, GeneratePrimes(3, 50, true, n), std::pow(2.0, 40), 1e-6);
+  }
+}
+
+// Coefficients of 2^64 or more are reduced from their floating-point
+// decomposition
+TEST(CKKSEncode, large_scale) {
+  uint64_t n = 256;
+  CheckRoundTrip(n, GeneratePrimes(3, 50, true, n), std::pow(2.0, 80), 1e-9);
+}
+
+// A constant c encodes to the polynomial round(c * scale)
+TEST(CKKSEncode, constant) {
+  uint64_t n = 64;
+  std::vector<uint64_t> moduli = GeneratePrimes(2, 40, true, n);
+  double scale = std::pow(2.0, 20);
+  CKKSEncoder encoder(n, moduli);
+
+  for (double c : {3.0, -5.0}) {
+    std::vector<std::complex<double>> values(encoder.GetSlotCount(), c);
+    std::vector<uint64_t> plain(moduli.size() * n);
+    encoder.Encode(plain.data(), values.data(), values.size(), scale);
+
+    for (size_t j = 0; j < moduli.size(); ++j) {
+      uint64_t modulus = moduli[j];
+      GetNTT(n, modulus)->ComputeInverse(&plain[j * n], &plain[j * n], 1, 1);
+      uint64_t magnitude = static_cast<uint64_t>(std::fabs(c) * scale);
+      uint64_t expected = c < 0 ? modulus - magnitude : magnitude;
+      ASSERT_EQ(plain[j * n], expected);
+      for (uint64_t i = 1; i < n; ++i) {
+        ASSERT_EQ(plain[j * n + i], 0ULL);
+      }
+    }
+  }
+}
+
+// Slots past num_values are zero
+TEST(CKKSEncode, partial_slots) {
+  uint64_t n = 128;
+  std::vector<uint64_t> moduli = GeneratePrimes(2, 50, true, n);
+  double scale = std::pow(2.0, 30);
+  auto values = RandomSlots(10, 1.0);
+
+  std::vector<uint64_t> plain(moduli.size() * n);
+  CKKSEncode(plain.data(), values.data(), values.size(), scale, moduli, n);
+  std::vector<std::complex<double>> decoded(n / 2);
+  CKKSDecode(decoded.data(), plain.data(), scale, moduli, n);
+  for (size_t i = 0; i < decoded.size(); ++i) {
+    std::complex<double> expected = i < values.size() ? values[i] : 0.0;
+    CheckClose(decoded[i], expected, 1e-6);
+  }
+}
+
+TEST(CKKSEncode, parallel) {
+  uint64_t n = 4096;
+  std::vector<uint64_t> moduli = GeneratePrimes(4, 50, true, n);
+  double scale = std::pow(2.0, 40);
+  CKKSEncoder encoder(n, moduli);
+  auto values = RandomSlots(encoder.GetSlotCount(), 10.0);
+
+  std::vector<uint64_t> expected(moduli.size() * n);
+  std::vector<uint64_t> plain(moduli.size() * n);
+  encoder.Encode(expected.data(), values.data(), values.size(), scale);
+  encoder.Encode(plain.data(), values.data(), values.size(), scale,
+                 ExecutionPolicy::Parallel(256));
+  ASSERT_EQ(plain, expected);
+
+  std::vector<std::complex<double>> decoded(encoder.GetSlotCount());
+  std::vector<std::complex<double>> decoded_parallel(encoder.GetSlotCount());
+  encoder.Decode(decoded.data(), plain.data(), scale);
+  encoder.Decode(decoded_parallel.data(), plain.data(), scale,
+                 ExecutionPolicy::Parallel(256));
+  ASSERT_EQ(decoded_parallel, decoded);
+}
+
+TEST(CKKSEncode, upper_half_threshold) {
+  // Q = 7, (Q + 1) / 2 = 4
+  ASSERT_EQ(CKKSComputeUpperHalfThreshold({7}), std::vector<uint64_t>{4});
+
+  // The low word of floor(Q / 2) is all ones, so adding one carries
+  const uint64_t max = std::numeric_limits<uint64_t>::max();
+  std::vector<uint64_t> expected{0, 1};
+  ASSERT_EQ(CKKSComputeUpperHalfThreshold({max, 1}), expected);
+
+  expected = {0, 0, 1};
+  ASSERT_EQ(CKKSComputeUpperHalfThreshold({max, max, 1}), expected);
+
+  // No carry past the low word
+  expected = {(1ULL << 63) + 2, 1};
+  ASSERT_EQ(CKKSComputeUpperHalfThreshold({3, 3}), expected);
+}
+
+#ifdef HEXL_HAS_AVX512DQ
+TEST(CKKSEncode, RoundReduceAVX512) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+
+  uint64_t n = 203;
+  std::vector<uint64_t> moduli = GeneratePrimes(3, 60, true, 1024);
+  for (double bound : {10.0, 1e15, 1e25}) {
+    auto values = RandomSlots(n, bound);
+    // Halfway cases round away from zero
+    values[0] = 2.5;
+    values[1] = -2.5;
+    values[2] = 0.49999999999999994;
+    values[3] = -0.4;
+
+    std::vector<uint64_t> result(moduli.size() * n);
+    std::vector<uint64_t> expected(moduli.size() * n);
+    CKKSRoundReduceNative(expected.data(), values.data(), n, n, moduli.data(),
+                          moduli.size());
+    CKKSRoundReduceAVX512(result.data(), values.data(), n, n, moduli.data(),
+                          moduli.size());
+    ASSERT_EQ(result, expected);
+    ASSERT_EQ(expected[0], 3ULL);
+    ASSERT_EQ(expected[1], moduli[0] - 3);
+    ASSERT_EQ(expected[2], 0ULL);
+    ASSERT_EQ(expected[3], 0ULL);
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,174 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "experimental/seal/decompose-internal.hpp"
+#include "hexl/experimental/seal/base-convert.hpp"
+#include "hexl/experimental/seal/decompose.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/defines.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+std::vector<uint64_t> RandomRNSOperand(const std::vector<uint64_t>& moduli,
+                                       uint64_t n) {
+  std::vector<uint64_t> operand;
+  for (uint64_t modulus : moduli) {
+    auto residues = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+    operand.insert(operand.end(), residues.begin(), residues.end());
+  }
+  return operand;
+}
+
+}  // namespace
+
+TEST(DecomposePowerOfTwoBase, small) {
+  // 0b110110 and 0b001111 in base 4
+  std::vector<uint64_t> operand{54, 15};
+  std::vector<uint64_t> exp_out{2, 1, 3, 0, 0, 3, 3, 0, 0, 0};
+  std::vector<uint64_t> result(exp_out.size());
+
+  DecomposePowerOfTwoBase(result.data(), operand.data(), 1, 2, 2, 5);
+  CheckEqual(result, exp_out);
+}
+
+TEST(DecomposePowerOfTwoBase, random) {
+  uint64_t n = 1024;
+  uint64_t num_polys = 3;
+  for (uint64_t log_base : {1, 7, 20, 60}) {
+    uint64_t num_digits = (60 + log_base - 1) / log_base;
+    auto values =
+        GenerateInsecureUniformIntRandomValues(n * num_polys, 0, 1ULL << 60);
+    std::vector<uint64_t> operand(values.begin(), values.end());
+    std::vector<uint64_t> result(num_polys * num_digits * n);
+
+    DecomposePowerOfTwoBase(result.data(), operand.data(), n, num_polys,
+                            log_base, num_digits);
+    for (uint64_t i = 0; i < num_polys; ++i) {
+      for (uint64_t m = 0; m < n; ++m) {
+        uint64_t x = 0;
+        for (uint64_t k = num_digits; k > 0; --k) {
+          uint64_t digit = result[(i * num_digits + k - 1) * n + m];
+          ASSERT_LT(digit, 1ULL << log_base);
+          x = (log_base * (k - 1) < 64) ? x + (digit << (log_base * (k - 1)))
+                                        : x;
+        }
+        ASSERT_EQ(x, operand[i * n + m]);
+      }
+    }
+
+    std::vector<uint64_t> parallel_result(result.size());
+    DecomposePowerOfTwoBase(parallel_result.data(), operand.data(), n,
+                            num_polys, log_base, num_digits,
+                            ExecutionPolicy::Parallel(256, 4));
+    CheckEqual(parallel_result, result);
+  }
+}
+
+#ifdef HEXL_HAS_AVX512DQ
+TEST(DecomposePowerOfTwoBase, AVX512) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+
+  uint64_t n = 203;
+  for (uint64_t log_base : {3, 16, 63}) {
+    uint64_t num_digits = 64 / log_base + 1;
+    auto operand = GenerateInsecureUniformIntRandomValues(n, 0, ~0ULL);
+    std::vector<uint64_t> result(num_digits * n);
+    std::vector<uint64_t> expected(num_digits * n);
+
+    DecomposePowerOfTwoBaseNative(expected.data(), n, operand.data(), n,
+                                  log_base, num_digits);
+    DecomposePowerOfTwoBaseAVX512(result.data(), n, operand.data(), n,
+                                  log_base, num_digits);
+    CheckEqual(result, expected);
+  }
+}
+#endif
+
+// Inside its group, each digit holds the residues of the operand
+TEST(GroupDecomposer, group_residues) {
+  uint64_t n = 64;
+  std::vector<uint64_t> primes = GeneratePrimes(9, 50, true, n);
+  std::vector<uint64_t> moduli(primes.begin(), primes.begin() + 7);
+  std::vector<uint64_t> extension_moduli(primes.begin() + 7, primes.end());
+
+  for (uint64_t dnum : {1, 2, 3, 7}) {
+    GroupDecomposer decomposer(moduli, dnum, extension_moduli);
+    uint64_t num_digits = decomposer.GetNumDigits();
+    uint64_t alpha = decomposer.GetGroupSize();
+    ASSERT_EQ(alpha, (moduli.size() + dnum - 1) / dnum);
+    ASSERT_EQ(num_digits, (moduli.size() + alpha - 1) / alpha);
+    ASSERT_EQ(decomposer.GetDigitModuli().size(), primes.size());
+
+    auto operand = RandomRNSOperand(moduli, n);
+    uint64_t digit_size = primes.size() * n;
+    std::vector<uint64_t> result(num_digits * digit_size);
+    decomposer.Decompose(result.data(), operand.data(), n);
+
+    for (uint64_t j = 0; j < num_digits; ++j) {
+      for (size_t i = 0; i < primes.size(); ++i) {
+        bool in_group = i >= j * alpha && i < (j + 1) * alpha &&
+                        i < moduli.size();
+        for (uint64_t m = 0; m < n; ++m) {
+          uint64_t digit = result[j * digit_size + i * n + m];
+          ASSERT_LT(digit, primes[i]);
+          if (in_group) {
+            ASSERT_EQ(digit, operand[i * n + m]);
+          }
+        }
+      }
+    }
+  }
+}
+
+// Outside its group, each digit is the fast base conversion of the group
+TEST(GroupDecomposer, base_extension) {
+  uint64_t n = 256;
+  std::vector<uint64_t> primes = GeneratePrimes(7, 40, true, n);
+  std::vector<uint64_t> moduli(primes.begin(), primes.begin() + 5);
+  std::vector<uint64_t> extension_moduli(primes.begin() + 5, primes.end());
+
+  GroupDecomposer decomposer(moduli, 2, extension_moduli);
+  ASSERT_EQ(decomposer.GetNumDigits(), 2ULL);
+  auto operand = RandomRNSOperand(moduli, n);
+  uint64_t digit_size = primes.size() * n;
+  std::vector<uint64_t> result(2 * digit_size);
+  decomposer.Decompose(result.data(), operand.data(), n,
+                       ExecutionPolicy::Parallel(64, 4));
+
+  // Digit 0 covers moduli 0-2, digit 1 moduli 3-4
+  std::vector<uint64_t> group0(moduli.begin(), moduli.begin() + 3);
+  std::vector<uint64_t> rest0(primes.begin() + 3, primes.end());
+  std::vector<uint64_t> expected(rest0.size() * n);
+  FastBaseConvert(expected.data(), operand.data(), group0, rest0, n);
+  std::vector<uint64_t> digit0(result.begin() + 3 * n,
+                               result.begin() + digit_size);
+  CheckEqual(digit0, expected);
+
+  std::vector<uint64_t> group1(moduli.begin() + 3, moduli.end());
+  std::vector<uint64_t> before1(moduli.begin(), moduli.begin() + 3);
+  expected.resize(before1.size() * n);
+  FastBaseConvert(expected.data(), &operand[3 * n], group1, before1, n);
+  std::vector<uint64_t> digit1_before(result.begin() + digit_size,
+                                      result.begin() + digit_size + 3 * n);
+  CheckEqual(digit1_before, expected);
+
+  std::vector<uint64_t> digit1_group(result.begin() + digit_size + 3 * n,
+                                     result.begin() + digit_size + 5 * n);
+  std::vector<uint64_t> operand_group1(operand.begin() + 3 * n, operand.end());
+  CheckEqual(digit1_group, operand_group1);
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -5,10 +5,13 @@
 
 #include <vector>
 
+#include "hexl/experimental/seal/dyadic-multiply-internal.hpp"
 #include "hexl/experimental/seal/dyadic-multiply.hpp"
 #include "hexl/logging/logging.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
@@ -154,5 +157,114 @@ TEST(DyadicMultiply, small_two_mod) {
   CheckEqual(out, exp_out);
 }
 
+// Checks splitting across threads matches the serial result
+TEST(DyadicMultiply, parallel) {
+  uint64_t n = 2048;
+  std::vector<uint64_t> moduli = GeneratePrimes(3, 50, true, n);
+  uint64_t size = 2 * n * moduli.size();
+
+  std::vector<uint64_t> op1(size);
+  std::vector<uint64_t> op2(size);
+  for (size_t i = 0; i < moduli.size(); ++i) {
+    for (uint64_t poly = 0; poly < 2; ++poly) {
+      uint64_t offset = (poly * moduli.size() + i) * n;
+      auto values1 = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      auto values2 = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      std::copy(values1.begin(), values1.end(), op1.begin() + offset);
+      std::copy(values2.begin(), values2.end(), op2.begin() + offset);
+    }
+  }
+
+  std::vector<uint64_t> expected(3 * n * moduli.size());
+  std::vector<uint64_t> result(3 * n * moduli.size());
+  DyadicMultiply(expected.data(), op1.data(), op2.data(), n, moduli.data(),
+                 moduli.size());
+  DyadicMultiply(result.data(), op1.data(), op2.data(), n, moduli.data(),
+                 moduli.size(), ExecutionPolicy::Parallel(512, 4));
+  ASSERT_EQ(result, expected);
+}
+
+// Checks the fused kernels against the schoolbook tensor product, in place
+TEST(DyadicMultiply, fused_kernels) {
+  uint64_t n = 203;
+  for (uint64_t bits : {20, 50, 61}) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+    std::vector<std::vector<uint64_t>> operands;
+    for (size_t k = 0; k < 4; ++k) {
+      auto values = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+      operands.emplace_back(values.begin(), values.end());
+    }
+    operands[0][0] = modulus - 1;
+    operands[1][0] = modulus - 1;
+    operands[2][0] = modulus - 1;
+    operands[3][0] = modulus - 1;
+    const auto& x0 = operands[0];
+    const auto& x1 = operands[1];
+    const auto& y0 = operands[2];
+    const auto& y1 = operands[3];
+
+    std::vector<uint64_t> expected(3 * n);
+    for (uint64_t j = 0; j < n; ++j) {
+      expected[j] = MultiplyMod(x0[j], y0[j], modulus);
+      expected[n + j] = AddUIntMod(MultiplyMod(x0[j], y1[j], modulus),
+                                   MultiplyMod(x1[j], y0[j], modulus), modulus);
+      expected[2 * n + j] = MultiplyMod(x1[j], y1[j], modulus);
+    }
+
+    std::vector<uint64_t> result(3 * n);
+    std::copy(x0.begin(), x0.end(), result.begin());
+    std::copy(x1.begin(), x1.end(), result.begin() + n);
+    internal::DyadicMultiplyNative(&result[0], &result[n], &result[2 * n],
+                                   &result[0], &result[n], y0.data(),
+                                   y1.data(), n, modulus);
+    ASSERT_EQ(result, expected);
+
+#ifdef HEXL_HAS_AVX512DQ
+    if (has_avx512dq) {
+      std::copy(x0.begin(), x0.end(), result.begin());
+      std::copy(x1.begin(), x1.end(), result.begin() + n);
+      internal::DyadicMultiplyAVX512(&result[0], &result[n], &result[2 * n],
+                                     &result[0], &result[n], y0.data(),
+                                     y1.data(), n, modulus);
+      ASSERT_EQ(result, expected);
+    }
+#endif
+  }
+}
+
+// The last tile of coefficients is shorter when n is not a multiple of the
+// tile size
+TEST(DyadicMultiply, partial_tile) {
+  uint64_t n = GetTileSize(7 * sizeof(uint64_t), 1ULL << 20) + 13;
+  std::vector<uint64_t> moduli = GeneratePrimes(2, 50, true, 1024);
+  uint64_t num_moduli = moduli.size();
+
+  std::vector<uint64_t> op1(2 * n * num_moduli);
+  std::vector<uint64_t> op2(2 * n * num_moduli);
+  for (size_t i = 0; i < num_moduli; ++i) {
+    for (uint64_t poly = 0; poly < 2; ++poly) {
+      uint64_t offset = (poly * num_moduli + i) * n;
+      auto values1 = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      auto values2 = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+      std::copy(values1.begin(), values1.end(), op1.begin() + offset);
+      std::copy(values2.begin(), values2.end(), op2.begin() + offset);
+    }
+  }
+
+  std::vector<uint64_t> expected(3 * n * num_moduli);
+  for (size_t i = 0; i < num_moduli; ++i) {
+    uint64_t poly0 = i * n;
+    uint64_t poly1 = poly0 + n * num_moduli;
+    internal::DyadicMultiplyNative(
+        &expected[poly0], &expected[poly1], &expected[poly1 + n * num_moduli],
+        &op1[poly0], &op1[poly1], &op2[poly0], &op2[poly1], n, moduli[i]);
+  }
+
+  std::vector<uint64_t> result(3 * n * num_moduli);
+  DyadicMultiply(result.data(), op1.data(), op2.data(), n, moduli.data(),
+                 num_moduli, ExecutionPolicy::Parallel(512, 4));
+  ASSERT_EQ(result, expected);
+}
+
 }  // namespace hexl
 }  // namespace intel
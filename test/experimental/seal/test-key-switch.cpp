@@ -5,10 +5,14 @@
 
 #include <vector>
 
+#include "experimental/seal/key-switch-accumulate.hpp"
 #include "hexl/experimental/seal/key-switch.hpp"
 #include "hexl/logging/logging.hpp"
 #include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/defines.hpp"
 #include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
@@ -143,6 +147,8 @@ TEST(KeySwitch, small) {
       409326672106986276,  871859211375214104,  683969770428749805,
       1007557589887202473, 1058613598685494981};
 
+  std::vector<uint64_t> workspace_input = input;
+
   KeySwitch(input.data(), t_target_iter_ptr.data(), coeff_count,
             decomp_modulus_size, key_modulus_size, rns_modulus_size,
             key_component_count, moduli.data(), hexl_key_vectors.data(),
@@ -183,7 +189,105 @@ TEST(KeySwitch, small) {
       683969770428749805,  1007557589887202473, 1058613598685494981};
 
   AssertEqual(input, expected_output);
+
+  // A workspace gives the same result, and can be reused
+  KeySwitchWorkspace workspace(coeff_count, decomp_modulus_size,
+                               key_modulus_size, key_component_count);
+  for (size_t trial = 0; trial < 2; ++trial) {
+    std::vector<uint64_t> result = workspace_input;
+    KeySwitch(result.data(), t_target_iter_ptr.data(), coeff_count,
+              decomp_modulus_size, key_modulus_size, rns_modulus_size,
+              key_component_count, moduli.data(), hexl_key_vectors.data(),
+              modswitch_factors.data(), workspace);
+    AssertEqual(result, expected_output);
+  }
+
+  std::vector<uint64_t> result = workspace_input;
+
+  // Workspaces which are empty or too small are rejected
+  std::vector<KeySwitchWorkspace> bad_workspaces;
+  bad_workspaces.emplace_back();
+  bad_workspaces.emplace_back(coeff_count, decomp_modulus_size - 1,
+                              key_modulus_size, key_component_count);
+  bad_workspaces.emplace_back(2 * coeff_count, decomp_modulus_size,
+                              key_modulus_size, key_component_count);
+  for (auto& bad_workspace : bad_workspaces) {
+    EXPECT_THROW(KeySwitch(result.data(), t_target_iter_ptr.data(),
+                           coeff_count, decomp_modulus_size, key_modulus_size,
+                           rns_modulus_size, key_component_count,
+                           moduli.data(), hexl_key_vectors.data(),
+                           modswitch_factors.data(), bad_workspace),
+                 std::invalid_argument);
+  }
+  EXPECT_THROW(KeySwitch(result.data(), t_target_iter_ptr.data(), coeff_count,
+                         decomp_modulus_size, key_modulus_size,
+                         rns_modulus_size + 1, key_component_count,
+                         moduli.data(), hexl_key_vectors.data(),
+                         modswitch_factors.data(), workspace),
+               std::invalid_argument);
+
+  // Parallel key switching is bit-exact with the serial path
+  result = workspace_input;
+  KeySwitch(result.data(), t_target_iter_ptr.data(), coeff_count,
+            decomp_modulus_size, key_modulus_size, rns_modulus_size,
+            key_component_count, moduli.data(), hexl_key_vectors.data(),
+            modswitch_factors.data(), nullptr,
+            ExecutionPolicy::Parallel(1, 4));
+  AssertEqual(result, expected_output);
+
+  KeySwitchWorkspace parallel_workspace(coeff_count, decomp_modulus_size,
+                                        key_modulus_size, key_component_count,
+                                        3);
+  result = workspace_input;
+  KeySwitch(result.data(), t_target_iter_ptr.data(), coeff_count,
+            decomp_modulus_size, key_modulus_size, rns_modulus_size,
+            key_component_count, moduli.data(), hexl_key_vectors.data(),
+            modswitch_factors.data(), parallel_workspace, nullptr,
+            ExecutionPolicy::Parallel(1, 0));
+  AssertEqual(result, expected_output);
+
+  // Keys laid out once, with and without factors for Shoup multiplication
+  for (bool precompute_shoup : {false, true}) {
+    KeySwitchKeys keys(hexl_key_vectors.data(), coeff_count,
+                       decomp_modulus_size, key_modulus_size,
+                       key_component_count, moduli.data(), precompute_shoup);
+    EXPECT_EQ(keys.HasPrecon(), precompute_shoup);
+    result = workspace_input;
+    KeySwitch(result.data(), t_target_iter_ptr.data(), coeff_count,
+              decomp_modulus_size, key_modulus_size, rns_modulus_size,
+              key_component_count, moduli.data(), keys,
+              modswitch_factors.data(), workspace);
+    AssertEqual(result, expected_output);
+  }
+}
+
+#ifdef HEXL_HAS_AVX512DQ
+TEST(KeySwitch, AccumulateShoupAVX512) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+  for (uint64_t n : {1, 8, 13, 1024}) {
+    for (uint64_t bits : {30, 50, 61}) {
+      uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+      std::vector<uint64_t> acc(n, 0);
+      std::vector<uint64_t> expected(n, 0);
+      for (size_t j = 0; j < 10; ++j) {
+        auto op = GenerateInsecureUniformIntRandomValues(n, 0, 4 * modulus);
+        auto key = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+        std::vector<uint64_t> key_precon(n);
+        for (size_t l = 0; l < n; ++l) {
+          key_precon[l] = MultiplyFactor(key[l], 64, modulus).BarrettFactor();
+        }
+        KeySwitchAccumulateShoupNative(expected.data(), op.data(), key.data(),
+                                       key_precon.data(), n, modulus);
+        KeySwitchAccumulateShoupAVX512(acc.data(), op.data(), key.data(),
+                                       key_precon.data(), n, modulus);
+      }
+      ASSERT_EQ(acc, expected);
+    }
+  }
 }
+#endif
 
 }  // namespace hexl
 }  // namespace intel
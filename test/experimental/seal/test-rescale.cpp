@@ -0,0 +1,150 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "experimental/seal/rescale-internal.hpp"
+#include "hexl/experimental/seal/rescale.hpp"
+#include "hexl/ntt/ntt-cache.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/defines.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Checks RescaleDivideRoundLastModulus on x = d + q_L * y, with y = e_0 + q_0
+// * (e_1 + q_1 * (...)) for random digits d < q_L and e_i < q_i, so that
+// round(x / q_L) = y + (d + floor(q_L / 2) >= q_L)
+void CheckRescale(const std::vector<uint64_t>& moduli, uint64_t n,
+                  const ExecutionPolicy& policy, bool in_place) {
+  uint64_t num_remaining = moduli.size() - 1;
+  uint64_t last_modulus = moduli.back();
+
+  std::vector<std::vector<uint64_t>> digits;
+  for (uint64_t modulus : moduli) {
+    auto values = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+    digits.emplace_back(values.begin(), values.end());
+  }
+
+  // Returns y mod modulus for coefficient m
+  auto y_mod = [&](uint64_t m, uint64_t modulus) {
+    uint64_t y = 0;
+    for (uint64_t i = num_remaining; i > 0; --i) {
+      y = MultiplyMod(y, moduli[i - 1] % modulus, modulus);
+      y = AddUIntMod(y, digits[i - 1][m] % modulus, modulus);
+    }
+    return y;
+  };
+
+  std::vector<uint64_t> operand(moduli.size() * n);
+  for (size_t j = 0; j < moduli.size(); ++j) {
+    uint64_t modulus = moduli[j];
+    for (uint64_t m = 0; m < n; ++m) {
+      uint64_t d = digits[num_remaining][m] % modulus;
+      operand[j * n + m] = AddUIntMod(
+          d, MultiplyMod(last_modulus % modulus, y_mod(m, modulus), modulus),
+          modulus);
+    }
+    GetNTT(n, modulus)->ComputeForward(&operand[j * n], &operand[j * n], 1, 1);
+  }
+
+  std::vector<uint64_t> result(num_remaining * n);
+  uint64_t* result_ptr = result.data();
+  if (in_place) {
+    result_ptr = operand.data();
+  }
+  RescaleDivideRoundLastModulus(result_ptr, operand.data(), n, moduli.data(),
+                                moduli.size(), policy);
+
+  for (size_t i = 0; i < num_remaining; ++i) {
+    uint64_t modulus = moduli[i];
+    std::vector<uint64_t> coeffs(result_ptr + i * n, result_ptr + (i + 1) * n);
+    GetNTT(n, modulus)->ComputeInverse(coeffs.data(), coeffs.data(), 1, 1);
+    for (uint64_t m = 0; m < n; ++m) {
+      uint64_t round_up =
+          (digits[num_remaining][m] + (last_modulus >> 1) >= last_modulus)
+              ? 1
+              : 0;
+      ASSERT_EQ(coeffs[m], AddUIntMod(y_mod(m, modulus), round_up, modulus));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(Rescale, divide_round_last_modulus) {
+  for (uint64_t n : {16, 1024}) {
+    for (uint64_t bits : {20, 40, 60}) {
+      for (uint64_t num_moduli : {2, 3, 5}) {
+        std::vector<uint64_t> moduli =
+            GeneratePrimes(num_moduli, bits, true, n);
+        CheckRescale(moduli, n, ExecutionPolicy::Serial(), false);
+      }
+    }
+  }
+}
+
+// The last modulus may be larger or smaller than the others
+TEST(Rescale, mixed_modulus_sizes) {
+  uint64_t n = 256;
+  std::vector<uint64_t> small = GeneratePrimes(3, 30, true, n);
+  std::vector<uint64_t> large = GeneratePrimes(3, 60, true, n);
+  CheckRescale({small[0], large[0], small[1], large[1]}, n,
+               ExecutionPolicy::Serial(), false);
+  CheckRescale({large[0], small[0], large[1], small[1]}, n,
+               ExecutionPolicy::Serial(), false);
+}
+
+TEST(Rescale, in_place_parallel) {
+  uint64_t n = 512;
+  std::vector<uint64_t> moduli = GeneratePrimes(6, 50, true, n);
+  CheckRescale(moduli, n, ExecutionPolicy::Serial(), true);
+  CheckRescale(moduli, n, ExecutionPolicy::Parallel(64), false);
+  CheckRescale(moduli, n, ExecutionPolicy::Parallel(64), true);
+}
+
+#ifdef HEXL_HAS_AVX512DQ
+TEST(Rescale, AVX512) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+
+  uint64_t n = 203;
+  for (uint64_t bits : {30, 50, 60}) {
+    for (uint64_t last_bits : {30, 50, 60}) {
+      uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+      uint64_t last_modulus = GeneratePrimes(2, last_bits, true, 1024)[1];
+      uint64_t fix = modulus - ((last_modulus >> 1) % modulus);
+      auto last = GenerateInsecureUniformIntRandomValues(n, 0, last_modulus);
+
+      std::vector<uint64_t> result(n);
+      std::vector<uint64_t> expected(n);
+      RescaleReduceLastNative(expected.data(), last.data(), n, modulus,
+                              last_modulus, fix);
+      RescaleReduceLastAVX512(result.data(), last.data(), n, modulus,
+                              last_modulus, fix);
+      ASSERT_EQ(result, expected);
+
+      uint64_t inv = InverseMod(last_modulus % modulus, modulus);
+      uint64_t inv_precon = MultiplyFactor(inv, 64, modulus).BarrettFactor();
+      auto operand = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+      auto last_ntt = GenerateInsecureUniformIntRandomValues(n, 0, 4 * modulus);
+      RescaleSubtractScaleNative(expected.data(), operand.data(),
+                                 last_ntt.data(), n, modulus, inv, inv_precon);
+      RescaleSubtractScaleAVX512(result.data(), operand.data(),
+                                 last_ntt.data(), n, modulus, inv, inv_precon);
+      ASSERT_EQ(result, expected);
+    }
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,90 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <immintrin.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/avx2-util.hpp"
+#include "util/cpu-features.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+
+TEST(AVX2, ExtractValues) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+  __m256i x = _mm256_set_epi64x(1, 2, 3, 4);
+
+  AssertEqual(ExtractValues(x), std::vector<uint64_t>{4, 3, 2, 1});
+}
+
+TEST(AVX2, _mm256_hexl_cmplt_epu64) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+  uint64_t big = (1ULL << 63) + 5;
+  __m256i x = _mm256_set_epi64x(static_cast<int64_t>(big), 1, 7, 10);
+  __m256i y = _mm256_set_epi64x(3, static_cast<int64_t>(big), 7, 11);
+
+  AssertEqual(ExtractValues(_mm256_hexl_cmplt_epu64(x, y)),
+              std::vector<uint64_t>{~0ULL, 0, ~0ULL, 0});
+}
+
+TEST(AVX2, _mm256_hexl_small_mod_epu64) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+  // Use a modulus close to 2^62, so 4q exceeds 2^63
+  uint64_t q = (1ULL << 62) - 57;
+  __m256i v_q = _mm256_set1_epi64x(static_cast<int64_t>(q));
+  __m256i v_twice_q = _mm256_set1_epi64x(static_cast<int64_t>(2 * q));
+
+  __m256i x = _mm256_set_epi64x(static_cast<int64_t>(4 * q - 1),
+                                static_cast<int64_t>(2 * q),
+                                static_cast<int64_t>(q), 3);
+  __m256i z = _mm256_hexl_small_mod_epu64<4>(x, v_q, &v_twice_q);
+
+  AssertEqual(ExtractValues(z), std::vector<uint64_t>{3, 0, 0, q - 1});
+}
+
+TEST(AVX2, _mm256_hexl_mullo_mulhi_epi64) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+  std::vector<uint64_t> x{90774764920991, 1ULL << 63, (1ULL << 60) + 1,
+                          0xFFFFFFFFFFFFFFFF};
+  std::vector<uint64_t> y{1ULL << 63, 1ULL << 63, (1ULL << 62) + 2,
+                          0xFFFFFFFFFFFFFFFF};
+
+  std::vector<uint64_t> exp_lo(4);
+  std::vector<uint64_t> exp_hi(4);
+  for (size_t i = 0; i < 4; ++i) {
+    MultiplyUInt64(x[i], y[i], &exp_hi[i], &exp_lo[i]);
+  }
+
+  __m256i v_x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x.data()));
+  __m256i v_y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y.data()));
+
+  AssertEqual(ExtractValues(_mm256_hexl_mullo_epi64(v_x, v_y)), exp_lo);
+  AssertEqual(ExtractValues(_mm256_hexl_mulhi_epi64(v_x, v_y)), exp_hi);
+
+  // Approximate computation may underestimate by at most one
+  std::vector<uint64_t> approx_hi =
+      ExtractValues(_mm256_hexl_mulhi_approx_epi64(v_x, v_y));
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_LE(approx_hi[i], exp_hi[i]);
+    EXPECT_LE(exp_hi[i] - approx_hi[i], 1ULL);
+  }
+}
+
+#endif  // HEXL_HAS_AVX256
+
+}  // namespace hexl
+}  // namespace intel
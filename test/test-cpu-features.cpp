@@ -0,0 +1,40 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include "util/cpu-features.hpp"
+
+namespace intel {
+namespace hexl {
+
+TEST(CacheSizes, probe) {
+  const CacheSizes& sizes = GetCacheSizes();
+  // Levels are either unknown or ordered by size
+  if (sizes.l1d_bytes != 0 && sizes.l2_bytes != 0) {
+    EXPECT_LE(sizes.l1d_bytes, sizes.l2_bytes);
+  }
+  EXPECT_EQ(&GetCacheSizes(), &sizes);
+  EXPECT_GT(GetTileBytes(), 0ULL);
+}
+
+TEST(GetTileSize, power_of_two) {
+  for (uint64_t bytes_per_element : {1ULL, 8ULL, 56ULL, 1000ULL, 1ULL << 40}) {
+    uint64_t tile_size = GetTileSize(bytes_per_element, 1ULL << 40);
+    EXPECT_GE(tile_size, 8ULL);
+    EXPECT_EQ(tile_size & (tile_size - 1), 0ULL);
+    if (tile_size > 8) {
+      EXPECT_LE(tile_size * bytes_per_element, GetTileBytes());
+    }
+    EXPECT_GT(2 * tile_size * bytes_per_element, GetTileBytes());
+  }
+}
+
+TEST(GetTileSize, max_tile_size) {
+  EXPECT_EQ(GetTileSize(8, 3), 3ULL);
+  EXPECT_EQ(GetTileSize(1ULL << 40, 1024), 8ULL);
+  EXPECT_LE(GetTileSize(1, 1000), 1000ULL);
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,92 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "eltwise/eltwise-add-mod-avx2.hpp"
+#include "eltwise/eltwise-add-mod-internal.hpp"
+#include "hexl/eltwise/eltwise-add-mod.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+TEST(EltwiseAddMod, vector_vector_avx2_small) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+
+  std::vector<uint64_t> op1{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<uint64_t> op2{1, 3, 5, 7, 9, 2, 4, 6, 5};
+  std::vector<uint64_t> exp_out{2, 5, 8, 1, 4, 8, 1, 4, 4};
+  uint64_t modulus = 10;
+  EltwiseAddModAVX2(op1.data(), op1.data(), op2.data(), op1.size(), modulus);
+
+  CheckEqual(op1, exp_out);
+}
+
+TEST(EltwiseAddMod, vector_scalar_avx2_small) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+
+  std::vector<uint64_t> op1{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  uint64_t op2{3};
+  std::vector<uint64_t> exp_out{4, 5, 6, 7, 8, 9, 0, 1, 2};
+  uint64_t modulus = 10;
+  EltwiseAddModAVX2(op1.data(), op1.data(), op2, op1.size(), modulus);
+
+  CheckEqual(op1, exp_out);
+}
+
+// Checks AVX2 and native implementations match
+TEST(EltwiseAddMod, avx2_native_match) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+
+  size_t length = 173;
+
+  for (size_t bits = 1; bits <= 62; ++bits) {
+    uint64_t modulus = 1ULL << bits;
+
+#ifdef HEXL_DEBUG
+    size_t num_trials = 10;
+#else
+    size_t num_trials = 100;
+#endif
+
+    for (size_t trial = 0; trial < num_trials; ++trial) {
+      auto op1 = GenerateInsecureUniformIntRandomValues(length, 0, modulus);
+      auto op2 = GenerateInsecureUniformIntRandomValues(length, 0, modulus);
+      uint64_t op3 = GenerateInsecureUniformIntRandomValue(0, modulus);
+      op1[length - 1] = modulus - 1;
+      op2[length - 1] = modulus - 1;
+
+      std::vector<uint64_t> out_native(length, 0);
+      std::vector<uint64_t> out_avx2(length, 0);
+
+      EltwiseAddModNative(out_native.data(), op1.data(), op2.data(),
+                          op1.size(), modulus);
+      EltwiseAddModAVX2(out_avx2.data(), op1.data(), op2.data(), op1.size(),
+                        modulus);
+      ASSERT_EQ(out_native, out_avx2);
+
+      EltwiseAddModNative(out_native.data(), op1.data(), op3, op1.size(),
+                          modulus);
+      EltwiseAddModAVX2(out_avx2.data(), op1.data(), op3, op1.size(), modulus);
+      ASSERT_EQ(out_native, out_avx2);
+    }
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
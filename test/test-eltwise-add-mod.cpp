@@ -10,6 +10,7 @@
 #include "hexl/logging/logging.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "test/test-util.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
@@ -109,5 +110,24 @@ TEST(EltwiseAddMod, vector_scalar_native_big) {
   CheckEqual(op1, exp_out);
 }
 
+// Checks splitting across threads matches the serial result
+TEST(EltwiseAddMod, parallel) {
+  uint64_t n = 1003;
+  uint64_t modulus = GeneratePrimes(1, 50, true, 1024)[0];
+  auto op1 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+  auto op2 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+  auto policy = ExecutionPolicy::Parallel(24, 4);
+
+  std::vector<uint64_t> expected(n);
+  std::vector<uint64_t> result(n);
+  EltwiseAddMod(expected.data(), op1.data(), op2.data(), n, modulus);
+  EltwiseAddMod(result.data(), op1.data(), op2.data(), n, modulus, policy);
+  ASSERT_EQ(result, expected);
+
+  EltwiseAddMod(expected.data(), op1.data(), op2[0], n, modulus);
+  EltwiseAddMod(result.data(), op1.data(), op2[0], n, modulus, policy);
+  ASSERT_EQ(result, expected);
+}
+
 }  // namespace hexl
 }  // namespace intel
@@ -0,0 +1,59 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "eltwise/eltwise-apply-galois-avx512.hpp"
+#include "eltwise/eltwise-apply-galois-internal.hpp"
+#include "hexl/eltwise/eltwise-apply-galois.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+TEST(EltwiseApplyGalois, avx512_native) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+
+  uint64_t n = 1024;
+  uint64_t modulus = GeneratePrimes(1, 60, true, n)[0];
+  auto op = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+  for (size_t i = 0; i < n; i += 7) {
+    op[i] = 0;
+  }
+
+  for (uint64_t galois_elt : {uint64_t{3}, uint64_t{5}, 2 * n - 1}) {
+    GaloisPermutation permutation(n, galois_elt);
+    // Odd length and offset exercise the scalar tail
+    uint64_t begin = 5;
+    uint64_t length = 203;
+
+    std::vector<uint64_t> result(length);
+    std::vector<uint64_t> expected(length);
+    const uint32_t* coeff_source =
+        permutation.GetCoeffSourceIndices().data() + begin;
+    EltwiseApplyGaloisNative(expected.data(), op.data(), coeff_source, length,
+                             modulus);
+    EltwiseApplyGaloisAVX512(result.data(), op.data(), coeff_source, length,
+                             modulus);
+    CheckEqual(result, expected);
+
+    const uint32_t* ntt_source =
+        permutation.GetNTTSourceIndices().data() + begin;
+    EltwiseApplyGaloisNTTNative(expected.data(), op.data(), ntt_source,
+                                length);
+    EltwiseApplyGaloisNTTAVX512(result.data(), op.data(), ntt_source, length);
+    CheckEqual(result, expected);
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,194 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "hexl/eltwise/eltwise-apply-galois.hpp"
+#include "hexl/ntt/ntt-cache.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Maps coefficient i to index i * galois_elt mod 2n, negating it past n
+std::vector<uint64_t> ApplyGaloisReference(const uint64_t* operand, uint64_t n,
+                                           uint64_t galois_elt,
+                                           uint64_t modulus) {
+  std::vector<uint64_t> result(n);
+  for (uint64_t i = 0; i < n; ++i) {
+    uint64_t index = (i * galois_elt) % (2 * n);
+    if (index < n) {
+      result[index] = operand[i];
+    } else {
+      result[index - n] = SubUIntMod(0, operand[i], modulus);
+    }
+  }
+  return result;
+}
+
+std::vector<uint64_t> RandomValues(uint64_t n, uint64_t modulus) {
+  auto values = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+  return std::vector<uint64_t>(values.begin(), values.end());
+}
+
+}  // namespace
+
+#ifdef HEXL_DEBUG
+TEST(EltwiseApplyGalois, bad_input) {
+  uint64_t n = 8;
+  uint64_t modulus = 17;
+  std::vector<uint64_t> op(n, 1);
+  std::vector<uint64_t> result(n);
+  std::vector<uint64_t> big_op(n, modulus);
+
+  EXPECT_ANY_THROW(GaloisPermutation(6, 3));
+  EXPECT_ANY_THROW(GaloisPermutation(n, 2));
+  EXPECT_ANY_THROW(GaloisPermutation(n, 2 * n + 1));
+  EXPECT_ANY_THROW(EltwiseApplyGalois(nullptr, op.data(), n, 3, modulus));
+  EXPECT_ANY_THROW(EltwiseApplyGalois(result.data(), nullptr, n, 3, modulus));
+  EXPECT_ANY_THROW(EltwiseApplyGalois(op.data(), op.data(), n, 3, modulus));
+  EXPECT_ANY_THROW(
+      EltwiseApplyGalois(result.data(), big_op.data(), n, 3, modulus));
+  EXPECT_ANY_THROW(EltwiseApplyGaloisNTT(op.data(), op.data(), n, 3));
+}
+#endif
+
+TEST(EltwiseApplyGalois, small) {
+  // 1 + 2X + 3X^2 + 4X^3 -> 1 + 2X^3 + 3X^6 + 4X^9 = 1 + 4X - 3X^2 + 2X^3
+  std::vector<uint64_t> op{1, 2, 3, 4};
+  std::vector<uint64_t> exp_out{1, 4, 7, 2};
+  std::vector<uint64_t> result(op.size());
+
+  EltwiseApplyGalois(result.data(), op.data(), op.size(), 3, 10);
+  CheckEqual(result, exp_out);
+}
+
+TEST(EltwiseApplyGalois, identity) {
+  uint64_t n = 64;
+  uint64_t modulus = GeneratePrimes(1, 40, true, n)[0];
+  std::vector<uint64_t> op = RandomValues(n, modulus);
+  std::vector<uint64_t> result(n);
+
+  EltwiseApplyGalois(result.data(), op.data(), n, 1, modulus);
+  CheckEqual(result, op);
+  EltwiseApplyGaloisNTT(result.data(), op.data(), n, 1);
+  CheckEqual(result, op);
+}
+
+TEST(EltwiseApplyGalois, random) {
+  for (uint64_t n : {2, 8, 1024}) {
+    uint64_t modulus = GeneratePrimes(1, 50, true, n)[0];
+    for (uint64_t galois_elt : {uint64_t{3}, uint64_t{5}, 2 * n - 1}) {
+      std::vector<uint64_t> op = RandomValues(n, modulus);
+      op[0] = 0;
+      std::vector<uint64_t> result(n);
+
+      EltwiseApplyGalois(result.data(), op.data(), n, galois_elt % (2 * n),
+                         modulus);
+      CheckEqual(result, ApplyGaloisReference(op.data(), n,
+                                              galois_elt % (2 * n), modulus));
+    }
+  }
+}
+
+// Applying the automorphism commutes with the forward NTT
+TEST(EltwiseApplyGalois, ntt) {
+  for (uint64_t n : {8, 16, 1024}) {
+    uint64_t modulus = GeneratePrimes(1, 50, true, n)[0];
+    auto ntt = GetNTT(n, modulus);
+    for (uint64_t galois_elt :
+         {uint64_t{3}, uint64_t{5}, uint64_t{25}, 2 * n - 1}) {
+      galois_elt %= 2 * n;
+      std::vector<uint64_t> op = RandomValues(n, modulus);
+      std::vector<uint64_t> op_ntt(n);
+      ntt->ComputeForward(op_ntt.data(), op.data(), 1, 1);
+
+      std::vector<uint64_t> expected(n);
+      EltwiseApplyGalois(expected.data(), op.data(), n, galois_elt, modulus);
+      ntt->ComputeForward(expected.data(), expected.data(), 1, 1);
+
+      std::vector<uint64_t> result(n);
+      EltwiseApplyGaloisNTT(result.data(), op_ntt.data(), n, galois_elt);
+      CheckEqual(result, expected);
+    }
+  }
+}
+
+TEST(EltwiseApplyGalois, compose) {
+  uint64_t n = 256;
+  uint64_t modulus = GeneratePrimes(1, 30, true, n)[0];
+  std::vector<uint64_t> op = RandomValues(n, modulus);
+  std::vector<uint64_t> tmp(n);
+  std::vector<uint64_t> result(n);
+  std::vector<uint64_t> expected(n);
+
+  EltwiseApplyGalois(tmp.data(), op.data(), n, 3, modulus);
+  EltwiseApplyGalois(result.data(), tmp.data(), n, 5, modulus);
+  EltwiseApplyGalois(expected.data(), op.data(), n, 15, modulus);
+  CheckEqual(result, expected);
+
+  EltwiseApplyGaloisNTT(tmp.data(), op.data(), n, 3);
+  EltwiseApplyGaloisNTT(result.data(), tmp.data(), n, 5);
+  EltwiseApplyGaloisNTT(expected.data(), op.data(), n, 15);
+  CheckEqual(result, expected);
+}
+
+TEST(EltwiseApplyGalois, parallel) {
+  uint64_t n = 4096;
+  uint64_t modulus = GeneratePrimes(1, 60, true, n)[0];
+  std::vector<uint64_t> op = RandomValues(n, modulus);
+  std::vector<uint64_t> result(n);
+  std::vector<uint64_t> expected(n);
+
+  EltwiseApplyGalois(expected.data(), op.data(), n, 5, modulus);
+  EltwiseApplyGalois(result.data(), op.data(), n, 5, modulus,
+                     ExecutionPolicy::Parallel(512, 4));
+  CheckEqual(result, expected);
+
+  EltwiseApplyGaloisNTT(expected.data(), op.data(), n, 5);
+  EltwiseApplyGaloisNTT(result.data(), op.data(), n, 5,
+                        ExecutionPolicy::Parallel(512, 4));
+  CheckEqual(result, expected);
+}
+
+TEST(EltwiseApplyGalois, cached_permutation) {
+  auto permutation = GetGaloisPermutation(512, 3);
+  EXPECT_EQ(permutation, GetGaloisPermutation(512, 3));
+  EXPECT_NE(permutation, GetGaloisPermutation(512, 5));
+  EXPECT_EQ(permutation->GetDegree(), 512ULL);
+  EXPECT_EQ(permutation->GetGaloisElt(), 3ULL);
+
+  // Using more permutations than the cache holds evicts the least recently
+  // used one
+  for (uint64_t i = 0; i < s_max_cached_galois_permutations; ++i) {
+    GetGaloisPermutation(1024, 2 * i + 1);
+  }
+  EXPECT_NE(permutation, GetGaloisPermutation(512, 3));
+}
+
+TEST(EltwiseApplyGalois, owned_permutation) {
+  uint64_t n = 1024;
+  uint64_t modulus = GeneratePrimes(1, 50, true, n)[0];
+  auto op = RandomValues(n, modulus);
+  std::vector<uint64_t> expected(n);
+  std::vector<uint64_t> result(n);
+  GaloisPermutation permutation(n, 7);
+
+  EltwiseApplyGalois(expected.data(), op.data(), n, 7, modulus);
+  EltwiseApplyGalois(result.data(), op.data(), permutation, modulus);
+  CheckEqual(result, expected);
+
+  EltwiseApplyGaloisNTT(expected.data(), op.data(), n, 7);
+  EltwiseApplyGaloisNTT(result.data(), op.data(), permutation,
+                        ExecutionPolicy::Parallel(256, 4));
+  CheckEqual(result, expected);
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,55 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "eltwise/eltwise-cmp-add-avx2.hpp"
+#include "eltwise/eltwise-cmp-add-internal.hpp"
+#include "hexl/eltwise/eltwise-cmp-add.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+// Checks AVX2 and native implementations match
+#ifdef HEXL_HAS_AVX256
+TEST(EltwiseCmpAdd, AVX2) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+
+  uint64_t length = 1027;
+  uint64_t modulus = 100;
+
+  for (size_t cmp = 0; cmp < 8; ++cmp) {
+    for (size_t trial = 0; trial < 200; ++trial) {
+      auto op1 = GenerateInsecureUniformIntRandomValues(length, 0, modulus);
+      uint64_t bound = GenerateInsecureUniformIntRandomValue(0, modulus);
+      uint64_t diff = GenerateInsecureUniformIntRandomValue(1, modulus);
+
+      std::vector<uint64_t> op1_out(op1.size(), 0);
+      std::vector<uint64_t> op1a_out(op1.size(), 0);
+      std::vector<uint64_t> op1b_out(op1.size(), 0);
+
+      EltwiseCmpAdd(op1_out.data(), op1.data(), op1.size(),
+                    static_cast<CMPINT>(cmp), bound, diff);
+      EltwiseCmpAddNative(op1a_out.data(), op1.data(), op1.size(),
+                          static_cast<CMPINT>(cmp), bound, diff);
+      EltwiseCmpAddAVX2(op1b_out.data(), op1.data(), op1.size(),
+                        static_cast<CMPINT>(cmp), bound, diff);
+
+      ASSERT_EQ(op1_out, op1a_out);
+      ASSERT_EQ(op1_out, op1b_out);
+    }
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -10,6 +10,7 @@
 #include "hexl/logging/logging.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "test/test-util.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
@@ -77,5 +78,18 @@ INSTANTIATE_TEST_SUITE_P(
                         CMPINT::TRUE, 4, 5,
                         std::vector<uint64_t>{6, 7, 8, 9, 10, 11, 12})));
 
+// Checks splitting across threads matches the serial result
+TEST(EltwiseCmpAdd, parallel) {
+  uint64_t n = 1003;
+  auto op = GenerateInsecureUniformIntRandomValues(n, 0, 100);
+
+  std::vector<uint64_t> expected(n);
+  std::vector<uint64_t> result(n);
+  EltwiseCmpAdd(expected.data(), op.data(), n, CMPINT::NLT, 50, 7);
+  EltwiseCmpAdd(result.data(), op.data(), n, CMPINT::NLT, 50, 7,
+                ExecutionPolicy::Parallel(24, 4));
+  ASSERT_EQ(result, expected);
+}
+
 }  // namespace hexl
 }  // namespace intel
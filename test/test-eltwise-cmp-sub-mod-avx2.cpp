@@ -0,0 +1,62 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "eltwise/eltwise-cmp-sub-mod-avx2.hpp"
+#include "eltwise/eltwise-cmp-sub-mod-internal.hpp"
+#include "hexl/eltwise/eltwise-cmp-sub-mod.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+// Checks AVX2 and native implementations match
+#ifdef HEXL_HAS_AVX256
+TEST(EltwiseCmpSubMod, AVX2) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+
+  uint64_t length = 1027;
+  for (size_t cmp = 0; cmp < 8; ++cmp) {
+    for (size_t bits = 20; bits <= 62; bits += 6) {
+      uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+
+      for (size_t trial = 0; trial < 20; ++trial) {
+        // Inputs need not be reduced
+        auto op1 = GenerateInsecureUniformIntRandomValues(length, 0,
+                                                          1ULL << 63);
+        op1[length - 1] = modulus;
+
+        uint64_t bound = GenerateInsecureUniformIntRandomValue(0, modulus);
+        // Ensure diff != 0
+        uint64_t diff = GenerateInsecureUniformIntRandomValue(1, modulus - 1);
+
+        std::vector<uint64_t> op1_out(op1.size(), 0);
+        std::vector<uint64_t> op1a_out(op1.size(), 0);
+        std::vector<uint64_t> op1b_out(op1.size(), 0);
+
+        EltwiseCmpSubMod(op1_out.data(), op1.data(), op1.size(), modulus,
+                         static_cast<CMPINT>(cmp), bound, diff);
+        EltwiseCmpSubModNative(op1a_out.data(), op1.data(), op1.size(),
+                               modulus, static_cast<CMPINT>(cmp), bound, diff);
+        EltwiseCmpSubModAVX2(op1b_out.data(), op1.data(), op1.size(), modulus,
+                             static_cast<CMPINT>(cmp), bound, diff);
+
+        ASSERT_EQ(op1_out, op1a_out);
+        ASSERT_EQ(op1_out, op1b_out);
+      }
+    }
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -10,6 +10,7 @@
 #include "hexl/logging/logging.hpp"
 #include "hexl/number-theory/number-theory.hpp"
 #include "test/test-util.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
@@ -88,5 +89,21 @@ INSTANTIATE_TEST_SUITE_P(
                         CMPINT::TRUE, 4, 5,
                         std::vector<uint64_t>{6, 7, 8, 9, 0, 1, 2})));
 
+// Checks splitting across threads matches the serial result
+TEST(EltwiseCmpSubMod, parallel) {
+  uint64_t n = 1003;
+  uint64_t modulus = GeneratePrimes(1, 50, true, 1024)[0];
+  auto op = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+  uint64_t bound = modulus / 2;
+
+  std::vector<uint64_t> expected(n);
+  std::vector<uint64_t> result(n);
+  EltwiseCmpSubMod(expected.data(), op.data(), n, modulus, CMPINT::NLT, bound,
+                   5);
+  EltwiseCmpSubMod(result.data(), op.data(), n, modulus, CMPINT::NLT, bound,
+                   5, ExecutionPolicy::Parallel(24, 4));
+  ASSERT_EQ(result, expected);
+}
+
 }  // namespace hexl
 }  // namespace intel
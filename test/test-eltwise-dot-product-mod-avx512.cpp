@@ -0,0 +1,89 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "eltwise/eltwise-dot-product-mod-avx512.hpp"
+#include "eltwise/eltwise-dot-product-mod-internal.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Compares the AVX512 kernel against EltwiseDotProductModNative on random and
+// max-valued inputs
+template <typename Kernel>
+void CheckAgainstNative(Kernel kernel, uint64_t modulus, uint64_t count) {
+  uint64_t n = 203;
+  std::vector<AlignedVector64<uint64_t>> operand1(count);
+  std::vector<AlignedVector64<uint64_t>> operand2(count);
+  std::vector<const uint64_t*> operand1_ptrs(count);
+  std::vector<const uint64_t*> operand2_ptrs(count);
+  for (size_t i = 0; i < count; ++i) {
+    operand1[i] = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+    operand2[i] = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+    operand1[i][n - 1] = modulus - 1;
+    operand2[i][n - 1] = modulus - 1;
+    operand1_ptrs[i] = operand1[i].data();
+    operand2_ptrs[i] = operand2[i].data();
+  }
+
+  std::vector<uint64_t> expected(n);
+  std::vector<uint64_t> result(n);
+  EltwiseDotProductModNative(expected.data(), operand1_ptrs.data(),
+                             operand2_ptrs.data(), count, 0, n, modulus);
+  kernel(result.data(), operand1_ptrs.data(), operand2_ptrs.data(), count, 0,
+         n, modulus);
+  CheckEqual(result, expected);
+
+  // A slice of the columns leaves the others untouched
+  std::vector<uint64_t> slice_result(n, 0);
+  std::vector<uint64_t> slice_expected(n, 0);
+  std::copy(expected.begin() + 5, expected.end() - 3,
+            slice_expected.begin() + 5);
+  kernel(slice_result.data(), operand1_ptrs.data(), operand2_ptrs.data(),
+         count, 5, n - 3, modulus);
+  CheckEqual(slice_result, slice_expected);
+}
+
+}  // namespace
+
+#ifdef HEXL_HAS_AVX512DQ
+TEST(EltwiseDotProductMod, AVX512DQ) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+  for (uint64_t bits : {20, 50, 60, 62}) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+    for (uint64_t count : {1, 16, 100}) {
+      CheckAgainstNative(EltwiseDotProductModAVX512DQ, modulus, count);
+    }
+  }
+}
+#endif
+
+#ifdef HEXL_HAS_AVX512IFMA
+TEST(EltwiseDotProductMod, AVX512IFMA) {
+  if (!has_avx512ifma) {
+    GTEST_SKIP();
+  }
+  for (uint64_t bits : {20, 40, 51}) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+    for (uint64_t count : {1, 100, 5000}) {
+      CheckAgainstNative(EltwiseDotProductModAVX512IFMA, modulus, count);
+    }
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,131 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "eltwise/eltwise-dot-product-mod-internal.hpp"
+#include "hexl/eltwise/eltwise-add-mod.hpp"
+#include "hexl/eltwise/eltwise-dot-product-mod.hpp"
+#include "hexl/eltwise/eltwise-mult-mod.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "test/test-util.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Computes the dot product with one EltwiseMultMod and EltwiseAddMod per term
+std::vector<uint64_t> ReferenceDotProduct(
+    const std::vector<AlignedVector64<uint64_t>>& operand1,
+    const std::vector<AlignedVector64<uint64_t>>& operand2, uint64_t n,
+    uint64_t modulus) {
+  std::vector<uint64_t> result(n, 0);
+  std::vector<uint64_t> product(n);
+  for (size_t i = 0; i < operand1.size(); ++i) {
+    EltwiseMultMod(product.data(), operand1[i].data(), operand2[i].data(), n,
+                   modulus, 1);
+    EltwiseAddMod(result.data(), result.data(), product.data(), n, modulus);
+  }
+  return result;
+}
+
+std::vector<const uint64_t*> Pointers(
+    const std::vector<AlignedVector64<uint64_t>>& operand) {
+  std::vector<const uint64_t*> pointers;
+  for (const auto& vec : operand) {
+    pointers.push_back(vec.data());
+  }
+  return pointers;
+}
+
+}  // namespace
+
+TEST(EltwiseDotProductMod, small) {
+  std::vector<uint64_t> a0{1, 2, 3, 4};
+  std::vector<uint64_t> a1{5, 6, 7, 8};
+  std::vector<uint64_t> b0{9, 10, 11, 12};
+  std::vector<uint64_t> b1{13, 14, 15, 16};
+  std::vector<const uint64_t*> operand1{a0.data(), a1.data()};
+  std::vector<const uint64_t*> operand2{b0.data(), b1.data()};
+  std::vector<uint64_t> result(4);
+
+  EltwiseDotProductMod(result.data(), operand1.data(), operand2.data(), 2, 4,
+                       101);
+  // 9 + 65 = 74, 20 + 84 = 104, 33 + 105 = 138, 48 + 128 = 176
+  CheckEqual(result, std::vector<uint64_t>{74, 3, 37, 75});
+}
+
+// Max-valued inputs with enough terms to need intermediate reductions
+TEST(EltwiseDotProductMod, max_values) {
+  for (uint64_t bits : {20, 50, 52, 61, 62}) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+    uint64_t count = 5000;
+    uint64_t n = 19;
+    std::vector<AlignedVector64<uint64_t>> operand1(
+        count, AlignedVector64<uint64_t>(n, modulus - 1));
+    std::vector<AlignedVector64<uint64_t>> operand2 = operand1;
+    std::vector<uint64_t> result(n);
+
+    EltwiseDotProductMod(result.data(), Pointers(operand1).data(),
+                         Pointers(operand2).data(), count, n, modulus);
+    // (-1)^2 * count
+    CheckEqual(result, std::vector<uint64_t>(n, count % modulus));
+  }
+}
+
+TEST(EltwiseDotProductMod, random) {
+  for (uint64_t bits : {20, 50, 60, 62}) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+    for (uint64_t count : {1, 3, 40}) {
+      uint64_t n = 1027;
+      std::vector<AlignedVector64<uint64_t>> operand1(count);
+      std::vector<AlignedVector64<uint64_t>> operand2(count);
+      for (size_t i = 0; i < count; ++i) {
+        operand1[i] = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+        operand2[i] = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+      }
+      auto expected = ReferenceDotProduct(operand1, operand2, n, modulus);
+
+      std::vector<uint64_t> result(n);
+      EltwiseDotProductMod(result.data(), Pointers(operand1).data(),
+                           Pointers(operand2).data(), count, n, modulus);
+      CheckEqual(result, expected);
+
+      std::vector<uint64_t> native_result(n);
+      EltwiseDotProductModNative(native_result.data(),
+                                 Pointers(operand1).data(),
+                                 Pointers(operand2).data(), count, 0, n,
+                                 modulus);
+      CheckEqual(native_result, expected);
+    }
+  }
+}
+
+TEST(EltwiseDotProductMod, parallel) {
+  uint64_t modulus = GeneratePrimes(1, 60, true, 1024)[0];
+  uint64_t count = 20;
+  uint64_t n = 4099;
+  std::vector<AlignedVector64<uint64_t>> operand1(count);
+  std::vector<AlignedVector64<uint64_t>> operand2(count);
+  for (size_t i = 0; i < count; ++i) {
+    operand1[i] = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+    operand2[i] = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+  }
+
+  std::vector<uint64_t> expected(n);
+  std::vector<uint64_t> result(n);
+  EltwiseDotProductMod(expected.data(), Pointers(operand1).data(),
+                       Pointers(operand2).data(), count, n, modulus);
+  EltwiseDotProductMod(result.data(), Pointers(operand1).data(),
+                       Pointers(operand2).data(), count, n, modulus,
+                       ExecutionPolicy::Parallel(256));
+  CheckEqual(result, expected);
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,126 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "eltwise/eltwise-fma-mod-avx2.hpp"
+#include "eltwise/eltwise-fma-mod-internal.hpp"
+#include "hexl/eltwise/eltwise-fma-mod.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+TEST(EltwiseFMAMod, avx2_small) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+
+  std::vector<uint64_t> arg1{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  uint64_t arg2 = 2;
+  std::vector<uint64_t> arg3{1, 1, 1, 1, 2, 3, 1, 0, 100};
+  std::vector<uint64_t> exp_out{3, 5, 7, 9, 12, 15, 15, 16, 17};
+
+  uint64_t modulus = 101;
+  EltwiseFMAModAVX2<64, 1>(arg1.data(), arg1.data(), arg2, arg3.data(),
+                           arg1.size(), modulus);
+
+  CheckEqual(arg1, exp_out);
+}
+
+// Checks AVX2 and native eltwise FMA implementations match
+TEST(EltwiseFMAMod, AVX2) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+
+  uint64_t length = 1031;
+
+  for (size_t input_mod_factor = 1; input_mod_factor <= 8;
+       input_mod_factor *= 2) {
+    for (size_t bits = 1; bits <= 60; ++bits) {
+      uint64_t modulus = (1ULL << bits) + 7;
+
+#ifdef HEXL_DEBUG
+      size_t num_trials = 10;
+#else
+      size_t num_trials = 50;
+#endif
+
+      for (size_t trial = 0; trial < num_trials; ++trial) {
+        auto arg1 = GenerateInsecureUniformIntRandomValues(
+            length, 0, input_mod_factor * modulus);
+        uint64_t arg2 = GenerateInsecureUniformIntRandomValue(
+            0, input_mod_factor * modulus);
+        auto arg3 = GenerateInsecureUniformIntRandomValues(
+            length, 0, input_mod_factor * modulus);
+
+        std::vector<uint64_t> out_native(length, 0);
+        std::vector<uint64_t> out_avx_64(length, 0);
+        std::vector<uint64_t> out_avx_32(length, 0);
+
+        uint64_t* arg3_data = (trial % 2 == 0) ? arg3.data() : nullptr;
+        bool use_32 = modulus < (1ULL << 30);
+
+        switch (input_mod_factor) {
+          case 1:
+            EltwiseFMAModNative<1>(out_native.data(), arg1.data(), arg2,
+                                   arg3_data, arg1.size(), modulus);
+            EltwiseFMAModAVX2<64, 1>(out_avx_64.data(), arg1.data(), arg2,
+                                     arg3_data, arg1.size(), modulus);
+            if (use_32) {
+              EltwiseFMAModAVX2<32, 1>(out_avx_32.data(), arg1.data(), arg2,
+                                       arg3_data, arg1.size(), modulus);
+            }
+            break;
+          case 2:
+            EltwiseFMAModNative<2>(out_native.data(), arg1.data(), arg2,
+                                   arg3_data, arg1.size(), modulus);
+            EltwiseFMAModAVX2<64, 2>(out_avx_64.data(), arg1.data(), arg2,
+                                     arg3_data, arg1.size(), modulus);
+            if (use_32) {
+              EltwiseFMAModAVX2<32, 2>(out_avx_32.data(), arg1.data(), arg2,
+                                       arg3_data, arg1.size(), modulus);
+            }
+            break;
+          case 4:
+            EltwiseFMAModNative<4>(out_native.data(), arg1.data(), arg2,
+                                   arg3_data, arg1.size(), modulus);
+            EltwiseFMAModAVX2<64, 4>(out_avx_64.data(), arg1.data(), arg2,
+                                     arg3_data, arg1.size(), modulus);
+            if (use_32) {
+              EltwiseFMAModAVX2<32, 4>(out_avx_32.data(), arg1.data(), arg2,
+                                       arg3_data, arg1.size(), modulus);
+            }
+            break;
+          case 8:
+            EltwiseFMAModNative<8>(out_native.data(), arg1.data(), arg2,
+                                   arg3_data, arg1.size(), modulus);
+            EltwiseFMAModAVX2<64, 8>(out_avx_64.data(), arg1.data(), arg2,
+                                     arg3_data, arg1.size(), modulus);
+            if (use_32) {
+              EltwiseFMAModAVX2<32, 8>(out_avx_32.data(), arg1.data(), arg2,
+                                       arg3_data, arg1.size(), modulus);
+            }
+            break;
+        }
+
+        ASSERT_EQ(out_native, out_avx_64);
+        if (use_32) {
+          ASSERT_EQ(out_native, out_avx_32);
+        }
+      }
+    }
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
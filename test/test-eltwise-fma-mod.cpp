@@ -11,6 +11,7 @@
 #include "hexl/number-theory/number-theory.hpp"
 #include "test/test-util.hpp"
 #include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
@@ -94,5 +95,27 @@ TEST(EltwiseFMAMod, mult_input_mod_factor) {
   }
 }
 
+// Checks splitting across threads matches the serial result
+TEST(EltwiseFMAMod, parallel) {
+  uint64_t n = 1003;
+  uint64_t modulus = GeneratePrimes(1, 50, true, 1024)[0];
+  auto arg1 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+  auto arg3 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+  uint64_t arg2 = modulus / 3;
+  auto policy = ExecutionPolicy::Parallel(24, 4);
+
+  std::vector<uint64_t> expected(n);
+  std::vector<uint64_t> result(n);
+  EltwiseFMAMod(expected.data(), arg1.data(), arg2, arg3.data(), n, modulus, 1);
+  EltwiseFMAMod(result.data(), arg1.data(), arg2, arg3.data(), n, modulus, 1,
+                policy);
+  ASSERT_EQ(result, expected);
+
+  EltwiseFMAMod(expected.data(), arg1.data(), arg2, nullptr, n, modulus, 1);
+  EltwiseFMAMod(result.data(), arg1.data(), arg2, nullptr, n, modulus, 1,
+                policy);
+  ASSERT_EQ(result, expected);
+}
+
 }  // namespace hexl
 }  // namespace intel
@@ -0,0 +1,98 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "eltwise/eltwise-lazy-accumulate-avx512.hpp"
+#include "eltwise/eltwise-lazy-accumulate-internal.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/defines.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX512DQ
+TEST(EltwiseLazyAccumulate, AVX512DQ) {
+  if (!has_avx512dq) {
+    GTEST_SKIP();
+  }
+  for (uint64_t n : {1, 8, 13, 1024}) {
+    for (uint64_t bits : {30, 50, 61}) {
+      uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+      std::vector<uint64_t> hi(n, 0);
+      std::vector<uint64_t> lo(n, 0);
+      std::vector<uint64_t> exp_hi(n, 0);
+      std::vector<uint64_t> exp_lo(n, 0);
+      for (size_t j = 0; j < 10; ++j) {
+        auto op1 = GenerateInsecureUniformIntRandomValues(n, 0, 4 * modulus);
+        auto op2 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+        EltwiseLazyMultAccumulateNative(exp_hi.data(), exp_lo.data(),
+                                        op1.data(), op2.data(), n);
+        EltwiseLazyMultAccumulateAVX512DQ(hi.data(), lo.data(), op1.data(),
+                                          op2.data(), n);
+      }
+      ASSERT_EQ(hi, exp_hi);
+      ASSERT_EQ(lo, exp_lo);
+
+      std::vector<uint64_t> result(n);
+      std::vector<uint64_t> expected(n);
+      EltwiseLazyReduceNative(expected.data(), hi.data(), lo.data(), n,
+                              modulus);
+      EltwiseLazyReduceAVX512DQ(result.data(), hi.data(), lo.data(), n,
+                                modulus);
+      ASSERT_EQ(result, expected);
+
+      // Arbitrary 128-bit accumulators
+      auto rand_hi = GenerateInsecureUniformIntRandomValues(n, 0, UINT64_MAX);
+      auto rand_lo = GenerateInsecureUniformIntRandomValues(n, 0, UINT64_MAX);
+      hi.assign(rand_hi.begin(), rand_hi.end());
+      lo.assign(rand_lo.begin(), rand_lo.end());
+      EltwiseLazyReduceNative(expected.data(), hi.data(), lo.data(), n,
+                              modulus);
+      EltwiseLazyReduceAVX512DQ(result.data(), hi.data(), lo.data(), n,
+                                modulus);
+      ASSERT_EQ(result, expected);
+    }
+  }
+}
+#endif
+
+#ifdef HEXL_HAS_AVX512IFMA
+TEST(EltwiseLazyAccumulate, AVX512IFMA) {
+  if (!has_avx512ifma) {
+    GTEST_SKIP();
+  }
+  for (uint64_t n : {1, 8, 13, 1024}) {
+    for (uint64_t bits : {30, 45, 50}) {
+      uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+      std::vector<uint64_t> hi(n, 0);
+      std::vector<uint64_t> lo(n, 0);
+      std::vector<uint64_t> exp_hi(n, 0);
+      std::vector<uint64_t> exp_lo(n, 0);
+      for (size_t j = 0; j < 10; ++j) {
+        auto op1 = GenerateInsecureUniformIntRandomValues(n, 0, 4 * modulus);
+        auto op2 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+        EltwiseLazyMultAccumulateNative(exp_hi.data(), exp_lo.data(),
+                                        op1.data(), op2.data(), n);
+        EltwiseLazyMultAccumulateAVX512IFMA(hi.data(), lo.data(), op1.data(),
+                                            op2.data(), n);
+      }
+
+      std::vector<uint64_t> result(n);
+      std::vector<uint64_t> expected(n);
+      EltwiseLazyReduceNative(expected.data(), exp_hi.data(), exp_lo.data(),
+                              n, modulus);
+      EltwiseLazyReduceAVX512IFMA(result.data(), hi.data(), lo.data(), n,
+                                  modulus);
+      ASSERT_EQ(result, expected);
+    }
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,50 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "eltwise/eltwise-lazy-accumulate-internal.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+
+namespace intel {
+namespace hexl {
+
+TEST(EltwiseLazyAccumulate, max_products) {
+  ASSERT_EQ(LazyAccumulateMaxProducts(2), ~0ULL);
+  ASSERT_EQ(LazyAccumulateMaxProducts(1ULL << 32), ~0ULL);
+  ASSERT_EQ(LazyAccumulateMaxProducts((1ULL << 32) + 1), (1ULL << 62) - 1);
+  ASSERT_EQ(LazyAccumulateMaxProducts((1ULL << 50) + 1), (1ULL << 26) - 1);
+  ASSERT_EQ(LazyAccumulateMaxProducts((1ULL << 62) - 57), 15ULL);
+  ASSERT_EQ(LazyAccumulateMaxProducts(0xffffffffffffffc5ULL), 0ULL);
+}
+
+// Accumulating the maximal products the bound allows, starting from modulus -
+// 1, does not overflow
+TEST(EltwiseLazyAccumulate, max_values) {
+  for (uint64_t bits : {20, 40, 51, 60, 61}) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+    const LazyAccumulateKernels kernels(modulus);
+    uint64_t count = std::min<uint64_t>(kernels.max_products, 5000);
+
+    uint64_t n = 19;
+    std::vector<uint64_t> max_value(n, modulus - 1);
+    std::vector<uint64_t> acc_hi(n, 0);
+    std::vector<uint64_t> acc_lo(n, modulus - 1);
+    for (size_t i = 0; i < count; ++i) {
+      kernels.accumulate(acc_hi.data(), acc_lo.data(), max_value.data(),
+                         max_value.data(), n);
+    }
+    std::vector<uint64_t> result(n);
+    kernels.reduce(result.data(), acc_hi.data(), acc_lo.data(), n, modulus);
+
+    // (modulus - 1) + count * (-1)^2
+    uint64_t expected = (modulus - 1 + count % modulus) % modulus;
+    ASSERT_EQ(result, std::vector<uint64_t>(n, expected));
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,116 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "eltwise/eltwise-mult-mod-avx2.hpp"
+#include "eltwise/eltwise-mult-mod-internal.hpp"
+#include "hexl/eltwise/eltwise-mult-mod.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+TEST(EltwiseMultMod, avx2_small) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+
+  std::vector<uint64_t> op1{1, 2, 3, 1, 1, 1, 0, 1, 0};
+  std::vector<uint64_t> op2{1, 1, 1, 1, 2, 3, 1, 0, 0};
+  std::vector<uint64_t> exp_out{1, 2, 3, 1, 2, 3, 0, 0, 0};
+  std::vector<uint64_t> result{0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+  uint64_t modulus = 101;
+
+  EltwiseMultModAVX2Int<1>(result.data(), op1.data(), op2.data(), op1.size(),
+                           modulus);
+
+  CheckEqual(result, exp_out);
+}
+
+// Checks AVX2 and native eltwise mult implementations match
+TEST(EltwiseMultMod, avx2int_big) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+
+  size_t length = 1027;
+  std::vector<uint64_t> rs1(length, 0);
+  std::vector<uint64_t> rs2(length, 0);
+  std::vector<uint64_t> rs3(length, 0);
+  std::vector<uint64_t> rs4(length, 0);
+
+  for (size_t input_mod_factor = 1; input_mod_factor <= 4;
+       input_mod_factor *= 2) {
+    for (size_t bits = 2; bits <= 60; ++bits) {
+      uint64_t modulus = (1ULL << bits) + 7;
+      uint64_t data_upper_bound = input_mod_factor * modulus;
+      bool use_avx2_float = (modulus < MaximumValue(50));
+
+      size_t num_trials = 5;
+      for (size_t trial = 0; trial < num_trials; ++trial) {
+        auto op1 =
+            GenerateInsecureUniformIntRandomValues(length, 0, data_upper_bound);
+        auto op2 =
+            GenerateInsecureUniformIntRandomValues(length, 0, data_upper_bound);
+
+        op1[length - 1] = data_upper_bound - 1;
+        op2[length - 1] = data_upper_bound - 1;
+
+        switch (input_mod_factor) {
+          case 1:
+            EltwiseMultModNative<1>(rs1.data(), op1.data(), op2.data(),
+                                    op1.size(), modulus);
+            EltwiseMultModAVX2Int<1>(rs2.data(), op1.data(), op2.data(),
+                                     op1.size(), modulus);
+            if (use_avx2_float) {
+              EltwiseMultModAVX2Float<1>(rs4.data(), op1.data(), op2.data(),
+                                         op1.size(), modulus);
+            }
+            break;
+          case 2:
+            EltwiseMultModNative<2>(rs1.data(), op1.data(), op2.data(),
+                                    op1.size(), modulus);
+            EltwiseMultModAVX2Int<2>(rs2.data(), op1.data(), op2.data(),
+                                     op1.size(), modulus);
+            if (use_avx2_float) {
+              EltwiseMultModAVX2Float<2>(rs4.data(), op1.data(), op2.data(),
+                                         op1.size(), modulus);
+            }
+            break;
+          case 4:
+            EltwiseMultModNative<4>(rs1.data(), op1.data(), op2.data(),
+                                    op1.size(), modulus);
+            EltwiseMultModAVX2Int<4>(rs2.data(), op1.data(), op2.data(),
+                                     op1.size(), modulus);
+            if (use_avx2_float) {
+              EltwiseMultModAVX2Float<4>(rs4.data(), op1.data(), op2.data(),
+                                         op1.size(), modulus);
+            }
+            break;
+        }
+        EltwiseMultMod(rs3.data(), op1.data(), op2.data(), op1.size(),
+                       modulus, input_mod_factor);
+
+        ASSERT_EQ(rs1, rs2);
+        ASSERT_EQ(rs1, rs3);
+        ASSERT_EQ(rs2[length - 1], 1);
+        if (use_avx2_float) {
+          ASSERT_EQ(rs1, rs4);
+        }
+      }
+    }
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -11,6 +11,7 @@
 #include "hexl/number-theory/number-theory.hpp"
 #include "ntt/ntt-internal.hpp"
 #include "test/test-util.hpp"
+#include "util/util-internal.hpp"
 
 namespace intel {
 namespace hexl {
@@ -290,5 +291,22 @@ INSTANTIATE_TEST_SUITE_P(
                        ::testing::ValuesIn(std::vector<uint64_t>{1, 2, 4})),
     ModulusInputModFactor::PrintToStringParamName());
 
+// Checks splitting across threads matches the serial result
+TEST(EltwiseMultMod, parallel) {
+  uint64_t n = 1003;
+  for (uint64_t bits : {30, 60}) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+    auto op1 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+    auto op2 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+
+    std::vector<uint64_t> expected(n);
+    std::vector<uint64_t> result(n);
+    EltwiseMultMod(expected.data(), op1.data(), op2.data(), n, modulus, 1);
+    EltwiseMultMod(result.data(), op1.data(), op2.data(), n, modulus, 1,
+                   ExecutionPolicy::Parallel(24, 4));
+    ASSERT_EQ(result, expected);
+  }
+}
+
 }  // namespace hexl
 }  // namespace intel
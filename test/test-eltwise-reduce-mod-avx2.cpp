@@ -0,0 +1,79 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "eltwise/eltwise-reduce-mod-avx2.hpp"
+#include "eltwise/eltwise-reduce-mod-internal.hpp"
+#include "hexl/eltwise/eltwise-reduce-mod.hpp"
+#include "hexl/logging/logging.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/cpu-features.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_HAS_AVX256
+TEST(EltwiseReduceMod, avx2_4_1) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+
+  std::vector<uint64_t> op{1, 730, 111, 111, 250, 250, 1, 1, 499};
+  std::vector<uint64_t> exp_out{1, 238, 111, 111, 4, 4, 1, 1, 7};
+  std::vector<uint64_t> result{0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+  uint64_t modulus = 246;
+  EltwiseReduceModAVX2(result.data(), op.data(), op.size(), modulus, 4, 1);
+  CheckEqual(result, exp_out);
+}
+
+// Checks AVX2 and native EltwiseReduceMod implementations match with randomly
+// generated inputs
+TEST(EltwiseReduceMod, AVX2Big) {
+  if (!has_avx2) {
+    GTEST_SKIP();
+  }
+
+  size_t length = 1027;
+
+  for (size_t bits = 20; bits <= 62; ++bits) {
+    uint64_t modulus = GeneratePrimes(1, bits, true, 1024)[0];
+
+    for (uint64_t input_mod_factor : {modulus, uint64_t(2), uint64_t(4)}) {
+      for (uint64_t output_mod_factor = 1; output_mod_factor <= 2;
+           ++output_mod_factor) {
+        if (input_mod_factor == output_mod_factor) {
+          continue;
+        }
+        uint64_t upper_bound = (input_mod_factor == modulus)
+                                   ? (1ULL << 63)
+                                   : input_mod_factor * modulus;
+
+        for (size_t trial = 0; trial < 10; ++trial) {
+          auto op = GenerateInsecureUniformIntRandomValues(length, 0,
+                                                           upper_bound);
+          op[length - 1] = upper_bound - 1;
+
+          std::vector<uint64_t> result1(length, 0);
+          std::vector<uint64_t> result2(length, 0);
+
+          EltwiseReduceModNative(result1.data(), op.data(), op.size(),
+                                 modulus, input_mod_factor, output_mod_factor);
+          EltwiseReduceModAVX2(result2.data(), op.data(), op.size(), modulus,
+                               input_mod_factor, output_mod_factor);
+
+          ASSERT_EQ(result1, result2);
+        }
+      }
+    }
+  }
+}
+#endif
+
+}  // namespace hexl
+}  // namespace intel
@@ -129,5 +129,19 @@ INSTANTIATE_TEST_SUITE_P(
                            55, 58, 59, 60}),
                        ::testing::ValuesIn(std::vector<bool>{false, true})));
 
+// Checks splitting across threads matches the serial result
+TEST(EltwiseReduceMod, parallel) {
+  uint64_t n = 1003;
+  uint64_t modulus = GeneratePrimes(1, 50, true, 1024)[0];
+  auto op = GenerateInsecureUniformIntRandomValues(n, 0, 4 * modulus);
+
+  std::vector<uint64_t> expected(n);
+  std::vector<uint64_t> result(n);
+  EltwiseReduceMod(expected.data(), op.data(), n, modulus, 4, 1);
+  EltwiseReduceMod(result.data(), op.data(), n, modulus, 4, 1,
+                   ExecutionPolicy::Parallel(24, 4));
+  ASSERT_EQ(result, expected);
+}
+
 }  // namespace hexl
 }  // namespace intel
@@ -0,0 +1,185 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "hexl/ntt/ntt-cache.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+
+namespace intel {
+namespace hexl {
+
+TEST(NTTCache, get) {
+  NTTCache cache;
+  uint64_t N = 64;
+  std::vector<uint64_t> moduli = GeneratePrimes(2, 40, true, N);
+
+  NTTHandle ntt0 = cache.Get(N, moduli[0]);
+  EXPECT_EQ(ntt0->GetDegree(), N);
+  EXPECT_EQ(ntt0->GetModulus(), moduli[0]);
+  EXPECT_EQ(cache.Get(N, moduli[0]).get(), ntt0.get());
+
+  NTTHandle ntt1 = cache.Get(N, moduli[1]);
+  EXPECT_NE(ntt1.get(), ntt0.get());
+  EXPECT_EQ(cache.Get(N, moduli[0]).get(), ntt0.get());
+
+  NTTCacheStats stats = cache.GetStats();
+  EXPECT_EQ(stats.hits, 2ULL);
+  EXPECT_EQ(stats.misses, 2ULL);
+  EXPECT_EQ(stats.evictions, 0ULL);
+  EXPECT_EQ(stats.num_entries, 2ULL);
+  EXPECT_GT(stats.memory_bytes, 2 * N * sizeof(uint64_t));
+
+  cache.Clear();
+  stats = cache.GetStats();
+  EXPECT_EQ(stats.hits, 0ULL);
+  EXPECT_EQ(stats.misses, 0ULL);
+  EXPECT_EQ(stats.num_entries, 0ULL);
+  EXPECT_EQ(stats.memory_bytes, 0ULL);
+
+  // Handles returned before Clear stay valid
+  EXPECT_EQ(ntt0->GetModulus(), moduli[0]);
+  EXPECT_NE(cache.Get(N, moduli[0]).get(), ntt0.get());
+  EXPECT_GT(cache.GetStats().retired_bytes, 0ULL);
+
+  // The removed NTTs are freed once no handle refers to them
+  ntt0 = NTTHandle();
+  ntt1 = NTTHandle();
+  cache.Clear();
+  EXPECT_EQ(cache.GetStats().retired_bytes, 0ULL);
+}
+
+TEST(NTTCache, prewarm) {
+  NTTCache cache;
+  uint64_t N = 64;
+  std::vector<uint64_t> moduli = GeneratePrimes(3, 40, true, N);
+
+  cache.Prewarm(N, moduli);
+  EXPECT_EQ(cache.GetStats().num_entries, 3ULL);
+  EXPECT_EQ(cache.GetStats().misses, 0ULL);
+
+  for (uint64_t modulus : moduli) {
+    cache.Get(N, modulus);
+  }
+  EXPECT_EQ(cache.GetStats().hits, 3ULL);
+  EXPECT_EQ(cache.GetStats().misses, 0ULL);
+}
+
+TEST(NTTCache, evicts_least_recently_used) {
+  uint64_t N = 256;
+  std::vector<uint64_t> moduli = GeneratePrimes(4, 40, true, N);
+
+  NTTCache cache;
+  cache.Get(N, moduli[0]);
+  uint64_t entry_bytes = cache.GetStats().memory_bytes;
+
+  cache.SetBudget(3 * entry_bytes);
+  EXPECT_EQ(cache.GetBudget(), 3 * entry_bytes);
+  NTTHandle ntt1 = cache.Get(N, moduli[1]);
+  cache.Get(N, moduli[2]);
+  cache.Get(N, moduli[0]);
+
+  // Evicts moduli[1], the least recently used
+  cache.Get(N, moduli[3]);
+  NTTCacheStats stats = cache.GetStats();
+  EXPECT_EQ(stats.evictions, 1ULL);
+  EXPECT_EQ(stats.num_entries, 3ULL);
+  EXPECT_LE(stats.memory_bytes, cache.GetBudget());
+
+  uint64_t misses = stats.misses;
+  cache.Get(N, moduli[0]);
+  cache.Get(N, moduli[2]);
+  cache.Get(N, moduli[3]);
+  EXPECT_EQ(cache.GetStats().misses, misses);
+
+  // Evicted NTTs stay valid while referenced
+  EXPECT_EQ(ntt1->GetModulus(), moduli[1]);
+  EXPECT_EQ(cache.GetStats().retired_bytes, entry_bytes);
+  EXPECT_NE(cache.Get(N, moduli[1]).get(), ntt1.get());
+  EXPECT_EQ(cache.GetStats().misses, misses + 1);
+
+  // and are freed once no handle refers to them
+  ntt1 = NTTHandle();
+  cache.SetBudget(cache.GetBudget());
+  EXPECT_EQ(cache.GetStats().retired_bytes, 0ULL);
+
+  // The most recently used NTT is kept even if it exceeds the budget
+  cache.SetBudget(0);
+  EXPECT_EQ(cache.GetStats().num_entries, 1ULL);
+  EXPECT_EQ(cache.Get(N, moduli[1])->GetModulus(), moduli[1]);
+}
+
+TEST(NTTCache, concurrent) {
+  NTTCache cache;
+  uint64_t N = 64;
+  std::vector<uint64_t> moduli = GeneratePrimes(4, 40, true, N);
+  size_t num_threads = 4;
+  uint64_t num_lookups = 100;
+
+  std::vector<std::vector<const NTT*>> ntts(num_threads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (uint64_t i = 0; i < num_lookups; ++i) {
+        NTTHandle ntt = cache.Get(N, moduli[i % moduli.size()]);
+        ASSERT_EQ(ntt->GetModulus(), moduli[i % moduli.size()]);
+        ntts[t].push_back(ntt.get());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t t = 0; t < num_threads; ++t) {
+    for (uint64_t i = 0; i < num_lookups; ++i) {
+      ASSERT_EQ(ntts[t][i], ntts[0][i]);
+    }
+  }
+  NTTCacheStats stats = cache.GetStats();
+  EXPECT_EQ(stats.misses, moduli.size());
+  EXPECT_EQ(stats.hits + stats.misses, num_threads * num_lookups);
+}
+
+// Handles stay valid while other threads evict their NTTs
+TEST(NTTCache, concurrent_evictions) {
+  uint64_t N = 64;
+  std::vector<uint64_t> moduli = GeneratePrimes(8, 40, true, N);
+  NTTCache cache;
+  cache.Get(N, moduli[0]);
+  cache.SetBudget(2 * cache.GetStats().memory_bytes);
+  size_t num_threads = 4;
+  uint64_t num_lookups = 200;
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      std::vector<uint64_t> input(N, 1);
+      std::vector<uint64_t> output(N);
+      for (uint64_t i = 0; i < num_lookups; ++i) {
+        uint64_t modulus = moduli[(i + t) % moduli.size()];
+        NTTHandle ntt = cache.Get(N, modulus);
+        NTTHandle other = cache.Get(N, moduli[(i + 1) % moduli.size()]);
+        ntt->ComputeForward(output.data(), input.data(), 1, 1);
+        ASSERT_EQ(ntt->GetModulus(), modulus);
+        ASSERT_EQ(other->GetDegree(), N);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  NTTCacheStats stats = cache.GetStats();
+  EXPECT_GT(stats.evictions, 0ULL);
+  EXPECT_LE(stats.num_entries, 2ULL);
+  EXPECT_EQ(stats.hits + stats.misses, 2 * num_threads * num_lookups + 1);
+  cache.SetBudget(cache.GetBudget());
+  EXPECT_EQ(cache.GetStats().retired_bytes, 0ULL);
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,234 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "hexl/ntt/ntt-cache.hpp"
+#include "hexl/ntt/ntt-tables.hpp"
+#include "hexl/ntt/ntt.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "hexl/util/aligned-allocator.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+std::string TablePath(const std::string& name) {
+  return ::testing::TempDir() + "hexl-ntt-tables-" + name + ".bin";
+}
+
+// Checks ntt has the same tables as expected_ntt, and computes the same
+// transforms
+void CheckSameNTT(NTT& ntt, NTT& expected_ntt) {
+  ASSERT_EQ(ntt.GetDegree(), expected_ntt.GetDegree());
+  ASSERT_EQ(ntt.GetModulus(), expected_ntt.GetModulus());
+  ASSERT_EQ(ntt.GetMinimalRootOfUnity(), expected_ntt.GetMinimalRootOfUnity());
+  for (size_t t = 0; t < NTT::s_num_tables; ++t) {
+    NTT::Table table = static_cast<NTT::Table>(t);
+    ASSERT_EQ(ntt.GetTableSize(table), expected_ntt.GetTableSize(table));
+    std::vector<uint64_t> values(ntt.GetTable(table),
+                                 ntt.GetTable(table) + ntt.GetTableSize(table));
+    std::vector<uint64_t> expected_values(
+        expected_ntt.GetTable(table),
+        expected_ntt.GetTable(table) + expected_ntt.GetTableSize(table));
+    ASSERT_EQ(values, expected_values);
+  }
+
+  uint64_t n = ntt.GetDegree();
+  auto input = GenerateInsecureUniformIntRandomValues(n, 0, ntt.GetModulus());
+  AlignedVector64<uint64_t> result(n);
+  AlignedVector64<uint64_t> expected(n);
+  ntt.ComputeForward(result.data(), input.data(), 1, 1);
+  expected_ntt.ComputeForward(expected.data(), input.data(), 1, 1);
+  ASSERT_EQ(result, expected);
+  ntt.ComputeInverse(result.data(), result.data(), 1, 1);
+  ASSERT_EQ(result, input);
+}
+
+}  // namespace
+
+TEST(NTTTables, save_and_map) {
+  std::vector<NTT> ntts;
+  for (uint64_t n : {2, 16, 1024}) {
+    for (uint64_t bits : {20, 50, 60}) {
+      ntts.emplace_back(n, GeneratePrimes(1, bits, true, n)[0]);
+    }
+  }
+  std::vector<const NTT*> ntt_ptrs;
+  for (const NTT& ntt : ntts) {
+    ntt_ptrs.push_back(&ntt);
+  }
+
+  std::string path = TablePath("save_and_map");
+  SaveNTTTables(path, ntt_ptrs);
+
+  std::vector<NTT> mapped_ntts;
+  {
+    MappedNTTTables tables(path);
+    ASSERT_EQ(tables.NumNTTs(), ntts.size());
+    mapped_ntts = tables.GetNTTs();
+  }
+  std::remove(path.c_str());
+
+  // The NTTs keep the mapping alive
+  for (size_t i = 0; i < ntts.size(); ++i) {
+    // Viewed tables aren't copied, unless accessed as a vector
+    uint64_t memory_bytes = mapped_ntts[i].GetTableMemoryBytes();
+    CheckSameNTT(mapped_ntts[i], ntts[i]);
+    EXPECT_EQ(mapped_ntts[i].GetTableMemoryBytes(), memory_bytes);
+    EXPECT_EQ(mapped_ntts[i].GetRootOfUnityPowers(),
+              ntts[i].GetRootOfUnityPowers());
+    EXPECT_EQ(mapped_ntts[i].GetPrecon64InvRootOfUnityPowers(),
+              ntts[i].GetPrecon64InvRootOfUnityPowers());
+    EXPECT_EQ(mapped_ntts[i].GetRootOfUnityPower(1),
+              ntts[i].GetRootOfUnityPower(1));
+    EXPECT_GT(mapped_ntts[i].GetTableMemoryBytes(), memory_bytes);
+
+    NTT copy = mapped_ntts[i];
+    CheckSameNTT(copy, ntts[i]);
+  }
+
+  NTTCache cache;
+  cache.Prewarm(mapped_ntts);
+  EXPECT_EQ(cache.GetStats().num_entries, ntts.size());
+  CheckSameNTT(*cache.Get(ntts[0].GetDegree(), ntts[0].GetModulus()),
+               ntts[0]);
+  EXPECT_EQ(cache.GetStats().misses, 0ULL);
+}
+
+// Absent tables are computed on first use
+TEST(NTTTables, computes_missing_tables) {
+  uint64_t n = 64;
+  NTT ntt(n, GeneratePrimes(1, 45, true, n)[0]);
+
+  NTT::PrecomputedTables tables;
+  tables.degree = n;
+  tables.modulus = ntt.GetModulus();
+  tables.root_of_unity = ntt.GetMinimalRootOfUnity();
+  for (size_t t = 0; t < NTT::s_num_tables; ++t) {
+    NTT::Table table = static_cast<NTT::Table>(t);
+    tables.tables[t].data = ntt.GetTable(table);
+    tables.tables[t].size = ntt.GetTableSize(table);
+  }
+  for (NTT::Table table : {NTT::Table::RootOfUnityPowers,
+                           NTT::Table::AVX512Precon32RootOfUnityPowers,
+                           NTT::Table::AVX512Precon52RootOfUnityPowers,
+                           NTT::Table::AVX512Precon64RootOfUnityPowers,
+                           NTT::Table::InvRootOfUnityPowers,
+                           NTT::Table::Precon52InvRootOfUnityPowers}) {
+    tables.tables[static_cast<size_t>(table)] = NTT::TableView{};
+  }
+
+  NTT view_ntt(tables);
+  CheckSameNTT(view_ntt, ntt);
+}
+
+TEST(NTTTables, invalid_file) {
+  EXPECT_THROW(MappedNTTTables(TablePath("missing")), std::runtime_error);
+
+  std::string path = TablePath("invalid_file");
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "not an NTT table file";
+  }
+  EXPECT_THROW(MappedNTTTables tables(path), std::invalid_argument);
+
+  // Truncated file
+  uint64_t n = 16;
+  NTT ntt(n, GeneratePrimes(1, 30, true, n)[0]);
+  SaveNTTTables(path, {&ntt});
+  std::string contents;
+  {
+    std::ifstream file(path, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file),
+                    std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(contents.data(),
+               static_cast<std::streamsize>(contents.size() - 64));
+  }
+  EXPECT_THROW(MappedNTTTables tables(path), std::invalid_argument);
+
+  // Records with a bad modulus or root of unity. The record of the first NTT
+  // starts with its degree, modulus and root of unity.
+  const size_t record_offset = 24;
+  for (size_t field : {1, 2}) {
+    for (uint64_t value : {uint64_t{0}, uint64_t{1}, ntt.GetModulus() + 2,
+                           ntt.GetModulus() - 1}) {
+      std::string bad_contents = contents;
+      std::memcpy(&bad_contents[record_offset + field * sizeof(uint64_t)],
+                  &value, sizeof(value));
+      {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bad_contents.data(),
+                   static_cast<std::streamsize>(bad_contents.size()));
+      }
+      EXPECT_THROW(MappedNTTTables tables(path), std::invalid_argument);
+    }
+  }
+
+  // Tables shorter than the kernels read, e.g. a truncated AVX512 table. The
+  // table sizes follow the degree, modulus, root of unity and table offsets.
+  for (NTT::Table table : {NTT::Table::RootOfUnityPowers,
+                           NTT::Table::AVX512RootOfUnityPowers,
+                           NTT::Table::AVX512Precon52RootOfUnityPowers}) {
+    const size_t size_offset =
+        record_offset +
+        (3 + NTT::s_num_tables + static_cast<size_t>(table)) * sizeof(uint64_t);
+    for (uint64_t size : {n / 2, n, 2 * n}) {
+      if (size == NTT::ExpectedTableSize(n, table)) {
+        continue;
+      }
+      std::string bad_contents = contents;
+      std::memcpy(&bad_contents[size_offset], &size, sizeof(size));
+      {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bad_contents.data(),
+                   static_cast<std::streamsize>(bad_contents.size()));
+      }
+      EXPECT_THROW(MappedNTTTables tables(path), std::invalid_argument);
+    }
+  }
+  std::remove(path.c_str());
+}
+
+// The expected sizes match the computed tables, and views of other sizes are
+// rejected
+TEST(NTTTables, table_sizes) {
+  for (uint64_t n : {2, 4, 8, 16, 1024}) {
+    NTT ntt(n, GeneratePrimes(1, 40, true, n)[0]);
+    for (size_t t = 0; t < NTT::s_num_tables; ++t) {
+      NTT::Table table = static_cast<NTT::Table>(t);
+      EXPECT_EQ(NTT::ExpectedTableSize(n, table), ntt.GetTableSize(table));
+    }
+    if (n >= 8) {
+      EXPECT_EQ(NTT::ExpectedTableSize(n, NTT::Table::AVX512RootOfUnityPowers),
+                13 * n / 8);
+    }
+
+    NTT::PrecomputedTables tables;
+    tables.degree = n;
+    tables.modulus = ntt.GetModulus();
+    tables.root_of_unity = ntt.GetMinimalRootOfUnity();
+    const size_t avx512 =
+        static_cast<size_t>(NTT::Table::AVX512RootOfUnityPowers);
+    tables.tables[avx512].data = ntt.GetTable(NTT::Table::RootOfUnityPowers);
+    tables.tables[avx512].size = n;
+    EXPECT_THROW(NTT{tables}, std::invalid_argument);
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
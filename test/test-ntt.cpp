@@ -93,6 +93,18 @@ TEST(NTT, bad_input) {
 }
 #endif
 
+// A default-constructed NTT has no tables
+TEST(NTT, default_constructed) {
+  NTT ntt;
+  for (size_t t = 0; t < NTT::s_num_tables; ++t) {
+    NTT::Table table = static_cast<NTT::Table>(t);
+    EXPECT_EQ(ntt.GetTableSize(table), 0ULL);
+  }
+  EXPECT_TRUE(ntt.GetRootOfUnityPowers().empty());
+  EXPECT_TRUE(ntt.GetPrecon64InvRootOfUnityPowers().empty());
+  EXPECT_EQ(ntt.GetTableMemoryBytes(), 0ULL);
+}
+
 TEST(NTT, Powers) {
   uint64_t modulus = 0xffffffffffc0001ULL;
   {
@@ -467,6 +479,101 @@ TEST_P(NttNativeTest, InverseRadix2Random) {
   AssertEqual(input, input_reference);
 }
 
+// Checks the multi-threaded transforms match the single-threaded transforms
+TEST(NTT, parallel_matches_serial) {
+  for (uint64_t N : {1ULL << 15, 1ULL << 16}) {
+    for (uint64_t bits : {30, 50, 60}) {
+      uint64_t modulus = GeneratePrimes(1, bits, true, N)[0];
+      NTT ntt(N, modulus);
+      auto input = GenerateInsecureUniformIntRandomValues(N, 0, 4 * modulus);
+      auto reduced_input = input;
+      for (auto& elem : reduced_input) {
+        elem %= modulus;
+      }
+
+      AlignedVector64<uint64_t> expected_fwd(N);
+      AlignedVector64<uint64_t> expected_inv(N);
+      ntt.ComputeForward(expected_fwd.data(), input.data(), 4, 1);
+      ntt.ComputeInverse(expected_inv.data(), expected_fwd.data(), 1, 1);
+      ASSERT_EQ(expected_inv, reduced_input);
+
+      for (size_t num_threads : {0, 2, 3, 4, 64}) {
+        auto policy = ExecutionPolicy::Parallel(
+            ExecutionPolicy::s_default_grain_size, num_threads);
+
+        // Out-of-place
+        AlignedVector64<uint64_t> output(N);
+        ntt.ComputeForward(output.data(), input.data(), 4, 1, policy);
+        ASSERT_EQ(output, expected_fwd);
+        AlignedVector64<uint64_t> inv_output(N);
+        ntt.ComputeInverse(inv_output.data(), output.data(), 1, 1, policy);
+        ASSERT_EQ(inv_output, reduced_input);
+
+        // In-place, with lazy outputs
+        output = input;
+        ntt.ComputeForward(output.data(), output.data(), 4, 4, policy);
+        for (size_t i = 0; i < N; ++i) {
+          ASSERT_LT(output[i], 4 * modulus);
+          output[i] %= modulus;
+        }
+        ASSERT_EQ(output, expected_fwd);
+        ntt.ComputeInverse(output.data(), output.data(), 1, 2, policy);
+        for (size_t i = 0; i < N; ++i) {
+          ASSERT_LT(output[i], 2 * modulus);
+          output[i] %= modulus;
+        }
+        ASSERT_EQ(output, reduced_input);
+      }
+    }
+  }
+}
+
+// Checks the tables are computed on first use, and Precompute() computes the
+// tables used by the transforms
+TEST(NTT, lazy_tables) {
+  for (uint64_t N : {1ULL << 3, 1ULL << 10, 1ULL << 15}) {
+    for (uint64_t bits : {30, 50, 60}) {
+      for (size_t num_threads : {1, 4}) {
+        uint64_t modulus = GeneratePrimes(1, bits, true, N)[0];
+        NTT ntt(N, modulus);
+        auto policy = num_threads == 1
+                          ? ExecutionPolicy::Serial()
+                          : ExecutionPolicy::Parallel(
+                                ExecutionPolicy::s_default_grain_size,
+                                num_threads);
+        EXPECT_EQ(ntt.GetTableMemoryBytes(), 0ULL);
+
+        ntt.Precompute(NTT::Direction::Forward, policy);
+        uint64_t forward_bytes = ntt.GetTableMemoryBytes();
+        EXPECT_GT(forward_bytes, 0ULL);
+
+        auto input = GenerateInsecureUniformIntRandomValues(N, 0, modulus);
+        AlignedVector64<uint64_t> output(N);
+        ntt.ComputeForward(output.data(), input.data(), 1, 1, policy);
+        EXPECT_EQ(ntt.GetTableMemoryBytes(), forward_bytes);
+
+        // Copies share the computed tables
+        NTT copy = ntt;
+        copy.Precompute(NTT::Direction::Inverse, policy);
+        uint64_t both_bytes = ntt.GetTableMemoryBytes();
+        EXPECT_GT(both_bytes, forward_bytes);
+        ntt.ComputeInverse(output.data(), output.data(), 1, 1, policy);
+        EXPECT_EQ(ntt.GetTableMemoryBytes(), both_bytes);
+        ASSERT_EQ(output, input);
+
+        // Not all tables are used on one CPU
+        uint64_t all_bytes = 0;
+        for (size_t t = 0; t < NTT::s_num_tables; ++t) {
+          all_bytes += ntt.GetTableSize(static_cast<NTT::Table>(t)) *
+                       sizeof(uint64_t);
+        }
+        EXPECT_LT(both_bytes, all_bytes);
+        EXPECT_EQ(ntt.GetTableMemoryBytes(), all_bytes);
+      }
+    }
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     NTT, NttNativeTest,
     ::testing::Combine(
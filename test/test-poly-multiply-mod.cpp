@@ -0,0 +1,180 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "hexl/eltwise/eltwise-mult-mod.hpp"
+#include "hexl/ntt/ntt.hpp"
+#include "hexl/ntt/poly-multiply-mod.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "ntt/ntt-internal.hpp"
+#include "test/test-util.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+namespace {
+
+// Schoolbook multiplication in Z_q[X]/(X^n + 1)
+std::vector<uint64_t> NegacyclicMultiply(const uint64_t* operand1,
+                                         const uint64_t* operand2, uint64_t n,
+                                         uint64_t modulus) {
+  std::vector<uint64_t> result(n, 0);
+  for (uint64_t i = 0; i < n; ++i) {
+    for (uint64_t j = 0; j < n; ++j) {
+      uint64_t product = MultiplyMod(operand1[i], operand2[j], modulus);
+      uint64_t k = i + j;
+      if (k < n) {
+        result[k] = AddUIntMod(result[k], product, modulus);
+      } else {
+        result[k - n] = SubUIntMod(result[k - n], product, modulus);
+      }
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+#ifdef HEXL_DEBUG
+TEST(PolyMultiplyMod, bad_input) {
+  uint64_t n = 8;
+  uint64_t modulus = 769;
+  std::vector<uint64_t> op(n, 1);
+  std::vector<uint64_t> big_op(n, modulus);
+
+  EXPECT_ANY_THROW(PolyMultiplyMod(nullptr, op.data(), op.data(), n, modulus));
+  EXPECT_ANY_THROW(PolyMultiplyMod(op.data(), nullptr, op.data(), n, modulus));
+  EXPECT_ANY_THROW(PolyMultiplyMod(op.data(), op.data(), nullptr, n, modulus));
+  EXPECT_ANY_THROW(
+      PolyMultiplyMod(op.data(), op.data(), op.data(), 6, modulus));
+  EXPECT_ANY_THROW(PolyMultiplyMod(op.data(), op.data(), op.data(), n, 19));
+  EXPECT_ANY_THROW(
+      PolyMultiplyMod(op.data(), big_op.data(), op.data(), n, modulus));
+  EXPECT_ANY_THROW(
+      PolyMultiplyMod(op.data(), op.data(), op.data(), n, &modulus, 0));
+}
+#endif
+
+TEST(PolyMultiplyMod, small) {
+  uint64_t n = 4;
+  uint64_t modulus = 17;
+  std::vector<uint64_t> op1{1, 2, 3, 4};
+  std::vector<uint64_t> op2{5, 6, 7, 8};
+  // (1 + 2x + 3x^2 + 4x^3)(5 + 6x + 7x^2 + 8x^3) mod (x^4 + 1)
+  std::vector<uint64_t> exp_out{(68 + 5 - 16 - 21 - 24) % 17,
+                                (51 + 6 + 10 - 24 - 28) % 17,
+                                (7 + 12 + 15 - 32) % 17,
+                                (8 + 14 + 18 + 20) % 17};
+  std::vector<uint64_t> result(n);
+
+  PolyMultiplyMod(result.data(), op1.data(), op2.data(), n, modulus);
+
+  CheckEqual(result, exp_out);
+}
+
+// Checks against schoolbook multiplication, including moduli too large for
+// lazy forward outputs
+TEST(PolyMultiplyMod, random) {
+  for (uint64_t n : {2, 16, 256}) {
+    for (uint64_t bits : {20, 50, 60, 61}) {
+      uint64_t modulus = GeneratePrimes(1, bits, true, n)[0];
+      auto op1 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+      auto op2 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+      auto expected = NegacyclicMultiply(op1.data(), op2.data(), n, modulus);
+
+      std::vector<uint64_t> result(n);
+      PolyMultiplyMod(result.data(), op1.data(), op2.data(), n, modulus);
+      ASSERT_EQ(result, expected);
+
+      // In-place, aliasing either operand
+      auto op1_copy = op1;
+      PolyMultiplyMod(op1_copy.data(), op1_copy.data(), op2.data(), n, modulus);
+      ASSERT_EQ(std::vector<uint64_t>(op1_copy.begin(), op1_copy.end()),
+                expected);
+
+      auto op2_copy = op2;
+      PolyMultiplyMod(op2_copy.data(), op1.data(), op2_copy.data(), n, modulus);
+      ASSERT_EQ(std::vector<uint64_t>(op2_copy.begin(), op2_copy.end()),
+                expected);
+    }
+  }
+}
+
+// Checks the fused kernel against separate transforms and dyadic product, for
+// sub-blocks from a single butterfly up to the full transform
+TEST(PolyMultiplyMod, fused_matches_unfused) {
+  for (uint64_t n : {16, 1024, 1 << 15}) {
+    for (uint64_t bits : {30, 50, 60, 61}) {
+      uint64_t modulus = GeneratePrimes(1, bits, true, n)[0];
+      NTT ntt(n, modulus);
+      auto op1 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+      auto op2 = GenerateInsecureUniformIntRandomValues(n, 0, modulus);
+
+      std::vector<uint64_t> expected(n);
+      std::vector<uint64_t> temp(n);
+      ntt.ComputeForward(expected.data(), op1.data(), 1, 1);
+      ntt.ComputeForward(temp.data(), op2.data(), 1, 1);
+      EltwiseMultMod(expected.data(), expected.data(), temp.data(), n,
+                     modulus, 1);
+      ntt.ComputeInverse(expected.data(), expected.data(), 1, 1);
+
+      for (uint64_t block_size = 2; block_size <= 2 * n; block_size *= 2) {
+        std::vector<uint64_t> result(n);
+        PolyMultiplyModFused(ntt, result.data(), op1.data(), op2.data(),
+                             temp.data(), block_size);
+        ASSERT_EQ(result, expected) << "n " << n << ", modulus " << modulus
+                                    << ", block_size " << block_size;
+
+        // In-place, aliasing either operand
+        auto op1_copy = op1;
+        PolyMultiplyModFused(ntt, op1_copy.data(), op1_copy.data(), op2.data(),
+                             temp.data(), block_size);
+        ASSERT_EQ(std::vector<uint64_t>(op1_copy.begin(), op1_copy.end()),
+                  expected);
+
+        auto op2_copy = op2;
+        PolyMultiplyModFused(ntt, op2_copy.data(), op1.data(), op2_copy.data(),
+                             temp.data(), block_size);
+        ASSERT_EQ(std::vector<uint64_t>(op2_copy.begin(), op2_copy.end()),
+                  expected);
+      }
+    }
+  }
+}
+
+TEST(PolyMultiplyMod, rns) {
+  uint64_t n = 1024;
+  std::vector<uint64_t> moduli = GeneratePrimes(3, 50, true, n);
+  std::vector<uint64_t> moduli_60 = GeneratePrimes(2, 60, true, n);
+  moduli.insert(moduli.end(), moduli_60.begin(), moduli_60.end());
+  uint64_t num_moduli = moduli.size();
+
+  std::vector<uint64_t> op1(n * num_moduli);
+  std::vector<uint64_t> op2(n * num_moduli);
+  std::vector<uint64_t> expected(n * num_moduli);
+  for (uint64_t i = 0; i < num_moduli; ++i) {
+    auto values1 = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+    auto values2 = GenerateInsecureUniformIntRandomValues(n, 0, moduli[i]);
+    std::copy(values1.begin(), values1.end(), op1.begin() + i * n);
+    std::copy(values2.begin(), values2.end(), op2.begin() + i * n);
+    PolyMultiplyMod(&expected[i * n], values1.data(), values2.data(), n,
+                    moduli[i]);
+  }
+
+  std::vector<uint64_t> result(n * num_moduli);
+  PolyMultiplyMod(result.data(), op1.data(), op2.data(), n, moduli.data(),
+                  num_moduli);
+  ASSERT_EQ(result, expected);
+
+  std::fill(result.begin(), result.end(), 0);
+  PolyMultiplyMod(result.data(), op1.data(), op2.data(), n, moduli.data(),
+                  num_moduli, ExecutionPolicy::Parallel(n, 4));
+  ASSERT_EQ(result, expected);
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,82 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "hexl/ntt/ntt.hpp"
+#include "hexl/ntt/rns-ntt.hpp"
+#include "hexl/number-theory/number-theory.hpp"
+#include "test/test-util.hpp"
+#include "util/util-internal.hpp"
+
+namespace intel {
+namespace hexl {
+
+#ifdef HEXL_DEBUG
+TEST(RNSNTT, bad_input) {
+  uint64_t N = 8;
+  std::vector<uint64_t> moduli{769, 17};
+  std::vector<uint64_t> input(2 * N, 1);
+
+  EXPECT_ANY_THROW(RNSNTT(N, {}));
+
+  RNSNTT rns_ntt(N, moduli);
+  EXPECT_ANY_THROW(rns_ntt.ComputeForward(input.data(), nullptr, 1, 1, 1));
+  EXPECT_ANY_THROW(rns_ntt.ComputeForward(nullptr, input.data(), 1, 1, 1));
+  EXPECT_ANY_THROW(rns_ntt.ComputeForward(input.data(), input.data(), 0, 1, 1));
+  EXPECT_ANY_THROW(rns_ntt.ComputeForward(input.data(), input.data(), 1, 3, 1));
+  EXPECT_ANY_THROW(rns_ntt.ComputeInverse(input.data(), input.data(), 1, 4, 1));
+  EXPECT_ANY_THROW(rns_ntt.ComputeInverse(input.data(), input.data(), 1, 1, 4));
+}
+#endif
+
+// Checks the batched transforms match per-modulus NTT calls
+TEST(RNSNTT, matches_ntt) {
+  uint64_t N = 1024;
+  std::vector<uint64_t> moduli = GeneratePrimes(3, 30, true, N);
+  std::vector<uint64_t> moduli_60 = GeneratePrimes(2, 60, true, N);
+  moduli.insert(moduli.end(), moduli_60.begin(), moduli_60.end());
+  const size_t num_moduli = moduli.size();
+  const uint64_t num_polys = 3;
+
+  RNSNTT rns_ntt(N, moduli);
+  ASSERT_EQ(rns_ntt.GetDegree(), N);
+  ASSERT_EQ(rns_ntt.GetNumModuli(), num_moduli);
+  ASSERT_EQ(rns_ntt.GetModuli(), moduli);
+
+  std::vector<uint64_t> input(num_polys * num_moduli * N);
+  for (uint64_t poly = 0; poly < num_polys; ++poly) {
+    for (size_t i = 0; i < num_moduli; ++i) {
+      auto values = GenerateInsecureUniformIntRandomValues(N, 0, moduli[i]);
+      std::copy(values.begin(), values.end(),
+                input.begin() + (poly * num_moduli + i) * N);
+    }
+  }
+
+  std::vector<uint64_t> expected_fwd(input.size());
+  for (uint64_t poly = 0; poly < num_polys; ++poly) {
+    for (size_t i = 0; i < num_moduli; ++i) {
+      size_t offset = (poly * num_moduli + i) * N;
+      NTT(N, moduli[i])
+          .ComputeForward(&expected_fwd[offset], &input[offset], 1, 1);
+    }
+  }
+
+  for (const ExecutionPolicy& policy :
+       {ExecutionPolicy::Serial(), ExecutionPolicy::Parallel(1, 2),
+        ExecutionPolicy::Parallel(1, 4), ExecutionPolicy::Parallel(1, 64)}) {
+    std::vector<uint64_t> output(input.size());
+    rns_ntt.ComputeForward(output.data(), input.data(), num_polys, 1, 1,
+                           policy);
+    ASSERT_EQ(output, expected_fwd);
+
+    rns_ntt.ComputeInverse(output.data(), output.data(), num_polys, 1, 1,
+                           policy);
+    ASSERT_EQ(output, input);
+  }
+}
+
+}  // namespace hexl
+}  // namespace intel
@@ -0,0 +1,112 @@
+// Copyright (C) 2020 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "hexl/util/execution-policy.hpp"
+#include "util/parallel.hpp"
+#include "util/thread-pool.hpp"
+
+namespace intel {
+namespace hexl {
+
+TEST(ExecutionPolicy, construct) {
+  EXPECT_TRUE(ExecutionPolicy::Serial().IsSerial());
+
+  ExecutionPolicy policy = ExecutionPolicy::Parallel();
+  EXPECT_FALSE(policy.IsSerial());
+  EXPECT_EQ(policy.GetNumThreads(), 0ULL);
+  EXPECT_EQ(policy.GetGrainSize(), ExecutionPolicy::s_default_grain_size);
+
+  policy = ExecutionPolicy::Parallel(0, 3);
+  EXPECT_EQ(policy.GetNumThreads(), 3ULL);
+  EXPECT_EQ(policy.GetGrainSize(), 1ULL);
+
+  EXPECT_TRUE(ExecutionPolicy::Parallel(64, 1).IsSerial());
+}
+
+TEST(ThreadPool, submit) {
+  std::atomic<int> num_tasks{0};
+  {
+    ThreadPool pool(3);
+    EXPECT_EQ(pool.NumWorkers(), 3ULL);
+    for (int i = 0; i < 10; ++i) {
+      pool.Submit([&]() { ++num_tasks; });
+    }
+  }
+  EXPECT_EQ(num_tasks, 10);
+}
+
+// Checks each index is visited exactly once
+TEST(ThreadPool, parallel_for_chunks) {
+  for (uint64_t size : {0, 1, 7, 64, 1000}) {
+    for (uint64_t chunk_size : {1, 3, 64, 2000}) {
+      for (size_t num_threads : {1, 2, 4, 16}) {
+        std::unique_ptr<std::atomic<int>[]> visits(
+            new std::atomic<int>[size + 1]());
+        ParallelForChunks(size, chunk_size, num_threads,
+                          [&](uint64_t begin, uint64_t end) {
+                            ASSERT_LE(end - begin, chunk_size);
+                            for (uint64_t i = begin; i < end; ++i) {
+                              ++visits[i];
+                            }
+                          });
+        for (uint64_t i = 0; i < size; ++i) {
+          ASSERT_EQ(visits[i], 1);
+        }
+      }
+    }
+  }
+}
+
+TEST(ThreadPool, rethrows) {
+  EXPECT_THROW(ParallelForChunks(100, 1, 4,
+                                 [](uint64_t begin, uint64_t) {
+                                   if (begin == 37) {
+                                     throw std::runtime_error("error");
+                                   }
+                                 }),
+               std::runtime_error);
+}
+
+TEST(ThreadPool, nested) {
+  std::atomic<uint64_t> sum{0};
+  ExecutionPolicy policy = ExecutionPolicy::Parallel(1);
+  ParallelFor(8, policy, [&](uint64_t begin, uint64_t end) {
+    for (uint64_t i = begin; i < end; ++i) {
+      ParallelFor(
+          100, policy,
+          [&](uint64_t inner_begin, uint64_t inner_end) {
+            sum += inner_end - inner_begin;
+          },
+          8);
+    }
+  });
+  EXPECT_EQ(sum, 800ULL);
+}
+
+TEST(ParallelFor, serial_single_call) {
+  int num_calls = 0;
+  ParallelFor(1000, ExecutionPolicy::Serial(),
+              [&](uint64_t begin, uint64_t end) {
+                EXPECT_EQ(begin, 0ULL);
+                EXPECT_EQ(end, 1000ULL);
+                ++num_calls;
+              });
+  EXPECT_EQ(num_calls, 1);
+
+  // Work below the grain size stays on the calling thread
+  num_calls = 0;
+  ParallelFor(
+      100, ExecutionPolicy::Parallel(1024),
+      [&](uint64_t, uint64_t) { ++num_calls; }, 8);
+  EXPECT_EQ(num_calls, 1);
+}
+
+}  // namespace hexl
+}  // namespace intel